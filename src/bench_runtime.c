@@ -0,0 +1,3261 @@
+/**
+ * @file bench_runtime.c
+ * @brief Runtime 性能基准
+ *
+ * 用法: ./bench_runtime <场景>
+ * - paging: 常量分页吞吐 vs 内存上限 (大规模合成模型)
+ * - arena:  大页内存池 + 预缺页对首次/稳态推理延迟的影响
+ * - dispatch: 串行路径每算子调度开销 (逐层遍历 / 扁平计划 / 直线代码)
+ * - emit:   为演示模型生成直线执行代码 (./bench_runtime emit <输出文件>; 未给出文件时跳过)
+ * - static: 多线程路径 共享队列 vs 静态切片 (LPT) 的完成时间与抖动
+ * - caller: 演示模型多算子层的逐层延迟 (对比 -DTVMRT_CALLER_PARTICIPATES=0 构建)
+ * - adaptive: 逐层自适应 串行/分发 与固定分发的对比
+ * - dataflow: 点对点依赖标志 vs 层屏障 (深而窄依赖的多链模型)
+ * - falseshare: 内存规划的缓存行隔离: 占用代价与并发写入的伪共享开销
+ * - profile: 逐算子剖析报告 (耗时 + 硬件计数器) 及其开销
+ * - scaling: 不同 Worker 数下的完成时间与运行时扩缩容
+ * - large:  10k 算子合成模型: 准备阶段耗时、各执行路径结果校验、推理期间零堆分配
+ * - batch:  并发单样本请求: 逐请求执行 vs 动态批处理 (不同攒批等待时间)
+ * - throughput: 上下文池在延迟模式 (单请求分发) 与吞吐模式 (整请求调度) 下随并发数的表现
+ * - multimodel: 两个模型共用线程池: 延迟敏感模型在批量负载下的延迟 (同优先级 vs 高优先级)
+ * - deadline: 算子失败/截止时刻/取消后提前结束，及吞吐模式过载时按截止时刻丢弃请求
+ * - int8:   同一图的 int8 量化版本与 fp32 的输出误差、常量区大小与延迟
+ * - half:   同一 fp32 图的中间张量与权重以 fp16/bf16 存放时的内存占用、延迟与误差
+ * - tiled:  超出缓存的逐元素算子链: 逐层执行 vs 不同块预算的分块执行
+ * - tune:   MatMul 候选实现自动调优并写入调优缓存 (./bench_runtime tune [缓存文件])
+ * - broadcast: 广播/步长二元运算引擎 vs 逐元素计算下标的朴素循环 (常见广播模式)
+ * - reduce: 拆分为部分算子 + 合并算子的并行归约: 不同 Worker 数下的耗时、结果一致性与求和误差
+ * - conv:   常见层形状上 Conv2D 的 im2col 与直接卷积路径 (GFLOP/s) 及池化带宽
+ * - sparse: 剪枝权重 MatMul: 不同稀疏度下 CSR / 块稀疏内核相对稠密内核的加速比与自动选择
+ * - norm:   单内核 Softmax / LayerNorm vs 多算子朴素实现: 耗时、带宽与相对 double 参考的误差
+ */
+
+#include "tvmrt.h"
+#include <malloc.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================
+// 公共工具
+// ============================================================
+
+// 演示/合成模型的静态数组容量 (运行时本身按模型规模分配)
+#define BENCH_MAX_OPS 64
+#define BENCH_MAX_LAYERS 32
+
+// 场景参数 (argv[2])
+static const char *g_bench_arg;
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 延迟统计 (微秒): 会对 samples 原地排序
+typedef struct {
+  double mean, p50, p99, max, stddev;
+} LatencyStats;
+
+static int bench_cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+static LatencyStats bench_latency_stats(uint64_t *samples, int32_t n) {
+  LatencyStats st = {0};
+  double sum = 0.0, sq = 0.0;
+  for (int32_t i = 0; i < n; i++) {
+    double us = (double)samples[i] / 1e3;
+    sum += us;
+    sq += us * us;
+  }
+  qsort(samples, (size_t)n, sizeof(uint64_t), bench_cmp_u64);
+  st.mean = sum / n;
+  st.stddev = sqrt(fmax(sq / n - st.mean * st.mean, 0.0));
+  st.p50 = (double)samples[n / 2] / 1e3;
+  st.p99 = (double)samples[(int32_t)(n * 0.99)] / 1e3;
+  st.max = (double)samples[n - 1] / 1e3;
+  return st;
+}
+
+static void bench_print_stats_header(const char *label) {
+  printf("%-20s %9s %9s %9s %9s %9s\n", label, "mean(us)", "p50", "p99", "max", "stddev");
+}
+
+static void bench_print_stats(const char *name, LatencyStats st) {
+  printf("%-20s %9.1f %9.1f %9.1f %9.1f %9.1f\n", name, st.mean, st.p50, st.p99, st.max,
+         st.stddev);
+}
+
+// ============================================================
+// 场景: 常量分页
+// ============================================================
+//
+// 合成模型: PAGING_LAYERS 层，每层 1 个算子，读取独立的 PAGING_LAYER_BYTES
+// 常量区并求和。常量文件总大小 = 层数 × 每层字节数。
+
+#define PAGING_LAYERS 32
+#define PAGING_LAYER_BYTES (4u << 20)
+#define PAGING_RUNS 8
+
+typedef struct {
+  tvmrt_context_t *ctx;
+  int32_t offset;
+  int32_t count;
+  float *output;
+} PagingOpArgs;
+
+static int32_t paging_sum_op(void *args) {
+  PagingOpArgs *a = (PagingOpArgs *)args;
+  const float *w = (const float *)(a->ctx->const_workspace + a->offset);
+  float acc = 0.0f;
+  for (int32_t i = 0; i < a->count; i++) {
+    acc += w[i];
+  }
+  *a->output = acc;
+  return 0;
+}
+
+static int paging_write_weights(const char *path) {
+  FILE *f = fopen(path, "wb");
+  if (!f) return -1;
+
+  float *buf = (float *)malloc(PAGING_LAYER_BYTES);
+  if (!buf) {
+    fclose(f);
+    return -1;
+  }
+  for (int32_t l = 0; l < PAGING_LAYERS; l++) {
+    for (uint32_t i = 0; i < PAGING_LAYER_BYTES / sizeof(float); i++) {
+      buf[i] = (float)((l + i) & 7);
+    }
+    fwrite(buf, 1, PAGING_LAYER_BYTES, f);
+  }
+  free(buf);
+  fclose(f);
+  return 0;
+}
+
+static int bench_paging(void) {
+  const char *path = "/tmp/tvmrt_bench_weights.bin";
+  if (paging_write_weights(path) != 0) {
+    printf("无法写入常量文件 %s\n", path);
+    return 1;
+  }
+
+  static tvmrt_op_desc_t op_descs[PAGING_LAYERS];
+  static int32_t layer_ops[PAGING_LAYERS];
+  static tvmrt_schedule_layer_t layers[PAGING_LAYERS];
+  static tvmrt_op_exec_t execs[PAGING_LAYERS];
+  static PagingOpArgs args[PAGING_LAYERS];
+  static float outputs[PAGING_LAYERS];
+
+  for (int32_t l = 0; l < PAGING_LAYERS; l++) {
+    op_descs[l] = (tvmrt_op_desc_t){.op_id = l,
+                                    .name = "paging_sum",
+                                    .backend = TVMRT_BACKEND_CPU,
+                                    .input_count = 0,
+                                    .output_count = 1,
+                                    .const_offset = l * PAGING_LAYER_BYTES,
+                                    .const_size = PAGING_LAYER_BYTES};
+    layer_ops[l] = l;
+    layers[l] = (tvmrt_schedule_layer_t){.op_indices = &layer_ops[l], .count = 1};
+  }
+  tvmrt_schedule_desc_t schedule = {.layers = layers, .layer_count = PAGING_LAYERS};
+  tvmrt_model_desc_t model = {.op_descs = op_descs,
+                              .op_count = PAGING_LAYERS,
+                              .schedule = &schedule};
+
+  const uint64_t mb = 1u << 20;
+  const uint64_t caps[] = {0, 64 * mb, 32 * mb, 16 * mb, 8 * mb};
+  const uint64_t total = (uint64_t)PAGING_LAYERS * PAGING_LAYER_BYTES;
+
+  printf("常量分页: %d 层 × %u MB = %llu MB, 每组 %d 次推理\n", PAGING_LAYERS,
+         PAGING_LAYER_BYTES >> 20, (unsigned long long)(total / mb), PAGING_RUNS);
+  printf("%-10s %-10s %12s %12s %14s %10s\n", "预取方式", "上限(MB)", "ms/推理",
+         "GB/s", "估计峰值(MB)", "释放次数");
+
+  for (int io = 0; io <= 1; io++) {
+    for (size_t c = 0; c < sizeof(caps) / sizeof(caps[0]); c++) {
+      tvmrt_pager_config_t cfg = {.path = path, .memory_cap = caps[c], .io_thread = io != 0};
+      tvmrt_pager_t pager;
+      if (tvmrt_pager_open(&pager, &cfg, &model) != 0) {
+        printf("分页器打开失败\n");
+        return 1;
+      }
+
+      tvmrt_context_t ctx = {.op_execs = execs, .op_count = PAGING_LAYERS};
+      tvmrt_pager_attach(&pager, &ctx);
+      for (int32_t l = 0; l < PAGING_LAYERS; l++) {
+        args[l] = (PagingOpArgs){&ctx, op_descs[l].const_offset,
+                                 PAGING_LAYER_BYTES / sizeof(float), &outputs[l]};
+        execs[l] = (tvmrt_op_exec_t){"paging_sum", paging_sum_op, &args[l]};
+      }
+
+      // 预热一次 (建立页缓存)，再计时
+      tvmrt_engine_run_single(&ctx, &schedule);
+      uint64_t t0 = bench_now_ns();
+      for (int r = 0; r < PAGING_RUNS; r++) {
+        tvmrt_engine_run_single(&ctx, &schedule);
+      }
+      double ms = (double)(bench_now_ns() - t0) / 1e6 / PAGING_RUNS;
+
+      char cap_str[16];
+      if (caps[c] == 0) {
+        snprintf(cap_str, sizeof(cap_str), "不限");
+      } else {
+        snprintf(cap_str, sizeof(cap_str), "%llu", (unsigned long long)(caps[c] / mb));
+      }
+      printf("%-10s %-10s %12.2f %12.2f %14.1f %10d\n", io ? "I/O线程" : "madvise",
+             cap_str, ms, (double)total / (ms * 1e6),
+             (double)pager.peak_resident_bytes / (double)mb, pager.release_count);
+
+      tvmrt_pager_close(&pager);
+    }
+  }
+
+  printf("估计峰值: 常驻层区间字节之和 (共享边界页按层重复计入)，非实测 RSS\n");
+  remove(path);
+  return 0;
+}
+
+// ============================================================
+// 场景: Workspace 内存池
+// ============================================================
+//
+// 合成模型: ARENA_LAYERS 层串行，每层读取上一层输出区并写入本层输出区，
+// 访问顺序按 ~1MB 步长置换，使相邻访问落在相距很远的页上 (TLB 压力大)。
+
+#define ARENA_LAYERS 8
+#define ARENA_REGION_FLOATS (2u << 20) // 每层 8 MB
+#define ARENA_STRIDE ((1u << 18) + 1)  // 奇数步长 (~1MB), 与 2^21 互质保证为置换
+#define ARENA_STEADY_RUNS 5
+
+typedef struct {
+  const float *in;
+  float *out;
+  uint32_t count;
+} ArenaOpArgs;
+
+static int32_t arena_stride_op(void *args) {
+  ArenaOpArgs *a = (ArenaOpArgs *)args;
+  uint32_t mask = a->count - 1;
+  uint32_t idx = 0;
+  for (uint32_t i = 0; i < a->count; i++) {
+    a->out[idx] = a->in[idx] + 1.0f;
+    idx = (idx + ARENA_STRIDE) & mask;
+  }
+  return 0;
+}
+
+static int bench_arena(void) {
+  static int32_t layer_ops[ARENA_LAYERS];
+  static tvmrt_schedule_layer_t layers[ARENA_LAYERS];
+  static tvmrt_op_exec_t execs[ARENA_LAYERS];
+  static ArenaOpArgs args[ARENA_LAYERS];
+
+  for (int32_t l = 0; l < ARENA_LAYERS; l++) {
+    layer_ops[l] = l;
+    layers[l] = (tvmrt_schedule_layer_t){.op_indices = &layer_ops[l], .count = 1};
+  }
+  tvmrt_schedule_desc_t schedule = {.layers = layers, .layer_count = ARENA_LAYERS};
+
+  const uint64_t region_bytes = (uint64_t)ARENA_REGION_FLOATS * sizeof(float);
+  const uint64_t ws_size = region_bytes * ARENA_LAYERS;
+  const char *mode_names[] = {"普通页", "透明大页", "显式大页"};
+
+  printf("Workspace: %llu MB, %d 层, 步长访问\n", (unsigned long long)(ws_size >> 20),
+         ARENA_LAYERS);
+  printf("%-10s %-8s %-10s %12s %12s %12s\n", "请求模式", "预缺页", "实际模式",
+         "prepare ms", "首次 ms", "稳态 ms");
+
+  for (int mode = TVMRT_HUGEPAGE_NONE; mode <= TVMRT_HUGEPAGE_EXPLICIT; mode++) {
+    for (int prefault = 0; prefault <= 1; prefault++) {
+      tvmrt_arena_t arena;
+      tvmrt_context_t ctx = {.op_execs = execs, .op_count = ARENA_LAYERS};
+
+      uint64_t t0 = bench_now_ns();
+      if (tvmrt_arena_init(&arena, ws_size, (tvmrt_hugepage_mode_t)mode) != 0 ||
+          tvmrt_arena_prepare_context(&arena, &ctx, ws_size, NULL, 0, prefault != 0) != 0) {
+        printf("内存池创建失败\n");
+        return 1;
+      }
+      double prepare_ms = (double)(bench_now_ns() - t0) / 1e6;
+
+      float *regions = (float *)ctx.workspace;
+      for (int32_t l = 0; l < ARENA_LAYERS; l++) {
+        int32_t prev = (l + ARENA_LAYERS - 1) % ARENA_LAYERS;
+        args[l] = (ArenaOpArgs){regions + (uint64_t)prev * ARENA_REGION_FLOATS,
+                                regions + (uint64_t)l * ARENA_REGION_FLOATS,
+                                ARENA_REGION_FLOATS};
+        execs[l] = (tvmrt_op_exec_t){"arena_stride", arena_stride_op, &args[l]};
+      }
+
+      t0 = bench_now_ns();
+      tvmrt_engine_run_single(&ctx, &schedule);
+      double first_ms = (double)(bench_now_ns() - t0) / 1e6;
+
+      t0 = bench_now_ns();
+      for (int r = 0; r < ARENA_STEADY_RUNS; r++) {
+        tvmrt_engine_run_single(&ctx, &schedule);
+      }
+      double steady_ms = (double)(bench_now_ns() - t0) / 1e6 / ARENA_STEADY_RUNS;
+
+      printf("%-10s %-8s %-10s %12.2f %12.2f %12.2f\n", mode_names[mode],
+             prefault ? "是" : "否", mode_names[arena.hugepage], prepare_ms, first_ms,
+             steady_ms);
+      tvmrt_arena_destroy(&arena);
+    }
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 串行调度开销
+// ============================================================
+
+#define DISPATCH_ITERS 200000
+#define DISPATCH_NOP_OPS 64
+#define DISPATCH_NOP_LAYERS 32
+
+extern const tvmrt_model_desc_t *model_get_descriptor(void);
+extern int32_t model_plan_run(tvmrt_op_args_t *args);
+
+static int32_t dispatch_nop_op(void *args) {
+  (void)args;
+  __asm__ __volatile__("" ::: "memory");
+  return 0;
+}
+
+// 每算子耗时 (ns): 计时 iters 次 run(ctx)
+typedef int (*DispatchRunFn)(void *user);
+
+static double dispatch_measure(DispatchRunFn fn, void *user, int32_t op_count) {
+  for (int i = 0; i < 1000; i++) fn(user); // 预热
+  uint64_t t0 = bench_now_ns();
+  for (int i = 0; i < DISPATCH_ITERS; i++) fn(user);
+  return (double)(bench_now_ns() - t0) / ((double)DISPATCH_ITERS * op_count);
+}
+
+typedef struct {
+  tvmrt_context_t *ctx;
+  const tvmrt_schedule_desc_t *schedule;
+  tvmrt_op_args_t *args;
+} DispatchUser;
+
+static int dispatch_run_legacy(void *user) {
+  DispatchUser *u = (DispatchUser *)user;
+  return tvmrt_engine_run_single(u->ctx, u->schedule);
+}
+
+static int dispatch_run_plan(void *user) {
+  DispatchUser *u = (DispatchUser *)user;
+  return tvmrt_plan_run(u->ctx->plan);
+}
+
+static int dispatch_run_generated(void *user) {
+  DispatchUser *u = (DispatchUser *)user;
+  return model_plan_run(u->args);
+}
+
+// 绑定演示模型 (输入 10.0)，编译计划
+static int dispatch_prepare_demo(tvmrt_context_t *ctx, tvmrt_plan_t *plan,
+                                 tvmrt_op_args_t *args, tvmrt_op_exec_t *execs,
+                                 uint8_t *ws, const uint8_t *cws, float *in,
+                                 float *out) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  void *inputs[1] = {in};
+  void *outputs[1] = {out};
+  *ctx = (tvmrt_context_t){.workspace = ws,
+                           .const_workspace = cws,
+                           .op_execs = execs,
+                           .args_storage = args};
+  if (tvmrt_semantic_bind_args(model, args, inputs, 1, outputs, 1, ws, cws) != 0 ||
+      tvmrt_semantic_init(ctx, model) != 0 ||
+      tvmrt_plan_compile(plan, ctx, model->schedule) != 0) {
+    return -1;
+  }
+  return 0;
+}
+
+// 演示模型常量区 (与 default_lib0.c 布局一致)
+static const float g_demo_const[17] __attribute__((aligned(16))) = {
+    [0] = 5.0f, [4] = 4.0f, [8] = 3.0f, [12] = 2.0f, [16] = 1.0f};
+
+static int bench_dispatch(void) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[64] __attribute__((aligned(16)));
+  float in = 10.0f, out = 0.0f;
+  tvmrt_context_t ctx;
+
+  if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const,
+                            &in, &out) != 0) {
+    printf("演示模型准备失败\n");
+    return 1;
+  }
+  DispatchUser user = {&ctx, model->schedule, args};
+
+  printf("演示模型: %d 算子 / %d 层, %d 次迭代\n", plan.op_count, plan.layer_count,
+         DISPATCH_ITERS);
+  printf("%-16s %12s\n", "执行方式", "ns/算子");
+  double legacy = dispatch_measure(dispatch_run_legacy, &user, plan.op_count);
+  ctx.plan = &plan;
+  double flat = dispatch_measure(dispatch_run_plan, &user, plan.op_count);
+  double gen = dispatch_measure(dispatch_run_generated, &user, plan.op_count);
+  printf("%-16s %12.2f\n", "逐层遍历", legacy);
+  printf("%-16s %12.2f\n", "扁平计划", flat);
+  printf("%-16s %12.2f\n", "直线代码", gen);
+  if (out != 235.0f) {
+    printf("结果错误: %.1f\n", out);
+    return 1;
+  }
+
+  // 空算子: 只剩调度开销
+  static int32_t nop_ids[DISPATCH_NOP_OPS];
+  static tvmrt_schedule_layer_t nop_layers[DISPATCH_NOP_LAYERS];
+  int32_t per_layer = DISPATCH_NOP_OPS / DISPATCH_NOP_LAYERS;
+  for (int32_t i = 0; i < DISPATCH_NOP_OPS; i++) {
+    nop_ids[i] = i;
+    execs[i] = (tvmrt_op_exec_t){"nop", dispatch_nop_op, NULL};
+  }
+  for (int32_t l = 0; l < DISPATCH_NOP_LAYERS; l++) {
+    nop_layers[l] = (tvmrt_schedule_layer_t){&nop_ids[l * per_layer], per_layer};
+  }
+  tvmrt_schedule_desc_t nop_schedule = {nop_layers, DISPATCH_NOP_LAYERS};
+  tvmrt_context_t nop_ctx = {.op_execs = execs, .op_count = DISPATCH_NOP_OPS};
+  tvmrt_plan_compile(&plan, &nop_ctx, &nop_schedule);
+  DispatchUser nop_user = {&nop_ctx, &nop_schedule, NULL};
+
+  printf("\n空算子: %d 算子 / %d 层\n", DISPATCH_NOP_OPS, DISPATCH_NOP_LAYERS);
+  printf("%-16s %12s\n", "执行方式", "ns/算子");
+  legacy = dispatch_measure(dispatch_run_legacy, &nop_user, DISPATCH_NOP_OPS);
+  nop_ctx.plan = &plan;
+  flat = dispatch_measure(dispatch_run_plan, &nop_user, DISPATCH_NOP_OPS);
+  printf("%-16s %12.2f\n", "逐层遍历", legacy);
+  printf("%-16s %12.2f\n", "扁平计划", flat);
+  return 0;
+}
+
+// ============================================================
+// 场景: 生成直线执行代码
+// ============================================================
+
+static int bench_emit(void) {
+  // 只写调用方给出的文件: 全部场景连跑时不改动源码树
+  const char *path = g_bench_arg;
+  static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[64];
+  float in = 0.0f, out = 0.0f;
+  tvmrt_context_t ctx;
+
+  if (!path) {
+    printf("未指定输出文件，跳过 (用法: ./bench_runtime emit <输出文件>，或 make gen-plan)\n");
+    return 0;
+  }
+  if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const,
+                            &in, &out) != 0) {
+    return 1;
+  }
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    printf("无法写入 %s\n", path);
+    return 1;
+  }
+  int ret = tvmrt_plan_emit_c(&plan, model_get_descriptor(), "model_plan_run", f);
+  fclose(f);
+  printf("%s %s\n", ret == 0 ? "已生成" : "生成失败", path);
+  return ret == 0 ? 0 : 1;
+}
+
+// ============================================================
+// 场景: 静态切片 vs 共享队列
+// ============================================================
+//
+// 合成模型: STATIC_LAYERS 层 × STATIC_OPS_PER_LAYER 个忙等算子，代价
+// 按 g_static_cost_units 轮转 (不均衡)，考察 LPT 分配的负载均衡效果。
+
+#define STATIC_LAYERS 8
+#define STATIC_OPS_PER_LAYER 6
+#define STATIC_OPS (STATIC_LAYERS * STATIC_OPS_PER_LAYER)
+#define STATIC_UNIT_ITERS 2000
+#define STATIC_RUNS 2000
+
+static const uint32_t g_static_cost_units[STATIC_OPS_PER_LAYER] = {16, 2, 2, 8, 4, 2};
+
+static int32_t static_spin_op(void *args) {
+  uint32_t iters = *(const uint32_t *)args;
+  volatile uint32_t sink = 0;
+  for (uint32_t i = 0; i < iters; i++) {
+    sink += i;
+  }
+  return 0;
+}
+
+static LatencyStats engine_measure(tvmrt_context_t *ctx, const tvmrt_schedule_desc_t *schedule) {
+  static uint64_t samples[STATIC_RUNS];
+  for (int i = 0; i < 50; i++) tvmrt_engine_run(ctx, schedule);  // 预热
+  for (int i = 0; i < STATIC_RUNS; i++) {
+    uint64_t t0 = tvmrt_time_ns();
+    tvmrt_engine_run(ctx, schedule);
+    samples[i] = tvmrt_time_ns() - t0;
+  }
+  return bench_latency_stats(samples, STATIC_RUNS);
+}
+
+// 演示模型在两种多线程模式下的结果校验
+static int static_check_demo(void) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[64] __attribute__((aligned(16)));
+  float in = 10.0f, out = 0.0f;
+  tvmrt_context_t ctx;
+
+  if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const,
+                            &in, &out) != 0) {
+    return -1;
+  }
+  int ret = tvmrt_engine_run(&ctx, model->schedule);
+  float dynamic_out = out;
+  out = 0.0f;
+  ctx.plan = &plan;
+  ret |= tvmrt_plan_assign(&plan, NULL, tvmrt_engine_slot_count());
+  ret |= tvmrt_engine_run(&ctx, model->schedule);
+  printf("演示模型: 共享队列 %.1f, 静态切片 %.1f (预期 235.0)\n", dynamic_out, out);
+  return (ret == 0 && dynamic_out == 235.0f && out == 235.0f) ? 0 : -1;
+}
+
+// 构造合成模型: STATIC_LAYERS 层 × STATIC_OPS_PER_LAYER 个代价不等的自旋算子
+static void static_build_model(tvmrt_context_t *ctx, tvmrt_schedule_desc_t *schedule,
+                               tvmrt_plan_t *plan) {
+  static tvmrt_op_exec_t execs[STATIC_OPS];
+  static uint32_t iters[STATIC_OPS];
+  static int32_t ids[STATIC_OPS];
+  static tvmrt_schedule_layer_t layers[STATIC_LAYERS];
+
+  for (int32_t i = 0; i < STATIC_OPS; i++) {
+    // 每层错开一位，避免重的算子总落在同一位置
+    int32_t l = i / STATIC_OPS_PER_LAYER;
+    iters[i] = g_static_cost_units[(i + l) % STATIC_OPS_PER_LAYER] * STATIC_UNIT_ITERS;
+    execs[i] = (tvmrt_op_exec_t){"spin", static_spin_op, &iters[i]};
+    ids[i] = i;
+  }
+  for (int32_t l = 0; l < STATIC_LAYERS; l++) {
+    layers[l] = (tvmrt_schedule_layer_t){&ids[l * STATIC_OPS_PER_LAYER], STATIC_OPS_PER_LAYER};
+  }
+  *schedule = (tvmrt_schedule_desc_t){layers, STATIC_LAYERS};
+  *ctx = (tvmrt_context_t){.op_execs = execs, .op_count = STATIC_OPS};
+  tvmrt_plan_compile(plan, ctx, schedule);
+}
+
+static int bench_static(void) {
+  static tvmrt_plan_t plan;
+  static uint64_t cost[BENCH_MAX_OPS];
+  tvmrt_schedule_desc_t schedule;
+  tvmrt_context_t ctx;
+
+  if (tvmrt_engine_init(NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  if (static_check_demo() != 0) {
+    printf("演示模型结果错误\n");
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+
+  static_build_model(&ctx, &schedule, &plan);
+
+  printf("\n合成模型: %d 层 × %d 算子, %d 个 Worker, %d 次推理\n", STATIC_LAYERS,
+         STATIC_OPS_PER_LAYER, tvmrt_engine_num_workers(), STATIC_RUNS);
+  bench_print_stats_header("调度方式");
+
+  ctx.plan = NULL;
+  bench_print_stats("共享队列", engine_measure(&ctx, &schedule));
+
+  ctx.plan = &plan;
+  tvmrt_plan_assign(&plan, NULL, tvmrt_engine_slot_count());
+  bench_print_stats("静态切片 (等代价)", engine_measure(&ctx, &schedule));
+
+  tvmrt_plan_measure(&plan, 20, cost);
+  tvmrt_plan_assign(&plan, cost, tvmrt_engine_slot_count());
+  bench_print_stats("静态切片 (LPT 实测)", engine_measure(&ctx, &schedule));
+
+  tvmrt_engine_shutdown();
+  return 0;
+}
+
+// ============================================================
+// 场景: 调用线程参与执行
+// ============================================================
+//
+// 层级回调在每层开始时打点，相邻打点之差即该层延迟。
+
+#define CALLER_RUNS 5000
+
+typedef struct {
+  uint64_t stamp[BENCH_MAX_LAYERS + 1];
+} CallerStamps;
+
+static void caller_layer_hook(int32_t layer_idx, void *user) {
+  ((CallerStamps *)user)->stamp[layer_idx] = tvmrt_time_ns();
+}
+
+static void caller_report(tvmrt_context_t *ctx, const tvmrt_schedule_desc_t *schedule,
+                          CallerStamps *st, const char *mode) {
+  static uint64_t per_layer[BENCH_MAX_LAYERS][CALLER_RUNS];
+  static uint64_t total[CALLER_RUNS];
+  int32_t layers = schedule->layer_count;
+
+  for (int i = 0; i < 200; i++) tvmrt_engine_run(ctx, schedule);  // 预热
+  for (int i = 0; i < CALLER_RUNS; i++) {
+    tvmrt_engine_run(ctx, schedule);
+    st->stamp[layers] = tvmrt_time_ns();
+    for (int32_t l = 0; l < layers; l++) {
+      per_layer[l][i] = st->stamp[l + 1] - st->stamp[l];
+    }
+    total[i] = st->stamp[layers] - st->stamp[0];
+  }
+
+  printf("\n%s\n", mode);
+  bench_print_stats_header("层 (算子数)");
+  for (int32_t l = 0; l < layers; l++) {
+    if (schedule->layers[l].count < 2) continue;
+    char name[32];
+    snprintf(name, sizeof(name), "Layer %d (%d)", l + 1, schedule->layers[l].count);
+    bench_print_stats(name, bench_latency_stats(per_layer[l], CALLER_RUNS));
+  }
+  bench_print_stats("整体", bench_latency_stats(total, CALLER_RUNS));
+}
+
+static int bench_caller(void) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[64] __attribute__((aligned(16)));
+  static CallerStamps stamps;
+  float in = 10.0f, out = 0.0f;
+  tvmrt_context_t ctx;
+
+  if (tvmrt_engine_init(NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const,
+                            &in, &out) != 0) {
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+  ctx.layer_hook = caller_layer_hook;
+  ctx.layer_hook_user = &stamps;
+  tvmrt_plan_compile(&plan, &ctx, model->schedule);
+
+  printf("调用线程参与: %s, %d 个 Worker, %d 次推理\n",
+         TVMRT_CALLER_PARTICIPATES ? "是" : "否", tvmrt_engine_num_workers(), CALLER_RUNS);
+
+  caller_report(&ctx, model->schedule, &stamps, "共享队列");
+  int ok = (out == 235.0f);
+
+  out = 0.0f;
+  ctx.plan = &plan;
+  tvmrt_plan_assign(&plan, NULL, tvmrt_engine_slot_count());
+  caller_report(&ctx, model->schedule, &stamps, "静态切片");
+  ok &= (out == 235.0f);
+
+  tvmrt_engine_shutdown();
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 逐层自适应 串行/分发
+// ============================================================
+
+#define ADAPT_WARMUP 40
+#define ADAPT_INTERVAL 1000
+
+// 固定分发 vs 自适应，结束后打印所选方案
+static void adaptive_compare(tvmrt_context_t *ctx, const tvmrt_schedule_desc_t *schedule,
+                             tvmrt_plan_t *plan) {
+  bench_print_stats_header("执行方式");
+  tvmrt_plan_set_adaptive(plan, 0, 0);
+  tvmrt_plan_assign(plan, NULL, tvmrt_engine_slot_count());
+  bench_print_stats("全部分发", engine_measure(ctx, schedule));
+  tvmrt_plan_set_adaptive(plan, ADAPT_WARMUP, ADAPT_INTERVAL);
+  bench_print_stats("自适应", engine_measure(ctx, schedule));
+  tvmrt_plan_dump(plan, stdout);
+}
+
+static int bench_adaptive(void) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[64] __attribute__((aligned(16)));
+  float in = 10.0f, out = 0.0f;
+  tvmrt_context_t ctx;
+
+  if (tvmrt_engine_init(NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const,
+                            &in, &out) != 0) {
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+  ctx.plan = &plan;
+  printf("演示模型: %d 个 Worker, %d 次推理 (探测 %d 次, 每 %d 次重新评估)\n",
+         tvmrt_engine_num_workers(), STATIC_RUNS, ADAPT_WARMUP, ADAPT_INTERVAL);
+  adaptive_compare(&ctx, model->schedule, &plan);
+  if (out != 235.0f) {
+    printf("结果错误: %.1f\n", out);
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+
+  // 与 static 场景相同的忙等模型: 单算子耗时数十微秒
+  static tvmrt_op_exec_t spin_execs[STATIC_OPS];
+  static uint32_t iters[STATIC_OPS];
+  static int32_t ids[STATIC_OPS];
+  static tvmrt_schedule_layer_t layers[STATIC_LAYERS];
+  for (int32_t i = 0; i < STATIC_OPS; i++) {
+    int32_t l = i / STATIC_OPS_PER_LAYER;
+    iters[i] = g_static_cost_units[(i + l) % STATIC_OPS_PER_LAYER] * STATIC_UNIT_ITERS;
+    spin_execs[i] = (tvmrt_op_exec_t){"spin", static_spin_op, &iters[i]};
+    ids[i] = i;
+  }
+  for (int32_t l = 0; l < STATIC_LAYERS; l++) {
+    layers[l] = (tvmrt_schedule_layer_t){&ids[l * STATIC_OPS_PER_LAYER], STATIC_OPS_PER_LAYER};
+  }
+  tvmrt_schedule_desc_t schedule = {layers, STATIC_LAYERS};
+  tvmrt_context_t spin_ctx = {.op_execs = spin_execs, .op_count = STATIC_OPS};
+  tvmrt_plan_compile(&plan, &spin_ctx, &schedule);
+  spin_ctx.plan = &plan;
+
+  printf("\n忙等模型: %d 层 × %d 算子\n", STATIC_LAYERS, STATIC_OPS_PER_LAYER);
+  adaptive_compare(&spin_ctx, &schedule, &plan);
+
+  tvmrt_engine_shutdown();
+  return 0;
+}
+
+// ============================================================
+// 场景: 点对点依赖 vs 层屏障
+// ============================================================
+//
+// 合成模型: DF_CHAINS 条互不相关的链，每层每条链一个算子，只读本链上一层
+// 的输出 (乒乓两个槽位)。每层恰有一个重算子且逐层轮换链，层屏障下每层
+// 都要等重算子，依赖模式下各链可各自推进。
+
+#define DF_CHAINS 4
+#define DF_DEPTH 16
+#define DF_OPS (DF_CHAINS * DF_DEPTH)
+
+static const uint32_t g_df_cost_units[DF_CHAINS] = {8, 1, 1, 1};
+
+// 关键路径 (us): 层屏障 = 各层最重算子之和; 依赖模式 = 依赖图最长路径
+static void dataflow_critical_path(const tvmrt_plan_t *plan, const uint64_t *cost,
+                                   double *barrier_us, double *dataflow_us) {
+  uint64_t finish[BENCH_MAX_OPS];
+  uint64_t barrier = 0, longest = 0;
+  for (int32_t l = 0; l < plan->layer_count; l++) {
+    uint64_t layer_max = 0;
+    for (int32_t i = plan->layer_begin[l]; i < plan->layer_begin[l + 1]; i++) {
+      uint64_t c = cost[plan->op_ids[i]];
+      layer_max = c > layer_max ? c : layer_max;
+      uint64_t start = 0;
+      for (int32_t d = plan->dep_begin[i]; d < plan->dep_begin[i + 1]; d++) {
+        start = finish[plan->dep_list[d]] > start ? finish[plan->dep_list[d]] : start;
+      }
+      finish[i] = start + c;
+      longest = finish[i] > longest ? finish[i] : longest;
+    }
+    barrier += layer_max;
+  }
+  *barrier_us = (double)barrier / 1e3;
+  *dataflow_us = (double)longest / 1e3;
+}
+
+static int bench_dataflow(void) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[64] __attribute__((aligned(16)));
+  static uint64_t cost[BENCH_MAX_OPS];
+  float in = 10.0f, out = 0.0f;
+  tvmrt_context_t ctx;
+
+  if (tvmrt_engine_init(NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const,
+                            &in, &out) != 0 ||
+      tvmrt_plan_build_deps(&plan, model) != 0) {
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+  ctx.plan = &plan;
+
+  // 演示模型: 打印 L7_add_1 的直接前驱
+  for (int32_t i = 0; i < plan.op_count; i++) {
+    if (strcmp(execs[plan.op_ids[i]].name, "L7_add_1") != 0) continue;
+    printf("L7_add_1 的前驱:");
+    for (int32_t d = plan.dep_begin[i]; d < plan.dep_begin[i + 1]; d++) {
+      printf(" %s", execs[plan.op_ids[plan.dep_list[d]]].name);
+    }
+    printf(" (共 %d 条依赖边)\n", plan.dep_begin[plan.op_count]);
+  }
+  printf("演示模型: %d 个 Worker, %d 次推理\n", tvmrt_engine_num_workers(), STATIC_RUNS);
+  bench_print_stats_header("同步方式");
+  plan.dataflow = false;
+  bench_print_stats("层屏障", engine_measure(&ctx, model->schedule));
+  plan.dataflow = true;
+  out = 0.0f;
+  bench_print_stats("依赖标志", engine_measure(&ctx, model->schedule));
+  if (out != 235.0f) {
+    printf("结果错误: %.1f\n", out);
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+
+  // 多链模型
+  static tvmrt_tensor_map_entry_t tmap[DF_CHAINS * 2];
+  static tvmrt_op_desc_t descs[DF_OPS];
+  static uint32_t iters[DF_OPS];
+  static int32_t ids[DF_OPS];
+  static tvmrt_schedule_layer_t layers[DF_DEPTH];
+  for (int32_t i = 0; i < DF_CHAINS * 2; i++) {
+    tmap[i] = (tvmrt_tensor_map_entry_t){.sid = i + 1, .offset = i * 4, .size = 4, .align = 4};
+  }
+  for (int32_t l = 0; l < DF_DEPTH; l++) {
+    for (int32_t c = 0; c < DF_CHAINS; c++) {
+      int32_t i = l * DF_CHAINS + c;
+      int32_t cur = 1 + c * 2 + (l & 1);
+      int32_t prev = (l == 0) ? TVMRT_SID_INPUT(0) : 1 + c * 2 + ((l + 1) & 1);
+      descs[i] = (tvmrt_op_desc_t){.op_id = i,
+                                   .name = "chain",
+                                   .input_sids = {prev, -1, -1, -1},
+                                   .output_sids = {cur, -1},
+                                   .input_count = 1,
+                                   .output_count = 1};
+      iters[i] = g_df_cost_units[(c + l) % DF_CHAINS] * STATIC_UNIT_ITERS;
+      execs[i] = (tvmrt_op_exec_t){"chain", static_spin_op, &iters[i]};
+      ids[i] = i;
+    }
+    layers[l] = (tvmrt_schedule_layer_t){&ids[l * DF_CHAINS], DF_CHAINS};
+  }
+  tvmrt_model_desc_t chain_model = {.tensor_map = tmap,
+                                    .tensor_count = DF_CHAINS * 2,
+                                    .op_descs = descs,
+                                    .op_count = DF_OPS};
+  tvmrt_schedule_desc_t schedule = {layers, DF_DEPTH};
+  tvmrt_context_t chain_ctx = {.op_execs = execs, .op_count = DF_OPS};
+  if (tvmrt_plan_compile(&plan, &chain_ctx, &schedule) != 0 ||
+      tvmrt_plan_assign(&plan, NULL, tvmrt_engine_slot_count()) != 0 ||
+      tvmrt_plan_build_deps(&plan, &chain_model) != 0) {
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+  chain_ctx.plan = &plan;
+
+  tvmrt_plan_measure(&plan, 20, cost);
+  double cp_barrier, cp_dataflow;
+  dataflow_critical_path(&plan, cost, &cp_barrier, &cp_dataflow);
+  printf("\n多链模型: %d 条链 × %d 层, %d 条依赖边\n", DF_CHAINS, DF_DEPTH,
+         plan.dep_begin[plan.op_count]);
+  printf("关键路径 (实测算子耗时): 层屏障 %.1f us, 依赖标志 %.1f us\n", cp_barrier,
+         cp_dataflow);
+  bench_print_stats_header("同步方式");
+  plan.dataflow = false;
+  bench_print_stats("层屏障", engine_measure(&chain_ctx, &schedule));
+  plan.dataflow = true;
+  bench_print_stats("依赖标志", engine_measure(&chain_ctx, &schedule));
+
+  tvmrt_engine_shutdown();
+  return 0;
+}
+
+// ============================================================
+// 场景: 缓存行隔离 (伪共享)
+// ============================================================
+//
+// 合成模型: 一层 FS_OPS 个并行算子，各自对自己的输出反复读改写。
+// 紧凑排布时输出相距 4 字节、同处一个缓存行。
+
+#define FS_OPS 4
+#define FS_ITERS 200000
+#define FS_RUNS 200
+
+static int32_t fs_write_op(void *args) {
+  tvmrt_op_args_t *a = (tvmrt_op_args_t *)args;
+  volatile float *out = (volatile float *)a->outputs[0];
+  for (int32_t i = 0; i < FS_ITERS; i++) {
+    *out += 1.0f;
+  }
+  return 0;
+}
+
+static const char *const g_fs_event_names[TVMRT_PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "cache-refs", "cache-misses", "L1D-rd-miss", "branch-miss"};
+
+static int bench_falseshare(void) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  static tvmrt_tensor_map_entry_t demo_map[BENCH_MAX_OPS * TVMRT_MAX_OP_OUTPUTS];
+  static const int32_t separations[] = {0, 64, 128};
+
+  // 演示模型: 各隔离粒度下的占用，并按规划结果执行校验
+  printf("演示模型 workspace 占用 (手写映射表 64 B):\n");
+  for (size_t k = 0; k < sizeof(separations) / sizeof(separations[0]); k++) {
+    static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+    static tvmrt_op_args_t args[BENCH_MAX_OPS];
+    static uint8_t ws[1024] __attribute__((aligned(128)));
+    int32_t ws_size = 0;
+    if (tvmrt_memory_plan(model, separations[k], demo_map, &ws_size) != 0 ||
+        ws_size > (int32_t)sizeof(ws)) {
+      return 1;
+    }
+    tvmrt_model_desc_t planned = *model;
+    planned.tensor_map = demo_map;
+    float in = 10.0f, out = 0.0f;
+    void *inputs[1] = {&in}, *outputs[1] = {&out};
+    tvmrt_context_t ctx = {.workspace = ws,
+                           .const_workspace = (const uint8_t *)g_demo_const,
+                           .op_execs = execs,
+                           .args_storage = args};
+    if (tvmrt_semantic_bind_args(&planned, args, inputs, 1, outputs, 1, ws,
+                                 (const uint8_t *)g_demo_const) != 0 ||
+        tvmrt_semantic_init(&ctx, &planned) != 0 ||
+        tvmrt_engine_run_single(&ctx, planned.schedule) != 0 || out != 235.0f) {
+      printf("规划后的演示模型结果错误: %.1f\n", out);
+      return 1;
+    }
+    printf("  隔离粒度 %3d B: %4d B (输出 %.1f)\n", separations[k], ws_size, out);
+  }
+
+  // 合成模型
+  static tvmrt_tensor_map_entry_t tmap[FS_OPS], planned_map[FS_OPS];
+  static tvmrt_op_desc_t descs[FS_OPS];
+  static int32_t ids[FS_OPS];
+  static tvmrt_op_exec_t execs[FS_OPS];
+  static tvmrt_op_args_t args[FS_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[FS_OPS * 128] __attribute__((aligned(128)));
+  for (int32_t i = 0; i < FS_OPS; i++) {
+    tmap[i] = (tvmrt_tensor_map_entry_t){.sid = i + 1, .offset = 0, .size = 4, .align = 4};
+    descs[i] = (tvmrt_op_desc_t){.op_id = i,
+                                 .name = "fs_write",
+                                 .input_sids = {TVMRT_SID_INPUT(0), -1, -1, -1},
+                                 .output_sids = {i + 1, -1},
+                                 .input_count = 1,
+                                 .output_count = 1};
+    ids[i] = i;
+  }
+  static const tvmrt_op_func_t fs_funcs[1] = {fs_write_op};
+  tvmrt_schedule_layer_t layer = {ids, FS_OPS};
+  tvmrt_schedule_desc_t schedule = {&layer, 1};
+  tvmrt_model_desc_t fs_model = {.tensor_map = tmap,
+                                 .tensor_count = FS_OPS,
+                                 .op_descs = descs,
+                                 .op_count = FS_OPS,
+                                 .schedule = &schedule,
+                                 .cpu_func_table = fs_funcs,
+                                 .cpu_func_count = 1};
+
+  tvmrt_perf_counter_t counters[TVMRT_PERF_EVENT_COUNT];
+  int32_t available = 0;
+  for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) {
+    available += (tvmrt_perf_open(&counters[e], (tvmrt_perf_event_t)e) == 0);
+  }
+  if (tvmrt_engine_init(NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+
+  printf("\n合成模型: 1 层 × %d 个并发写算子, 每算子 %d 次读改写, %d 次推理\n", FS_OPS,
+         FS_ITERS, FS_RUNS);
+  if (available == 0) {
+    printf("硬件计数器不可用 (无 PMU 或 perf_event_paranoid 限制)，仅报告耗时\n");
+  }
+  printf("%-10s %8s %10s", "隔离粒度", "占用(B)", "us/推理");
+  for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) {
+    if (counters[e].fd >= 0) printf(" %14s", g_fs_event_names[e]);
+  }
+  printf("\n");
+
+  for (size_t k = 0; k < sizeof(separations) / sizeof(separations[0]); k++) {
+    int32_t ws_size = 0;
+    float in = 0.0f;
+    void *inputs[1] = {&in};
+    tvmrt_memory_plan(&fs_model, separations[k], planned_map, &ws_size);
+    tvmrt_model_desc_t planned = fs_model;
+    planned.tensor_map = planned_map;
+    tvmrt_context_t ctx = {.workspace = ws, .op_execs = execs, .args_storage = args};
+    tvmrt_semantic_bind_args(&planned, args, inputs, 1, NULL, 0, ws, NULL);
+    tvmrt_semantic_init(&ctx, &planned);
+    tvmrt_plan_compile(&plan, &ctx, &schedule);
+    tvmrt_plan_assign(&plan, NULL, tvmrt_engine_slot_count());  // 每个算子一个执行线程
+    ctx.plan = &plan;
+
+    uint64_t before[TVMRT_PERF_EVENT_COUNT];
+    for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) before[e] = tvmrt_perf_read(&counters[e]);
+    uint64_t t0 = tvmrt_time_ns();
+    for (int32_t r = 0; r < FS_RUNS; r++) {
+      tvmrt_engine_run(&ctx, &schedule);
+    }
+    double us = (double)(tvmrt_time_ns() - t0) / 1e3 / FS_RUNS;
+
+    printf("%-10d %8d %10.1f", separations[k], ws_size, us);
+    for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) {
+      if (counters[e].fd >= 0) {
+        printf(" %14llu", (unsigned long long)((tvmrt_perf_read(&counters[e]) - before[e]) / FS_RUNS));
+      }
+    }
+    printf("\n");
+  }
+
+  tvmrt_engine_shutdown();
+  for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) tvmrt_perf_close(&counters[e]);
+  return 0;
+}
+
+// ============================================================
+// 场景: 逐算子剖析
+// ============================================================
+
+static int bench_profile(void) {
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+  static tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static tvmrt_plan_t plan;
+  static uint8_t ws[64] __attribute__((aligned(16)));
+  static tvmrt_profile_t prof;
+  float in = 10.0f, out = 0.0f;
+  tvmrt_context_t ctx;
+
+  if (tvmrt_engine_init(NULL) != 0 || tvmrt_profile_init(&prof, model->op_count, NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const,
+                            &in, &out) != 0) {
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+  ctx.plan = &plan;
+  tvmrt_plan_assign(&plan, NULL, tvmrt_engine_slot_count());
+
+  printf("演示模型 (静态切片, %d 个 Worker), %d 次推理\n", tvmrt_engine_num_workers(), STATIC_RUNS);
+  bench_print_stats_header("剖析");
+  tvmrt_engine_set_profile(NULL);
+  bench_print_stats("关闭", engine_measure(&ctx, model->schedule));
+  tvmrt_profile_reset(&prof);
+  tvmrt_engine_set_profile(&prof);
+  bench_print_stats("开启", engine_measure(&ctx, model->schedule));
+  tvmrt_engine_set_profile(NULL);
+  printf("\n");
+  tvmrt_profile_report(&prof, &ctx, stdout);
+  tvmrt_profile_destroy(&prof);
+
+  tvmrt_engine_shutdown();
+  if (out != 235.0f) {
+    printf("结果错误: %.1f\n", out);
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 线程池规模与运行时扩缩容
+// ============================================================
+//
+// 同一进程内按不同 Worker 数重跑合成模型，每次扩缩容后校验演示模型结果。
+
+static int bench_scaling(void) {
+  static const int32_t counts[] = {0, 1, 2, 4, 8, TVMRT_WORKERS_AUTO};
+  enum { SCALING_ROWS = sizeof(counts) / sizeof(counts[0]) + 1 };
+  static tvmrt_plan_t plan;
+  static uint64_t cost[BENCH_MAX_OPS];
+  LatencyStats stats[SCALING_ROWS];
+  char names[SCALING_ROWS][32];
+  tvmrt_schedule_desc_t schedule;
+  tvmrt_context_t ctx;
+
+  tvmrt_engine_config_t config = {.num_workers = counts[0]};
+  if (tvmrt_engine_init(&config) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  static_build_model(&ctx, &schedule, &plan);
+  tvmrt_plan_measure(&plan, 20, cost);
+  ctx.plan = &plan;
+
+  printf("可用 CPU (亲和性 + cgroup 配额): %d\n", tvmrt_cpu_count());
+
+  // 每次扩缩容后先校验演示模型，表格统一在最后打印
+  int ok = 1;
+  int rows = 0;
+  for (; rows < SCALING_ROWS - 1; rows++) {
+    if (tvmrt_engine_resize(counts[rows]) != 0) {
+      printf("扩缩容失败: %d\n", counts[rows]);
+      ok = 0;
+      break;
+    }
+    ok &= (static_check_demo() == 0);
+    tvmrt_plan_assign(&plan, cost, tvmrt_engine_slot_count());
+    snprintf(names[rows], sizeof(names[rows]), counts[rows] < 0 ? "%d (auto)" : "%d",
+             tvmrt_engine_num_workers());
+    stats[rows] = engine_measure(&ctx, &schedule);
+  }
+
+  // 按 8 个 Worker 分配后缩容: 下次执行自动按原代价重新分配
+  if (ok && tvmrt_engine_resize(8) == 0) {
+    tvmrt_plan_assign(&plan, cost, tvmrt_engine_slot_count());
+    tvmrt_engine_resize(2);
+    snprintf(names[rows], sizeof(names[rows]), "8 -> 2");
+    stats[rows++] = engine_measure(&ctx, &schedule);
+    ok &= (plan.slot_count == tvmrt_engine_slot_count());
+  }
+
+  printf("\n合成模型: %d 层 × %d 算子, %d 次推理\n", STATIC_LAYERS, STATIC_OPS_PER_LAYER,
+         STATIC_RUNS);
+  bench_print_stats_header("Worker 数");
+  for (int i = 0; i < rows; i++) {
+    bench_print_stats(names[i], stats[i]);
+  }
+
+  tvmrt_engine_shutdown();
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 万级算子模型
+// ============================================================
+//
+// LARGE_LAYERS 层 × LARGE_WIDTH 条链，第 l 层第 k 个算子读第 l-1 层第 k 个
+// 算子的输出并加 1。张量映射表经内存规划后绑定，末层输出应为输入 + 层数。
+
+#define LARGE_LAYERS 40
+#define LARGE_WIDTH 250
+#define LARGE_OPS (LARGE_LAYERS * LARGE_WIDTH)
+#define LARGE_RUNS 200
+
+static int32_t large_inc_op(void *p) {
+  tvmrt_op_args_t *a = (tvmrt_op_args_t *)p;
+  *(float *)a->outputs[0] = *(const float *)a->inputs[0] + 1.0f;
+  return 0;
+}
+
+static double large_ms_since(uint64_t t0) { return (double)(tvmrt_time_ns() - t0) / 1e6; }
+
+// 当前堆上已分配字节数 (glibc)
+static size_t large_heap_bytes(void) { return mallinfo2().uordblks; }
+
+static int large_check(const tvmrt_model_desc_t *model, const uint8_t *ws, float in) {
+  for (int32_t k = 0; k < LARGE_WIDTH; k++) {
+    int32_t sid = (LARGE_LAYERS - 1) * LARGE_WIDTH + k;
+    if (*(const float *)(ws + model->tensor_map[sid].offset) != in + LARGE_LAYERS) return 0;
+  }
+  return 1;
+}
+
+static int bench_large(void) {
+  static tvmrt_op_desc_t descs[LARGE_OPS];
+  static tvmrt_tensor_map_entry_t tmap[LARGE_OPS], planned[LARGE_OPS];
+  static int32_t ids[LARGE_OPS];
+  static tvmrt_schedule_layer_t layers[LARGE_LAYERS];
+  static tvmrt_op_exec_t execs[LARGE_OPS];
+  static tvmrt_op_args_t args[LARGE_OPS];
+  static tvmrt_plan_t plan;
+  static uint64_t samples[LARGE_RUNS];
+  static const tvmrt_op_func_t funcs[] = {large_inc_op};
+  float in = 0.5f;
+
+  for (int32_t i = 0; i < LARGE_OPS; i++) {
+    int32_t l = i / LARGE_WIDTH;
+    descs[i] = (tvmrt_op_desc_t){.op_id = i, .name = "inc", .input_count = 1, .output_count = 1};
+    descs[i].input_sids[0] = (l == 0) ? TVMRT_SID_INPUT(0) : i - LARGE_WIDTH;
+    descs[i].output_sids[0] = i;
+    tmap[i] = (tvmrt_tensor_map_entry_t){.sid = i, .offset = i * 4, .size = 4, .align = 4};
+    ids[i] = i;
+  }
+  for (int32_t l = 0; l < LARGE_LAYERS; l++) {
+    layers[l] = (tvmrt_schedule_layer_t){&ids[l * LARGE_WIDTH], LARGE_WIDTH};
+  }
+  tvmrt_schedule_desc_t schedule = {layers, LARGE_LAYERS};
+  tvmrt_model_desc_t model = {.tensor_map = tmap, .tensor_count = LARGE_OPS, .op_descs = descs,
+                              .op_count = LARGE_OPS, .schedule = &schedule,
+                              .cpu_func_table = funcs, .cpu_func_count = 1};
+
+  if (tvmrt_engine_init(NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  printf("合成模型: %d 层 × %d 算子 = %d 算子, %d 个 Worker\n", LARGE_LAYERS, LARGE_WIDTH,
+         LARGE_OPS, tvmrt_engine_num_workers());
+
+  // 准备阶段
+  int32_t ws_size = 0;
+  uint64_t t0 = tvmrt_time_ns();
+  int ret = tvmrt_memory_plan(&model, 0, planned, &ws_size);
+  printf("内存规划: %.1f ms, workspace %d B (未规划 %d B)\n", large_ms_since(t0), ws_size,
+         LARGE_OPS * 4);
+  model.tensor_map = planned;
+  uint8_t *ws = (uint8_t *)calloc(1, (size_t)ws_size);
+  void *inputs[1] = {&in};
+  tvmrt_context_t ctx = {.workspace = ws, .op_execs = execs, .args_storage = args};
+
+  t0 = tvmrt_time_ns();
+  ret |= tvmrt_semantic_bind_args(&model, args, inputs, 1, NULL, 0, ws, NULL);
+  ret |= tvmrt_semantic_init(&ctx, &model);
+  printf("参数绑定: %.1f ms\n", large_ms_since(t0));
+
+  t0 = tvmrt_time_ns();
+  ret |= tvmrt_plan_compile(&plan, &ctx, &schedule);
+  ret |= tvmrt_plan_assign(&plan, NULL, tvmrt_engine_slot_count());
+  printf("计划编译 + 切片分配: %.1f ms\n", large_ms_since(t0));
+
+  t0 = tvmrt_time_ns();
+  ret |= tvmrt_plan_build_deps(&plan, &model);
+  printf("依赖推导: %.1f ms, %d 条依赖边\n", large_ms_since(t0), plan.dep_begin[plan.op_count]);
+  plan.dataflow = false;
+  if (ret != 0 || !ws) {
+    printf("准备失败\n");
+    tvmrt_engine_shutdown();
+    return 1;
+  }
+
+  // 各执行路径: 先清零 workspace 校验结果，再计时; 计时区间内统计堆变化
+  static const char *const modes[] = {"串行计划", "共享队列", "静态切片", "依赖标志"};
+  bench_print_stats_header("执行路径");
+  int ok = 1;
+  for (int m = 0; m < 4; m++) {
+    ctx.plan = (m == 1) ? NULL : &plan;
+    plan.dataflow = (m == 3);
+    memset(ws, 0, (size_t)ws_size);
+    int run_ok = (m == 0 ? tvmrt_engine_run_single(&ctx, &schedule) : tvmrt_engine_run(&ctx, &schedule)) == 0;
+    ok &= run_ok && large_check(&model, ws, in);
+
+    size_t heap = large_heap_bytes();
+    for (int i = 0; i < LARGE_RUNS; i++) {
+      t0 = tvmrt_time_ns();
+      if (m == 0) {
+        tvmrt_engine_run_single(&ctx, &schedule);
+      } else {
+        tvmrt_engine_run(&ctx, &schedule);
+      }
+      samples[i] = tvmrt_time_ns() - t0;
+    }
+    ok &= (large_heap_bytes() == heap);
+    bench_print_stats(modes[m], bench_latency_stats(samples, LARGE_RUNS));
+  }
+
+  // 每次推理前重新编译 (default_lib1.c 的用法): 容量足够时不应分配
+  size_t heap = large_heap_bytes();
+  for (int i = 0; i < 10; i++) tvmrt_plan_compile(&plan, &ctx, &schedule);
+  size_t recompile_delta = large_heap_bytes() - heap;
+  printf("推理与重新编译期间堆变化: %s\n", ok && recompile_delta == 0 ? "0 B" : "非零");
+  ok &= (recompile_delta == 0);
+
+  tvmrt_plan_destroy(&plan);
+  tvmrt_engine_shutdown();
+  free(ws);
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 动态批处理
+// ============================================================
+//
+// BATCH_CLIENTS 个线程并发提交演示模型的单样本请求 (输入各不相同，输出
+// 逐个校验)。基线为逐请求执行: 每个线程持有自己的已绑定上下文，调度引擎
+// 由互斥锁串行化; 批处理器按不同 max_delay 攒批。
+
+#define BATCH_CLIENTS 16
+#define BATCH_REQUESTS 400
+#define BATCH_MAX 16
+#define BATCH_WS_SIZE 64
+
+typedef struct {
+  int32_t id;
+  tvmrt_batcher_t *batcher; // NULL 时走逐请求基线
+  tvmrt_mutex_t *engine_lock;
+  uint64_t *samples;
+  int ok;
+} BatchClient;
+
+static void *batch_client_func(void *arg) {
+  BatchClient *c = (BatchClient *)arg;
+  static __thread tvmrt_op_args_t args[BENCH_MAX_OPS];
+  static __thread tvmrt_op_exec_t execs[BENCH_MAX_OPS];
+  static __thread tvmrt_plan_t plan;
+  static __thread uint8_t ws[BATCH_WS_SIZE] __attribute__((aligned(16)));
+  float in = 0.0f, out = 0.0f;
+  void *inputs[1] = {&in};
+  void *outputs[1] = {&out};
+  tvmrt_context_t ctx;
+
+  c->ok = 1;
+  if (!c->batcher) {
+    if (dispatch_prepare_demo(&ctx, &plan, args, execs, ws, (const uint8_t *)g_demo_const, &in,
+                              &out) != 0) {
+      c->ok = 0;
+      return NULL;
+    }
+    ctx.plan = &plan;
+  }
+  const tvmrt_schedule_desc_t *schedule = model_get_descriptor()->schedule;
+
+  for (int32_t i = 0; i < BATCH_REQUESTS; i++) {
+    // 演示模型: 输出 = 输入 × 20 + 35 (输入 10 -> 235)
+    in = (float)(c->id * BATCH_REQUESTS + i);
+    out = 0.0f;
+    uint64_t t0 = tvmrt_time_ns();
+    int ret;
+    if (c->batcher) {
+      ret = tvmrt_batcher_submit(c->batcher, inputs, outputs);
+    } else {
+      tvmrt_mutex_lock(c->engine_lock);
+      ret = tvmrt_engine_run(&ctx, schedule);
+      tvmrt_mutex_unlock(c->engine_lock);
+    }
+    c->samples[i] = tvmrt_time_ns() - t0;
+    c->ok &= (ret == 0 && out == in * 20.0f + 35.0f);
+  }
+  if (!c->batcher) tvmrt_plan_destroy(&plan);
+  return NULL;
+}
+
+// 并发跑一轮，打印吞吐与请求延迟
+static int batch_round(const char *name, tvmrt_batcher_t *batcher) {
+  static uint64_t samples[BATCH_CLIENTS * BATCH_REQUESTS];
+  tvmrt_thread_t threads[BATCH_CLIENTS];
+  BatchClient clients[BATCH_CLIENTS];
+  tvmrt_mutex_t engine_lock;
+  tvmrt_mutex_init(&engine_lock);
+
+  uint64_t t0 = tvmrt_time_ns();
+  for (int32_t i = 0; i < BATCH_CLIENTS; i++) {
+    clients[i] = (BatchClient){.id = i, .batcher = batcher, .engine_lock = &engine_lock,
+                               .samples = &samples[i * BATCH_REQUESTS]};
+    tvmrt_thread_create(&threads[i], batch_client_func, &clients[i]);
+  }
+  int ok = 1;
+  for (int32_t i = 0; i < BATCH_CLIENTS; i++) {
+    tvmrt_thread_join(&threads[i]);
+    ok &= clients[i].ok;
+  }
+  double secs = (double)(tvmrt_time_ns() - t0) / 1e9;
+  tvmrt_mutex_destroy(&engine_lock);
+
+  LatencyStats st = bench_latency_stats(samples, BATCH_CLIENTS * BATCH_REQUESTS);
+  double avg_batch = batcher && batcher->batch_count
+                         ? (double)batcher->request_count / (double)batcher->batch_count
+                         : 1.0;
+  printf("%-20s %10.0f %9.1f %9.1f %9.2f %s\n", name, BATCH_CLIENTS * BATCH_REQUESTS / secs,
+         st.p50, st.p99, avg_batch, ok ? "" : "结果错误");
+  return ok ? 0 : 1;
+}
+
+static int bench_batch(void) {
+  static const uint64_t delays_us[] = {0, 20, 50, 100, 200, 500};
+  const tvmrt_model_desc_t *model = model_get_descriptor();
+
+  if (tvmrt_engine_init(NULL) != 0) {
+    printf("引擎初始化失败\n");
+    return 1;
+  }
+  printf("演示模型, %d 个客户端线程 × %d 个请求, %d 个 Worker, max_batch %d\n", BATCH_CLIENTS,
+         BATCH_REQUESTS, tvmrt_engine_num_workers(), BATCH_MAX);
+  printf("%-20s %10s %9s %9s %9s\n", "方式", "req/s", "p50(us)", "p99", "平均批");
+
+  int ret = batch_round("逐请求", NULL);
+  for (size_t i = 0; i < sizeof(delays_us) / sizeof(delays_us[0]); i++) {
+    tvmrt_batcher_t batcher;
+    tvmrt_batcher_config_t config = {.max_batch = BATCH_MAX,
+                                     .max_delay_ns = delays_us[i] * 1000,
+                                     .input_count = 1,
+                                     .output_count = 1,
+                                     .workspace_size = BATCH_WS_SIZE,
+                                     .const_workspace = (const uint8_t *)g_demo_const};
+    if (tvmrt_batcher_init(&batcher, model, &config) != 0) {
+      printf("批处理器初始化失败\n");
+      ret = 1;
+      break;
+    }
+    char name[32];
+    snprintf(name, sizeof(name), "批处理 %4llu us", (unsigned long long)delays_us[i]);
+    ret |= batch_round(name, &batcher);
+    tvmrt_batcher_destroy(&batcher);
+  }
+
+  tvmrt_engine_shutdown();
+  return ret;
+}
+
+// ============================================================
+// 场景: 延迟模式 vs 吞吐模式
+// ============================================================
+//
+// 合成模型: THRU_LAYERS 层 × THRU_WIDTH 条链的自旋算子 (每个加 1)，末尾
+// 一个算子汇总各链写出，输出 = THRU_WIDTH × (输入 + THRU_LAYERS)。
+// 不同并发客户端数下分别以两种引擎工作方式经上下文池执行。
+
+#define THRU_LAYERS 6
+#define THRU_WIDTH 4
+#define THRU_OPS (THRU_LAYERS * THRU_WIDTH + 1)
+#define THRU_SPIN 20000
+#define THRU_REQUESTS 200
+#define THRU_MAX_CLIENTS 16
+
+// deadline 场景: 统计执行过的链算子数，参数为 g_thru_fail_args 的算子返回错误
+static uint32_t g_thru_executed;
+static void *g_thru_fail_args;
+
+static int32_t thru_chain_op(void *p) {
+  tvmrt_op_args_t *a = (tvmrt_op_args_t *)p;
+  __atomic_add_fetch(&g_thru_executed, 1, __ATOMIC_RELAXED);
+  if (p == __atomic_load_n(&g_thru_fail_args, __ATOMIC_RELAXED)) return -7;
+  volatile uint32_t sink = 0;
+  for (uint32_t i = 0; i < THRU_SPIN; i++) sink += i;
+  *(float *)a->outputs[0] = *(const float *)a->inputs[0] + 1.0f;
+  return 0;
+}
+
+static int32_t thru_sum_op(void *p) {
+  tvmrt_op_args_t *a = (tvmrt_op_args_t *)p;
+  float sum = 0.0f;
+  for (int32_t k = 0; k < THRU_WIDTH; k++) sum += *(const float *)a->inputs[k];
+  *(float *)a->outputs[0] = sum;
+  return 0;
+}
+
+static const tvmrt_model_desc_t *thru_build_model(void) {
+  static tvmrt_op_desc_t descs[THRU_OPS];
+  static tvmrt_tensor_map_entry_t tmap[THRU_OPS - 1];
+  static int32_t ids[THRU_OPS];
+  static tvmrt_schedule_layer_t layers[THRU_LAYERS + 1];
+  static tvmrt_schedule_desc_t schedule;
+  static const tvmrt_op_func_t funcs[] = {thru_chain_op, thru_sum_op};
+  static tvmrt_model_desc_t model;
+
+  for (int32_t i = 0; i < THRU_OPS - 1; i++) {
+    int32_t l = i / THRU_WIDTH;
+    descs[i] = (tvmrt_op_desc_t){.op_id = i, .name = "chain", .input_count = 1, .output_count = 1};
+    descs[i].input_sids[0] = (l == 0) ? TVMRT_SID_INPUT(0) : i - THRU_WIDTH;
+    descs[i].output_sids[0] = i;
+    tmap[i] = (tvmrt_tensor_map_entry_t){.sid = i, .offset = i * 4, .size = 4, .align = 4};
+  }
+  tvmrt_op_desc_t *sum = &descs[THRU_OPS - 1];
+  *sum = (tvmrt_op_desc_t){.op_id = THRU_OPS - 1, .name = "sum", .func_entry_id = 1,
+                           .input_count = THRU_WIDTH, .output_count = 1};
+  for (int32_t k = 0; k < THRU_WIDTH; k++) {
+    sum->input_sids[k] = (THRU_LAYERS - 1) * THRU_WIDTH + k;
+  }
+  sum->output_sids[0] = TVMRT_SID_OUTPUT(0);
+  for (int32_t i = 0; i < THRU_OPS; i++) ids[i] = i;
+  for (int32_t l = 0; l <= THRU_LAYERS; l++) {
+    layers[l] = (tvmrt_schedule_layer_t){&ids[l * THRU_WIDTH], l < THRU_LAYERS ? THRU_WIDTH : 1};
+  }
+  schedule = (tvmrt_schedule_desc_t){layers, THRU_LAYERS + 1};
+  model = (tvmrt_model_desc_t){.tensor_map = tmap, .tensor_count = THRU_OPS - 1, .op_descs = descs,
+                               .op_count = THRU_OPS, .schedule = &schedule,
+                               .cpu_func_table = funcs, .cpu_func_count = 2};
+  return &model;
+}
+
+typedef struct {
+  int32_t id;
+  int32_t requests;
+  tvmrt_context_pool_t *pool;
+  float (*expect)(float);
+  uint64_t *samples;
+  int ok;
+} ThruClient;
+
+static float thru_expect(float in) { return THRU_WIDTH * (in + THRU_LAYERS); }
+static float thru_expect_demo(float in) { return in * 20.0f + 35.0f; }
+
+static void *thru_client_func(void *arg) {
+  ThruClient *c = (ThruClient *)arg;
+  float in = 0.0f, out = 0.0f;
+  void *inputs[1] = {&in};
+  void *outputs[1] = {&out};
+  c->ok = 1;
+  for (int32_t i = 0; i < c->requests; i++) {
+    in = (float)(c->id * c->requests + i);
+    out = 0.0f;
+    uint64_t t0 = tvmrt_time_ns();
+    int ret = tvmrt_context_pool_run(c->pool, inputs, outputs);
+    c->samples[i] = tvmrt_time_ns() - t0;
+    c->ok &= (ret == 0 && out == c->expect(in));
+  }
+  return NULL;
+}
+
+// clients 个线程并发经上下文池执行 requests 个请求; 返回吞吐 (req/s)，延迟统计写入 st
+static double thru_round(const tvmrt_model_desc_t *model, uint64_t ws_size, const uint8_t *cws,
+                         float (*expect)(float), int32_t clients, int32_t requests,
+                         LatencyStats *st, int *ok) {
+  static uint64_t samples[THRU_MAX_CLIENTS * THRU_REQUESTS];
+  tvmrt_thread_t threads[THRU_MAX_CLIENTS];
+  ThruClient cl[THRU_MAX_CLIENTS];
+  tvmrt_context_pool_t pool;
+  tvmrt_context_pool_config_t config = {.context_count = clients, .input_count = 1,
+                                        .output_count = 1, .workspace_size = ws_size,
+                                        .const_workspace = cws};
+  if (tvmrt_context_pool_init(&pool, model, &config) != 0) {
+    *ok = 0;
+    return 0.0;
+  }
+
+  uint64_t t0 = tvmrt_time_ns();
+  for (int32_t i = 0; i < clients; i++) {
+    cl[i] = (ThruClient){.id = i, .requests = requests, .pool = &pool, .expect = expect,
+                         .samples = &samples[i * requests]};
+    tvmrt_thread_create(&threads[i], thru_client_func, &cl[i]);
+  }
+  for (int32_t i = 0; i < clients; i++) {
+    tvmrt_thread_join(&threads[i]);
+    *ok &= cl[i].ok;
+  }
+  double secs = (double)(tvmrt_time_ns() - t0) / 1e9;
+  tvmrt_context_pool_destroy(&pool);
+
+  *st = bench_latency_stats(samples, clients * requests);
+  return clients * requests / secs;
+}
+
+static int bench_throughput(void) {
+  static const int32_t concurrency[] = {1, 2, 4, 8, 16};
+  static const tvmrt_engine_mode_t modes[] = {TVMRT_ENGINE_LATENCY, TVMRT_ENGINE_THROUGHPUT};
+  static const char *const mode_names[] = {"延迟", "吞吐"};
+  const tvmrt_model_desc_t *model = thru_build_model();
+  int ok = 1;
+
+  printf("合成模型: %d 层 × %d 链 + 汇总, 每算子自旋 %d 次; 每客户端 %d 个请求\n", THRU_LAYERS,
+         THRU_WIDTH, THRU_SPIN, THRU_REQUESTS);
+  printf("%-16s %10s %9s %9s\n", "模式/并发", "req/s", "p50(us)", "p99");
+  for (int m = 0; m < 2; m++) {
+    tvmrt_engine_config_t config = {.num_workers = TVMRT_NUM_WORKERS, .mode = modes[m]};
+    if (tvmrt_engine_init(&config) != 0) {
+      printf("引擎初始化失败\n");
+      return 1;
+    }
+    // 演示模型结果校验
+    LatencyStats st;
+    thru_round(model_get_descriptor(), 64, (const uint8_t *)g_demo_const, thru_expect_demo, 4, 50,
+               &st, &ok);
+
+    for (size_t c = 0; c < sizeof(concurrency) / sizeof(concurrency[0]); c++) {
+      double rps = thru_round(model, (THRU_OPS - 1) * 4, NULL, thru_expect, concurrency[c],
+                              THRU_REQUESTS, &st, &ok);
+      char name[32];
+      snprintf(name, sizeof(name), "%s / %d", mode_names[m], concurrency[c]);
+      printf("%-16s %10.0f %9.1f %9.1f\n", name, rps, st.p50, st.p99);
+    }
+    tvmrt_engine_shutdown();
+  }
+  printf("Worker 数: %d, 可用 CPU: %d\n", TVMRT_NUM_WORKERS, tvmrt_cpu_count());
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 多模型共享线程池与优先级
+// ============================================================
+//
+// 演示模型 (延迟敏感，间隔提交) 与 throughput 场景的合成模型 (批量，
+// MM_BULK_CLIENTS 个线程持续提交) 各建一个上下文池，共用同一线程池。
+// 比较演示模型单独运行、同优先级混跑、高优先级混跑时的请求延迟。
+
+#define MM_BULK_CLIENTS 8
+#define MM_CRIT_REQUESTS 300
+#define MM_CRIT_GAP_NS 500000ull
+
+typedef struct {
+  tvmrt_context_pool_t *pool;
+  int32_t id;
+  int *stop;
+  uint64_t completed;
+  int ok;
+} MmBulkClient;
+
+static void *mm_bulk_func(void *arg) {
+  MmBulkClient *c = (MmBulkClient *)arg;
+  float in = 0.0f, out = 0.0f;
+  void *inputs[1] = {&in};
+  void *outputs[1] = {&out};
+  c->ok = 1;
+  while (!__atomic_load_n(c->stop, __ATOMIC_RELAXED)) {
+    in = (float)(c->id * 1000 + (int32_t)(c->completed % 1000));
+    c->ok &= (tvmrt_context_pool_run(c->pool, inputs, outputs) == 0 && out == thru_expect(in));
+    c->completed++;
+  }
+  return NULL;
+}
+
+static void mm_sleep_ns(uint64_t ns) {
+  struct timespec ts = {(time_t)(ns / 1000000000ull), (long)(ns % 1000000000ull)};
+  nanosleep(&ts, NULL);
+}
+
+// 演示模型以 crit_priority 间隔提交，批量模型 bulk 个线程持续提交
+static void mm_round(const char *name, tvmrt_engine_mode_t mode, int32_t crit_priority,
+                     int32_t bulk, int *ok) {
+  static uint64_t samples[MM_CRIT_REQUESTS];
+  tvmrt_thread_t threads[MM_BULK_CLIENTS];
+  MmBulkClient clients[MM_BULK_CLIENTS];
+  tvmrt_context_pool_t crit_pool, bulk_pool;
+  int stop = 0;
+
+  tvmrt_engine_config_t engine = {.num_workers = TVMRT_NUM_WORKERS, .mode = mode};
+  tvmrt_context_pool_config_t crit_cfg = {.context_count = 1, .input_count = 1,
+                                          .output_count = 1, .workspace_size = 64,
+                                          .const_workspace = (const uint8_t *)g_demo_const,
+                                          .priority = crit_priority};
+  tvmrt_context_pool_config_t bulk_cfg = {.context_count = MM_BULK_CLIENTS, .input_count = 1,
+                                          .output_count = 1,
+                                          .workspace_size = (THRU_OPS - 1) * 4};
+  if (tvmrt_engine_init(&engine) != 0 ||
+      tvmrt_context_pool_init(&crit_pool, model_get_descriptor(), &crit_cfg) != 0 ||
+      tvmrt_context_pool_init(&bulk_pool, thru_build_model(), &bulk_cfg) != 0) {
+    printf("初始化失败\n");
+    *ok = 0;
+    return;
+  }
+
+  uint64_t t0 = tvmrt_time_ns();
+  for (int32_t i = 0; i < bulk; i++) {
+    clients[i] = (MmBulkClient){.pool = &bulk_pool, .id = i, .stop = &stop};
+    tvmrt_thread_create(&threads[i], mm_bulk_func, &clients[i]);
+  }
+
+  float in = 0.0f, out = 0.0f;
+  void *inputs[1] = {&in};
+  void *outputs[1] = {&out};
+  for (int32_t i = 0; i < MM_CRIT_REQUESTS; i++) {
+    mm_sleep_ns(MM_CRIT_GAP_NS);
+    in = (float)i;
+    uint64_t t1 = tvmrt_time_ns();
+    *ok &= (tvmrt_context_pool_run(&crit_pool, inputs, outputs) == 0 && out == in * 20.0f + 35.0f);
+    samples[i] = tvmrt_time_ns() - t1;
+  }
+
+  __atomic_store_n(&stop, 1, __ATOMIC_RELAXED);
+  uint64_t bulk_done = 0;
+  for (int32_t i = 0; i < bulk; i++) {
+    tvmrt_thread_join(&threads[i]);
+    bulk_done += clients[i].completed;
+    *ok &= clients[i].ok;
+  }
+  double secs = (double)(tvmrt_time_ns() - t0) / 1e9;
+
+  tvmrt_context_pool_destroy(&bulk_pool);
+  tvmrt_context_pool_destroy(&crit_pool);
+  tvmrt_engine_shutdown();
+
+  LatencyStats st = bench_latency_stats(samples, MM_CRIT_REQUESTS);
+  printf("%-24s %9.1f %9.1f %9.1f %10.0f\n", name, st.p50, st.p99, st.max, bulk_done / secs);
+}
+
+static int bench_multimodel(void) {
+  int ok = 1;
+  printf("演示模型 %d 个请求 (间隔 %llu us) + 合成模型 %d 个客户端持续提交, %d 个 Worker\n",
+         MM_CRIT_REQUESTS, MM_CRIT_GAP_NS / 1000, MM_BULK_CLIENTS, TVMRT_NUM_WORKERS);
+  printf("%-24s %9s %9s %9s %10s\n", "", "演示p50", "p99", "max(us)", "批量req/s");
+  mm_round("吞吐: 单独运行", TVMRT_ENGINE_THROUGHPUT, TVMRT_PRIORITY_LEVELS - 1, 0, &ok);
+  mm_round("吞吐: 混跑 同优先级", TVMRT_ENGINE_THROUGHPUT, 0, MM_BULK_CLIENTS, &ok);
+  mm_round("吞吐: 混跑 高优先级", TVMRT_ENGINE_THROUGHPUT, TVMRT_PRIORITY_LEVELS - 1,
+           MM_BULK_CLIENTS, &ok);
+  mm_round("延迟: 混跑 同优先级", TVMRT_ENGINE_LATENCY, 0, MM_BULK_CLIENTS, &ok);
+  mm_round("延迟: 混跑 高优先级", TVMRT_ENGINE_LATENCY, TVMRT_PRIORITY_LEVELS - 1,
+           MM_BULK_CLIENTS, &ok);
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 截止时刻、取消与失败后提前结束
+// ============================================================
+//
+// 使用 throughput 场景的合成模型:
+// 1. 第 2 层首个算子失败时，各多线程路径实际执行的算子数与耗时
+// 2. 截止时刻设为完整执行时间的 1/3、或由另一线程在 1/3 处取消
+// 3. 吞吐模式过载 (DL_CLIENTS 个客户端持续提交) 下有无截止时刻的对比
+
+#define DL_CLIENTS 16
+#define DL_REQUESTS 60
+#define DL_BUDGET_NS 8000000ull
+
+typedef struct {
+  tvmrt_cancel_token_t *token;
+  uint64_t delay_ns;
+} DlCanceller;
+
+static void *dl_cancel_func(void *arg) {
+  DlCanceller *c = (DlCanceller *)arg;
+  mm_sleep_ns(c->delay_ns);
+  tvmrt_cancel(c->token);
+  return NULL;
+}
+
+// 执行一次，打印返回值、执行的链算子数与耗时
+static uint64_t dl_run_once(const char *name, tvmrt_context_t *ctx,
+                            const tvmrt_schedule_desc_t *schedule, int32_t expect_ret, int *ok) {
+  __atomic_store_n(&g_thru_executed, 0, __ATOMIC_RELAXED);
+  uint64_t t0 = tvmrt_time_ns();
+  int ret = tvmrt_engine_run(ctx, schedule);
+  uint64_t dt = tvmrt_time_ns() - t0;
+  printf("%-28s %6d %8u/%d %10.1f\n", name, ret, g_thru_executed, THRU_OPS - 1, dt / 1e3);
+  *ok &= (ret == expect_ret);
+  return dt;
+}
+
+typedef struct {
+  tvmrt_context_pool_t *pool;
+  int32_t id;
+  uint64_t budget_ns;
+  uint64_t *samples;
+  int32_t completed;
+  int32_t shed;
+  int ok;
+} DlClient;
+
+static void *dl_client_func(void *arg) {
+  DlClient *c = (DlClient *)arg;
+  float in = 0.0f, out = 0.0f;
+  void *inputs[1] = {&in};
+  void *outputs[1] = {&out};
+  c->ok = 1;
+  for (int32_t i = 0; i < DL_REQUESTS; i++) {
+    in = (float)(c->id * DL_REQUESTS + i);
+    uint64_t t0 = tvmrt_time_ns();
+    int ret = tvmrt_context_pool_run_until(c->pool, inputs, outputs,
+                                           c->budget_ns ? t0 + c->budget_ns : 0, NULL);
+    if (ret == 0) {
+      c->ok &= (out == thru_expect(in));
+      c->samples[c->completed++] = tvmrt_time_ns() - t0;
+    } else {
+      c->ok &= (ret == TVMRT_ERR_TIMEOUT);
+      c->shed++;
+    }
+  }
+  return NULL;
+}
+
+static void dl_overload(const char *name, uint64_t budget_ns, int *ok) {
+  static uint64_t samples[DL_CLIENTS * DL_REQUESTS], merged[DL_CLIENTS * DL_REQUESTS];
+  tvmrt_thread_t threads[DL_CLIENTS];
+  DlClient clients[DL_CLIENTS];
+  tvmrt_context_pool_t pool;
+  tvmrt_context_pool_config_t config = {.context_count = DL_CLIENTS, .input_count = 1,
+                                        .output_count = 1,
+                                        .workspace_size = (THRU_OPS - 1) * 4};
+  if (tvmrt_context_pool_init(&pool, thru_build_model(), &config) != 0) {
+    *ok = 0;
+    return;
+  }
+  uint64_t t0 = tvmrt_time_ns();
+  for (int32_t i = 0; i < DL_CLIENTS; i++) {
+    clients[i] = (DlClient){.pool = &pool, .id = i, .budget_ns = budget_ns,
+                            .samples = &samples[i * DL_REQUESTS]};
+    tvmrt_thread_create(&threads[i], dl_client_func, &clients[i]);
+  }
+  int32_t done = 0, shed = 0, late = 0;
+  for (int32_t i = 0; i < DL_CLIENTS; i++) {
+    tvmrt_thread_join(&threads[i]);
+    for (int32_t k = 0; k < clients[i].completed; k++) {
+      merged[done++] = clients[i].samples[k];
+      late += clients[i].samples[k] > DL_BUDGET_NS;
+    }
+    shed += clients[i].shed;
+    *ok &= clients[i].ok;
+  }
+  double secs = (double)(tvmrt_time_ns() - t0) / 1e9;
+  tvmrt_context_pool_destroy(&pool);
+
+  LatencyStats st = done ? bench_latency_stats(merged, done) : (LatencyStats){0};
+  printf("%-20s %7d %7d %9d %9.1f %9.1f %10.0f\n", name, done, shed, late, st.p50 / 1e3,
+         st.p99 / 1e3, (done - late) / secs);
+}
+
+static int bench_deadline(void) {
+  static tvmrt_op_exec_t execs[THRU_OPS];
+  static tvmrt_op_args_t args[THRU_OPS];
+  static uint8_t ws[(THRU_OPS - 1) * 4];
+  static tvmrt_plan_t plan;
+  const tvmrt_model_desc_t *model = thru_build_model();
+  float in = 1.0f, out = 0.0f;
+  void *inputs[1] = {&in};
+  void *outputs[1] = {&out};
+  tvmrt_context_t ctx = {.workspace = ws, .op_execs = execs, .args_storage = args};
+  int ok = 1;
+
+  if (tvmrt_engine_init(NULL) != 0 ||
+      tvmrt_semantic_bind_args(model, args, inputs, 1, outputs, 1, ws, NULL) != 0 ||
+      tvmrt_semantic_init(&ctx, model) != 0 || tvmrt_plan_compile(&plan, &ctx, model->schedule) != 0 ||
+      tvmrt_plan_build_deps(&plan, model) != 0) {
+    printf("准备失败\n");
+    return 1;
+  }
+  plan.dataflow = false;
+  const tvmrt_schedule_desc_t *schedule = model->schedule;
+
+  printf("合成模型 %d 个链算子, %d 个 Worker\n", THRU_OPS - 1, tvmrt_engine_num_workers());
+  printf("%-28s %6s %10s %10s\n", "", "返回值", "执行算子", "耗时(us)");
+
+  // 1. 失败后提前结束: 共享队列 / 静态切片 / 依赖标志
+  static const char *const paths[] = {"共享队列", "静态切片", "依赖标志"};
+  uint64_t full = 0;
+  for (int m = 0; m < 3; m++) {
+    ctx.plan = (m == 0) ? NULL : &plan;
+    plan.dataflow = (m == 2);
+    char name[64];
+    snprintf(name, sizeof(name), "%s: 正常", paths[m]);
+    uint64_t dt = dl_run_once(name, &ctx, schedule, 0, &ok);
+    full = (m == 0) ? dt : full;
+    ok &= (out == thru_expect(in));
+    g_thru_fail_args = &args[THRU_WIDTH];
+    snprintf(name, sizeof(name), "%s: 第 2 层失败", paths[m]);
+    dl_run_once(name, &ctx, schedule, -7, &ok);
+    g_thru_fail_args = NULL;
+  }
+  plan.dataflow = false;
+  ctx.plan = &plan;
+
+  // 2. 截止时刻与取消
+  ctx.deadline_ns = tvmrt_time_ns() + full / 3;
+  dl_run_once("截止时刻 = 1/3 完整耗时", &ctx, schedule, TVMRT_ERR_TIMEOUT, &ok);
+  ctx.deadline_ns = 0;
+
+  tvmrt_cancel_token_t token = {0};
+  DlCanceller canceller = {&token, full / 3};
+  tvmrt_thread_t thread;
+  ctx.cancel = &token;
+  tvmrt_thread_create(&thread, dl_cancel_func, &canceller);
+  dl_run_once("1/3 处由另一线程取消", &ctx, schedule, TVMRT_ERR_CANCELLED, &ok);
+  tvmrt_thread_join(&thread);
+  ctx.cancel = NULL;
+  tvmrt_plan_destroy(&plan);
+  tvmrt_engine_shutdown();
+
+  // 3. 吞吐模式过载
+  tvmrt_engine_config_t config = {.num_workers = TVMRT_NUM_WORKERS,
+                                  .mode = TVMRT_ENGINE_THROUGHPUT};
+  tvmrt_engine_init(&config);
+  printf("\n吞吐模式过载: %d 个客户端 × %d 个请求, 预算 %llu ms\n", DL_CLIENTS, DL_REQUESTS,
+         DL_BUDGET_NS / 1000000);
+  printf("%-20s %7s %7s %9s %9s %9s %10s\n", "", "完成", "丢弃", "超预算", "p50(ms)", "p99",
+         "有效req/s");
+  dl_overload("无截止时刻", 0, &ok);
+  dl_overload("截止时刻 = 预算", DL_BUDGET_NS, &ok);
+  tvmrt_engine_shutdown();
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: int8 量化 vs fp32
+// ============================================================
+//
+// 同一个图分别以 fp32 与 int8 算子执行:
+//   x[M,K] -> MatMul(W1)+b1 -> ReLU -> MatMul(W2)+b2 -> Add(x) -> Sigmoid
+// int8 图在两端各加一个 Quantize / Dequantize。激活的量化参数由 fp32 图在
+// 校准输入上观测到的取值范围确定 (非对称)，权重按张量对称量化，偏置为
+// int32 (尺度 = 输入尺度 × 权重尺度)。比较输出误差、常量区大小与延迟。
+
+#define I8_M 16
+#define I8_K 256
+#define I8_H 256
+#define I8_CALIB 4
+#define I8_EVAL 8
+#define I8_RUNS 200
+#define I8_MAX_OPS 7
+#define I8_CONST_BYTES (4 * I8_K * I8_H * 2 + 64 * 1024)
+
+extern int32_t wrapped_matmul_f32(void *args);
+extern int32_t wrapped_add_f32(void *args);
+extern int32_t wrapped_relu_f32(void *args);
+extern int32_t wrapped_sigmoid_f32(void *args);
+extern int32_t wrapped_quantize_s8(void *args);
+extern int32_t wrapped_dequantize_s8(void *args);
+extern int32_t wrapped_qadd_s8(void *args);
+extern int32_t wrapped_qrelu_s8(void *args);
+extern int32_t wrapped_qlut_s8(void *args);
+extern int32_t wrapped_qmatmul_s8(void *args);
+
+typedef struct {
+  tvmrt_op_desc_t descs[I8_MAX_OPS];
+  tvmrt_tensor_map_entry_t tmap[I8_MAX_OPS];
+  int32_t ids[I8_MAX_OPS];
+  tvmrt_schedule_layer_t layers[I8_MAX_OPS];
+  tvmrt_schedule_desc_t schedule;
+  tvmrt_op_func_t funcs[I8_MAX_OPS];
+  tvmrt_model_desc_t model;
+  uint8_t *cws;
+  int32_t const_bytes;
+  int32_t ws_bytes;
+  tvmrt_op_exec_t execs[I8_MAX_OPS];
+  tvmrt_op_args_t args[I8_MAX_OPS];
+  uint8_t *ws;
+  tvmrt_context_t ctx;
+} I8Graph;
+
+static uint32_t g_i8_seed = 12345;
+
+static float i8_rand(void) {
+  g_i8_seed = g_i8_seed * 1664525u + 1013904223u;
+  return (float)(g_i8_seed >> 8) / (float)(1u << 24) * 2.0f - 1.0f;
+}
+
+static int i8_init(I8Graph *g) {
+  memset(g, 0, sizeof(*g));
+  g->cws = (uint8_t *)tvmrt_mem_alloc(I8_CONST_BYTES, 64);
+  g->model.tensor_map = g->tmap;
+  g->model.op_descs = g->descs;
+  g->model.schedule = &g->schedule;
+  g->model.cpu_func_table = g->funcs;
+  return g->cws ? 0 : -1;
+}
+
+// 追加一个张量 (顺序排布, 64 字节对齐)
+static int32_t i8_tensor(I8Graph *g, tvmrt_dtype_t dtype, int32_t elems) {
+  int32_t sid = g->model.tensor_count++;
+  int32_t bytes = elems * tvmrt_dtype_size(dtype);
+  g->tmap[sid] = (tvmrt_tensor_map_entry_t){.sid = sid, .offset = g->ws_bytes, .size = bytes,
+                                            .align = 64, .dtype = dtype};
+  g->ws_bytes += (bytes + 63) & ~63;
+  return sid;
+}
+
+// 追加一个单算子层: 常量区 = 属性块 + 偏置 + 权重 (各 64 字节对齐)，
+// 属性块作为最后一个输入 (TVMRT_SID_CONST)
+static tvmrt_qattrs_t *i8_op(I8Graph *g, tvmrt_op_func_t func, int32_t in0, int32_t in1,
+                             int32_t out, int32_t count, int32_t n, int32_t k, int32_t bias_bytes,
+                             int32_t weight_bytes) {
+  int32_t i = g->model.op_count++;
+  tvmrt_op_desc_t *d = &g->descs[i];
+  int32_t bias_off = bias_bytes ? 128 : 0;
+  int32_t weight_off = 128 + ((bias_bytes + 63) & ~63);
+  *d = (tvmrt_op_desc_t){.op_id = i, .name = "i8", .func_entry_id = i, .output_count = 1,
+                         .const_offset = g->const_bytes,
+                         .const_size = weight_off + weight_bytes};
+  d->input_sids[d->input_count++] = in0;
+  if (in1 != TVMRT_SID_NONE) d->input_sids[d->input_count++] = in1;
+  d->input_sids[d->input_count++] = TVMRT_SID_CONST;
+  d->output_sids[0] = out;
+  g->funcs[i] = func;
+  g->ids[i] = i;
+  g->layers[i] = (tvmrt_schedule_layer_t){&g->ids[i], 1};
+  tvmrt_qattrs_t *at = (tvmrt_qattrs_t *)(g->cws + g->const_bytes);
+  *at = (tvmrt_qattrs_t){.count = count, .n = n, .k = k, .weight_offset = weight_off,
+                         .bias_offset = bias_off, .act_min = -128, .act_max = 127};
+  g->const_bytes += (d->const_size + 63) & ~63;
+  return at;
+}
+
+// 组装模型描述并绑定参数 (输入输出缓冲区固定为 in/out)
+static int i8_finish(I8Graph *g, float *in, float *out) {
+  g->schedule = (tvmrt_schedule_desc_t){g->layers, g->model.op_count};
+  g->model.cpu_func_count = g->model.op_count;
+  g->ws = (uint8_t *)tvmrt_mem_alloc((uint64_t)g->ws_bytes, 64);
+  g->ctx = (tvmrt_context_t){.workspace = g->ws, .const_workspace = g->cws,
+                             .op_execs = g->execs, .args_storage = g->args};
+  void *ins[1] = {in}, *outs[1] = {out};
+  if (!g->ws ||
+      tvmrt_semantic_bind_args(&g->model, g->args, ins, 1, outs, 1, g->ws, g->cws) != 0 ||
+      tvmrt_semantic_init(&g->ctx, &g->model) != 0) {
+    return -1;
+  }
+  return 0;
+}
+
+// 由观测到的取值范围确定非对称量化参数 (范围包含 0)
+static tvmrt_quant_param_t i8_range_param(float lo, float hi) {
+  lo = fminf(lo, 0.0f);
+  hi = fmaxf(hi, 0.0f);
+  float scale = (hi - lo) / 255.0f;
+  scale = scale > 0.0f ? scale : 1.0f;
+  return (tvmrt_quant_param_t){scale, (int32_t)lrintf(-128.0f - lo / scale)};
+}
+
+static void i8_minmax(const float *v, int32_t n, float *lo, float *hi) {
+  for (int32_t i = 0; i < n; i++) {
+    *lo = fminf(*lo, v[i]);
+    *hi = fmaxf(*hi, v[i]);
+  }
+}
+
+// 写入 MatMul 的偏置与权重 (按 dt 存放)
+static void i8_put_weights(tvmrt_qattrs_t *at, tvmrt_dtype_t dt, const float *bias, int32_t n,
+                           const float *w, int32_t nw) {
+  at->weight_dtype = dt;
+  tvmrt_convert_from_f32(bias, (uint8_t *)at + at->bias_offset, dt, n);
+  tvmrt_convert_from_f32(w, (uint8_t *)at + at->weight_offset, dt, nw);
+}
+
+// fp32 计算图: 中间张量以 act_dt 存放 (经内存规划重新排布)，权重与偏置以
+// weight_dt 存放，各算子属性块的存储类型按映射表填充
+static int i8_build_f32(I8Graph *g, tvmrt_dtype_t act_dt, tvmrt_dtype_t weight_dt,
+                        const float *w1, const float *b1, const float *w2, const float *b2,
+                        float *x, float *y) {
+  int32_t wsz = tvmrt_dtype_size(weight_dt);
+  int32_t h1 = i8_tensor(g, TVMRT_DTYPE_FLOAT32, I8_M * I8_H);
+  int32_t r1 = i8_tensor(g, TVMRT_DTYPE_FLOAT32, I8_M * I8_H);
+  int32_t h2 = i8_tensor(g, TVMRT_DTYPE_FLOAT32, I8_M * I8_K);
+  int32_t sm = i8_tensor(g, TVMRT_DTYPE_FLOAT32, I8_M * I8_K);
+  tvmrt_qattrs_t *at = i8_op(g, wrapped_matmul_f32, TVMRT_SID_INPUT(0), TVMRT_SID_NONE, h1, I8_M,
+                             I8_H, I8_K, I8_H * wsz, I8_K * I8_H * wsz);
+  i8_put_weights(at, weight_dt, b1, I8_H, w1, I8_K * I8_H);
+  i8_op(g, wrapped_relu_f32, h1, TVMRT_SID_NONE, r1, I8_M * I8_H, 0, 0, 0, 0);
+  at = i8_op(g, wrapped_matmul_f32, r1, TVMRT_SID_NONE, h2, I8_M, I8_K, I8_H, I8_K * wsz,
+             I8_H * I8_K * wsz);
+  i8_put_weights(at, weight_dt, b2, I8_K, w2, I8_H * I8_K);
+  i8_op(g, wrapped_add_f32, h2, TVMRT_SID_INPUT(0), sm, I8_M * I8_K, 0, 0, 0, 0);
+  i8_op(g, wrapped_sigmoid_f32, sm, TVMRT_SID_NONE, TVMRT_SID_OUTPUT(0), I8_M * I8_K, 0, 0, 0, 0);
+
+  tvmrt_dtype_t dts[I8_MAX_OPS];
+  for (int32_t t = 0; t < g->model.tensor_count; t++) dts[t] = act_dt;
+  g->schedule = (tvmrt_schedule_desc_t){g->layers, g->model.op_count};
+  if (tvmrt_tensor_map_retype(g->tmap, g->model.tensor_count, dts, g->tmap) != 0 ||
+      tvmrt_memory_plan(&g->model, 0, g->tmap, &g->ws_bytes) != 0) {
+    return -1;
+  }
+  for (int32_t i = 0; i < g->model.op_count; i++) {
+    if (tvmrt_storage_prepare_op(&g->model, i, g->cws) != 0) return -1;
+  }
+  return i8_finish(g, x, y);
+}
+
+typedef struct {
+  I8Graph *g;
+  float lo[5], hi[5];  // [0] 为模型输入, [t + 1] 为 SID t
+} I8Calib;
+
+// 每层执行前观测上一层算子的输出 (中间张量经内存规划复用，只能在此时读取)
+static void i8_calib_hook(int32_t layer_idx, void *user) {
+  I8Calib *c = (I8Calib *)user;
+  if (layer_idx == 0 || layer_idx > c->g->model.tensor_count) return;
+  const tvmrt_tensor_map_entry_t *e = &c->g->tmap[layer_idx - 1];
+  i8_minmax((const float *)(c->g->ws + e->offset), e->size / 4, &c->lo[layer_idx],
+            &c->hi[layer_idx]);
+}
+
+static void i8_make_weights(float *w1, float *b1, float *w2, float *b2) {
+  for (int32_t i = 0; i < I8_K * I8_H; i++) {
+    w1[i] = i8_rand() / 16.0f;
+    w2[i] = i8_rand() / 16.0f;
+  }
+  for (int32_t i = 0; i < I8_H; i++) b1[i] = i8_rand() * 0.1f;
+  for (int32_t i = 0; i < I8_K; i++) b2[i] = i8_rand() * 0.1f;
+}
+
+static double i8_latency_us(I8Graph *g) {
+  static uint64_t samples[I8_RUNS];
+  for (int32_t r = 0; r < I8_RUNS; r++) {
+    uint64_t t0 = tvmrt_time_ns();
+    tvmrt_engine_run_single(&g->ctx, &g->schedule);
+    samples[r] = tvmrt_time_ns() - t0;
+  }
+  return bench_latency_stats(samples, I8_RUNS).p50;
+}
+
+static int bench_int8(void) {
+  static float w1[I8_K * I8_H], w2[I8_H * I8_K], b1[I8_H], b2[I8_K];
+  static float x[I8_M * I8_K], y_f32[I8_M * I8_K], y_i8[I8_M * I8_K];
+  static I8Graph gf, gq;
+  if (i8_init(&gf) != 0 || i8_init(&gq) != 0) {
+    printf("内存不足\n");
+    return 1;
+  }
+  i8_make_weights(w1, b1, w2, b2);
+  if (i8_build_f32(&gf, TVMRT_DTYPE_FLOAT32, TVMRT_DTYPE_FLOAT32, w1, b1, w2, b2, x, y_f32) != 0) {
+    printf("fp32 图准备失败\n");
+    return 1;
+  }
+
+  // 校准: 记录输入与各中间张量的取值范围
+  I8Calib calib = {.g = &gf};
+  gf.ctx.layer_hook = i8_calib_hook;
+  gf.ctx.layer_hook_user = &calib;
+  for (int32_t c = 0; c < I8_CALIB; c++) {
+    for (int32_t i = 0; i < I8_M * I8_K; i++) x[i] = i8_rand();
+    i8_minmax(x, I8_M * I8_K, &calib.lo[0], &calib.hi[0]);
+    tvmrt_engine_run_single(&gf.ctx, &gf.schedule);
+  }
+  gf.ctx.layer_hook = NULL;
+  const float *lo = calib.lo, *hi = calib.hi;
+
+  // int8 图: 张量量化参数写入映射表，权重对称量化
+  int32_t q_x = i8_tensor(&gq, TVMRT_DTYPE_INT8, I8_M * I8_K);
+  int32_t q_h1 = i8_tensor(&gq, TVMRT_DTYPE_INT8, I8_M * I8_H);
+  int32_t q_r1 = i8_tensor(&gq, TVMRT_DTYPE_INT8, I8_M * I8_H);
+  int32_t q_h2 = i8_tensor(&gq, TVMRT_DTYPE_INT8, I8_M * I8_K);
+  int32_t q_s = i8_tensor(&gq, TVMRT_DTYPE_INT8, I8_M * I8_K);
+  int32_t q_y = i8_tensor(&gq, TVMRT_DTYPE_INT8, I8_M * I8_K);
+  for (int32_t t = 0; t < 5; t++) gq.tmap[t].quant = i8_range_param(lo[t], hi[t]);
+  gq.tmap[q_y].quant = (tvmrt_quant_param_t){1.0f / 256.0f, -128};  // sigmoid 输出 [0, 1)
+
+  static const tvmrt_qop_kind_t kinds[] = {TVMRT_QOP_QUANTIZE, TVMRT_QOP_MATMUL,
+                                           TVMRT_QOP_RELU,     TVMRT_QOP_MATMUL,
+                                           TVMRT_QOP_ADD,      TVMRT_QOP_SIGMOID,
+                                           TVMRT_QOP_DEQUANTIZE};
+  const float *ws_f[2] = {w1, w2}, *bs_f[2] = {b1, b2};
+  const int32_t mm_in[2] = {q_x, q_r1}, mm_n[2] = {I8_H, I8_K};
+  int32_t mm_op[2];
+  i8_op(&gq, wrapped_quantize_s8, TVMRT_SID_INPUT(0), TVMRT_SID_NONE, q_x, I8_M * I8_K, 0, 0, 0,
+        0);
+  mm_op[0] = gq.model.op_count;
+  i8_op(&gq, wrapped_qmatmul_s8, q_x, TVMRT_SID_NONE, q_h1, I8_M, I8_H, I8_K, I8_H * 4,
+        I8_K * I8_H);
+  i8_op(&gq, wrapped_qrelu_s8, q_h1, TVMRT_SID_NONE, q_r1, I8_M * I8_H, 0, 0, 0, 0);
+  mm_op[1] = gq.model.op_count;
+  i8_op(&gq, wrapped_qmatmul_s8, q_r1, TVMRT_SID_NONE, q_h2, I8_M, I8_K, I8_H, I8_K * 4,
+        I8_H * I8_K);
+  i8_op(&gq, wrapped_qadd_s8, q_h2, q_x, q_s, I8_M * I8_K, 0, 0, 0, 0);
+  i8_op(&gq, wrapped_qlut_s8, q_s, TVMRT_SID_NONE, q_y, I8_M * I8_K, 0, 0, 0, 256);
+  i8_op(&gq, wrapped_dequantize_s8, q_y, TVMRT_SID_NONE, TVMRT_SID_OUTPUT(0), I8_M * I8_K, 0, 0,
+        0, 0);
+  for (int32_t m = 0; m < 2; m++) {
+    tvmrt_op_desc_t *d = &gq.descs[mm_op[m]];
+    tvmrt_qattrs_t *qa = (tvmrt_qattrs_t *)(gq.cws + d->const_offset);
+    int32_t nw = I8_K * I8_H;
+    float amax = 0.0f;
+    for (int32_t i = 0; i < nw; i++) amax = fmaxf(amax, fabsf(ws_f[m][i]));
+    d->weight_quant = (tvmrt_quant_param_t){amax / 127.0f, 0};
+    int8_t *wq = (int8_t *)qa + qa->weight_offset;
+    for (int32_t i = 0; i < nw; i++) wq[i] = (int8_t)lrintf(ws_f[m][i] / d->weight_quant.scale);
+    float bias_scale = gq.tmap[mm_in[m]].quant.scale * d->weight_quant.scale;
+    int32_t *bq = (int32_t *)((uint8_t *)qa + qa->bias_offset);
+    for (int32_t j = 0; j < mm_n[m]; j++) bq[j] = (int32_t)lrintf(bs_f[m][j] / bias_scale);
+  }
+  for (int32_t i = 0; i < gq.model.op_count; i++) {
+    if (tvmrt_quant_prepare_op(&gq.model, i, kinds[i], gq.cws) != 0) {
+      printf("int8 算子 %d 准备失败\n", i);
+      return 1;
+    }
+  }
+  if (i8_finish(&gq, x, y_i8) != 0) {
+    printf("int8 图准备失败\n");
+    return 1;
+  }
+
+  // 精度: 校准之外的输入上与 fp32 输出比较
+  double max_err = 0.0, sum_err = 0.0;
+  for (int32_t e = 0; e < I8_EVAL; e++) {
+    for (int32_t i = 0; i < I8_M * I8_K; i++) x[i] = i8_rand();
+    tvmrt_engine_run_single(&gf.ctx, &gf.schedule);
+    tvmrt_engine_run_single(&gq.ctx, &gq.schedule);
+    for (int32_t i = 0; i < I8_M * I8_K; i++) {
+      double err = fabs((double)y_i8[i] - y_f32[i]);
+      max_err = err > max_err ? err : max_err;
+      sum_err += err;
+    }
+  }
+
+  double us_f = i8_latency_us(&gf), us_q = i8_latency_us(&gq);
+  double macs = 2.0 * I8_M * I8_K * I8_H;
+  printf("图: [%d,%d] -> MatMul %d -> ReLU -> MatMul %d -> Add -> Sigmoid\n", I8_M, I8_K, I8_H,
+         I8_K);
+  printf("%-8s %12s %10s %10s\n", "", "常量区(KB)", "p50(us)", "GMAC/s");
+  printf("%-8s %12.1f %10.1f %10.2f\n", "fp32", gf.const_bytes / 1024.0, us_f, macs / us_f / 1e3);
+  printf("%-8s %12.1f %10.1f %10.2f\n", "int8", gq.const_bytes / 1024.0, us_q, macs / us_q / 1e3);
+  printf("int8 / fp32 加速比: %.2fx\n", us_f / us_q);
+  printf("输出误差 (%d 组校准外输入): 最大 %.5f, 平均 %.5f (输出量化步长 %.5f)\n", I8_EVAL,
+         max_err, sum_err / (I8_EVAL * I8_M * I8_K), 1.0 / 256.0);
+
+  tvmrt_mem_free(gf.ws);
+  tvmrt_mem_free(gq.ws);
+  tvmrt_mem_free(gf.cws);
+  tvmrt_mem_free(gq.cws);
+  if (max_err > 0.05) {
+    printf("误差超出预期\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: fp16/bf16 存储
+// ============================================================
+//
+// int8 场景中的 fp32 图，中间张量与权重 (含偏置) 改以 fp16 / bf16 存放，
+// 计算仍为 fp32。workspace 经 tvmrt_tensor_map_retype 换算字节数后由内存
+// 规划重新排布。比较 workspace/常量区大小、延迟与相对 fp32 存储的误差。
+
+static int bench_half(void) {
+  static const tvmrt_dtype_t dts[] = {TVMRT_DTYPE_FLOAT32, TVMRT_DTYPE_FLOAT16,
+                                      TVMRT_DTYPE_BFLOAT16};
+  static const char *const names[] = {"fp32", "fp16", "bf16"};
+  static float w1[I8_K * I8_H], w2[I8_H * I8_K], b1[I8_H], b2[I8_K];
+  static float x[I8_M * I8_K], y[3][I8_M * I8_K];
+  static I8Graph g[3];
+  double max_err[3] = {0}, sum_err[3] = {0};
+  int ok = 1;
+
+  i8_make_weights(w1, b1, w2, b2);
+  for (int d = 0; d < 3; d++) {
+    if (i8_init(&g[d]) != 0 ||
+        i8_build_f32(&g[d], dts[d], dts[d], w1, b1, w2, b2, x, y[d]) != 0) {
+      printf("%s 图准备失败\n", names[d]);
+      return 1;
+    }
+  }
+  for (int32_t e = 0; e < I8_EVAL; e++) {
+    for (int32_t i = 0; i < I8_M * I8_K; i++) x[i] = i8_rand();
+    for (int d = 0; d < 3; d++) ok &= tvmrt_engine_run_single(&g[d].ctx, &g[d].schedule) == 0;
+    for (int d = 1; d < 3; d++) {
+      for (int32_t i = 0; i < I8_M * I8_K; i++) {
+        double err = fabs((double)y[d][i] - y[0][i]);
+        max_err[d] = err > max_err[d] ? err : max_err[d];
+        sum_err[d] += err;
+      }
+    }
+  }
+
+  printf("图: [%d,%d] -> MatMul %d -> ReLU -> MatMul %d -> Add -> Sigmoid (fp32 计算)\n", I8_M,
+         I8_K, I8_H, I8_K);
+  printf("F16C: %s, AVX-512-BF16: %s\n", __builtin_cpu_supports("f16c") ? "有" : "无",
+         __builtin_cpu_supports("avx512bf16") ? "有" : "无 (标量舍入)");
+  printf("%-6s %14s %12s %10s %10s %10s\n", "存储", "workspace(KB)", "常量区(KB)", "p50(us)",
+         "最大误差", "平均误差");
+  for (int d = 0; d < 3; d++) {
+    double us = i8_latency_us(&g[d]);
+    printf("%-6s %14.1f %12.1f %10.1f %10.5f %10.6f\n", names[d], g[d].ws_bytes / 1024.0,
+           g[d].const_bytes / 1024.0, us, max_err[d], sum_err[d] / (I8_EVAL * I8_M * I8_K));
+    tvmrt_mem_free(g[d].ws);
+    tvmrt_mem_free(g[d].cws);
+  }
+
+  if (!ok || max_err[1] > 0.01 || max_err[2] > 0.05) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 逐元素算子链的分块执行
+// ============================================================
+//
+// 远超缓存的 fp32 逐元素链:
+//   x -> ReLU(a) -> Add(a, x) -> ReLU -> Add(., a) -> ReLU -> y
+// 逐层执行时每个中间张量都要完整写回内存再读入；分块执行把整条链按块
+// 依次跑完，块内中间结果留在缓存中。比较逐层与从 L1/4 到 L2/2 的各档
+// 块预算及默认预算的耗时与有效带宽 (每元素按各算子读写的字节数计)，并校验
+// 结果逐位一致。
+
+#define TILE_ELEMS (8 * 1024 * 1024)
+#define TILE_RUNS 5
+
+static double tile_run_ms(tvmrt_context_t *ctx, const tvmrt_schedule_desc_t *schedule,
+                          bool engine, int *ok) {
+  uint64_t best = UINT64_MAX;
+  for (int32_t r = 0; r < TILE_RUNS; r++) {
+    uint64_t t0 = tvmrt_time_ns();
+    *ok &= (engine ? tvmrt_engine_run(ctx, schedule) : tvmrt_engine_run_single(ctx, schedule)) == 0;
+    uint64_t dt = tvmrt_time_ns() - t0;
+    best = dt < best ? dt : best;
+  }
+  return best / 1e6;
+}
+
+static int bench_tiled(void) {
+  static I8Graph g;
+  float *x = (float *)tvmrt_mem_alloc((uint64_t)TILE_ELEMS * 4, 64);
+  float *y = (float *)tvmrt_mem_alloc((uint64_t)TILE_ELEMS * 4, 64);
+  float *ref = (float *)tvmrt_mem_alloc((uint64_t)TILE_ELEMS * 4, 64);
+  if (!x || !y || !ref || i8_init(&g) != 0) {
+    printf("内存不足\n");
+    return 1;
+  }
+  int32_t t[4];
+  for (int32_t i = 0; i < 4; i++) t[i] = i8_tensor(&g, TVMRT_DTYPE_FLOAT32, TILE_ELEMS);
+  i8_op(&g, wrapped_relu_f32, TVMRT_SID_INPUT(0), TVMRT_SID_NONE, t[0], TILE_ELEMS, 0, 0, 0, 0);
+  i8_op(&g, wrapped_add_f32, t[0], TVMRT_SID_INPUT(0), t[1], TILE_ELEMS, 0, 0, 0, 0);
+  i8_op(&g, wrapped_relu_f32, t[1], TVMRT_SID_NONE, t[2], TILE_ELEMS, 0, 0, 0, 0);
+  i8_op(&g, wrapped_add_f32, t[2], t[0], t[3], TILE_ELEMS, 0, 0, 0, 0);
+  i8_op(&g, wrapped_relu_f32, t[3], TVMRT_SID_NONE, TVMRT_SID_OUTPUT(0), TILE_ELEMS, 0, 0, 0, 0);
+  for (int32_t i = 0; i < g.model.op_count; i++) g.descs[i].flags = TVMRT_OP_ELEMENTWISE;
+  for (int32_t i = 0; i < TILE_ELEMS; i++) x[i] = i8_rand() * 4.0f;
+  if (i8_finish(&g, x, y) != 0 || tvmrt_engine_init(NULL) != 0) {
+    printf("准备失败\n");
+    return 1;
+  }
+
+  // 每元素读写字节数: 3 个 ReLU 各读 4 写 4, 2 个 Add 各读 8 写 4
+  double bytes = (double)TILE_ELEMS * (3 * 8 + 2 * 12);
+  int ok = 1;
+  tvmrt_op_exec_t *execs = g.ctx.op_execs;
+  int32_t op_count = g.ctx.op_count;
+  double base = tile_run_ms(&g.ctx, &g.schedule, false, &ok);
+  memcpy(ref, y, (size_t)TILE_ELEMS * 4);
+
+  printf("%d 元素 × 5 个逐元素算子, 张量 %d MB, L1D %lld KB, L2 %lld KB, %d 个 Worker\n",
+         TILE_ELEMS, TILE_ELEMS * 4 / (1024 * 1024), (long long)tvmrt_cache_size(1) / 1024,
+         (long long)tvmrt_cache_size(2) / 1024, tvmrt_engine_num_workers());
+  printf("%-22s %10s %8s %10s %10s %8s\n", "", "块大小", "块数", "耗时(ms)", "GB/s", "加速比");
+  printf("%-22s %10s %8s %10.2f %10.2f %8s\n", "逐层 (单线程)", "-", "-", base, bytes / base / 1e6,
+         "1.00");
+
+  // 预算 = 该级缓存容量 × scale / 8 (level 0 = 默认预算)
+  static const struct {
+    const char *name;
+    int32_t level;
+    int32_t scale;
+    bool engine;
+  } cases[] = {
+      {"L1/4 分块 (单线程)", 1, 2, false},
+      {"L1/2 分块 (单线程)", 1, 4, false},
+      {"L1 分块 (单线程)", 1, 8, false},
+      {"2*L1 分块 (单线程)", 1, 16, false},
+      {"L2/8 分块 (单线程)", 2, 1, false},
+      {"L2/2 分块 (单线程)", 2, 4, false},
+      {"默认分块 (线程池)", 0, 0, true},
+  };
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    tvmrt_tiled_t tiled;
+    int64_t cache = cases[c].level ? tvmrt_cache_size(cases[c].level) : 0;
+    if (tvmrt_tiled_init(&tiled, &g.model, &g.ctx, &g.schedule, cache * cases[c].scale / 8) != 0 ||
+        tiled.segment_count != 1) {
+      printf("分块失败\n");
+      return 1;
+    }
+    g.ctx.op_execs = tiled.execs;
+    g.ctx.op_count = tiled.exec_count;
+    memset(y, 0, (size_t)TILE_ELEMS * 4);
+    double ms = tile_run_ms(&g.ctx, &tiled.schedule, cases[c].engine, &ok);
+    ok &= memcmp(y, ref, (size_t)TILE_ELEMS * 4) == 0;
+    printf("%-22s %10d %8d %10.2f %10.2f %8.2f\n", cases[c].name, tiled.segments[0].tile_elems,
+           tiled.segments[0].tile_count, ms, bytes / ms / 1e6, base / ms);
+    g.ctx.op_execs = execs;
+    g.ctx.op_count = op_count;
+    tvmrt_tiled_destroy(&tiled);
+  }
+  tvmrt_engine_shutdown();
+  tvmrt_mem_free(g.ws);
+  tvmrt_mem_free(g.cws);
+  tvmrt_mem_free(x);
+  tvmrt_mem_free(y);
+  tvmrt_mem_free(ref);
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 内核自动调优
+// ============================================================
+//
+// int8 场景中的 fp32 图 (两个同形状 MatMul)，对 MatMul 的分块/指令集候选
+// 逐一计时并写入调优缓存 (离线预调优: make tune [TUNE_CACHE=文件])。第二次
+// 调用模拟下次启动: 命中缓存，不再计时。比较调优前后的延迟并校验结果。
+
+extern const tvmrt_tune_kernel_t *tvmgen_default_tune_kernels(int32_t *count);
+
+static const char *tune_variant_name(const tvmrt_tune_kernel_t *kernels, int32_t count,
+                                     tvmrt_op_func_t func) {
+  for (int32_t k = 0; k < count; k++) {
+    for (int32_t v = 0; v < kernels[k].variant_count; v++) {
+      if (kernels[k].variants[v].func == func) return kernels[k].variants[v].name;
+    }
+  }
+  return "-";
+}
+
+static int bench_tune(void) {
+  static float w1[I8_K * I8_H], w2[I8_H * I8_K], b1[I8_H], b2[I8_K];
+  static float x[I8_M * I8_K], y[I8_M * I8_K], ref[I8_M * I8_K];
+  static I8Graph g;
+  const char *path = g_bench_arg ? g_bench_arg : "tvmrt_tune.cache";
+  int ok = 1;
+
+  i8_make_weights(w1, b1, w2, b2);
+  for (int32_t i = 0; i < I8_M * I8_K; i++) x[i] = i8_rand();
+  if (i8_init(&g) != 0 ||
+      i8_build_f32(&g, TVMRT_DTYPE_FLOAT32, TVMRT_DTYPE_FLOAT32, w1, b1, w2, b2, x, y) != 0) {
+    printf("准备失败\n");
+    return 1;
+  }
+  ok &= tvmrt_engine_run_single(&g.ctx, &g.schedule) == 0;
+  memcpy(ref, y, sizeof(y));
+  double before = i8_latency_us(&g);
+
+  int32_t kernel_count = 0;
+  const tvmrt_tune_kernel_t *kernels = tvmgen_default_tune_kernels(&kernel_count);
+  char cpu[128];
+  tvmrt_cpu_model(cpu, (int32_t)sizeof(cpu));
+  printf("CPU: %s\n调优缓存: %s\n", cpu, path);
+  printf("候选:");
+  for (int32_t k = 0; k < kernel_count; k++) {
+    for (int32_t v = 0; v < kernels[k].variant_count; v++) {
+      printf(" %s/%s", kernels[k].kernel, kernels[k].variants[v].name);
+    }
+  }
+  printf("\n%-10s %8s %8s %8s %12s\n", "", "计时", "命中", "无候选", "调优耗时(ms)");
+
+  // 1. 离线预调优 (忽略已有缓存)，2. 下次启动命中缓存
+  static const char *const names[] = {"预调优", "命中缓存"};
+  for (int pass = 0; pass < 2; pass++) {
+    tvmrt_tune_config_t config = {.kernels = kernels, .kernel_count = kernel_count,
+                                  .cache_path = path, .force = (pass == 0)};
+    tvmrt_tune_stats_t st;
+    uint64_t t0 = tvmrt_time_ns();
+    if (tvmrt_tune(&g.ctx, &g.model, &config, &st) != 0) {
+      printf("调优失败\n");
+      return 1;
+    }
+    printf("%-10s %8d %8d %8d %12.2f\n", names[pass], st.tuned, st.cached, st.skipped,
+           (tvmrt_time_ns() - t0) / 1e6);
+    ok &= (pass == 0) ? st.tuned == 2 : st.cached == 2;
+  }
+
+  for (int32_t i = 0; i < g.model.op_count; i++) {
+    const char *name = tune_variant_name(kernels, kernel_count, g.ctx.op_execs[i].func);
+    if (strcmp(name, "-") != 0) printf("算子 %d (MatMul): %s\n", i, name);
+  }
+  double after = i8_latency_us(&g);
+  ok &= tvmrt_engine_run_single(&g.ctx, &g.schedule) == 0;
+  for (int32_t i = 0; i < I8_M * I8_K; i++) ok &= fabsf(y[i] - ref[i]) <= 1e-5f;
+  printf("p50 延迟: 默认 %.1f us, 调优后 %.1f us (%.2fx)\n", before, after, before / after);
+  tvmrt_mem_free(g.ws);
+  tvmrt_mem_free(g.cws);
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 广播二元运算
+// ============================================================
+//
+// 常见广播模式下，广播/步长迭代引擎 (维度合并 + 最内维特化循环) 与逐元素
+// 由输出下标计算输入偏移的朴素循环对比; 引擎分别以默认构建与本机最宽
+// 指令集构建执行，结果须与朴素循环逐位一致。
+
+#define BC_ELEMS (256 * 1024)
+#define BC_RUNS 20
+
+extern int32_t tvmgen_default_binary_f32(float *p0, float *p1, float *output, uint8_t *cws,
+                                         uint8_t *ws);
+
+typedef struct {
+  const char *name;
+  tvmrt_binary_kind_t kind;
+  int32_t rank;
+  int32_t shape[4], a_shape[4], b_shape[4];
+  bool transpose;  // a 为 [shape[1], shape[0]] 连续张量的转置视图
+} BcCase;
+
+// 朴素实现: 每个元素由输出下标逐维计算两个输入的偏移
+static void bc_naive(const BcCase *c, const int32_t *a_strides, const float *a, const float *b,
+                     float *out) {
+  int32_t total = 1;
+  for (int32_t d = 0; d < c->rank; d++) total *= c->shape[d];
+  for (int32_t i = 0; i < total; i++) {
+    int32_t rem = i, ia = 0, ib = 0, sb = 1;
+    for (int32_t d = c->rank - 1; d >= 0; d--) {
+      int32_t idx = rem % c->shape[d];
+      rem /= c->shape[d];
+      ia += (c->a_shape[d] == 1 ? 0 : idx) * a_strides[d];
+      ib += (c->b_shape[d] == 1 ? 0 : idx) * sb;
+      sb *= c->b_shape[d];
+    }
+    float x = a[ia], y = b[ib];
+    switch (c->kind) {
+    case TVMRT_BINARY_ADD: out[i] = x + y; break;
+    case TVMRT_BINARY_SUB: out[i] = x - y; break;
+    case TVMRT_BINARY_MUL: out[i] = x * y; break;
+    case TVMRT_BINARY_DIV: out[i] = x / y; break;
+    case TVMRT_BINARY_MAX: out[i] = x > y ? x : y; break;
+    default: out[i] = x < y ? x : y; break;
+    }
+  }
+}
+
+static double bc_time_us(tvmrt_op_func_t func, void *args, const BcCase *c,
+                         const int32_t *a_strides, const float *a, const float *b, float *out) {
+  uint64_t best = UINT64_MAX;
+  for (int32_t r = 0; r < BC_RUNS; r++) {
+    uint64_t t0 = tvmrt_time_ns();
+    if (func) {
+      func(args);
+    } else {
+      bc_naive(c, a_strides, a, b, out);
+    }
+    uint64_t dt = tvmrt_time_ns() - t0;
+    best = dt < best ? dt : best;
+  }
+  return best / 1e3;
+}
+
+static int bench_broadcast(void) {
+  static const BcCase cases[] = {
+      {"[512,512] + [512,512]", TVMRT_BINARY_ADD, 2, {512, 512}, {512, 512}, {512, 512}, false},
+      {"[512,512] * 标量", TVMRT_BINARY_MUL, 2, {512, 512}, {512, 512}, {1, 1}, false},
+      {"[512,512] + [512] (行)", TVMRT_BINARY_ADD, 2, {512, 512}, {512, 512}, {1, 512}, false},
+      {"[512,512] - [512,1] (列)", TVMRT_BINARY_SUB, 2, {512, 512}, {512, 512}, {512, 1}, false},
+      {"[8,64,512] max [8,1,512]", TVMRT_BINARY_MAX, 3, {8, 64, 512}, {8, 64, 512}, {8, 1, 512}, false},
+      {"[4096,64] + [64] (短行)", TVMRT_BINARY_ADD, 2, {4096, 64}, {4096, 64}, {1, 64}, false},
+      {"转置[512,512] + [512]", TVMRT_BINARY_ADD, 2, {512, 512}, {512, 512}, {1, 512}, true},
+  };
+  float *a = (float *)tvmrt_mem_alloc(BC_ELEMS * 4, 64);
+  float *b = (float *)tvmrt_mem_alloc(BC_ELEMS * 4, 64);
+  float *ref = (float *)tvmrt_mem_alloc(BC_ELEMS * 4, 64);
+  float *out = (float *)tvmrt_mem_alloc(BC_ELEMS * 4, 64);
+  if (!a || !b || !ref || !out) {
+    printf("内存不足\n");
+    return 1;
+  }
+  for (int32_t i = 0; i < BC_ELEMS; i++) {
+    a[i] = i8_rand() * 8.0f;
+    b[i] = i8_rand() * 8.0f + 16.0f;
+  }
+
+  // 本机最宽的指令集版本
+  int32_t kernel_count = 0;
+  const tvmrt_tune_kernel_t *kernels = tvmgen_default_tune_kernels(&kernel_count);
+  const tvmrt_tune_kernel_t *bin = NULL;
+  for (int32_t k = 0; k < kernel_count; k++) {
+    if (strcmp(kernels[k].kernel, "binary_f32") == 0) bin = &kernels[k];
+  }
+  const tvmrt_tune_variant_t *isa = bin ? &bin->variants[bin->variant_count - 1] : NULL;
+
+  int ok = isa != NULL;
+  printf("%d 元素, 取 %d 次最小值, 指令集版本: %s\n", BC_ELEMS, BC_RUNS, isa ? isa->name : "-");
+  printf("%-26s %6s %10s %10s %10s %8s %8s\n", "", "合并后", "朴素(us)", "默认(us)", "指令集",
+         "默认加速", "指令集加速");
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]) && ok; c++) {
+    const BcCase *bc = &cases[c];
+    int32_t a_strides[4], s = 1;
+    for (int32_t d = bc->rank - 1; d >= 0; d--) {
+      a_strides[d] = s;
+      s *= bc->a_shape[d];
+    }
+    if (bc->transpose) {
+      a_strides[0] = 1;
+      a_strides[1] = bc->a_shape[0];
+    }
+    tvmrt_view_t va = {.rank = bc->rank, .strides = a_strides};
+    tvmrt_view_t vb = {.rank = bc->rank};
+    memcpy(va.shape, bc->a_shape, sizeof(bc->a_shape));
+    memcpy(vb.shape, bc->b_shape, sizeof(bc->b_shape));
+    tvmrt_bcast_attrs_t at;
+    if (tvmrt_broadcast_prepare(&at, bc->kind, &va, &vb, NULL) != 0) {
+      printf("%s: 准备失败\n", bc->name);
+      return 1;
+    }
+    tvmrt_op_args_t args = {.inputs = {a, b, &at}, .outputs = {out}};
+    int32_t total = s;
+
+    double naive = bc_time_us(NULL, NULL, bc, a_strides, a, b, ref);
+    double def = bc_time_us(bin->base, &args, bc, a_strides, a, b, out);
+    ok &= memcmp(out, ref, (size_t)total * 4) == 0;
+    memset(out, 0, (size_t)total * 4);
+    double wide = bc_time_us(isa->func, &args, bc, a_strides, a, b, out);
+    ok &= memcmp(out, ref, (size_t)total * 4) == 0;
+    printf("%-26s %6d %10.1f %10.1f %10.1f %8.1fx %8.1fx\n", bc->name, at.rank, naive, def, wide,
+           naive / def, naive / wide);
+  }
+  tvmrt_mem_free(a);
+  tvmrt_mem_free(b);
+  tvmrt_mem_free(ref);
+  tvmrt_mem_free(out);
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 并行归约
+// ============================================================
+//
+// 大规模归约拆成最多 RED_PARTS 个部分算子 (同一层，可并行) 与一个合并
+// 算子，在不同 Worker 数下经引擎执行; 与单算子及朴素顺序循环比较耗时，
+// 校验拆分执行与单算子逐位一致 (与 Worker 数无关)，求和以 double 参考值
+// 比较误差。
+
+#define RED_ELEMS (16 * 1024 * 1024)
+#define RED_PARTS 8
+#define RED_RUNS 5
+#define RED_ATTR_STRIDE (((int32_t)sizeof(tvmrt_reduce_attrs_t) + 63) & ~63)
+
+extern int32_t wrapped_reduce_f32(void *args);
+extern int32_t wrapped_reduce_combine_f32(void *args);
+extern int32_t tvmgen_default_reduce_f32(float *p0, void *output, uint8_t *cws, uint8_t *ws);
+
+typedef struct {
+  tvmrt_op_desc_t descs[RED_PARTS + 1];
+  tvmrt_tensor_map_entry_t tmap[1];
+  int32_t ids[RED_PARTS + 1];
+  tvmrt_schedule_layer_t layers[2];
+  tvmrt_schedule_desc_t schedule;
+  tvmrt_model_desc_t model;
+  tvmrt_op_exec_t execs[RED_PARTS + 1];
+  tvmrt_op_args_t args[RED_PARTS + 1];
+  uint8_t *cws;
+  uint8_t *ws;
+  tvmrt_context_t ctx;
+} RedGraph;
+
+// 第 0 层为各部分算子，第 1 层为合并算子; 常量区依次存放各算子的属性块
+static int red_build(RedGraph *g, const tvmrt_reduce_attrs_t *at, float *x, void *out) {
+  static const tvmrt_op_func_t funcs[] = {wrapped_reduce_f32, wrapped_reduce_combine_f32};
+  int32_t parts = at->parts, n = at->parts + 1;
+  int32_t partial = (int32_t)tvmrt_reduce_partial_bytes(at);
+  memset(g, 0, sizeof(*g));
+  g->cws = (uint8_t *)tvmrt_mem_alloc((uint64_t)n * RED_ATTR_STRIDE, 64);
+  g->ws = (uint8_t *)tvmrt_mem_alloc((uint64_t)partial, 64);
+  if (!g->cws || !g->ws) return -1;
+  g->tmap[0] = (tvmrt_tensor_map_entry_t){.sid = 0, .size = partial, .align = 64,
+                                          .dtype = TVMRT_DTYPE_FLOAT32};
+  for (int32_t i = 0; i < n; i++) {
+    tvmrt_reduce_attrs_t *a = (tvmrt_reduce_attrs_t *)(g->cws + i * RED_ATTR_STRIDE);
+    *a = *at;
+    a->part = (i < parts) ? i : -1;
+    tvmrt_op_desc_t *d = &g->descs[i];
+    *d = (tvmrt_op_desc_t){.op_id = i, .name = i < parts ? "reduce" : "combine",
+                           .func_entry_id = i < parts ? 0 : 1, .input_count = 2,
+                           .output_count = 1, .const_offset = i * RED_ATTR_STRIDE,
+                           .const_size = (int32_t)sizeof(*a)};
+    d->input_sids[0] = (i < parts) ? TVMRT_SID_INPUT(0) : 0;
+    d->input_sids[1] = TVMRT_SID_CONST;
+    d->output_sids[0] = (i < parts) ? 0 : TVMRT_SID_OUTPUT(0);
+    g->ids[i] = i;
+  }
+  g->layers[0] = (tvmrt_schedule_layer_t){&g->ids[0], parts};
+  g->layers[1] = (tvmrt_schedule_layer_t){&g->ids[parts], 1};
+  g->schedule = (tvmrt_schedule_desc_t){g->layers, 2};
+  g->model = (tvmrt_model_desc_t){.tensor_map = g->tmap, .tensor_count = 1, .op_descs = g->descs,
+                                  .op_count = n, .schedule = &g->schedule,
+                                  .cpu_func_table = funcs, .cpu_func_count = 2};
+  g->ctx = (tvmrt_context_t){.workspace = g->ws, .const_workspace = g->cws,
+                             .op_execs = g->execs, .args_storage = g->args};
+  void *ins[1] = {x}, *outs[1] = {out};
+  if (tvmrt_semantic_bind_args(&g->model, g->args, ins, 1, outs, 1, g->ws, g->cws) != 0 ||
+      tvmrt_semantic_init(&g->ctx, &g->model) != 0) {
+    return -1;
+  }
+  return 0;
+}
+
+// 朴素实现: 按内存顺序顺序累加 (axis 0 时逐行累加到各列)
+static void red_naive(tvmrt_reduce_kind_t kind, int32_t rows, int32_t cols, int32_t axis,
+                      const float *x, void *out) {
+  float *o = (float *)out;
+  int32_t *idx = (int32_t *)out;
+  if (axis == 0) {
+    for (int32_t c = 0; c < cols; c++) o[c] = 0.0f;
+    for (int32_t r = 0; r < rows; r++) {
+      for (int32_t c = 0; c < cols; c++) o[c] += x[(int64_t)r * cols + c];
+    }
+    return;
+  }
+  for (int32_t r = 0; r < rows; r++) {
+    const float *p = x + (int64_t)r * cols;
+    float best = p[0], sum = 0.0f;
+    int32_t bi = 0;
+    for (int32_t c = 0; c < cols; c++) {
+      sum += p[c];
+      if (p[c] > best) {
+        best = p[c];
+        bi = c;
+      }
+    }
+    if (kind == TVMRT_REDUCE_ARGMAX) {
+      idx[r] = bi;
+    } else {
+      o[r] = sum;
+    }
+  }
+}
+
+// 求和结果相对 double 参考值的最大相对误差
+static double red_sum_error(int32_t rows, int32_t cols, int32_t axis, const float *x,
+                            const float *out) {
+  int32_t outputs = (axis == 0) ? cols : rows, count = (axis == 0) ? rows : cols;
+  double worst = 0.0;
+  for (int32_t o = 0; o < outputs; o++) {
+    double exact = 0.0;
+    for (int32_t r = 0; r < count; r++) {
+      exact += (axis == 0) ? x[(int64_t)r * cols + o] : x[(int64_t)o * cols + r];
+    }
+    double err = fabs(out[o] - exact) / fabs(exact);
+    worst = err > worst ? err : worst;
+  }
+  return worst;
+}
+
+static int bench_reduce(void) {
+  static const struct {
+    const char *name;
+    tvmrt_reduce_kind_t kind;
+    int32_t rows, cols, axis;
+  } cases[] = {
+      {"Sum 全部 [16M]", TVMRT_REDUCE_SUM, 1, RED_ELEMS, -1},
+      {"Sum [4096,4096] axis 0", TVMRT_REDUCE_SUM, 4096, 4096, 0},
+      {"ArgMax [4096,4096] axis -1", TVMRT_REDUCE_ARGMAX, 4096, 4096, -1},
+  };
+  static const int32_t workers[] = {1, 2, 4};
+  enum { WORKER_ROWS = sizeof(workers) / sizeof(workers[0]) };
+  float *x = (float *)tvmrt_mem_alloc((uint64_t)RED_ELEMS * 4, 64);
+  float *ref = (float *)tvmrt_mem_alloc(4096 * 4, 64);
+  float *single = (float *)tvmrt_mem_alloc(4096 * 4, 64);
+  float *out = (float *)tvmrt_mem_alloc(4096 * 4, 64);
+  tvmrt_engine_config_t config = {.num_workers = workers[0]};
+  if (!x || !ref || !single || !out || tvmrt_engine_init(&config) != 0) {
+    printf("准备失败\n");
+    return 1;
+  }
+  for (int32_t i = 0; i < RED_ELEMS; i++) x[i] = i8_rand() + 1.0f;
+
+  printf("%d 元素, 最多 %d 个部分算子 + 1 个合并算子, 可用 CPU %d, 取 %d 次最小值 (ms)\n",
+         RED_ELEMS, RED_PARTS, tvmrt_cpu_count(), RED_RUNS);
+  printf("%-28s %8s %8s", "", "朴素", "单算子");
+  for (int32_t w = 0; w < WORKER_ROWS; w++) printf("   %d Worker", workers[w]);
+  printf(" %6s %10s %10s\n", "一致", "朴素误差", "归约误差");
+
+  int ok = 1;
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+    tvmrt_view_t v = {.rank = 2, .shape = {cases[c].rows, cases[c].cols}};
+    tvmrt_reduce_attrs_t at;
+    RedGraph g;
+    if (tvmrt_reduce_prepare(&at, cases[c].kind, &v, &cases[c].axis, 1, RED_PARTS) != 0 ||
+        red_build(&g, &at, x, out) != 0) {
+      printf("%s: 准备失败\n", cases[c].name);
+      return 1;
+    }
+    size_t out_bytes = (size_t)at.outputs * 4;
+
+    double ms[2 + WORKER_ROWS];
+    for (int32_t m = 0; m < 2 + WORKER_ROWS; m++) {
+      if (m >= 2) ok &= tvmrt_engine_resize(workers[m - 2]) == 0;
+      uint64_t best = UINT64_MAX;
+      for (int32_t r = 0; r < RED_RUNS; r++) {
+        uint64_t t0 = tvmrt_time_ns();
+        if (m == 0) {
+          red_naive(cases[c].kind, cases[c].rows, cases[c].cols, cases[c].axis, x, ref);
+        } else if (m == 1) {
+          at.part = -1;
+          ok &= tvmgen_default_reduce_f32(x, single, (uint8_t *)&at, NULL) == 0;
+        } else {
+          memset(out, 0, out_bytes);
+          ok &= tvmrt_engine_run(&g.ctx, &g.schedule) == 0;
+        }
+        uint64_t dt = tvmrt_time_ns() - t0;
+        best = dt < best ? dt : best;
+      }
+      ms[m] = best / 1e6;
+      if (m >= 2) ok &= memcmp(out, single, out_bytes) == 0;
+    }
+
+    bool same = memcmp(out, single, out_bytes) == 0;
+    printf("%-28s %8.2f %8.2f", cases[c].name, ms[0], ms[1]);
+    for (int32_t w = 0; w < WORKER_ROWS; w++) printf(" %10.2f", ms[2 + w]);
+    if (cases[c].kind == TVMRT_REDUCE_SUM) {
+      printf(" %6s %10.2e %10.2e\n", same ? "是" : "否",
+             red_sum_error(cases[c].rows, cases[c].cols, cases[c].axis, x, ref),
+             red_sum_error(cases[c].rows, cases[c].cols, cases[c].axis, x, out));
+    } else {
+      ok &= memcmp(ref, out, out_bytes) == 0;
+      printf(" %6s %10s %10s\n", same ? "是" : "否", "-", "-");
+    }
+    tvmrt_mem_free(g.ws);
+    tvmrt_mem_free(g.cws);
+  }
+  tvmrt_engine_shutdown();
+  tvmrt_mem_free(x);
+  tvmrt_mem_free(ref);
+  tvmrt_mem_free(single);
+  tvmrt_mem_free(out);
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 卷积与池化
+// ============================================================
+//
+// 常见视觉网络层形状 (batch 1, NHWC) 上分别强制 im2col + GEMM 与直接卷积
+// 两条路径，报告 GFLOP/s、自动选择的路径与 im2col 临时区大小，并校验两条
+// 路径结果逐位一致; 池化报告读入带宽。
+
+#define CONV_RUNS 5
+
+extern int32_t tvmgen_default_conv2d_f32(float *p0, float *output, float *scratch, uint8_t *cws,
+                                         uint8_t *ws);
+extern int32_t tvmgen_default_pool2d_f32(float *p0, float *output, uint8_t *cws, uint8_t *ws);
+
+static double conv_time_ms(const tvmrt_conv2d_attrs_t *at, uint8_t *cws, const float *x, float *y,
+                           float *scratch, int *ok) {
+  uint64_t best = UINT64_MAX;
+  memcpy(cws, at, sizeof(*at));
+  for (int32_t r = 0; r < CONV_RUNS; r++) {
+    uint64_t t0 = tvmrt_time_ns();
+    *ok &= tvmgen_default_conv2d_f32((float *)x, y, scratch, cws, NULL) == 0;
+    uint64_t dt = tvmrt_time_ns() - t0;
+    best = dt < best ? dt : best;
+  }
+  return best / 1e6;
+}
+
+static int bench_conv(void) {
+  static const struct {
+    const char *name;
+    tvmrt_window2d_t win;
+    int32_t k;
+  } convs[] = {
+      {"7x7/2 [224,224,3]->64", {1, 224, 224, 3, 7, 7, 2, 2, 3, 3, 3, 3}, 64},
+      {"3x3 [56,56,64]->64", {1, 56, 56, 64, 3, 3, 1, 1, 1, 1, 1, 1}, 64},
+      {"1x1 [56,56,64]->256", {1, 56, 56, 64, 1, 1, 1, 1, 0, 0, 0, 0}, 256},
+      {"3x3/2 [56,56,128]->128", {1, 56, 56, 128, 3, 3, 2, 2, 0, 1, 0, 1}, 128},
+      {"3x3 [28,28,128]->128", {1, 28, 28, 128, 3, 3, 1, 1, 1, 1, 1, 1}, 128},
+      {"3x3 [14,14,256]->256", {1, 14, 14, 256, 3, 3, 1, 1, 1, 1, 1, 1}, 256},
+      {"3x3 [112,112,8]->16", {1, 112, 112, 8, 3, 3, 1, 1, 1, 1, 1, 1}, 16},
+  };
+  static const struct {
+    const char *name;
+    tvmrt_pool_kind_t kind;
+    tvmrt_window2d_t win;
+  } pools[] = {
+      {"MaxPool 3x3/2 [112,112,64]", TVMRT_POOL_MAX, {1, 112, 112, 64, 3, 3, 2, 2, 1, 1, 1, 1}},
+      {"AvgPool 2x2/2 [56,56,256]", TVMRT_POOL_AVG, {1, 56, 56, 256, 2, 2, 2, 2, 0, 0, 0, 0}},
+      {"AvgPool 7x7 [7,7,512] (全局)", TVMRT_POOL_AVG, {1, 7, 7, 512, 7, 7, 1, 1, 0, 0, 0, 0}},
+  };
+  const int32_t max_elems = 1024 * 1024;
+  float *x = (float *)tvmrt_mem_alloc((uint64_t)max_elems * 4, 64);
+  float *y = (float *)tvmrt_mem_alloc((uint64_t)max_elems * 4, 64);
+  float *y2 = (float *)tvmrt_mem_alloc((uint64_t)max_elems * 4, 64);
+  float *scratch = (float *)tvmrt_mem_alloc((uint64_t)max_elems * 4, 64);
+  uint8_t *cws = (uint8_t *)tvmrt_mem_alloc(4 * 1024 * 1024, 64);
+  if (!x || !y || !y2 || !scratch || !cws) {
+    printf("内存不足\n");
+    return 1;
+  }
+  for (int32_t i = 0; i < max_elems; i++) x[i] = i8_rand();
+
+  int ok = 1;
+  printf("batch 1, NHWC fp32, 取 %d 次最小值\n", CONV_RUNS);
+  printf("%-26s %7s %10s %10s %10s %10s %6s %10s\n", "", "MFLOP", "im2col ms", "GFLOP/s",
+         "直接 ms", "GFLOP/s", "自动", "临时区 KB");
+  for (size_t c = 0; c < sizeof(convs) / sizeof(convs[0]); c++) {
+    tvmrt_conv2d_attrs_t at, im, direct;
+    if (tvmrt_conv2d_prepare(&at, &convs[c].win, convs[c].k, true, TVMRT_CONV_AUTO) != 0 ||
+        tvmrt_conv2d_prepare(&im, &convs[c].win, convs[c].k, true, TVMRT_CONV_IM2COL) != 0 ||
+        tvmrt_conv2d_prepare(&direct, &convs[c].win, convs[c].k, true, TVMRT_CONV_DIRECT) != 0 ||
+        at.const_bytes > 4 * 1024 * 1024) {
+      printf("%s: 准备失败\n", convs[c].name);
+      return 1;
+    }
+    float *w = (float *)(cws + at.weight_offset);
+    int32_t kdim = convs[c].win.kh * convs[c].win.kw * convs[c].win.c;
+    for (int32_t i = 0; i < kdim * at.k; i++) w[i] = i8_rand() * 0.1f;
+    for (int32_t j = 0; j < at.k; j++) ((float *)(cws + at.bias_offset))[j] = i8_rand();
+    int32_t outputs = at.out_h * at.out_w * at.k;
+    double mflop = 2.0 * outputs * kdim / 1e6;
+
+    double t_direct = conv_time_ms(&direct, cws, x, y2, NULL, &ok);
+    double t_im = conv_time_ms(&im, cws, x, y, scratch, &ok);
+    ok &= memcmp(y, y2, (size_t)outputs * 4) == 0;
+    printf("%-26s %7.1f %10.2f %10.2f %10.2f %10.2f %6s %10.1f\n", convs[c].name, mflop, t_im,
+           mflop / t_im, t_direct, mflop / t_direct,
+           at.algo == TVMRT_CONV_DIRECT ? "直接" : "im2col", im.scratch_bytes / 1024.0);
+  }
+
+  printf("\n%-30s %10s %10s\n", "", "耗时 ms", "读入 GB/s");
+  for (size_t p = 0; p < sizeof(pools) / sizeof(pools[0]); p++) {
+    tvmrt_pool2d_attrs_t at;
+    if (tvmrt_pool2d_prepare(&at, pools[p].kind, &pools[p].win) != 0) {
+      printf("%s: 准备失败\n", pools[p].name);
+      return 1;
+    }
+    uint64_t best = UINT64_MAX;
+    for (int32_t r = 0; r < CONV_RUNS; r++) {
+      uint64_t t0 = tvmrt_time_ns();
+      ok &= tvmgen_default_pool2d_f32(x, y, (uint8_t *)&at, NULL) == 0;
+      uint64_t dt = tvmrt_time_ns() - t0;
+      best = dt < best ? dt : best;
+    }
+    double bytes = 4.0 * at.win.h * at.win.w * at.win.c;
+    printf("%-30s %10.3f %10.2f\n", pools[p].name, best / 1e6, bytes / best);
+  }
+  tvmrt_mem_free(x);
+  tvmrt_mem_free(y);
+  tvmrt_mem_free(y2);
+  tvmrt_mem_free(scratch);
+  tvmrt_mem_free(cws);
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: 稀疏权重 MatMul
+// ============================================================
+//
+// [32,1024] x [1024,1024] 的 fp32 MatMul，权重按不同稀疏度剪枝 (非结构化:
+// 逐元素随机置 0; 块剪枝: 按 1x16 块随机置 0)，分别以稠密内核、CSR 与块
+// 稀疏 (BSR) 内核执行，报告耗时、相对稠密内核的加速比与自动选择的格式，
+// 并校验稀疏内核结果与稠密内核相同。
+
+#define SPARSE_M 32
+#define SPARSE_K 1024
+#define SPARSE_N 1024
+#define SPARSE_RUNS 5
+#define SPARSE_WEIGHT_OFFSET (128 + 4096)
+
+extern void tvmgen_default_sparse_kernels(tvmrt_sparse_config_t *config);
+
+static double sparse_time_ms(tvmrt_op_func_t func, tvmrt_op_args_t *args) {
+  uint64_t best = UINT64_MAX;
+  for (int32_t r = 0; r < SPARSE_RUNS; r++) {
+    uint64_t t0 = tvmrt_time_ns();
+    func(args);
+    uint64_t dt = tvmrt_time_ns() - t0;
+    best = dt < best ? dt : best;
+  }
+  return best / 1e6;
+}
+
+static int bench_sparse(void) {
+  static const float sparsity[] = {0.0f, 0.5f, 0.7f, 0.8f, 0.9f, 0.95f};
+  const int64_t wbytes = (int64_t)SPARSE_K * SPARSE_N * 4;
+  const int64_t cap = SPARSE_WEIGHT_OFFSET + 5 * wbytes;
+  uint8_t *cws = (uint8_t *)tvmrt_mem_alloc((uint64_t)SPARSE_WEIGHT_OFFSET + wbytes, 64);
+  uint8_t *packed = (uint8_t *)tvmrt_mem_alloc((uint64_t)cap, 64);
+  float *x = (float *)tvmrt_mem_alloc(SPARSE_M * SPARSE_K * 4, 64);
+  float *ref = (float *)tvmrt_mem_alloc(SPARSE_M * SPARSE_N * 4, 64);
+  float *y = (float *)tvmrt_mem_alloc(SPARSE_M * SPARSE_N * 4, 64);
+  if (!cws || !packed || !x || !ref || !y) {
+    printf("内存不足\n");
+    return 1;
+  }
+  tvmrt_sparse_config_t config = {0};
+  tvmgen_default_sparse_kernels(&config);
+  tvmrt_qattrs_t *at = (tvmrt_qattrs_t *)cws;
+  *at = (tvmrt_qattrs_t){.count = SPARSE_M, .n = SPARSE_N, .k = SPARSE_K,
+                         .weight_offset = SPARSE_WEIGHT_OFFSET, .bias_offset = 128};
+  float *bias = (float *)(cws + 128), *w = (float *)(cws + SPARSE_WEIGHT_OFFSET);
+  for (int32_t j = 0; j < SPARSE_N; j++) bias[j] = i8_rand();
+  for (int32_t i = 0; i < SPARSE_M * SPARSE_K; i++) x[i] = i8_rand();
+
+  int ok = 1;
+  printf("[%d,%d] x [%d,%d] fp32, 取 %d 次最小值\n", SPARSE_M, SPARSE_K, SPARSE_K, SPARSE_N,
+         SPARSE_RUNS);
+  printf("%-6s %-8s %9s %9s %7s %9s %7s %9s %9s %6s\n", "稀疏度", "模式", "稠密 ms", "CSR ms",
+         "加速", "BSR ms", "加速", "元素密度", "块密度", "自动");
+  for (int32_t pattern = 0; pattern < 2; pattern++) {
+    for (size_t s = 0; s < sizeof(sparsity) / sizeof(sparsity[0]); s++) {
+      for (int32_t t = 0; t < SPARSE_K; t++) {
+        float keep = 0.0f;
+        for (int32_t j = 0; j < SPARSE_N; j++) {
+          if (pattern == 0 || j % TVMRT_SPARSE_BLOCK_COLS == 0) keep = i8_rand() * 0.5f + 0.5f;
+          float v = i8_rand();
+          w[t * SPARSE_N + j] = (keep >= sparsity[s] && v != 0.0f) ? v : 0.0f;
+        }
+      }
+      tvmrt_op_args_t args = {.inputs = {x, cws}, .outputs = {ref}};
+      double t_dense = sparse_time_ms(config.dense, &args);
+      double t_fmt[2];
+      args.outputs[0] = y;
+      for (int32_t f = 0; f < 2; f++) {
+        tvmrt_sparse_format_t fmt = f == 0 ? TVMRT_SPARSE_CSR : TVMRT_SPARSE_BSR;
+        int64_t bytes = tvmrt_sparse_pack(at, fmt, (tvmrt_sparse_attrs_t *)packed, cap);
+        ok &= bytes > 0 && bytes <= cap;
+        args.inputs[1] = packed;
+        t_fmt[f] = sparse_time_ms(f == 0 ? config.csr : config.bsr, &args);
+        for (int32_t i = 0; i < SPARSE_M * SPARSE_N; i++) ok &= y[i] == ref[i];
+        args.inputs[1] = cws;
+      }
+      tvmrt_sparse_format_t choice = tvmrt_sparse_choose(at, NULL);
+      printf("%5.0f%% %-8s %9.2f %9.2f %6.2fx %9.2f %6.2fx %9.3f %9.3f %6s\n",
+             sparsity[s] * 100, pattern == 0 ? "逐元素" : "1x16块", t_dense, t_fmt[0],
+             t_dense / t_fmt[0], t_fmt[1], t_dense / t_fmt[1],
+             tvmrt_sparse_density(at, TVMRT_SPARSE_CSR), tvmrt_sparse_density(at, TVMRT_SPARSE_BSR),
+             choice == TVMRT_SPARSE_CSR ? "CSR" : choice == TVMRT_SPARSE_BSR ? "BSR" : "稠密");
+    }
+  }
+  tvmrt_mem_free(cws);
+  tvmrt_mem_free(packed);
+  tvmrt_mem_free(x);
+  tvmrt_mem_free(ref);
+  tvmrt_mem_free(y);
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 场景: Softmax 与 LayerNorm
+// ============================================================
+//
+// 4M 元素 (16 MB，超出缓存) 的 fp32 张量在不同行长下逐行 Softmax /
+// LayerNorm: 单内核两遍实现 vs 拆成多个整张量算子的朴素实现 (Softmax:
+// 行最大值、exp、行和、缩放; LayerNorm: 行均值、减均值、方差、缩放)，报告
+// 耗时、按读入 + 写出一遍计的带宽，以及单内核结果相对 double 参考实现的
+// 最大误差 (Softmax 为相对误差，LayerNorm 为绝对误差)。
+
+#define NORM_ELEMS (4 * 1024 * 1024)
+#define NORM_RUNS 5
+
+extern int32_t tvmgen_default_softmax_f32(float *p0, float *output, uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_layernorm_f32(float *p0, float *output, uint8_t *cws, uint8_t *ws);
+
+static void norm_naive_softmax(const float *x, float *y, float *stat, int32_t rows, int32_t cols) {
+  for (int32_t r = 0; r < rows; r++) {
+    float m = -INFINITY;
+    for (int32_t c = 0; c < cols; c++) m = fmaxf(m, x[(size_t)r * cols + c]);
+    stat[r] = m;
+  }
+  for (int32_t r = 0; r < rows; r++) {
+    for (int32_t c = 0; c < cols; c++) y[(size_t)r * cols + c] = expf(x[(size_t)r * cols + c] - stat[r]);
+  }
+  for (int32_t r = 0; r < rows; r++) {
+    float s = 0.0f;
+    for (int32_t c = 0; c < cols; c++) s += y[(size_t)r * cols + c];
+    stat[r] = 1.0f / s;
+  }
+  for (int32_t r = 0; r < rows; r++) {
+    for (int32_t c = 0; c < cols; c++) y[(size_t)r * cols + c] *= stat[r];
+  }
+}
+
+static void norm_naive_layernorm(const float *x, float *y, float *stat, int32_t rows, int32_t cols,
+                                 const float *gamma, const float *beta) {
+  for (int32_t r = 0; r < rows; r++) {
+    float s = 0.0f;
+    for (int32_t c = 0; c < cols; c++) s += x[(size_t)r * cols + c];
+    stat[r] = s / cols;
+  }
+  for (int32_t r = 0; r < rows; r++) {
+    for (int32_t c = 0; c < cols; c++) y[(size_t)r * cols + c] = x[(size_t)r * cols + c] - stat[r];
+  }
+  for (int32_t r = 0; r < rows; r++) {
+    float s = 0.0f;
+    for (int32_t c = 0; c < cols; c++) s += y[(size_t)r * cols + c] * y[(size_t)r * cols + c];
+    stat[r] = 1.0f / sqrtf(s / cols + 1e-5f);
+  }
+  for (int32_t r = 0; r < rows; r++) {
+    for (int32_t c = 0; c < cols; c++) {
+      size_t i = (size_t)r * cols + c;
+      y[i] = y[i] * stat[r] * gamma[c] + beta[c];
+    }
+  }
+}
+
+// 单内核结果相对 double 参考实现的最大误差
+static double norm_error(const tvmrt_norm_attrs_t *at, const float *x, const float *y) {
+  const float *gamma = at->gamma_offset ? (const float *)((const uint8_t *)at + at->gamma_offset) : NULL;
+  const float *beta = at->beta_offset ? (const float *)((const uint8_t *)at + at->beta_offset) : NULL;
+  double worst = 0.0;
+  for (int32_t r = 0; r < at->rows; r++) {
+    const float *v = x + (size_t)r * at->cols;
+    const float *o = y + (size_t)r * at->cols;
+    double a = at->kind == TVMRT_NORM_SOFTMAX ? -INFINITY : 0.0, b = 0.0;
+    for (int32_t c = 0; c < at->cols; c++) a = at->kind == TVMRT_NORM_SOFTMAX ? fmax(a, v[c]) : a + v[c];
+    if (at->kind == TVMRT_NORM_LAYERNORM) a /= at->cols;
+    for (int32_t c = 0; c < at->cols; c++) {
+      b += at->kind == TVMRT_NORM_SOFTMAX ? exp(v[c] - a) : (v[c] - a) * (v[c] - a);
+    }
+    double rstd = 1.0 / sqrt(b / at->cols + at->eps);
+    for (int32_t c = 0; c < at->cols; c++) {
+      double ref, e;
+      if (at->kind == TVMRT_NORM_SOFTMAX) {
+        ref = exp(v[c] - a) / b;
+        e = fabs(o[c] - ref) / ref;
+      } else {
+        ref = (v[c] - a) * rstd * (gamma ? gamma[c] : 1.0) + (beta ? beta[c] : 0.0);
+        e = fabs(o[c] - ref);
+      }
+      worst = e > worst ? e : worst;
+    }
+  }
+  return worst;
+}
+
+static int bench_norm(void) {
+  static const int32_t col_sizes[] = {128, 1024, 4096, 65536};
+  float *x = (float *)tvmrt_mem_alloc((uint64_t)NORM_ELEMS * 4, 64);
+  float *y = (float *)tvmrt_mem_alloc((uint64_t)NORM_ELEMS * 4, 64);
+  float *stat = (float *)tvmrt_mem_alloc((uint64_t)NORM_ELEMS * 4, 64);
+  uint8_t *cws = (uint8_t *)tvmrt_mem_alloc(64 + 2 * 4 * 65536 + 128, 64);
+  if (!x || !y || !stat || !cws) {
+    printf("内存不足\n");
+    return 1;
+  }
+  for (int32_t i = 0; i < NORM_ELEMS; i++) x[i] = i8_rand() * 8.0f;
+
+  int ok = 1;
+  printf("[rows, cols] = %d 元素 fp32, 取 %d 次最小值\n", NORM_ELEMS, NORM_RUNS);
+  printf("%-10s %-14s %9s %9s %9s %9s %7s %10s\n", "", "形状", "单内核 ms", "GB/s", "朴素 ms",
+         "GB/s", "加速", "最大误差");
+  for (int32_t kind = 0; kind < 2; kind++) {
+    for (size_t s = 0; s < sizeof(col_sizes) / sizeof(col_sizes[0]); s++) {
+      int32_t cols = col_sizes[s], rows = NORM_ELEMS / cols;
+      tvmrt_norm_attrs_t *at = (tvmrt_norm_attrs_t *)cws;
+      const float *gamma = NULL, *beta = NULL;
+      if (kind == TVMRT_NORM_SOFTMAX) {
+        ok &= tvmrt_softmax_prepare(at, rows, cols) == 0;
+      } else {
+        ok &= tvmrt_layernorm_prepare(at, rows, cols, 1e-5f, true) == 0;
+        gamma = (const float *)(cws + at->gamma_offset);
+        beta = (const float *)(cws + at->beta_offset);
+        for (int32_t c = 0; c < cols; c++) {
+          ((float *)gamma)[c] = 1.0f + i8_rand() * 0.1f;
+          ((float *)beta)[c] = i8_rand() * 0.1f;
+        }
+      }
+      uint64_t best = UINT64_MAX, best_naive = UINT64_MAX;
+      for (int32_t r = 0; r < NORM_RUNS; r++) {
+        uint64_t t0 = tvmrt_time_ns();
+        if (kind == TVMRT_NORM_SOFTMAX) {
+          norm_naive_softmax(x, y, stat, rows, cols);
+        } else {
+          norm_naive_layernorm(x, y, stat, rows, cols, gamma, beta);
+        }
+        uint64_t t1 = tvmrt_time_ns();
+        ok &= (kind == TVMRT_NORM_SOFTMAX ? tvmgen_default_softmax_f32(x, y, cws, NULL)
+                                          : tvmgen_default_layernorm_f32(x, y, cws, NULL)) == 0;
+        uint64_t t2 = tvmrt_time_ns();
+        best_naive = (t1 - t0) < best_naive ? (t1 - t0) : best_naive;
+        best = (t2 - t1) < best ? (t2 - t1) : best;
+      }
+      double bytes = 2.0 * 4.0 * NORM_ELEMS;
+      char shape[32];
+      snprintf(shape, sizeof(shape), "[%d,%d]", rows, cols);
+      printf("%-10s %-14s %9.2f %9.2f %9.2f %9.2f %6.2fx %10.2e\n",
+             kind == TVMRT_NORM_SOFTMAX ? "Softmax" : "LayerNorm", shape, best / 1e6,
+             bytes / best, best_naive / 1e6, bytes / best_naive, (double)best_naive / best,
+             norm_error(at, x, y));
+    }
+  }
+  tvmrt_mem_free(x);
+  tvmrt_mem_free(y);
+  tvmrt_mem_free(stat);
+  tvmrt_mem_free(cws);
+
+  if (!ok) {
+    printf("结果错误\n");
+    return 1;
+  }
+  return 0;
+}
+
+// ============================================================
+// 入口
+// ============================================================
+
+typedef struct {
+  const char *name;
+  int (*func)(void);
+} BenchEntry;
+
+static const BenchEntry g_benches[] = {
+    {"paging", bench_paging},
+    {"arena", bench_arena},
+    {"dispatch", bench_dispatch},
+    {"emit", bench_emit},
+    {"static", bench_static},
+    {"caller", bench_caller},
+    {"adaptive", bench_adaptive},
+    {"dataflow", bench_dataflow},
+    {"falseshare", bench_falseshare},
+    {"profile", bench_profile},
+    {"scaling", bench_scaling},
+    {"large", bench_large},
+    {"batch", bench_batch},
+    {"throughput", bench_throughput},
+    {"multimodel", bench_multimodel},
+    {"deadline", bench_deadline},
+    {"int8", bench_int8},
+    {"half", bench_half},
+    {"tiled", bench_tiled},
+    {"tune", bench_tune},
+    {"broadcast", bench_broadcast},
+    {"reduce", bench_reduce},
+    {"conv", bench_conv},
+    {"sparse", bench_sparse},
+    {"norm", bench_norm},
+};
+
+#define BENCH_COUNT ((int)(sizeof(g_benches) / sizeof(g_benches[0])))
+
+int main(int argc, char **argv) {
+  int ret = 0;
+  int ran = 0;
+
+  g_bench_arg = (argc > 2) ? argv[2] : NULL;
+  for (int i = 0; i < BENCH_COUNT; i++) {
+    if (argc > 1 && strcmp(argv[1], g_benches[i].name) != 0) continue;
+
+    printf("========================================\n");
+    printf("  基准: %s\n", g_benches[i].name);
+    printf("========================================\n");
+    ret |= g_benches[i].func();
+    printf("\n");
+    ran++;
+  }
+
+  if (ran == 0) {
+    printf("未知场景: %s\n可选:", argv[1]);
+    for (int i = 0; i < BENCH_COUNT; i++) printf(" %s", g_benches[i].name);
+    printf("\n");
+    return 1;
+  }
+  return ret;
+}
@@ -37,7 +37,7 @@ static struct global_const_workspace {
 // ============================================================
 // Workspace (64 bytes, 8 内存槽)
 // ============================================================
-__attribute__((aligned(16))) static uint8_t global_workspace[64];
+__attribute__((aligned(64))) static uint8_t global_workspace[64];
 
 // ============================================================
 // 外部声明
@@ -8,6 +8,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "tvmrt.h"
 
@@ -16,36 +17,31 @@
 
 extern const tvmrt_model_desc_t *model_get_descriptor(void);
 extern const tvmrt_schedule_desc_t *model_get_schedule(void);
-extern int model_fill_args(void *args, float *input, float *output,
-                           uint8_t *workspace, const uint8_t *const_workspace);
-extern void *model_get_op_args(int32_t op_id);
 
 // ============================================================
-// 静态算子执行表
+// 静态算子执行表与参数区
 // ============================================================
 static tvmrt_op_exec_t g_op_execs[MODEL_NUM_OPS];
+static tvmrt_op_args_t g_op_args[MODEL_NUM_OPS];
+static tvmrt_plan_t g_plan;
 
-// 初始化标志
+// 初始化标志与当前绑定的缓冲区 (缓冲区不变时不重新绑定)
 static bool g_engine_initialized = false;
+static void *g_bound[4];
 
-// ============================================================
-// 初始化算子条目
-// ============================================================
-static int init_op_execs(float *input, float *output, uint8_t *workspace,
-                         const uint8_t *const_workspace) {
-  const tvmrt_model_desc_t *model = model_get_descriptor();
-
-  // 先填充参数
-  model_fill_args(NULL, input, output, workspace, (uint8_t *)const_workspace);
-
-  // 设置执行条目
-  for (int32_t i = 0; i < MODEL_NUM_OPS; i++) {
-    const tvmrt_op_desc_t *desc = &model->op_descs[i];
-    g_op_execs[i].name = desc->name;
-    g_op_execs[i].func = model->cpu_func_table[desc->func_entry_id];
-    g_op_execs[i].args = model_get_op_args(i);
+// 首次调用: 初始化引擎，填充执行表并编译扁平执行计划 (此后不再编译)
+static int32_t lib1_init(void) {
+  if (tvmrt_engine_init(NULL) != 0) {
+    return -1;
   }
-
+  tvmrt_context_t ctx = {.op_execs = g_op_execs,
+                         .op_count = MODEL_NUM_OPS,
+                         .args_storage = g_op_args};
+  if (tvmrt_semantic_init(&ctx, model_get_descriptor()) != 0 ||
+      tvmrt_plan_compile(&g_plan, &ctx, model_get_schedule()) != 0) {
+    return -1;
+  }
+  g_engine_initialized = true;
   return 0;
 }
 
@@ -60,28 +56,25 @@ extern "C"
                                 float *output_buffer_var,
                                 uint8_t *global_const_workspace_0_var,
                                 uint8_t *global_workspace_1_var) {
-  // 如需初始化引擎
-  if (!g_engine_initialized) {
-    if (tvmrt_engine_init() != 0) {
+  if (!g_engine_initialized && lib1_init() != 0) {
+    return -1;
+  }
+
+  // 计划引用的是参数区 g_op_args: 缓冲区变化时只需按算子描述重新绑定参数
+  void *bufs[4] = {input_buffer_var, output_buffer_var,
+                   global_const_workspace_0_var, global_workspace_1_var};
+  if (memcmp(bufs, g_bound, sizeof(bufs)) != 0) {
+    void *inputs[1] = {input_buffer_var};
+    void *outputs[1] = {output_buffer_var};
+    if (tvmrt_semantic_bind_args(model_get_descriptor(), g_op_args, inputs, 1,
+                                 outputs, 1, global_workspace_1_var,
+                                 global_const_workspace_0_var) != 0) {
+      memset(g_bound, 0, sizeof(g_bound));
       return -1;
     }
-    g_engine_initialized = true;
+    memcpy(g_bound, bufs, sizeof(bufs));
   }
 
-  // 初始化算子条目
-  init_op_execs(input_buffer_var, output_buffer_var, global_workspace_1_var,
-                global_const_workspace_0_var);
-
-  // 创建运行时上下文
-  tvmrt_context_t ctx = {.workspace = global_workspace_1_var,
-                         .const_workspace = global_const_workspace_0_var,
-                         .op_execs = g_op_execs,
-                         .op_count = MODEL_NUM_OPS,
-                         .args_storage = NULL};
-
-  // 获取调度表并运行 (单线程模式)
-  const tvmrt_schedule_desc_t *schedule = model_get_schedule();
-  int32_t ret = tvmrt_engine_run_single(&ctx, schedule);
-
-  return ret;
+  // 单线程模式: 直接执行编译好的扁平计划 (调度表只在编译时使用)
+  return tvmrt_plan_run(&g_plan);
 }
@@ -21,25 +21,6 @@
 #define MODEL_NUM_OPS 16     // 算子总数
 #define MODEL_NUM_LAYERS 9   // 层数 (Layer 8 拆成两层)
 
-// ============================================================
-// 参数结构体 (复用 ops.c 中定义的)
-// ============================================================
-
-typedef struct {
-  float *p0;
-  float *output;
-  uint8_t *const_ws;
-  uint8_t *ws;
-} FusedAddArgs;
-
-typedef struct {
-  float *p0;
-  float *p1;
-  float *output;
-  uint8_t *const_ws;
-  uint8_t *ws;
-} FusedAdd3Args;
-
 // ============================================================
 // 包装函数前向声明
 // ============================================================
@@ -61,6 +42,15 @@ extern int32_t wrapped_minimum(void *args);  // min(p0, p1)
 // Phase 3: 常量乘法
 extern int32_t wrapped_mul_2(void *args);    // p0 * 2
 extern int32_t wrapped_mul_half(void *args); // p0 * 0.5
+// Phase 6: 归约
+extern int32_t wrapped_reduce_f32(void *args);         // 部分/完整归约
+extern int32_t wrapped_reduce_combine_f32(void *args); // 合并部分值
+// Phase 7: 卷积与池化
+extern int32_t wrapped_conv2d_f32(void *args); // NHWC Conv2D
+extern int32_t wrapped_pool2d_f32(void *args); // MaxPool / AvgPool
+// Phase 9: Softmax 与 LayerNorm
+extern int32_t wrapped_softmax_f32(void *args);   // 逐行 Softmax
+extern int32_t wrapped_layernorm_f32(void *args); // 逐行 LayerNorm
 
 // ============================================================
 // 张量内存映射表 (8槽, 8字节对齐)
@@ -110,34 +100,42 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .name = "L1_add_0",
      .backend = TVMRT_BACKEND_CPU,
      .func_entry_id = 0,
-     .input_sids = {-1, -1, -1, -1},
+     .input_sids = {TVMRT_SID_INPUT(0), -1, -1, -1},
      .output_sids = {1, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 64,
+     .const_size = 4},
     {.op_id = 1,
      .name = "L1_add_1",
      .backend = TVMRT_BACKEND_CPU,
      .func_entry_id = 1,
-     .input_sids = {-1, -1, -1, -1},
+     .input_sids = {TVMRT_SID_INPUT(0), -1, -1, -1},
      .output_sids = {2, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 32,
+     .const_size = 4},
     {.op_id = 2,
      .name = "L1_add_2",
      .backend = TVMRT_BACKEND_CPU,
      .func_entry_id = 2,
-     .input_sids = {-1, -1, -1, -1},
+     .input_sids = {TVMRT_SID_INPUT(0), -1, -1, -1},
      .output_sids = {3, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 0,
+     .const_size = 4},
     {.op_id = 3,
      .name = "L1_add_3",
      .backend = TVMRT_BACKEND_CPU,
      .func_entry_id = 0,
-     .input_sids = {-1, -1, -1, -1},
+     .input_sids = {TVMRT_SID_INPUT(0), -1, -1, -1},
      .output_sids = {4, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 64,
+     .const_size = 4},
 
     // Layer 2: 两两合并
     {.op_id = 4,
@@ -165,7 +163,9 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .input_sids = {5, -1, -1, -1},
      .output_sids = {7, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 48,
+     .const_size = 4},
     {.op_id = 7,
      .name = "L3_sub_1",
      .backend = TVMRT_BACKEND_CPU,
@@ -173,7 +173,9 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .input_sids = {6, -1, -1, -1},
      .output_sids = {8, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 16,
+     .const_size = 4},
 
     // Layer 4: 合并到 M6
     {.op_id = 8,
@@ -193,7 +195,9 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .input_sids = {9, -1, -1, -1},
      .output_sids = {10, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 32,
+     .const_size = 4},
     {.op_id = 10,
      .name = "L5_add2_1",
      .backend = TVMRT_BACKEND_CPU,
@@ -201,7 +205,9 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .input_sids = {9, -1, -1, -1},
      .output_sids = {11, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 0,
+     .const_size = 4},
 
     // Layer 6: 交叉合并到 M7
     {.op_id = 11,
@@ -221,7 +227,9 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .input_sids = {12, -1, -1, -1},
      .output_sids = {5, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 48,
+     .const_size = 4},
     {.op_id = 13,
      .name = "L7_add_1",
      .backend = TVMRT_BACKEND_CPU,
@@ -229,7 +237,9 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .input_sids = {9, -1, -1, -1},
      .output_sids = {6, -1},
      .input_count = 1,
-     .output_count = 1},
+     .output_count = 1,
+     .const_offset = 64,
+     .const_size = 4},
 
     // Layer 8: 输出
     {.op_id = 14,
@@ -245,7 +255,7 @@ static const tvmrt_op_desc_t g_model_op_descs[MODEL_NUM_OPS] = {
      .backend = TVMRT_BACKEND_CPU,
      .func_entry_id = 3,
      .input_sids = {1, 12, -1, -1},
-     .output_sids = {-1, -1},
+     .output_sids = {TVMRT_SID_OUTPUT(0), -1},
      .input_count = 2,
      .output_count = 1},
 };
@@ -274,9 +284,29 @@ static const tvmrt_op_func_t g_model_cpu_func_table[] = {
     // Phase 3: 常量乘法 (索引 13-14)
     wrapped_mul_2,    // 索引 13: p0*2
     wrapped_mul_half, // 索引 14: p0*0.5
+    // Phase 6: 归约 (索引 15-16)
+    wrapped_reduce_f32,         // 索引 15: Sum/Max/Min/ArgMax
+    wrapped_reduce_combine_f32, // 索引 16: 合并部分值
+    // Phase 7: 卷积与池化 (索引 17-18)
+    wrapped_conv2d_f32, // 索引 17: Conv2D (im2col / 直接)
+    wrapped_pool2d_f32, // 索引 18: MaxPool / AvgPool
+    // Phase 9: Softmax 与 LayerNorm (索引 19-20)
+    wrapped_softmax_f32,   // 索引 19: Softmax (在线最大值/指数和)
+    wrapped_layernorm_f32, // 索引 20: LayerNorm (Welford)
 };
 
-#define MODEL_CPU_FUNC_COUNT 15
+#define MODEL_CPU_FUNC_COUNT 21
+
+// 函数表符号名 (与 g_model_cpu_func_table 一一对应, 用于生成直线执行代码)
+static const char *const g_model_cpu_func_names[MODEL_CPU_FUNC_COUNT] = {
+    "wrapped_fused_add",      "wrapped_fused_add_1",      "wrapped_fused_add_2",
+    "wrapped_fused_add_3",    "wrapped_fused_subtract",   "wrapped_fused_subtract_1",
+    "wrapped_relu",           "wrapped_sigmoid",          "wrapped_tanh_op",
+    "wrapped_relu6",          "wrapped_multiply",         "wrapped_maximum",
+    "wrapped_minimum",        "wrapped_mul_2",            "wrapped_mul_half",
+    "wrapped_reduce_f32",     "wrapped_reduce_combine_f32", "wrapped_conv2d_f32",
+    "wrapped_pool2d_f32",     "wrapped_softmax_f32",      "wrapped_layernorm_f32",
+};
 
 // ============================================================
 // 静态 BSP 调度表
@@ -320,7 +350,8 @@ static const tvmrt_model_desc_t g_model_desc = {
     .op_count = MODEL_NUM_OPS,
     .schedule = &g_model_schedule,
     .cpu_func_table = g_model_cpu_func_table,
-    .cpu_func_count = MODEL_CPU_FUNC_COUNT};
+    .cpu_func_count = MODEL_CPU_FUNC_COUNT,
+    .cpu_func_names = g_model_cpu_func_names};
 
 // ============================================================
 // 访问函数
@@ -331,117 +362,3 @@ const tvmrt_model_desc_t *model_get_descriptor(void) { return &g_model_desc; }
 const tvmrt_schedule_desc_t *model_get_schedule(void) {
   return &g_model_schedule;
 }
-
-// ============================================================
-// 参数存储 (静态分配)
-// ============================================================
-
-static FusedAddArgs g_model_single_args[16]; // 单输入算子参数
-static FusedAdd3Args g_model_dual_args[16];  // 双输入算子参数
-
-// ============================================================
-// 参数填充
-// ============================================================
-
-int model_fill_args(void *args, float *input, float *output, uint8_t *workspace,
-                    const uint8_t *const_workspace) {
-  (void)args;
-
-  // 内存槽指针
-  float *M0 = (float *)(workspace + 0);
-  float *M1 = (float *)(workspace + 8);
-  float *M2 = (float *)(workspace + 16);
-  float *M3 = (float *)(workspace + 24);
-  float *M4 = (float *)(workspace + 32);
-  float *M5 = (float *)(workspace + 40);
-  float *M6 = (float *)(workspace + 48);
-  float *M7 = (float *)(workspace + 56);
-
-  // Layer 1: input + const → M0-M3
-  g_model_single_args[0] =
-      (FusedAddArgs){input, M0, (uint8_t *)const_workspace, workspace};
-  g_model_single_args[1] =
-      (FusedAddArgs){input, M1, (uint8_t *)const_workspace, workspace};
-  g_model_single_args[2] =
-      (FusedAddArgs){input, M2, (uint8_t *)const_workspace, workspace};
-  g_model_single_args[3] =
-      (FusedAddArgs){input, M3, (uint8_t *)const_workspace, workspace};
-
-  // Layer 2: M0+M1→M4, M2+M3→M5
-  g_model_dual_args[4] =
-      (FusedAdd3Args){M0, M1, M4, (uint8_t *)const_workspace, workspace};
-  g_model_dual_args[5] =
-      (FusedAdd3Args){M2, M3, M5, (uint8_t *)const_workspace, workspace};
-
-  // Layer 3: M4-2→M0, M5-4→M1
-  g_model_single_args[6] =
-      (FusedAddArgs){M4, M0, (uint8_t *)const_workspace, workspace};
-  g_model_single_args[7] =
-      (FusedAddArgs){M5, M1, (uint8_t *)const_workspace, workspace};
-
-  // Layer 4: M0+M1→M6
-  g_model_dual_args[8] =
-      (FusedAdd3Args){M0, M1, M6, (uint8_t *)const_workspace, workspace};
-
-  // Layer 5: M6+3→M2, M6+5→M3
-  g_model_single_args[9] =
-      (FusedAddArgs){M6, M2, (uint8_t *)const_workspace, workspace};
-  g_model_single_args[10] =
-      (FusedAddArgs){M6, M3, (uint8_t *)const_workspace, workspace};
-
-  // Layer 6: M2+M3→M7
-  g_model_dual_args[11] =
-      (FusedAdd3Args){M2, M3, M7, (uint8_t *)const_workspace, workspace};
-
-  // Layer 7: M7-2→M4, M6+1→M5
-  g_model_single_args[12] =
-      (FusedAddArgs){M7, M4, (uint8_t *)const_workspace, workspace};
-  g_model_single_args[13] =
-      (FusedAddArgs){M6, M5, (uint8_t *)const_workspace, workspace};
-
-  // Layer 8: M4+M5→M0, M0+M7→output
-  g_model_dual_args[14] =
-      (FusedAdd3Args){M4, M5, M0, (uint8_t *)const_workspace, workspace};
-  g_model_dual_args[15] =
-      (FusedAdd3Args){M0, M7, output, (uint8_t *)const_workspace, workspace};
-
-  return 0;
-}
-
-// ============================================================
-// 获取指定算子的参数指针
-// ============================================================
-
-void *model_get_op_args(int32_t op_id) {
-  if (op_id < 0 || op_id >= MODEL_NUM_OPS) {
-    return NULL;
-  }
-
-  // 根据算子类型返回对应参数
-  switch (op_id) {
-  // 单输入算子
-  case 0:
-  case 1:
-  case 2:
-  case 3: // Layer 1
-  case 6:
-  case 7: // Layer 3
-  case 9:
-  case 10: // Layer 5
-  case 12:
-  case 13: // Layer 7
-    return &g_model_single_args[op_id];
-
-  // 双输入算子
-  case 4:
-  case 5:  // Layer 2
-  case 8:  // Layer 4
-  case 11: // Layer 6
-  case 14:
-  case 15: // Layer 8
-    return &g_model_dual_args[op_id];
-
-  default:
-    return NULL;
-  }
-}
@@ -0,0 +1,54 @@
+/**
+ * @brief model_plan_run - 直线展开的执行函数 (由 tvmrt_plan_emit_c 生成, 请勿手改)
+ *
+ * 16 算子 / 9 层
+ */
+
+#include "tvmrt.h"
+
+extern int32_t wrapped_fused_add(void *args);
+extern int32_t wrapped_fused_add_1(void *args);
+extern int32_t wrapped_fused_add_2(void *args);
+extern int32_t wrapped_fused_add_3(void *args);
+extern int32_t wrapped_fused_subtract(void *args);
+extern int32_t wrapped_fused_subtract_1(void *args);
+
+int32_t model_plan_run(tvmrt_op_args_t *args) {
+  int32_t ret;
+
+  // Layer 1
+  if ((ret = wrapped_fused_add(&args[0])) != 0) return ret; // L1_add_0
+  if ((ret = wrapped_fused_add_1(&args[1])) != 0) return ret; // L1_add_1
+  if ((ret = wrapped_fused_add_2(&args[2])) != 0) return ret; // L1_add_2
+  if ((ret = wrapped_fused_add(&args[3])) != 0) return ret; // L1_add_3
+
+  // Layer 2
+  if ((ret = wrapped_fused_add_3(&args[4])) != 0) return ret; // L2_add3_0
+  if ((ret = wrapped_fused_add_3(&args[5])) != 0) return ret; // L2_add3_1
+
+  // Layer 3
+  if ((ret = wrapped_fused_subtract(&args[6])) != 0) return ret; // L3_sub_0
+  if ((ret = wrapped_fused_subtract_1(&args[7])) != 0) return ret; // L3_sub_1
+
+  // Layer 4
+  if ((ret = wrapped_fused_add_3(&args[8])) != 0) return ret; // L4_add3
+
+  // Layer 5
+  if ((ret = wrapped_fused_add_1(&args[9])) != 0) return ret; // L5_add1_0
+  if ((ret = wrapped_fused_add_2(&args[10])) != 0) return ret; // L5_add2_1
+
+  // Layer 6
+  if ((ret = wrapped_fused_add_3(&args[11])) != 0) return ret; // L6_add3
+
+  // Layer 7
+  if ((ret = wrapped_fused_subtract(&args[12])) != 0) return ret; // L7_sub_0
+  if ((ret = wrapped_fused_add(&args[13])) != 0) return ret; // L7_add_1
+
+  // Layer 8
+  if ((ret = wrapped_fused_add_3(&args[14])) != 0) return ret; // L8_add3_0
+
+  // Layer 9
+  if ((ret = wrapped_fused_add_3(&args[15])) != 0) return ret; // L8_add3_out
+
+  return 0;
+}
@@ -8,25 +8,13 @@
 
 #include "tvmrt.h"
 #include <math.h>
+#include <string.h>
 
 // ============================================================
-// 参数结构体 (模型特定)
+// 参数结构体
 // ============================================================
-
-typedef struct {
-    float* p0;
-    float* output;
-    uint8_t* const_ws;
-    uint8_t* ws;
-} FusedAddArgs;
-
-typedef struct {
-    float* p0;
-    float* p1;
-    float* output;
-    uint8_t* const_ws;
-    uint8_t* ws;
-} FusedAdd3Args;
+// 所有包装函数的 args 均为 tvmrt_op_args_t (见 tvmrt.h)，
+// 由 tvmrt_semantic_bind_args() 按算子描述统一填充。
 
 #ifdef __cplusplus
 extern "C"
@@ -103,50 +91,63 @@ int32_t tvmgen_default_fused_subtract_1(float* p0, float* T_subtract,
 // 实现零运行时开销。
 
 int32_t wrapped_fused_add(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("fused_add", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_fused_add(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("fused_add", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("fused_add", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_fused_add(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("fused_add", out);
     return ret;
 }
 
 int32_t wrapped_fused_add_1(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("fused_add_1", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_fused_add_1(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("fused_add_1", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("fused_add_1", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_fused_add_1(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("fused_add_1", out);
     return ret;
 }
 
 int32_t wrapped_fused_add_2(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("fused_add_2", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_fused_add_2(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("fused_add_2", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("fused_add_2", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_fused_add_2(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("fused_add_2", out);
     return ret;
 }
 
 int32_t wrapped_fused_add_3(void* args) {
-    FusedAdd3Args* a = (FusedAdd3Args*)args;
-    TVMRT_LOG_PARAMS("fused_add_3", a->p0 ? *(a->p0) : 0.0f, a->p1 ? *(a->p1) : 0.0f, a->output);
-    int32_t ret = tvmgen_default_fused_add_3(a->p0, a->p1, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("fused_add_3", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* p1 = (float*)a->inputs[1];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("fused_add_3", p0 ? *p0 : 0.0f, p1 ? *p1 : 0.0f, out);
+    int32_t ret = tvmgen_default_fused_add_3(p0, p1, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("fused_add_3", out);
     return ret;
 }
 
 int32_t wrapped_fused_subtract(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("fused_subtract", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_fused_subtract(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("fused_subtract", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("fused_subtract", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_fused_subtract(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("fused_subtract", out);
     return ret;
 }
 
 int32_t wrapped_fused_subtract_1(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("fused_subtract_1", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_fused_subtract_1(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("fused_subtract_1", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("fused_subtract_1", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_fused_subtract_1(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("fused_subtract_1", out);
     return ret;
 }
 
@@ -162,10 +163,12 @@ int32_t tvmgen_default_relu(float* p0, float* output, uint8_t* cws, uint8_t* ws)
 }
 
 int32_t wrapped_relu(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("relu", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_relu(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("relu", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("relu", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_relu(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("relu", out);
     return ret;
 }
 
@@ -177,10 +180,12 @@ int32_t tvmgen_default_sigmoid(float* p0, float* output, uint8_t* cws, uint8_t*
 }
 
 int32_t wrapped_sigmoid(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("sigmoid", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_sigmoid(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("sigmoid", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("sigmoid", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_sigmoid(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("sigmoid", out);
     return ret;
 }
 
@@ -192,10 +197,12 @@ int32_t tvmgen_default_tanh_op(float* p0, float* output, uint8_t* cws, uint8_t*
 }
 
 int32_t wrapped_tanh_op(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("tanh", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_tanh_op(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("tanh", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("tanh", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_tanh_op(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("tanh", out);
     return ret;
 }
 
@@ -208,10 +215,12 @@ int32_t tvmgen_default_relu6(float* p0, float* output, uint8_t* cws, uint8_t* ws
 }
 
 int32_t wrapped_relu6(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("relu6", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_relu6(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("relu6", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("relu6", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_relu6(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("relu6", out);
     return ret;
 }
 
@@ -227,10 +236,13 @@ int32_t tvmgen_default_multiply(float* p0, float* p1, float* output, uint8_t* cw
 }
 
 int32_t wrapped_multiply(void* args) {
-    FusedAdd3Args* a = (FusedAdd3Args*)args;
-    TVMRT_LOG_PARAMS("multiply", a->p0 ? *(a->p0) : 0.0f, a->p1 ? *(a->p1) : 0.0f, a->output);
-    int32_t ret = tvmgen_default_multiply(a->p0, a->p1, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("multiply", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* p1 = (float*)a->inputs[1];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("multiply", p0 ? *p0 : 0.0f, p1 ? *p1 : 0.0f, out);
+    int32_t ret = tvmgen_default_multiply(p0, p1, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("multiply", out);
     return ret;
 }
 
@@ -242,10 +254,13 @@ int32_t tvmgen_default_maximum(float* p0, float* p1, float* output, uint8_t* cws
 }
 
 int32_t wrapped_maximum(void* args) {
-    FusedAdd3Args* a = (FusedAdd3Args*)args;
-    TVMRT_LOG_PARAMS("maximum", a->p0 ? *(a->p0) : 0.0f, a->p1 ? *(a->p1) : 0.0f, a->output);
-    int32_t ret = tvmgen_default_maximum(a->p0, a->p1, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("maximum", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* p1 = (float*)a->inputs[1];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("maximum", p0 ? *p0 : 0.0f, p1 ? *p1 : 0.0f, out);
+    int32_t ret = tvmgen_default_maximum(p0, p1, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("maximum", out);
     return ret;
 }
 
@@ -257,10 +272,13 @@ int32_t tvmgen_default_minimum(float* p0, float* p1, float* output, uint8_t* cws
 }
 
 int32_t wrapped_minimum(void* args) {
-    FusedAdd3Args* a = (FusedAdd3Args*)args;
-    TVMRT_LOG_PARAMS("minimum", a->p0 ? *(a->p0) : 0.0f, a->p1 ? *(a->p1) : 0.0f, a->output);
-    int32_t ret = tvmgen_default_minimum(a->p0, a->p1, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("minimum", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* p1 = (float*)a->inputs[1];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("minimum", p0 ? *p0 : 0.0f, p1 ? *p1 : 0.0f, out);
+    int32_t ret = tvmgen_default_minimum(p0, p1, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("minimum", out);
     return ret;
 }
 
@@ -276,10 +294,12 @@ int32_t tvmgen_default_mul_2(float* p0, float* output, uint8_t* cws, uint8_t* ws
 }
 
 int32_t wrapped_mul_2(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("mul_2", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_mul_2(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("mul_2", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("mul_2", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_mul_2(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("mul_2", out);
     return ret;
 }
 
@@ -291,9 +311,1464 @@ int32_t tvmgen_default_mul_half(float* p0, float* output, uint8_t* cws, uint8_t*
 }
 
 int32_t wrapped_mul_half(void* args) {
-    FusedAddArgs* a = (FusedAddArgs*)args;
-    TVMRT_LOG_PARAMS("mul_half", a->p0 ? *(a->p0) : 0.0f, 0.0f, a->output);
-    int32_t ret = tvmgen_default_mul_half(a->p0, a->output, a->const_ws, a->ws);
-    TVMRT_LOG_RESULT("mul_half", a->output);
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    float* p0 = (float*)a->inputs[0];
+    float* out = (float*)a->outputs[0];
+    TVMRT_LOG_PARAMS("mul_half", p0 ? *p0 : 0.0f, 0.0f, out);
+    int32_t ret = tvmgen_default_mul_half(p0, out, a->const_ws, a->ws);
+    TVMRT_LOG_RESULT("mul_half", out);
     return ret;
 }
+
+// ============================================================
+// Phase 4: 矢量算子 (fp32 基准与 int8 量化版本)
+// ============================================================
+// 形状、偏置与权重位于算子常量区起始的 tvmrt_qattrs_t 属性块 (见
+// tvmrt.h)，算子描述以 TVMRT_SID_CONST 作为最后一个输入引用它，
+// 下列算子的 cws 参数即该属性块。int8 版本一律 int32 累加，结尾经
+// 定点乘数重量化到输出尺度并钳位到 [act_min, act_max]。
+
+// x * real (定点乘数 + 舍入右移)
+static inline int32_t q_requant(int32_t x, tvmrt_requant_t rq) {
+    int32_t s = 31 + rq.shift;
+    return (int32_t)(((int64_t)x * rq.multiplier + (1ll << (s - 1))) >> s);
+}
+
+static inline int8_t q_clamp(int32_t v, const tvmrt_qattrs_t* at) {
+    return (int8_t)(v < at->act_min ? at->act_min : (v > at->act_max ? at->act_max : v));
+}
+
+// fp32 矢量算子按属性块中的存储类型分块加载/写回 (fp16/bf16 存储时转换，
+// fp32 存储直接使用原缓冲区)
+#define F32_CHUNK 256
+
+static inline const float* f32_load(const void* p, tvmrt_dtype_t dt, int32_t i, int32_t n,
+                                    float* buf) {
+    if (dt == TVMRT_DTYPE_FLOAT32) return (const float*)p + i;
+    tvmrt_convert_to_f32((const uint16_t*)p + i, dt, buf, n);
+    return buf;
+}
+
+static inline float* f32_dst(void* p, tvmrt_dtype_t dt, int32_t i, float* buf) {
+    return (dt == TVMRT_DTYPE_FLOAT32) ? (float*)p + i : buf;
+}
+
+static inline void f32_store(void* p, tvmrt_dtype_t dt, int32_t i, int32_t n, const float* buf) {
+    if (dt != TVMRT_DTYPE_FLOAT32) tvmrt_convert_from_f32(buf, (uint16_t*)p + i, dt, n);
+}
+
+// MatMul fp32: [M,K] x [K,N] (+ bias) -> [M,N]
+// 按 rows 行 × cols 列分块: 半精度权重的每个行片段只转换一次。默认 8 × 64，
+// 其余分块与指令集版本供自动调优选择 (分块版本累加次序相同; 满列分块的内层
+// 循环次数为常量，便于矢量化)
+#define MATMUL_ROWS 8
+#define MATMUL_COLS 64
+#define MATMUL_MAX_ROWS 16
+#define MATMUL_MAX_COLS 128
+
+// 全 fp32 存储时按 MATMUL_MR 行 × MATMUL_NR 列的微块计算: 权重按 MATMUL_KC ×
+// MATMUL_NR 打包成连续片段 (避免行跨步造成的缓存组冲突)，累加器在片段内留在
+// 寄存器中。部分和经输出回读，每个元素仍从偏置起按 t 递增累加，与通用路径逐位
+// 一致; 行列分块参数只影响半精度等需要转换的路径
+#define MATMUL_MR 4
+#define MATMUL_NR 8
+#define MATMUL_KC 256
+#define MATMUL_VEC 4
+
+// 微块的一行由两个 4 路矢量组成 (16 字节，各指令集都有原生寄存器，不会溢出到栈)
+typedef float matmul_vec_t __attribute__((vector_size(MATMUL_VEC * 4)));
+
+typedef struct {
+    matmul_vec_t lo, hi;
+} matmul_row_t;
+
+static inline __attribute__((always_inline)) matmul_row_t matmul_row_load(const float* p,
+                                                                          int32_t nr) {
+    float buf[MATMUL_NR] = {0};
+    memcpy(buf, p, (size_t)nr * 4);
+    matmul_row_t v;
+    memcpy(&v.lo, buf, sizeof(v.lo));
+    memcpy(&v.hi, buf + MATMUL_VEC, sizeof(v.hi));
+    return v;
+}
+
+static inline __attribute__((always_inline)) void matmul_row_store(float* p, matmul_row_t v,
+                                                                   int32_t nr) {
+    float buf[MATMUL_NR];
+    memcpy(buf, &v.lo, sizeof(v.lo));
+    memcpy(buf + MATMUL_VEC, &v.hi, sizeof(v.hi));
+    memcpy(p, buf, (size_t)nr * 4);
+}
+
+static inline __attribute__((always_inline)) void matmul_row_fma(matmul_row_t* acc, float a,
+                                                                 matmul_vec_t wlo,
+                                                                 matmul_vec_t whi) {
+    acc->lo += a * wlo;
+    acc->hi += a * whi;
+}
+
+// 一个 mr × nr 微块在规约片段 [t0, t0 + kc) 上的累加; pk 为打包后的权重片段，
+// first 时从偏置 (或 0) 起累加，否则从输出中的部分和继续
+static inline __attribute__((always_inline)) void matmul_f32_micro(
+    const float* a, const float* pk, const float* b, float* o, int32_t k, int32_t n, int32_t kc,
+    int32_t mr, int32_t nr, bool first) {
+    matmul_row_t init = {{0}, {0}};
+    if (first && b) init = matmul_row_load(b, nr);
+    if (mr == MATMUL_MR) {
+        matmul_row_t acc0 = first ? init : matmul_row_load(o, nr);
+        matmul_row_t acc1 = first ? init : matmul_row_load(o + n, nr);
+        matmul_row_t acc2 = first ? init : matmul_row_load(o + 2 * (int64_t)n, nr);
+        matmul_row_t acc3 = first ? init : matmul_row_load(o + 3 * (int64_t)n, nr);
+        const float *a0 = a, *a1 = a + k, *a2 = a + 2 * (int64_t)k, *a3 = a + 3 * (int64_t)k;
+        for (int32_t t = 0; t < kc; t++) {
+            matmul_vec_t wlo, whi;
+            memcpy(&wlo, pk + (int64_t)t * MATMUL_NR, sizeof(wlo));
+            memcpy(&whi, pk + (int64_t)t * MATMUL_NR + MATMUL_VEC, sizeof(whi));
+            matmul_row_fma(&acc0, a0[t], wlo, whi);
+            matmul_row_fma(&acc1, a1[t], wlo, whi);
+            matmul_row_fma(&acc2, a2[t], wlo, whi);
+            matmul_row_fma(&acc3, a3[t], wlo, whi);
+        }
+        matmul_row_store(o, acc0, nr);
+        matmul_row_store(o + n, acc1, nr);
+        matmul_row_store(o + 2 * (int64_t)n, acc2, nr);
+        matmul_row_store(o + 3 * (int64_t)n, acc3, nr);
+        return;
+    }
+    for (int32_t r = 0; r < mr; r++) {
+        const float* ar = a + (int64_t)r * k;
+        float* or = o + (int64_t)r * n;
+        matmul_row_t acc = first ? init : matmul_row_load(or, nr);
+        for (int32_t t = 0; t < kc; t++) {
+            matmul_vec_t wlo, whi;
+            memcpy(&wlo, pk + (int64_t)t * MATMUL_NR, sizeof(wlo));
+            memcpy(&whi, pk + (int64_t)t * MATMUL_NR + MATMUL_VEC, sizeof(whi));
+            matmul_row_fma(&acc, ar[t], wlo, whi);
+        }
+        matmul_row_store(or, acc, nr);
+    }
+}
+
+static inline __attribute__((always_inline)) void matmul_f32_direct(
+    const float* x, const float* w, const float* bias, float* y, int32_t m, int32_t n, int32_t k) {
+    float pk[MATMUL_KC * MATMUL_NR];
+    for (int32_t j = 0; j < n; j += MATMUL_NR) {
+        int32_t nr = (n - j < MATMUL_NR) ? n - j : MATMUL_NR;
+        if (k == 0) {
+            for (int32_t i = 0; i < m; i++)
+                for (int32_t c = 0; c < nr; c++) y[(int64_t)i * n + j + c] = bias ? bias[j + c] : 0.0f;
+            continue;
+        }
+        for (int32_t t0 = 0; t0 < k; t0 += MATMUL_KC) {
+            int32_t kc = (k - t0 < MATMUL_KC) ? k - t0 : MATMUL_KC;
+            for (int32_t t = 0; t < kc; t++) {
+                memcpy(pk + (int64_t)t * MATMUL_NR, w + (int64_t)(t0 + t) * n + j, (size_t)nr * 4);
+                for (int32_t c = nr; c < MATMUL_NR; c++) pk[(int64_t)t * MATMUL_NR + c] = 0.0f;
+            }
+            for (int32_t i = 0; i < m; i += MATMUL_MR) {
+                int32_t mr = (m - i < MATMUL_MR) ? m - i : MATMUL_MR;
+                matmul_f32_micro(x + (int64_t)i * k + t0, pk, bias ? bias + j : NULL,
+                                 y + (int64_t)i * n + j, k, n, kc, mr, nr, t0 == 0);
+            }
+        }
+    }
+}
+
+static inline __attribute__((always_inline)) int32_t matmul_f32_tiled(
+    float* p0, float* output, uint8_t* cws, int32_t rows, int32_t cols) {
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    const void* w = cws + at->weight_offset;
+    const void* bias = at->bias_offset ? cws + at->bias_offset : NULL;
+    tvmrt_dtype_t wdt = at->weight_dtype, adt = at->in_dtype[0], odt = at->out_dtype;
+    int32_t m = at->count, n = at->n, k = at->k;
+    if (wdt == TVMRT_DTYPE_FLOAT32 && adt == TVMRT_DTYPE_FLOAT32 && odt == TVMRT_DTYPE_FLOAT32) {
+        matmul_f32_direct(p0, (const float*)w, (const float*)bias, output, m, n, k);
+        return 0;
+    }
+    float acc[MATMUL_MAX_ROWS][MATMUL_MAX_COLS], wbuf[MATMUL_MAX_COLS], bbuf[MATMUL_MAX_COLS];
+    for (int32_t j0 = 0; j0 < n; j0 += cols) {
+        int32_t nb = (n - j0 < cols) ? n - j0 : cols;
+        const float* b = bias ? f32_load(bias, wdt, j0, nb, bbuf) : NULL;
+        for (int32_t i0 = 0; i0 < m; i0 += rows) {
+            int32_t mr = (m - i0 < rows) ? m - i0 : rows;
+            for (int32_t r = 0; r < mr; r++) {
+                for (int32_t j = 0; j < nb; j++) acc[r][j] = b ? b[j] : 0.0f;
+            }
+            for (int32_t t = 0; t < k; t++) {
+                const float* wr = f32_load(w, wdt, t * n + j0, nb, wbuf);
+                for (int32_t r = 0; r < mr; r++) {
+                    float abuf;
+                    float a = *f32_load(p0, adt, (i0 + r) * k + t, 1, &abuf);
+                    if (nb == cols) {
+                        for (int32_t j = 0; j < cols; j++) acc[r][j] += a * wr[j];
+                    } else {
+                        for (int32_t j = 0; j < nb; j++) acc[r][j] += a * wr[j];
+                    }
+                }
+            }
+            for (int32_t r = 0; r < mr; r++) {
+                tvmrt_convert_from_f32(acc[r], (uint8_t*)output + (size_t)((i0 + r) * n + j0) *
+                                                                   tvmrt_dtype_size(odt),
+                                       odt, nb);
+            }
+        }
+    }
+    return 0;
+}
+
+int32_t tvmgen_default_matmul_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    return matmul_f32_tiled(p0, output, cws, MATMUL_ROWS, MATMUL_COLS);
+}
+
+int32_t tvmgen_default_matmul_f32_r4c32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    return matmul_f32_tiled(p0, output, cws, 4, 32);
+}
+
+int32_t tvmgen_default_matmul_f32_r8c128(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    return matmul_f32_tiled(p0, output, cws, 8, 128);
+}
+
+int32_t tvmgen_default_matmul_f32_r16c32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    return matmul_f32_tiled(p0, output, cws, 16, 32);
+}
+
+// 指令集版本: 同一分块按 AVX2+FMA / AVX-512 编译 (乘加融合，与标量版本相差在舍入误差内)
+__attribute__((target("avx2,fma")))
+int32_t tvmgen_default_matmul_f32_avx2(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    return matmul_f32_tiled(p0, output, cws, MATMUL_ROWS, MATMUL_COLS);
+}
+
+__attribute__((target("avx512f")))
+int32_t tvmgen_default_matmul_f32_avx512(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    return matmul_f32_tiled(p0, output, cws, MATMUL_ROWS, MATMUL_COLS);
+}
+
+int32_t tvmgen_default_add_f32(float* p0, float* p1, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    float abuf[F32_CHUNK], bbuf[F32_CHUNK], obuf[F32_CHUNK];
+    for (int32_t i0 = 0; i0 < at->count; i0 += F32_CHUNK) {
+        int32_t nb = (at->count - i0 < F32_CHUNK) ? at->count - i0 : F32_CHUNK;
+        const float* a = f32_load(p0, at->in_dtype[0], i0, nb, abuf);
+        const float* b = f32_load(p1, at->in_dtype[1], i0, nb, bbuf);
+        float* o = f32_dst(output, at->out_dtype, i0, obuf);
+        for (int32_t i = 0; i < nb; i++) o[i] = a[i] + b[i];
+        f32_store(output, at->out_dtype, i0, nb, o);
+    }
+    return 0;
+}
+
+int32_t tvmgen_default_relu_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    float abuf[F32_CHUNK], obuf[F32_CHUNK];
+    for (int32_t i0 = 0; i0 < at->count; i0 += F32_CHUNK) {
+        int32_t nb = (at->count - i0 < F32_CHUNK) ? at->count - i0 : F32_CHUNK;
+        const float* a = f32_load(p0, at->in_dtype[0], i0, nb, abuf);
+        float* o = f32_dst(output, at->out_dtype, i0, obuf);
+        for (int32_t i = 0; i < nb; i++) o[i] = a[i] > 0.0f ? a[i] : 0.0f;
+        f32_store(output, at->out_dtype, i0, nb, o);
+    }
+    return 0;
+}
+
+int32_t tvmgen_default_sigmoid_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    float abuf[F32_CHUNK], obuf[F32_CHUNK];
+    for (int32_t i0 = 0; i0 < at->count; i0 += F32_CHUNK) {
+        int32_t nb = (at->count - i0 < F32_CHUNK) ? at->count - i0 : F32_CHUNK;
+        const float* a = f32_load(p0, at->in_dtype[0], i0, nb, abuf);
+        float* o = f32_dst(output, at->out_dtype, i0, obuf);
+        for (int32_t i = 0; i < nb; i++) o[i] = 1.0f / (1.0f + expf(-a[i]));
+        f32_store(output, at->out_dtype, i0, nb, o);
+    }
+    return 0;
+}
+
+// Quantize: round(x / scale) + zp
+int32_t tvmgen_default_quantize_s8(float* p0, int8_t* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    float inv = 1.0f / at->scale;
+    for (int32_t i = 0; i < at->count; i++) {
+        output[i] = q_clamp((int32_t)lrintf(p0[i] * inv) + at->out_zp, at);
+    }
+    return 0;
+}
+
+// Dequantize: scale * (q - zp)
+int32_t tvmgen_default_dequantize_s8(int8_t* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    for (int32_t i = 0; i < at->count; i++) {
+        output[i] = at->scale * (float)(p0[i] - at->in_zp[0]);
+    }
+    return 0;
+}
+
+// QAdd: 两输入左移后对齐到公共尺度相加，再重量化到输出
+int32_t tvmgen_default_qadd_s8(int8_t* p0, int8_t* p1, int8_t* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    for (int32_t i = 0; i < at->count; i++) {
+        int32_t a = q_requant((p0[i] - at->in_zp[0]) * (1 << TVMRT_QUANT_LEFT_SHIFT), at->in_rq[0]);
+        int32_t b = q_requant((p1[i] - at->in_zp[1]) * (1 << TVMRT_QUANT_LEFT_SHIFT), at->in_rq[1]);
+        output[i] = q_clamp(q_requant(a + b, at->out_rq) + at->out_zp, at);
+    }
+    return 0;
+}
+
+// QMul: (a - za)(b - zb) 经 s_a * s_b / s_out 重量化
+int32_t tvmgen_default_qmul_s8(int8_t* p0, int8_t* p1, int8_t* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    for (int32_t i = 0; i < at->count; i++) {
+        int32_t acc = (p0[i] - at->in_zp[0]) * (p1[i] - at->in_zp[1]);
+        output[i] = q_clamp(q_requant(acc, at->out_rq) + at->out_zp, at);
+    }
+    return 0;
+}
+
+// QReLU / QReLU6: 重量化到输出尺度后钳位 (下界为输出零点)
+int32_t tvmgen_default_qrelu_s8(int8_t* p0, int8_t* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    for (int32_t i = 0; i < at->count; i++) {
+        int32_t v = q_requant((p0[i] - at->in_zp[0]) * (1 << TVMRT_QUANT_LEFT_SHIFT), at->out_rq);
+        output[i] = q_clamp(v + at->out_zp, at);
+    }
+    return 0;
+}
+
+// QSigmoid / QTanh: 256 项查找表 (prepare 阶段按输入输出量化参数生成)
+int32_t tvmgen_default_qlut_s8(int8_t* p0, int8_t* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    const int8_t* lut = (const int8_t*)(cws + at->weight_offset);
+    for (int32_t i = 0; i < at->count; i++) output[i] = lut[p0[i] + 128];
+    return 0;
+}
+
+// QMatMul: int32 累加 (a - za)(w - zw) + bias，按列块重量化写出。
+// 权重零点项提出为 zw * Σ(a - za)，内层只剩 int8 x int32 乘加
+#define QMATMUL_BLOCK 64
+
+static void qmatmul_block(const int8_t* a, const int8_t* w, int32_t n, int32_t k, int32_t za,
+                          int32_t* acc, int32_t nb) {
+    for (int32_t t = 0; t < k; t++) {
+        int32_t av = a[t] - za;
+        const int8_t* wr = &w[t * n];
+        if (nb == QMATMUL_BLOCK) {
+            for (int32_t j = 0; j < QMATMUL_BLOCK; j++) acc[j] += av * wr[j];
+        } else {
+            for (int32_t j = 0; j < nb; j++) acc[j] += av * wr[j];
+        }
+    }
+}
+
+int32_t tvmgen_default_qmatmul_s8(int8_t* p0, int8_t* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)cws;
+    const int8_t* w = (const int8_t*)(cws + at->weight_offset);
+    const int32_t* bias = at->bias_offset ? (const int32_t*)(cws + at->bias_offset) : NULL;
+    int32_t m = at->count, n = at->n, k = at->k;
+    int32_t acc[QMATMUL_BLOCK];
+    for (int32_t i = 0; i < m; i++) {
+        const int8_t* a = &p0[i * k];
+        int32_t a_sum = 0;
+        for (int32_t t = 0; t < k; t++) a_sum += a[t] - at->in_zp[0];
+        int32_t zw_term = at->weight_zp * a_sum;
+        for (int32_t j0 = 0; j0 < n; j0 += QMATMUL_BLOCK) {
+            int32_t nb = (n - j0 < QMATMUL_BLOCK) ? n - j0 : QMATMUL_BLOCK;
+            for (int32_t j = 0; j < nb; j++) acc[j] = (bias ? bias[j0 + j] : 0) - zw_term;
+            qmatmul_block(a, &w[j0], n, k, at->in_zp[0], acc, nb);
+            for (int32_t j = 0; j < nb; j++) {
+                output[i * n + j0 + j] = q_clamp(q_requant(acc[j], at->out_rq) + at->out_zp, at);
+            }
+        }
+    }
+    return 0;
+}
+
+// 包装函数: 属性块为最后一个输入 (TVMRT_SID_CONST)
+
+int32_t wrapped_matmul_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_matmul_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                     (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_matmul_f32_r4c32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_matmul_f32_r4c32((float*)a->inputs[0], (float*)a->outputs[0],
+                                           (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_matmul_f32_r8c128(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_matmul_f32_r8c128((float*)a->inputs[0], (float*)a->outputs[0],
+                                            (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_matmul_f32_r16c32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_matmul_f32_r16c32((float*)a->inputs[0], (float*)a->outputs[0],
+                                            (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_matmul_f32_avx2(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_matmul_f32_avx2((float*)a->inputs[0], (float*)a->outputs[0],
+                                          (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_matmul_f32_avx512(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_matmul_f32_avx512((float*)a->inputs[0], (float*)a->outputs[0],
+                                            (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_add_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_add_f32((float*)a->inputs[0], (float*)a->inputs[1], (float*)a->outputs[0],
+                                  (uint8_t*)a->inputs[2], a->ws);
+}
+
+int32_t wrapped_relu_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_relu_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                   (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_sigmoid_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_sigmoid_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                      (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_quantize_s8(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_quantize_s8((float*)a->inputs[0], (int8_t*)a->outputs[0],
+                                      (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_dequantize_s8(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_dequantize_s8((int8_t*)a->inputs[0], (float*)a->outputs[0],
+                                        (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_qadd_s8(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_qadd_s8((int8_t*)a->inputs[0], (int8_t*)a->inputs[1],
+                                  (int8_t*)a->outputs[0], (uint8_t*)a->inputs[2], a->ws);
+}
+
+int32_t wrapped_qmul_s8(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_qmul_s8((int8_t*)a->inputs[0], (int8_t*)a->inputs[1],
+                                  (int8_t*)a->outputs[0], (uint8_t*)a->inputs[2], a->ws);
+}
+
+int32_t wrapped_qrelu_s8(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_qrelu_s8((int8_t*)a->inputs[0], (int8_t*)a->outputs[0],
+                                   (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_qlut_s8(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_qlut_s8((int8_t*)a->inputs[0], (int8_t*)a->outputs[0],
+                                  (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_qmatmul_s8(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_qmatmul_s8((int8_t*)a->inputs[0], (int8_t*)a->outputs[0],
+                                     (uint8_t*)a->inputs[1], a->ws);
+}
+
+// ============================================================
+// Phase 5: 广播二元运算 (fp32)
+// ============================================================
+//
+// 属性块 (tvmrt_bcast_attrs_t) 由 tvmrt_broadcast_prepare 生成。外层维按
+// 多维下标递推偏移，最内维按步长选择连续 / 标量广播 / 通用步长循环;
+// 前两种以 BIN_LANES 宽的矢量处理 (GCC 矢量扩展，按编译目标映射到
+// SSE / AVX2 / AVX-512)，尾部与通用步长逐元素处理。各版本结果逐位一致。
+
+#define BIN_LANES 16
+
+typedef float bin_vec_t __attribute__((vector_size(BIN_LANES * 4)));
+typedef int32_t bin_mask_t __attribute__((vector_size(BIN_LANES * 4)));
+
+#define BIN_INLINE static inline __attribute__((always_inline))
+
+BIN_INLINE float bin_apply(int32_t kind, float x, float y) {
+    switch (kind) {
+    case TVMRT_BINARY_ADD: return x + y;
+    case TVMRT_BINARY_SUB: return x - y;
+    case TVMRT_BINARY_MUL: return x * y;
+    case TVMRT_BINARY_DIV: return x / y;
+    case TVMRT_BINARY_MAX: return x > y ? x : y;
+    default: return x < y ? x : y;
+    }
+}
+
+// 一个矢量: a_bcast / b_bcast 非 NULL 时代替对应输入 (标量广播)。矢量按指针
+// 传递 (宽于 SSE 的矢量按值传递会随编译目标改变调用约定)
+BIN_INLINE void bin_apply_vec(int32_t kind, const float* a, const bin_vec_t* a_bcast,
+                              const float* b, const bin_vec_t* b_bcast, float* o) {
+    bin_vec_t x, y, r;
+    bin_mask_t m;
+    if (a_bcast) {
+        x = *a_bcast;
+    } else {
+        memcpy(&x, a, sizeof(x));
+    }
+    if (b_bcast) {
+        y = *b_bcast;
+    } else {
+        memcpy(&y, b, sizeof(y));
+    }
+    switch (kind) {
+    case TVMRT_BINARY_ADD: r = x + y; break;
+    case TVMRT_BINARY_SUB: r = x - y; break;
+    case TVMRT_BINARY_MUL: r = x * y; break;
+    case TVMRT_BINARY_DIV: r = x / y; break;
+    case TVMRT_BINARY_MAX:
+        m = x > y;
+        r = (bin_vec_t)((m & (bin_mask_t)x) | (~m & (bin_mask_t)y));
+        break;
+    default:
+        m = x < y;
+        r = (bin_vec_t)((m & (bin_mask_t)x) | (~m & (bin_mask_t)y));
+        break;
+    }
+    memcpy(o, &r, sizeof(r));
+}
+
+// 最内维一行 n 个元素 (kind 为常量时各分支展开为专用循环)
+BIN_INLINE void bin_row(int32_t kind, const float* a, int32_t sa, const float* b, int32_t sb,
+                        float* o, int32_t so, int32_t n) {
+    int32_t i = 0;
+    if (so == 1 && sa == 1 && sb == 1) {
+        for (; i + BIN_LANES <= n; i += BIN_LANES) {
+            bin_apply_vec(kind, a + i, NULL, b + i, NULL, o + i);
+        }
+    } else if (so == 1 && sa == 1 && sb == 0) {
+        bin_vec_t y = b[0] - (bin_vec_t){0};
+        for (; i + BIN_LANES <= n; i += BIN_LANES) {
+            bin_apply_vec(kind, a + i, NULL, NULL, &y, o + i);
+        }
+    } else if (so == 1 && sa == 0 && sb == 1) {
+        bin_vec_t x = a[0] - (bin_vec_t){0};
+        for (; i + BIN_LANES <= n; i += BIN_LANES) {
+            bin_apply_vec(kind, NULL, &x, b + i, NULL, o + i);
+        }
+    }
+    for (; i < n; i++) {
+        o[(int64_t)i * so] = bin_apply(kind, a[(int64_t)i * sa], b[(int64_t)i * sb]);
+    }
+}
+
+BIN_INLINE void bin_run(int32_t kind, const tvmrt_bcast_attrs_t* at, const float* a,
+                        const float* b, float* o) {
+    int32_t r = at->rank - 1;
+    int32_t idx[TVMRT_BCAST_MAX_DIMS] = {0};
+    int64_t rows = 1, oa = 0, ob = 0, oo = 0;
+    for (int32_t d = 0; d < r; d++) rows *= at->shape[d];
+    for (int64_t row = 0; row < rows && at->shape[r] > 0; row++) {
+        bin_row(kind, a + oa, at->a_strides[r], b + ob, at->b_strides[r], o + oo,
+                at->out_strides[r], at->shape[r]);
+        for (int32_t d = r - 1; d >= 0; d--) {
+            oa += at->a_strides[d];
+            ob += at->b_strides[d];
+            oo += at->out_strides[d];
+            if (++idx[d] < at->shape[d]) break;
+            oa -= (int64_t)at->a_strides[d] * at->shape[d];
+            ob -= (int64_t)at->b_strides[d] * at->shape[d];
+            oo -= (int64_t)at->out_strides[d] * at->shape[d];
+            idx[d] = 0;
+        }
+    }
+}
+
+BIN_INLINE int32_t binary_f32(float* p0, float* p1, float* output, uint8_t* cws) {
+    const tvmrt_bcast_attrs_t* at = (const tvmrt_bcast_attrs_t*)cws;
+    switch (at->kind) {
+    case TVMRT_BINARY_ADD: bin_run(TVMRT_BINARY_ADD, at, p0, p1, output); return 0;
+    case TVMRT_BINARY_SUB: bin_run(TVMRT_BINARY_SUB, at, p0, p1, output); return 0;
+    case TVMRT_BINARY_MUL: bin_run(TVMRT_BINARY_MUL, at, p0, p1, output); return 0;
+    case TVMRT_BINARY_DIV: bin_run(TVMRT_BINARY_DIV, at, p0, p1, output); return 0;
+    case TVMRT_BINARY_MAX: bin_run(TVMRT_BINARY_MAX, at, p0, p1, output); return 0;
+    case TVMRT_BINARY_MIN: bin_run(TVMRT_BINARY_MIN, at, p0, p1, output); return 0;
+    default: return -1;
+    }
+}
+
+int32_t tvmgen_default_binary_f32(float* p0, float* p1, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    return binary_f32(p0, p1, output, cws);
+}
+
+__attribute__((target("avx2")))
+int32_t tvmgen_default_binary_f32_avx2(float* p0, float* p1, float* output, uint8_t* cws,
+                                       uint8_t* ws) {
+    (void)ws;
+    return binary_f32(p0, p1, output, cws);
+}
+
+__attribute__((target("avx512f")))
+int32_t tvmgen_default_binary_f32_avx512(float* p0, float* p1, float* output, uint8_t* cws,
+                                         uint8_t* ws) {
+    (void)ws;
+    return binary_f32(p0, p1, output, cws);
+}
+
+int32_t wrapped_binary_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_binary_f32((float*)a->inputs[0], (float*)a->inputs[1],
+                                     (float*)a->outputs[0], (uint8_t*)a->inputs[2], a->ws);
+}
+
+int32_t wrapped_binary_f32_avx2(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_binary_f32_avx2((float*)a->inputs[0], (float*)a->inputs[1],
+                                          (float*)a->outputs[0], (uint8_t*)a->inputs[2], a->ws);
+}
+
+int32_t wrapped_binary_f32_avx512(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_binary_f32_avx512((float*)a->inputs[0], (float*)a->inputs[1],
+                                            (float*)a->outputs[0], (uint8_t*)a->inputs[2], a->ws);
+}
+
+// ============================================================
+// Phase 6: 归约 (fp32 Sum / Max / Min / ArgMax)
+// ============================================================
+//
+// 属性块 (tvmrt_reduce_attrs_t) 由 tvmrt_reduce_prepare 生成。每次处理
+// RED_CHUNK 个输出: 逐块计算块值并压入按层级排列的进位栈 (同层两棵子树
+// 立即合并)，最后自低层向高层合并剩余子树，即各块按固定二叉树合并;
+// 部分算子只处理自己的块组，合并算子把各部分值按同一方式压栈。
+// 块内: 最内归约维连续时每个输出 RED_LANES 路分道累加再两两合并，否则
+// 逐个被归约元素更新整段输出 (保留维连续时为连续访问)。
+// 进位栈共 RED_STACK 个值，每层宽度为本段输出数: 块数不超过 2^8 - 1 时
+// 一段为 RED_CHUNK 个输出，块数更多时按所需层数缩小每段的输出数
+// (不改变每个输出的合并次序)。
+
+#define RED_CHUNK 256
+#define RED_LANES 16
+#define RED_STACK (8 * RED_CHUNK)
+
+#define RED_INLINE static inline __attribute__((always_inline))
+
+// 一段输出的值 (ArgMax 同时记录下标，-1 = 尚无元素)
+typedef struct {
+    float v[RED_CHUNK];
+    int32_t i[RED_CHUNK];
+} red_vals_t;
+
+// 进位栈: 第 l 层为 2^l 块的子树值，位于 v/i[l * width ...]
+typedef struct {
+    float v[RED_STACK];
+    int32_t i[RED_STACK];
+    uint32_t full;
+    int32_t width;
+} red_stack_t;
+
+// blocks 个块 (或部分) 压栈所需层数下每段可处理的输出数
+RED_INLINE int32_t red_chunk(int32_t blocks) {
+    int32_t levels = 32 - __builtin_clz((uint32_t)(blocks > 1 ? blocks : 1));
+    int32_t width = RED_STACK / levels;
+    return (width < RED_CHUNK) ? width : RED_CHUNK;
+}
+
+RED_INLINE float red_identity(int32_t kind) {
+    return (kind == TVMRT_REDUCE_SUM) ? 0.0f : (kind == TVMRT_REDUCE_MIN) ? INFINITY : -INFINITY;
+}
+
+// 把 (bv, bi) 并入 (av, ai)
+RED_INLINE void red_merge(int32_t kind, float* av, int32_t* ai, float bv, int32_t bi) {
+    switch (kind) {
+    case TVMRT_REDUCE_SUM: *av += bv; break;
+    case TVMRT_REDUCE_MAX: *av = bv > *av ? bv : *av; break;
+    case TVMRT_REDUCE_MIN: *av = bv < *av ? bv : *av; break;
+    default:
+        if (bi >= 0 && (*ai < 0 || bv > *av || (bv == *av && bi < *ai))) {
+            *av = bv;
+            *ai = bi;
+        }
+        break;
+    }
+}
+
+// 按展平下标递增的次序并入一个元素 (ArgMax 仅在严格更大时更新，即取首次出现)
+RED_INLINE void red_update(int32_t kind, float* av, int32_t* ai, float x, int32_t idx) {
+    if (kind == TVMRT_REDUCE_ARGMAX) {
+        bool take = x > *av || *ai < 0;
+        *av = take ? x : *av;
+        *ai = take ? idx : *ai;
+    } else {
+        red_merge(kind, av, ai, x, idx);
+    }
+}
+
+// 行主序展平下标 -> 元素偏移
+RED_INLINE int64_t red_offset(int32_t rank, const int32_t* shape, const int32_t* strides,
+                              int32_t flat) {
+    int64_t off = 0;
+    for (int32_t d = rank - 1; d >= 0; d--) {
+        off += (int64_t)(flat % shape[d]) * strides[d];
+        flat /= shape[d];
+    }
+    return off;
+}
+
+// 单个输出在展平归约下标 [r0, r1) 上的块值 (最内归约维连续)
+RED_INLINE void red_block_row(int32_t kind, const tvmrt_reduce_attrs_t* at, const float* x,
+                              int32_t r0, int32_t r1, float* out_v, int32_t* out_i) {
+    float lv[RED_LANES];
+    int32_t li[RED_LANES];
+    for (int32_t l = 0; l < RED_LANES; l++) {
+        lv[l] = red_identity(kind);
+        li[l] = -1;
+    }
+    int32_t inner = at->red_shape[at->red_rank - 1];
+    for (int32_t r = r0; r < r1;) {
+        int32_t run = inner - r % inner;
+        run = (run < r1 - r) ? run : r1 - r;
+        const float* p = x + red_offset(at->red_rank, at->red_shape, at->red_strides, r);
+        int32_t k = 0;
+        for (; k + RED_LANES <= run; k += RED_LANES) {
+            for (int32_t l = 0; l < RED_LANES; l++) red_update(kind, &lv[l], &li[l], p[k + l], r + k + l);
+        }
+        for (; k < run; k++) red_update(kind, &lv[k % RED_LANES], &li[k % RED_LANES], p[k], r + k);
+        r += run;
+    }
+    for (int32_t w = RED_LANES / 2; w >= 1; w /= 2) {
+        for (int32_t l = 0; l < w; l++) red_merge(kind, &lv[l], &li[l], lv[l + w], li[l + w]);
+    }
+    *out_v = lv[0];
+    *out_i = li[0];
+}
+
+// 一段输出在展平归约下标 [r0, r1) 上的块值 (逐个被归约元素更新整段输出)
+RED_INLINE void red_block_cols(int32_t kind, const tvmrt_reduce_attrs_t* at, const float* x,
+                               const int64_t* out_off, int32_t oc, bool contiguous, int32_t r0,
+                               int32_t r1, red_vals_t* b) {
+    for (int32_t j = 0; j < oc; j++) {
+        b->v[j] = red_identity(kind);
+        b->i[j] = -1;
+    }
+    for (int32_t r = r0; r < r1; r++) {
+        const float* p = x + red_offset(at->red_rank, at->red_shape, at->red_strides, r);
+        if (contiguous && oc == RED_CHUNK) {
+            p += out_off[0];
+            for (int32_t j = 0; j < RED_CHUNK; j++) red_update(kind, &b->v[j], &b->i[j], p[j], r);
+        } else if (contiguous) {
+            p += out_off[0];
+            for (int32_t j = 0; j < oc; j++) red_update(kind, &b->v[j], &b->i[j], p[j], r);
+        } else {
+            for (int32_t j = 0; j < oc; j++) red_update(kind, &b->v[j], &b->i[j], p[out_off[j]], r);
+        }
+    }
+}
+
+// 压入一个块 (组) 值: 同层已有子树时合并后进位
+RED_INLINE void red_push(int32_t kind, red_stack_t* st, red_vals_t* b, int32_t oc) {
+    int32_t l = 0;
+    for (; st->full & (1u << l); l++) {
+        const float* av = st->v + l * st->width;
+        const int32_t* ai = st->i + l * st->width;
+        for (int32_t j = 0; j < oc; j++) red_merge(kind, &b->v[j], &b->i[j], av[j], ai[j]);
+        st->full &= ~(1u << l);
+    }
+    memcpy(st->v + l * st->width, b->v, (size_t)oc * sizeof(float));
+    memcpy(st->i + l * st->width, b->i, (size_t)oc * sizeof(int32_t));
+    st->full |= 1u << l;
+}
+
+RED_INLINE void red_fold(int32_t kind, const red_stack_t* st, red_vals_t* out, int32_t oc) {
+    bool have = false;
+    for (int32_t l = 0; l < 32; l++) {
+        if (!(st->full & (1u << l))) continue;
+        const float* av = st->v + l * st->width;
+        const int32_t* ai = st->i + l * st->width;
+        for (int32_t j = 0; j < oc; j++) {
+            if (have) {
+                red_merge(kind, &out->v[j], &out->i[j], av[j], ai[j]);
+            } else {
+                out->v[j] = av[j];
+                out->i[j] = ai[j];
+            }
+        }
+        have = true;
+    }
+}
+
+// 写出最终结果 (part < 0) 或本部分的部分值
+RED_INLINE void red_write(int32_t kind, const tvmrt_reduce_attrs_t* at, int32_t part,
+                          void* output, int32_t o0, const red_vals_t* b, int32_t oc) {
+    int64_t base = (part < 0) ? o0 : (int64_t)part * at->outputs + o0;
+    for (int32_t j = 0; j < oc; j++) {
+        if (kind != TVMRT_REDUCE_ARGMAX) {
+            ((float*)output)[base + j] = b->v[j];
+        } else if (part < 0) {
+            ((int32_t*)output)[base + j] = b->i[j];
+        } else {
+            ((tvmrt_argmax_t*)output)[base + j] = (tvmrt_argmax_t){b->v[j], b->i[j]};
+        }
+    }
+}
+
+RED_INLINE void red_run(int32_t kind, const tvmrt_reduce_attrs_t* at, const float* x,
+                        void* output) {
+    red_stack_t st;
+    red_vals_t b;
+    int64_t out_off[RED_CHUNK];
+    int32_t b0 = (at->part < 0) ? 0 : at->part * at->group_blocks;
+    int32_t b1 = (at->part < 0) ? at->blocks : b0 + at->group_blocks;
+    b1 = (b1 < at->blocks) ? b1 : at->blocks;
+    bool horizontal = at->red_strides[at->red_rank - 1] == 1;
+    bool contiguous = !horizontal && at->keep_rank > 0 &&
+                      at->keep_strides[at->keep_rank - 1] == 1;
+    int32_t keep_inner = at->keep_rank > 0 ? at->keep_shape[at->keep_rank - 1] : 1;
+    st.width = red_chunk(b1 - b0);
+    for (int32_t o0 = 0, oc = 0; o0 < at->outputs; o0 += oc) {
+        oc = (at->outputs - o0 < st.width) ? at->outputs - o0 : st.width;
+        if (contiguous && keep_inner - o0 % keep_inner < oc) oc = keep_inner - o0 % keep_inner;
+        for (int32_t j = 0; j < oc; j++) {
+            out_off[j] = red_offset(at->keep_rank, at->keep_shape, at->keep_strides, o0 + j);
+        }
+        st.full = 0;
+        for (int32_t blk = b0; blk < b1; blk++) {
+            int32_t r0 = blk * TVMRT_REDUCE_BLOCK;
+            int32_t r1 = (at->reduce_count - r0 < TVMRT_REDUCE_BLOCK) ? at->reduce_count
+                                                                      : r0 + TVMRT_REDUCE_BLOCK;
+            if (horizontal) {
+                for (int32_t j = 0; j < oc; j++) {
+                    red_block_row(kind, at, x + out_off[j], r0, r1, &b.v[j], &b.i[j]);
+                }
+            } else {
+                red_block_cols(kind, at, x, out_off, oc, contiguous, r0, r1, &b);
+            }
+            red_push(kind, &st, &b, oc);
+        }
+        red_fold(kind, &st, &b, oc);
+        red_write(kind, at, at->part, output, o0, &b, oc);
+    }
+}
+
+// 合并各部分值 (部分值依次为按块组对齐的子树，压栈即得同一棵树)
+RED_INLINE void red_combine(int32_t kind, const tvmrt_reduce_attrs_t* at, const void* partials,
+                            void* output) {
+    red_stack_t st;
+    red_vals_t b;
+    st.width = red_chunk(at->parts);
+    for (int32_t o0 = 0, oc = 0; o0 < at->outputs; o0 += oc) {
+        oc = (at->outputs - o0 < st.width) ? at->outputs - o0 : st.width;
+        st.full = 0;
+        for (int32_t p = 0; p < at->parts; p++) {
+            int64_t base = (int64_t)p * at->outputs + o0;
+            for (int32_t j = 0; j < oc; j++) {
+                if (kind == TVMRT_REDUCE_ARGMAX) {
+                    tvmrt_argmax_t e = ((const tvmrt_argmax_t*)partials)[base + j];
+                    b.v[j] = e.value;
+                    b.i[j] = e.index;
+                } else {
+                    b.v[j] = ((const float*)partials)[base + j];
+                    b.i[j] = -1;
+                }
+            }
+            red_push(kind, &st, &b, oc);
+        }
+        red_fold(kind, &st, &b, oc);
+        red_write(kind, at, -1, output, o0, &b, oc);
+    }
+}
+
+int32_t tvmgen_default_reduce_f32(float* p0, void* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_reduce_attrs_t* at = (const tvmrt_reduce_attrs_t*)cws;
+    switch (at->kind) {
+    case TVMRT_REDUCE_SUM: red_run(TVMRT_REDUCE_SUM, at, p0, output); return 0;
+    case TVMRT_REDUCE_MAX: red_run(TVMRT_REDUCE_MAX, at, p0, output); return 0;
+    case TVMRT_REDUCE_MIN: red_run(TVMRT_REDUCE_MIN, at, p0, output); return 0;
+    case TVMRT_REDUCE_ARGMAX: red_run(TVMRT_REDUCE_ARGMAX, at, p0, output); return 0;
+    default: return -1;
+    }
+}
+
+int32_t tvmgen_default_reduce_combine_f32(void* p0, void* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_reduce_attrs_t* at = (const tvmrt_reduce_attrs_t*)cws;
+    switch (at->kind) {
+    case TVMRT_REDUCE_SUM: red_combine(TVMRT_REDUCE_SUM, at, p0, output); return 0;
+    case TVMRT_REDUCE_MAX: red_combine(TVMRT_REDUCE_MAX, at, p0, output); return 0;
+    case TVMRT_REDUCE_MIN: red_combine(TVMRT_REDUCE_MIN, at, p0, output); return 0;
+    case TVMRT_REDUCE_ARGMAX: red_combine(TVMRT_REDUCE_ARGMAX, at, p0, output); return 0;
+    default: return -1;
+    }
+}
+
+int32_t wrapped_reduce_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_reduce_f32((float*)a->inputs[0], a->outputs[0], (uint8_t*)a->inputs[1],
+                                     a->ws);
+}
+
+int32_t wrapped_reduce_combine_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_reduce_combine_f32(a->inputs[0], a->outputs[0], (uint8_t*)a->inputs[1],
+                                             a->ws);
+}
+
+// ============================================================
+// Phase 7: 卷积与池化 (NHWC fp32)
+// ============================================================
+//
+// 属性块见 tvmrt_conv2d_attrs_t / tvmrt_pool2d_attrs_t (tvmrt.h)。卷积按
+// CONV_ROWS 个输出像素 × CONV_COLS 个输出通道分块累加 (与 MatMul 相同的
+// 分块，满块内层循环次数为常量，便于矢量化)。im2col 路径的规约行是临时区
+// 中展开的感受野; 直接卷积路径逐个卷积核位置取输入像素的通道向量，越出
+// 输入的位置跳过。两条路径的累加次序相同 (卷积核位置、输入通道)。
+
+#define CONV_ROWS 8
+#define CONV_COLS 64
+#define POOL_CHUNK 64
+
+#define CONV_INLINE static inline __attribute__((always_inline))
+
+// acc[r][j] += Σ_t a[r][t * step] * w[t * ldw + j]  (a[r] 为 NULL 的行跳过)
+CONV_INLINE void conv_accumulate(float acc[CONV_ROWS][CONV_COLS], const float* const* a,
+                                 int32_t step, int32_t mr, const float* w, int32_t ldw,
+                                 int32_t len, int32_t nb) {
+    for (int32_t t = 0; t < len; t++) {
+        const float* wr = w + (int64_t)t * ldw;
+        for (int32_t r = 0; r < mr; r++) {
+            if (!a[r]) continue;
+            float x = a[r][(int64_t)t * step];
+            if (nb == CONV_COLS) {
+                for (int32_t j = 0; j < CONV_COLS; j++) acc[r][j] += x * wr[j];
+            } else {
+                for (int32_t j = 0; j < nb; j++) acc[r][j] += x * wr[j];
+            }
+        }
+    }
+}
+
+CONV_INLINE void conv_init(float acc[CONV_ROWS][CONV_COLS], int32_t mr, const float* bias,
+                           int32_t j0, int32_t nb) {
+    for (int32_t r = 0; r < mr; r++) {
+        for (int32_t j = 0; j < nb; j++) acc[r][j] = bias ? bias[j0 + j] : 0.0f;
+    }
+}
+
+// 钳位后写出第 p0.. 个输出像素的 [j0, j0+nb) 通道
+CONV_INLINE void conv_store(const tvmrt_conv2d_attrs_t* at, float acc[CONV_ROWS][CONV_COLS],
+                            int32_t mr, float* output, int32_t p0, int32_t j0, int32_t nb) {
+    float lo = at->act_min, hi = at->act_max;
+    for (int32_t r = 0; r < mr; r++) {
+        float* o = output + (int64_t)(p0 + r) * at->k + j0;
+        for (int32_t j = 0; j < nb; j++) {
+            float v = acc[r][j] < lo ? lo : acc[r][j];
+            o[j] = v > hi ? hi : v;
+        }
+    }
+}
+
+// 输出像素 p 的感受野左上角 (可为负) 与所在样本的输入起点
+CONV_INLINE const float* conv_origin(const tvmrt_window2d_t* win, int32_t out_h, int32_t out_w,
+                                     const float* input, int32_t p, int32_t* iy, int32_t* ix) {
+    int32_t ox = p % out_w, oy = (p / out_w) % out_h, b = p / (out_w * out_h);
+    *iy = oy * win->stride_h - win->pad_top;
+    *ix = ox * win->stride_w - win->pad_left;
+    return input + (int64_t)b * win->h * win->w * win->c;
+}
+
+static int32_t conv_direct(const tvmrt_conv2d_attrs_t* at, const float* input, float* output,
+                           const float* w, const float* bias) {
+    const tvmrt_window2d_t* win = &at->win;
+    int32_t pixels = win->n * at->out_h * at->out_w, c = win->c;
+    float acc[CONV_ROWS][CONV_COLS];
+    const float* base[CONV_ROWS];
+    const float* a[CONV_ROWS];
+    int32_t iy[CONV_ROWS], ix[CONV_ROWS];
+    for (int32_t p0 = 0; p0 < pixels; p0 += CONV_ROWS) {
+        int32_t mr = (pixels - p0 < CONV_ROWS) ? pixels - p0 : CONV_ROWS;
+        for (int32_t r = 0; r < mr; r++) {
+            base[r] = conv_origin(win, at->out_h, at->out_w, input, p0 + r, &iy[r], &ix[r]);
+        }
+        for (int32_t j0 = 0; j0 < at->k; j0 += CONV_COLS) {
+            int32_t nb = (at->k - j0 < CONV_COLS) ? at->k - j0 : CONV_COLS;
+            conv_init(acc, mr, bias, j0, nb);
+            for (int32_t ky = 0; ky < win->kh; ky++) {
+                for (int32_t kx = 0; kx < win->kw; kx++) {
+                    for (int32_t r = 0; r < mr; r++) {
+                        int32_t y = iy[r] + ky, x = ix[r] + kx;
+                        bool inside = y >= 0 && y < win->h && x >= 0 && x < win->w;
+                        a[r] = inside ? base[r] + ((int64_t)y * win->w + x) * c : NULL;
+                    }
+                    const float* wt = w + (int64_t)(ky * win->kw + kx) * c * at->k + j0;
+                    conv_accumulate(acc, a, 1, mr, wt, at->k, c, nb);
+                }
+            }
+            conv_store(at, acc, mr, output, p0, j0, nb);
+        }
+    }
+    return 0;
+}
+
+static int32_t conv_im2col(const tvmrt_conv2d_attrs_t* at, const float* input, float* output,
+                           float* scratch, const float* w, const float* bias) {
+    const tvmrt_window2d_t* win = &at->win;
+    int32_t pixels = win->n * at->out_h * at->out_w, c = win->c;
+    int32_t kdim = win->kh * win->kw * c;
+    float acc[CONV_ROWS][CONV_COLS];
+    const float* a[CONV_ROWS];
+    for (int32_t p0 = 0; p0 < pixels; p0 += TVMRT_CONV_PANEL) {
+        int32_t pr = (pixels - p0 < TVMRT_CONV_PANEL) ? pixels - p0 : TVMRT_CONV_PANEL;
+        // 展开感受野 [kh, kw, c] (越出输入处填 0)。每 CONV_ROWS 行交错存放
+        // (第 t 个元素的各行相邻)，累加时各行只形成一路连续访问
+        for (int32_t q = 0; q < pr; q++) {
+            int32_t iy, ix;
+            const float* base = conv_origin(win, at->out_h, at->out_w, input, p0 + q, &iy, &ix);
+            float* row = scratch + (int64_t)(q / CONV_ROWS) * kdim * CONV_ROWS + q % CONV_ROWS;
+            for (int32_t ky = 0; ky < win->kh; ky++) {
+                int32_t y = iy + ky;
+                for (int32_t kx = 0; kx < win->kw; kx++, row += c * CONV_ROWS) {
+                    int32_t x = ix + kx;
+                    const float* src = base + ((int64_t)y * win->w + x) * c;
+                    bool inside = y >= 0 && y < win->h && x >= 0 && x < win->w;
+                    for (int32_t ci = 0; ci < c; ci++) row[ci * CONV_ROWS] = inside ? src[ci] : 0.0f;
+                }
+            }
+        }
+        // 权重的一段列在整个面板的各行间复用
+        for (int32_t j0 = 0; j0 < at->k; j0 += CONV_COLS) {
+            int32_t nb = (at->k - j0 < CONV_COLS) ? at->k - j0 : CONV_COLS;
+            for (int32_t r0 = 0; r0 < pr; r0 += CONV_ROWS) {
+                int32_t mr = (pr - r0 < CONV_ROWS) ? pr - r0 : CONV_ROWS;
+                for (int32_t r = 0; r < mr; r++) a[r] = scratch + (int64_t)r0 * kdim + r;
+                conv_init(acc, mr, bias, j0, nb);
+                conv_accumulate(acc, a, CONV_ROWS, mr, w + j0, at->k, kdim, nb);
+                conv_store(at, acc, mr, output, p0 + r0, j0, nb);
+            }
+        }
+    }
+    return 0;
+}
+
+int32_t tvmgen_default_conv2d_f32(float* p0, float* output, float* scratch, uint8_t* cws,
+                                  uint8_t* ws) {
+    (void)ws;
+    const tvmrt_conv2d_attrs_t* at = (const tvmrt_conv2d_attrs_t*)cws;
+    const float* w = (const float*)(cws + at->weight_offset);
+    const float* bias = at->bias_offset ? (const float*)(cws + at->bias_offset) : NULL;
+    if (at->algo == TVMRT_CONV_DIRECT) {
+        return conv_direct(at, p0, output, w, bias);
+    }
+    if (at->algo == TVMRT_CONV_IM2COL && scratch) {
+        return conv_im2col(at, p0, output, scratch, w, bias);
+    }
+    return -1;
+}
+
+// 池化: 每个输出像素在窗口与输入的交集上按通道段累加 (kind 为常量)
+CONV_INLINE void pool_run(int32_t kind, const tvmrt_pool2d_attrs_t* at, const float* input,
+                          float* output) {
+    const tvmrt_window2d_t* win = &at->win;
+    int32_t pixels = win->n * at->out_h * at->out_w, c = win->c;
+    float acc[POOL_CHUNK];
+    for (int32_t p = 0; p < pixels; p++) {
+        int32_t iy, ix;
+        const float* base = conv_origin(win, at->out_h, at->out_w, input, p, &iy, &ix);
+        int32_t y0 = iy > 0 ? iy : 0, y1 = (iy + win->kh < win->h) ? iy + win->kh : win->h;
+        int32_t x0 = ix > 0 ? ix : 0, x1 = (ix + win->kw < win->w) ? ix + win->kw : win->w;
+        float div = (float)(at->count_include_pad ? win->kh * win->kw : (y1 - y0) * (x1 - x0));
+        for (int32_t c0 = 0; c0 < c; c0 += POOL_CHUNK) {
+            int32_t nb = (c - c0 < POOL_CHUNK) ? c - c0 : POOL_CHUNK;
+            for (int32_t j = 0; j < nb; j++) acc[j] = (kind == TVMRT_POOL_MAX) ? -INFINITY : 0.0f;
+            for (int32_t y = y0; y < y1; y++) {
+                for (int32_t x = x0; x < x1; x++) {
+                    const float* s = base + ((int64_t)y * win->w + x) * c + c0;
+                    if (kind == TVMRT_POOL_MAX && nb == POOL_CHUNK) {
+                        for (int32_t j = 0; j < POOL_CHUNK; j++) {
+                            acc[j] = s[j] > acc[j] ? s[j] : acc[j];
+                        }
+                    } else if (kind == TVMRT_POOL_MAX) {
+                        for (int32_t j = 0; j < nb; j++) acc[j] = s[j] > acc[j] ? s[j] : acc[j];
+                    } else if (nb == POOL_CHUNK) {
+                        for (int32_t j = 0; j < POOL_CHUNK; j++) acc[j] += s[j];
+                    } else {
+                        for (int32_t j = 0; j < nb; j++) acc[j] += s[j];
+                    }
+                }
+            }
+            float* o = output + (int64_t)p * c + c0;
+            for (int32_t j = 0; j < nb; j++) o[j] = (kind == TVMRT_POOL_MAX) ? acc[j] : acc[j] / div;
+        }
+    }
+}
+
+int32_t tvmgen_default_pool2d_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_pool2d_attrs_t* at = (const tvmrt_pool2d_attrs_t*)cws;
+    switch (at->kind) {
+    case TVMRT_POOL_MAX: pool_run(TVMRT_POOL_MAX, at, p0, output); return 0;
+    case TVMRT_POOL_AVG: pool_run(TVMRT_POOL_AVG, at, p0, output); return 0;
+    default: return -1;
+    }
+}
+
+// 卷积: inputs = {x, 属性块}，outputs = {y, im2col 临时区 (直接卷积时可省略)}
+int32_t wrapped_conv2d_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_conv2d_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                     (float*)a->outputs[1], (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_pool2d_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_pool2d_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                     (uint8_t*)a->inputs[1], a->ws);
+}
+
+// ============================================================
+// Phase 8: 稀疏 MatMul (CSR / 块稀疏)
+// ============================================================
+//
+// 属性块为 tvmrt_sparse_attrs_t (tvmrt_sparse_init 转换生成)，输入输出与
+// 稠密 MatMul 相同 (fp32)。与稠密内核同样按 64 列面板 × SPMM_ROWS 行分块，
+// 每个输出元素按规约行 t 递增累加，只跳过零项。
+
+#define SPMM_ROWS 8
+
+// 块稀疏: 非零块做 TVMRT_SPARSE_BLOCK_COLS 列定长矢量累加
+int32_t tvmgen_default_spmm_bsr_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_sparse_attrs_t* at = (const tvmrt_sparse_attrs_t*)cws;
+    const int32_t* ptr = (const int32_t*)(cws + at->ptr_offset);
+    const int32_t* idx = (const int32_t*)(cws + at->idx_offset);
+    const float* val = (const float*)(cws + at->val_offset);
+    const float* bias = at->bias_offset ? (const float*)(cws + at->bias_offset) : NULL;
+    int32_t m = at->m, n = at->n, k = at->k;
+    float acc[SPMM_ROWS][TVMRT_SPARSE_PANEL];
+    for (int32_t p = 0; p < at->panels; p++) {
+        int32_t j0 = p * TVMRT_SPARSE_PANEL;
+        int32_t nb = (n - j0 < TVMRT_SPARSE_PANEL) ? n - j0 : TVMRT_SPARSE_PANEL;
+        const int32_t* pp = ptr + (int64_t)p * k;
+        for (int32_t i0 = 0; i0 < m; i0 += SPMM_ROWS) {
+            int32_t mr = (m - i0 < SPMM_ROWS) ? m - i0 : SPMM_ROWS;
+            for (int32_t r = 0; r < mr; r++) {
+                for (int32_t j = 0; j < TVMRT_SPARSE_PANEL; j++) {
+                    acc[r][j] = (bias && j < nb) ? bias[j0 + j] : 0.0f;
+                }
+            }
+            const float* a = p0 + (int64_t)i0 * k;
+            for (int32_t t = 0; t < k; t++) {
+                for (int32_t e = pp[t]; e < pp[t + 1]; e++) {
+                    const float* v = val + (int64_t)e * TVMRT_SPARSE_BLOCK_COLS;
+                    int32_t c0 = idx[e] * TVMRT_SPARSE_BLOCK_COLS;
+                    for (int32_t r = 0; r < mr; r++) {
+                        float x = a[(int64_t)r * k + t];
+                        for (int32_t j = 0; j < TVMRT_SPARSE_BLOCK_COLS; j++) {
+                            acc[r][c0 + j] += x * v[j];
+                        }
+                    }
+                }
+            }
+            for (int32_t r = 0; r < mr; r++) {
+                memcpy(output + (int64_t)(i0 + r) * n + j0, acc[r], (size_t)nb * sizeof(float));
+            }
+        }
+    }
+    return 0;
+}
+
+// CSR: 累加器按 [列][行] 存放，每个非零元素对 SPMM_ROWS 个输入行做一次
+// 定长矢量乘加 (不足 SPMM_ROWS 行时补 0 行)
+int32_t tvmgen_default_spmm_csr_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_sparse_attrs_t* at = (const tvmrt_sparse_attrs_t*)cws;
+    const int32_t* ptr = (const int32_t*)(cws + at->ptr_offset);
+    const int32_t* idx = (const int32_t*)(cws + at->idx_offset);
+    const float* val = (const float*)(cws + at->val_offset);
+    const float* bias = at->bias_offset ? (const float*)(cws + at->bias_offset) : NULL;
+    int32_t m = at->m, n = at->n, k = at->k;
+    float acc[TVMRT_SPARSE_PANEL][SPMM_ROWS];
+    float x[SPMM_ROWS];
+    for (int32_t p = 0; p < at->panels; p++) {
+        int32_t j0 = p * TVMRT_SPARSE_PANEL;
+        int32_t nb = (n - j0 < TVMRT_SPARSE_PANEL) ? n - j0 : TVMRT_SPARSE_PANEL;
+        const int32_t* pp = ptr + (int64_t)p * k;
+        for (int32_t i0 = 0; i0 < m; i0 += SPMM_ROWS) {
+            int32_t mr = (m - i0 < SPMM_ROWS) ? m - i0 : SPMM_ROWS;
+            for (int32_t j = 0; j < nb; j++) {
+                for (int32_t r = 0; r < SPMM_ROWS; r++) acc[j][r] = bias ? bias[j0 + j] : 0.0f;
+            }
+            const float* a = p0 + (int64_t)i0 * k;
+            for (int32_t t = 0; t < k; t++) {
+                if (pp[t] == pp[t + 1]) continue;
+                for (int32_t r = 0; r < SPMM_ROWS; r++) {
+                    x[r] = (r < mr) ? a[(int64_t)r * k + t] : 0.0f;
+                }
+                for (int32_t e = pp[t]; e < pp[t + 1]; e++) {
+                    float v = val[e];
+                    float* c = acc[idx[e]];
+                    for (int32_t r = 0; r < SPMM_ROWS; r++) c[r] += x[r] * v;
+                }
+            }
+            for (int32_t r = 0; r < mr; r++) {
+                float* o = output + (int64_t)(i0 + r) * n + j0;
+                for (int32_t j = 0; j < nb; j++) o[j] = acc[j][r];
+            }
+        }
+    }
+    return 0;
+}
+
+int32_t wrapped_spmm_bsr_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_spmm_bsr_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                       (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_spmm_csr_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_spmm_csr_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                       (uint8_t*)a->inputs[1], a->ws);
+}
+
+// 稀疏转换所用的稠密/稀疏内核 (阈值与格式保持默认，调用方可再修改)
+const tvmrt_tune_kernel_t* tvmgen_default_tune_kernels(int32_t* count);
+
+void tvmgen_default_sparse_kernels(tvmrt_sparse_config_t* config) {
+    int32_t count = 0;
+    config->dense = wrapped_matmul_f32;
+    config->csr = wrapped_spmm_csr_f32;
+    config->bsr = wrapped_spmm_bsr_f32;
+    config->tune_kernel = &tvmgen_default_tune_kernels(&count)[0];
+}
+
+// ============================================================
+// Phase 9: Softmax 与 LayerNorm (逐行，fp32)
+// ============================================================
+//
+// 属性块见 tvmrt_norm_attrs_t (tvmrt.h)。每行先按 NORM_LANES 路分道统计
+// (满分道的内层循环次数为常量，便于矢量化)，分道结果按固定次序合并，再
+// 一遍写出。
+
+#define NORM_LANES 16
+#define NORM_INLINE static inline __attribute__((always_inline))
+
+// 按掩码 (全 1 / 全 0) 选择: 两侧都先算出再按位合并，条件分支内含运算时
+// 编译器不会做 if 转换
+NORM_INLINE float norm_select(int32_t mask, float a, float b) {
+    int32_t ai, bi;
+    memcpy(&ai, &a, sizeof(ai));
+    memcpy(&bi, &b, sizeof(bi));
+    ai = (ai & mask) | (bi & ~mask);
+    memcpy(&a, &ai, sizeof(a));
+    return a;
+}
+
+// exp(x) 多项式近似 (Cephes expf 系数): x = n ln2 + r，|r| <= ln2/2，2^n 直接
+// 加到结果的指数位。只用乘加、比较与整数运算，可矢量化; x 上限钳位到
+// 88.7，x < -87.3 (含 -inf) 与 NaN 返回 0
+NORM_INLINE float norm_exp(float x) {
+    int32_t low = -(int32_t)(x >= -87.3f);     // 同时排除 NaN
+    float xc = norm_select(low, x > 88.7f ? 88.7f : x, -87.3f);
+    float t = xc * 1.44269504f + 12582912.0f;  // + 1.5 * 2^23: 就近取整到整数
+    float n = t - 12582912.0f;
+    float r = xc - n * 0.693359375f + n * 2.12194440e-4f;
+    float p = 1.9875691500e-4f;
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    float y = p * r * r + r + 1.0f;
+    uint32_t ti, yi;
+    memcpy(&ti, &t, sizeof(ti));
+    memcpy(&yi, &y, sizeof(yi));
+    yi += (ti - 0x4B400000u) << 23;            // 0x4B400000 = 1.5 * 2^23 的位模式
+    yi &= (uint32_t)low;
+    memcpy(&y, &yi, sizeof(y));
+    return y;
+}
+
+// 在线 Softmax 的一步: 新值不超过当前最大值时 s += exp(v - m)，否则
+// s = s * exp(m - v) + 1 并更新最大值。两种情况的指数都是 exp(-|v - m|)，
+// 每个元素只算一次; v 为 -inf 或 NaN 时 (差为 NaN 或 -inf) 不改变 s 与 m
+NORM_INLINE void softmax_update(float* m, float* s, float v) {
+    float d = v - *m;
+    float e = norm_exp(-fabsf(d));
+    int32_t up = -(int32_t)(d > 0.0f);
+    *s = norm_select(up, *s * e + 1.0f, *s + e);
+    *m = d > 0.0f ? v : *m;
+}
+
+static void softmax_row(const float* x, float* o, int32_t cols) {
+    float m[NORM_LANES], s[NORM_LANES], buf[NORM_LANES];
+    for (int32_t j = 0; j < NORM_LANES; j++) {
+        m[j] = -INFINITY;
+        s[j] = 0.0f;
+    }
+    int32_t i = 0;
+    for (; i + NORM_LANES <= cols; i += NORM_LANES) {
+        for (int32_t j = 0; j < NORM_LANES; j++) softmax_update(&m[j], &s[j], x[i + j]);
+    }
+    for (int32_t j = 0; i + j < cols; j++) softmax_update(&m[j], &s[j], x[i + j]);
+
+    float mx = m[0], sum = 0.0f;
+    for (int32_t j = 1; j < NORM_LANES; j++) mx = m[j] > mx ? m[j] : mx;
+    for (int32_t j = 0; j < NORM_LANES; j++) sum += s[j] * norm_exp(m[j] - mx);
+    float inv = 1.0f / sum;
+    for (i = 0; i + NORM_LANES <= cols; i += NORM_LANES) {
+        for (int32_t j = 0; j < NORM_LANES; j++) buf[j] = norm_exp(x[i + j] - mx) * inv;
+        memcpy(o + i, buf, sizeof(buf));
+    }
+    for (; i < cols; i++) o[i] = norm_exp(x[i] - mx) * inv;
+}
+
+static void layernorm_row(const float* x, float* o, int32_t cols, float eps, const float* gamma,
+                          const float* beta) {
+    // 1. 各分道 Welford 递推 (每道计数相同)。数据先减去行首元素: 均值远大于
+    //    标准差时，平移后的均值只有标准差量级，递推中的舍入误差随之变小
+    float mean[NORM_LANES], m2[NORM_LANES], buf[NORM_LANES];
+    float shift = x[0];
+    for (int32_t j = 0; j < NORM_LANES; j++) mean[j] = m2[j] = 0.0f;
+    int32_t chunks = 0, i = 0;
+    for (; i + NORM_LANES <= cols; i += NORM_LANES) {
+        float inv = 1.0f / (float)(++chunks);
+        for (int32_t j = 0; j < NORM_LANES; j++) {
+            float v = x[i + j] - shift;
+            float d = v - mean[j];
+            mean[j] += d * inv;
+            m2[j] += d * (v - mean[j]);
+        }
+    }
+    // 2. 分道按二叉树两两合并 (Chan 公式，两侧计数相等)，再递推剩余元素
+    float cnt = (float)chunks;
+    for (int32_t w = NORM_LANES / 2; chunks > 0 && w >= 1; w /= 2) {
+        for (int32_t j = 0; j < w; j++) {
+            float d = mean[j + w] - mean[j];
+            mean[j] += d * 0.5f;
+            m2[j] += m2[j + w] + d * d * cnt * 0.5f;
+        }
+        cnt *= 2.0f;
+    }
+    float mu = mean[0], q = m2[0];
+    for (; i < cols; i++) {
+        cnt += 1.0f;
+        float v = x[i] - shift;
+        float d = v - mu;
+        mu += d / cnt;
+        q += d * (v - mu);
+    }
+    float rstd = 1.0f / sqrtf(q / (float)cols + eps);
+
+    // 3. 写出 (经分块缓冲，输出可与输入重合)
+    for (i = 0; i + NORM_LANES <= cols; i += NORM_LANES) {
+        if (gamma) {
+            for (int32_t j = 0; j < NORM_LANES; j++) {
+                buf[j] = (x[i + j] - shift - mu) * rstd * gamma[i + j] + beta[i + j];
+            }
+        } else {
+            for (int32_t j = 0; j < NORM_LANES; j++) buf[j] = (x[i + j] - shift - mu) * rstd;
+        }
+        memcpy(o + i, buf, sizeof(buf));
+    }
+    for (; i < cols; i++) {
+        float v = (x[i] - shift - mu) * rstd;
+        o[i] = gamma ? v * gamma[i] + beta[i] : v;
+    }
+}
+
+int32_t tvmgen_default_softmax_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_norm_attrs_t* at = (const tvmrt_norm_attrs_t*)cws;
+    if (at->kind != TVMRT_NORM_SOFTMAX) {
+        return -1;
+    }
+    for (int32_t r = 0; r < at->rows; r++) {
+        int64_t off = (int64_t)r * at->cols;
+        softmax_row(p0 + off, output + off, at->cols);
+    }
+    return 0;
+}
+
+int32_t tvmgen_default_layernorm_f32(float* p0, float* output, uint8_t* cws, uint8_t* ws) {
+    (void)ws;
+    const tvmrt_norm_attrs_t* at = (const tvmrt_norm_attrs_t*)cws;
+    if (at->kind != TVMRT_NORM_LAYERNORM) {
+        return -1;
+    }
+    const float* gamma = at->gamma_offset ? (const float*)(cws + at->gamma_offset) : NULL;
+    const float* beta = at->beta_offset ? (const float*)(cws + at->beta_offset) : NULL;
+    if (!gamma != !beta) {
+        return -1;
+    }
+    for (int32_t r = 0; r < at->rows; r++) {
+        int64_t off = (int64_t)r * at->cols;
+        layernorm_row(p0 + off, output + off, at->cols, at->eps, gamma, beta);
+    }
+    return 0;
+}
+
+int32_t wrapped_softmax_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_softmax_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                      (uint8_t*)a->inputs[1], a->ws);
+}
+
+int32_t wrapped_layernorm_f32(void* args) {
+    tvmrt_op_args_t* a = (tvmrt_op_args_t*)args;
+    return tvmgen_default_layernorm_f32((float*)a->inputs[0], (float*)a->outputs[0],
+                                        (uint8_t*)a->inputs[1], a->ws);
+}
+
+// ============================================================
+// 自动调优候选
+// ============================================================
+
+// MatMul fp32 的分块与指令集版本、广播二元运算的指令集版本 (各组首项为
+// 默认实现)，按本机指令集筛选
+const tvmrt_tune_kernel_t* tvmgen_default_tune_kernels(int32_t* count) {
+    static tvmrt_tune_variant_t variants[6], bin_variants[3];
+    static tvmrt_tune_kernel_t kernels[2];
+    int32_t n = 0;
+    variants[n++] = (tvmrt_tune_variant_t){"r8c64", wrapped_matmul_f32};
+    variants[n++] = (tvmrt_tune_variant_t){"r4c32", wrapped_matmul_f32_r4c32};
+    variants[n++] = (tvmrt_tune_variant_t){"r8c128", wrapped_matmul_f32_r8c128};
+    variants[n++] = (tvmrt_tune_variant_t){"r16c32", wrapped_matmul_f32_r16c32};
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        variants[n++] = (tvmrt_tune_variant_t){"avx2", wrapped_matmul_f32_avx2};
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        variants[n++] = (tvmrt_tune_variant_t){"avx512", wrapped_matmul_f32_avx512};
+    }
+    kernels[0] = (tvmrt_tune_kernel_t){"matmul_f32", wrapped_matmul_f32, variants, n};
+
+    n = 0;
+    bin_variants[n++] = (tvmrt_tune_variant_t){"default", wrapped_binary_f32};
+    if (__builtin_cpu_supports("avx2")) {
+        bin_variants[n++] = (tvmrt_tune_variant_t){"avx2", wrapped_binary_f32_avx2};
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        bin_variants[n++] = (tvmrt_tune_variant_t){"avx512", wrapped_binary_f32_avx512};
+    }
+    kernels[1] = (tvmrt_tune_kernel_t){"binary_f32", wrapped_binary_f32, bin_variants, n};
+    *count = 2;
+    return kernels;
+}
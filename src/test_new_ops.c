@@ -2,12 +2,19 @@
  * @file test_new_ops.c
  * @brief 新算子单元测试
  *
- * 验证 Phase 1-3 添加的 9 个新算子的正确性
+ * 验证 Phase 1-3 添加的 9 个新算子、Phase 4 矢量/int8 量化算子、
+ * Phase 5 半精度 (fp16/bf16) 存储、Phase 6 自动调优候选实现、Phase 7
+ * 广播二元运算、Phase 8 归约 (含拆分执行结果一致性)、Phase 9 卷积与
+ * 池化 (含 im2col 临时区经内存规划复用)、Phase 10 稀疏 MatMul 及 Phase 11
+ * Softmax / LayerNorm (与 double 参考实现比较) 的正确性，
+ * 以及运行时 API 的主要行为与错误路径
  */
 
+#include "tvmrt.h"
 #include <math.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 // 直接调用算子函数进行测试
 extern int32_t tvmgen_default_relu(float *p0, float *output, uint8_t *cws,
@@ -28,8 +35,54 @@ extern int32_t tvmgen_default_mul_2(float *p0, float *output, uint8_t *cws,
                                     uint8_t *ws);
 extern int32_t tvmgen_default_mul_half(float *p0, float *output, uint8_t *cws,
                                        uint8_t *ws);
+extern int32_t tvmgen_default_matmul_f32(float *p0, float *output, uint8_t *cws,
+                                         uint8_t *ws);
+extern int32_t tvmgen_default_add_f32(float *p0, float *p1, float *output,
+                                      uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_quantize_s8(float *p0, int8_t *output,
+                                          uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_dequantize_s8(int8_t *p0, float *output,
+                                            uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_qadd_s8(int8_t *p0, int8_t *p1, int8_t *output,
+                                      uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_qmul_s8(int8_t *p0, int8_t *p1, int8_t *output,
+                                      uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_qrelu_s8(int8_t *p0, int8_t *output, uint8_t *cws,
+                                       uint8_t *ws);
+extern int32_t tvmgen_default_qlut_s8(int8_t *p0, int8_t *output, uint8_t *cws,
+                                      uint8_t *ws);
+extern int32_t tvmgen_default_qmatmul_s8(int8_t *p0, int8_t *output,
+                                         uint8_t *cws, uint8_t *ws);
+extern const tvmrt_tune_kernel_t *tvmgen_default_tune_kernels(int32_t *count);
+extern int32_t tvmgen_default_binary_f32(float *p0, float *p1, float *output,
+                                         uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_reduce_f32(float *p0, void *output, uint8_t *cws,
+                                         uint8_t *ws);
+extern int32_t tvmgen_default_reduce_combine_f32(void *p0, void *output,
+                                                 uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_conv2d_f32(float *p0, float *output, float *scratch,
+                                         uint8_t *cws, uint8_t *ws);
+extern int32_t tvmgen_default_pool2d_f32(float *p0, float *output, uint8_t *cws,
+                                         uint8_t *ws);
+extern int32_t wrapped_conv2d_f32(void *args);
+extern int32_t wrapped_pool2d_f32(void *args);
+extern int32_t tvmgen_default_spmm_csr_f32(float *p0, float *output, uint8_t *cws,
+                                           uint8_t *ws);
+extern int32_t tvmgen_default_spmm_bsr_f32(float *p0, float *output, uint8_t *cws,
+                                           uint8_t *ws);
+extern int32_t wrapped_matmul_f32(void *args);
+extern void tvmgen_default_sparse_kernels(tvmrt_sparse_config_t *config);
+extern int32_t tvmgen_default_softmax_f32(float *p0, float *output, uint8_t *cws,
+                                          uint8_t *ws);
+extern int32_t tvmgen_default_layernorm_f32(float *p0, float *output, uint8_t *cws,
+                                            uint8_t *ws);
+extern int32_t wrapped_softmax_f32(void *args);
+extern int32_t wrapped_layernorm_f32(void *args);
 
 #define EPSILON 1e-5f
+// 量化测试: 实数值 = s * (q - zp)
+#define DEQ(q, s, zp) ((s) * (float)((q) - (zp)))
+
 #define TEST(name, cond)                                                       \
   do {                                                                         \
     if (cond) {                                                                \
@@ -41,6 +94,377 @@ extern int32_t tvmgen_default_mul_half(float *p0, float *output, uint8_t *cws,
     }                                                                          \
   } while (0)
 
+// 广播参考实现: 逐元素由输出下标计算两个输入的偏移 (a/b 为 rank 维连续张量)
+static void bcast_ref(tvmrt_binary_kind_t kind, int rank, const int *shape, const int *as,
+                      const int *bs, const float *a, const float *b, float *out) {
+  int total = 1;
+  for (int d = 0; d < rank; d++) total *= shape[d];
+  for (int i = 0; i < total; i++) {
+    int rem = i, ia = 0, ib = 0, sa = 1, sb = 1;
+    for (int d = rank - 1; d >= 0; d--) {
+      int idx = rem % shape[d];
+      rem /= shape[d];
+      ia += (as[d] == 1 ? 0 : idx) * sa;
+      ib += (bs[d] == 1 ? 0 : idx) * sb;
+      sa *= as[d];
+      sb *= bs[d];
+    }
+    float x = a[ia], y = b[ib];
+    out[i] = kind == TVMRT_BINARY_ADD ? x + y
+             : kind == TVMRT_BINARY_SUB ? x - y
+             : kind == TVMRT_BINARY_MUL ? x * y
+             : kind == TVMRT_BINARY_DIV ? x / y
+             : kind == TVMRT_BINARY_MAX ? (x > y ? x : y)
+                                        : (x < y ? x : y);
+  }
+}
+
+// 归约参考实现: 逐个输出按行主序遍历被归约元素 (求和用 double)
+static void reduce_ref(tvmrt_reduce_kind_t kind, int rank, const int *shape, const int *strides,
+                       const int *axes, int axis_count, const float *x, float *out,
+                       int32_t *idx) {
+  int red[6] = {0}, outputs = 1, count = 1;
+  for (int i = 0; i < axis_count; i++) red[(axes[i] + rank) % rank] = 1;
+  for (int d = 0; d < rank; d++) {
+    if (red[d]) {
+      count *= shape[d];
+    } else {
+      outputs *= shape[d];
+    }
+  }
+  for (int o = 0; o < outputs; o++) {
+    double sum = 0.0;
+    float best = 0.0f;
+    int32_t bi = -1;
+    for (int r = 0; r < count; r++) {
+      int ro = o, rr = r, off = 0;
+      for (int d = rank - 1; d >= 0; d--) {
+        int *rem = red[d] ? &rr : &ro;
+        off += (*rem % shape[d]) * strides[d];
+        *rem /= shape[d];
+      }
+      float v = x[off];
+      sum += v;
+      if (bi < 0 || (kind == TVMRT_REDUCE_MIN ? v < best : v > best)) {
+        best = v;
+        bi = r;
+      }
+    }
+    out[o] = kind == TVMRT_REDUCE_SUM ? (float)sum : best;
+    idx[o] = bi;
+  }
+}
+
+// 拆分执行: 各部分算子按逆序执行后合并 (验证与部分数和执行次序无关)
+static int reduce_split(const tvmrt_reduce_attrs_t *at, float *x, void *partials, void *out) {
+  for (int32_t p = at->parts - 1; p >= 0; p--) {
+    tvmrt_reduce_attrs_t part = *at;
+    part.part = p;
+    if (tvmgen_default_reduce_f32(x, partials, (uint8_t *)&part, NULL) != 0) return -1;
+  }
+  return tvmgen_default_reduce_combine_f32(partials, out, (uint8_t *)at, NULL);
+}
+
+// 卷积参考实现: 逐输出元素在窗口内累加 (double)，权重 [kh,kw,c,k]
+static void conv_ref(const tvmrt_conv2d_attrs_t *at, const float *x, const float *w,
+                     const float *bias, float *out) {
+  const tvmrt_window2d_t *v = &at->win;
+  for (int b = 0; b < v->n; b++) {
+    for (int oy = 0; oy < at->out_h; oy++) {
+      for (int ox = 0; ox < at->out_w; ox++) {
+        for (int j = 0; j < at->k; j++) {
+          double acc = bias ? bias[j] : 0.0;
+          for (int ky = 0; ky < v->kh; ky++) {
+            for (int kx = 0; kx < v->kw; kx++) {
+              int y = oy * v->stride_h - v->pad_top + ky, xx = ox * v->stride_w - v->pad_left + kx;
+              if (y < 0 || y >= v->h || xx < 0 || xx >= v->w) continue;
+              for (int ci = 0; ci < v->c; ci++) {
+                acc += (double)x[((b * v->h + y) * v->w + xx) * v->c + ci] *
+                       w[((ky * v->kw + kx) * v->c + ci) * at->k + j];
+              }
+            }
+          }
+          out[((b * at->out_h + oy) * at->out_w + ox) * at->k + j] = (float)acc;
+        }
+      }
+    }
+  }
+}
+
+// 池化参考实现: 窗口与输入的交集按行、列次序累加
+static void pool_ref(const tvmrt_pool2d_attrs_t *at, const float *x, float *out) {
+  const tvmrt_window2d_t *v = &at->win;
+  for (int p = 0; p < v->n * at->out_h * at->out_w; p++) {
+    int ox = p % at->out_w, oy = (p / at->out_w) % at->out_h, b = p / (at->out_w * at->out_h);
+    for (int ci = 0; ci < v->c; ci++) {
+      float acc = at->kind == TVMRT_POOL_MAX ? -INFINITY : 0.0f;
+      int cnt = 0;
+      for (int ky = 0; ky < v->kh; ky++) {
+        for (int kx = 0; kx < v->kw; kx++) {
+          int y = oy * v->stride_h - v->pad_top + ky, xx = ox * v->stride_w - v->pad_left + kx;
+          if (y < 0 || y >= v->h || xx < 0 || xx >= v->w) continue;
+          float e = x[((b * v->h + y) * v->w + xx) * v->c + ci];
+          acc = at->kind == TVMRT_POOL_MAX ? (e > acc ? e : acc) : acc + e;
+          cnt++;
+        }
+      }
+      if (at->kind == TVMRT_POOL_AVG) acc /= (float)(at->count_include_pad ? v->kh * v->kw : cnt);
+      out[p * v->c + ci] = acc;
+    }
+  }
+}
+
+// 稀疏 MatMul 测试权重: 0 = 非结构化剪枝 (约 85% 为 0)，1 = 按 16 列块剪枝
+// (约 75% 的块为 0)，2 = 稠密
+static void sparse_weights(uint8_t *cws, int m, int k, int n, int pattern) {
+  tvmrt_qattrs_t *at = (tvmrt_qattrs_t *)cws;
+  *at = (tvmrt_qattrs_t){.count = m, .n = n, .k = k, .weight_offset = 128 + 1024,
+                         .bias_offset = 128};
+  float *bias = (float *)(cws + 128), *w = (float *)(cws + 128 + 1024);
+  for (int j = 0; j < n; j++) bias[j] = (float)(j % 7) * 0.25f - 0.5f;
+  for (int t = 0; t < k; t++) {
+    for (int j = 0; j < n; j++) {
+      unsigned h = (unsigned)(t * 7919 + j * 104729) * 2654435761u;
+      unsigned hb = (unsigned)(t * 7919 + (j / 16) * 104729) * 2654435761u;
+      int keep = pattern == 2 || (pattern == 0 && (h >> 24) % 100 < 15) ||
+                 (pattern == 1 && (hb >> 24) % 100 < 25);
+      w[t * n + j] = keep ? (float)((t * 37 + j * 11) % 101) / 101.0f - 0.5f : 0.0f;
+    }
+  }
+}
+
+// Softmax / LayerNorm 参考实现 (double，两遍)
+static void softmax_ref(const float *x, double *out, int rows, int cols) {
+  for (int r = 0; r < rows; r++) {
+    const float *v = x + (size_t)r * cols;
+    double mx = -INFINITY, sum = 0.0;
+    for (int c = 0; c < cols; c++) mx = v[c] > mx ? v[c] : mx;
+    for (int c = 0; c < cols; c++) sum += exp((double)v[c] - mx);
+    for (int c = 0; c < cols; c++) out[(size_t)r * cols + c] = exp((double)v[c] - mx) / sum;
+  }
+}
+
+static void layernorm_ref(const tvmrt_norm_attrs_t *at, const float *x, double *out) {
+  const float *gamma = at->gamma_offset ? (const float *)((const uint8_t *)at + at->gamma_offset) : NULL;
+  const float *beta = at->beta_offset ? (const float *)((const uint8_t *)at + at->beta_offset) : NULL;
+  for (int r = 0; r < at->rows; r++) {
+    const float *v = x + (size_t)r * at->cols;
+    double mean = 0.0, var = 0.0;
+    for (int c = 0; c < at->cols; c++) mean += v[c];
+    mean /= at->cols;
+    for (int c = 0; c < at->cols; c++) var += (v[c] - mean) * (v[c] - mean);
+    double rstd = 1.0 / sqrt(var / at->cols + at->eps);
+    for (int c = 0; c < at->cols; c++) {
+      double y = (v[c] - mean) * rstd;
+      out[(size_t)r * at->cols + c] = gamma ? y * gamma[c] + beta[c] : y;
+    }
+  }
+}
+
+// 运行时测试模型: 第 0 层 4 个独立算子各把输入加 1 写入自己的槽位，
+// 第 1 层把槽位 0 加 1 写到输出 (输出 = 输入 + 2)
+#define RT_WS_SIZE 256
+static int rt_calls;
+static int rt_seq[5];   // rt_ec 中各算子最近一次执行的全局序号
+static int rt_seq_n;
+static __thread char rt_tls;         // 取其地址作为执行线程的标识
+static const void *rt_owner[5];      // rt_ec 中各算子最近一次的执行线程
+
+// 引擎测试共用的上下文: 参数按 rt_model 绑定，计划已编译
+typedef struct {
+  uint8_t ws[RT_WS_SIZE] __attribute__((aligned(64)));
+  tvmrt_op_exec_t execs[5];
+  tvmrt_op_args_t args[5];
+  float x, y;
+  tvmrt_context_t ctx;
+  tvmrt_plan_t plan;
+} rt_engine_ctx_t;
+static rt_engine_ctx_t rt_ec;
+
+static int rt_gate;                  // 非 0 时 rt_add1 在入口处等待
+#define RT_TRACE_MAX 256
+static float rt_trace[RT_TRACE_MAX];   // 各次调用的输入值 (按调用顺序)
+static int rt_trace_n;
+static int32_t rt_add1(void *args) {
+  tvmrt_op_args_t *a = (tvmrt_op_args_t *)args;
+  __atomic_fetch_add(&rt_calls, 1, __ATOMIC_RELAXED);
+  int t = __atomic_fetch_add(&rt_trace_n, 1, __ATOMIC_RELAXED);
+  if (t < RT_TRACE_MAX) rt_trace[t] = *(const float *)a->inputs[0];
+  while (__atomic_load_n(&rt_gate, __ATOMIC_ACQUIRE)) tvmrt_thread_yield();
+  uintptr_t op = ((uintptr_t)a - (uintptr_t)rt_ec.args) / sizeof(tvmrt_op_args_t);
+  if (op < 5) {
+    rt_seq[op] = __atomic_fetch_add(&rt_seq_n, 1, __ATOMIC_RELAXED);
+    rt_owner[op] = &rt_tls;
+  }
+  // 原子写出: rt_add1_after_output 在其他线程上等待输出
+  float y = *(const float *)a->inputs[0] + 1.0f;
+  __atomic_store((float *)a->outputs[0], &y, __ATOMIC_RELEASE);
+  return 0;
+}
+
+static const tvmrt_op_func_t rt_funcs[1] = {rt_add1};
+static const tvmrt_tensor_map_entry_t rt_tmap[4] = {
+    {.sid = 0, .offset = 0, .size = 4, .align = 64},
+    {.sid = 1, .offset = 64, .size = 4, .align = 64},
+    {.sid = 2, .offset = 128, .size = 4, .align = 64},
+    {.sid = 3, .offset = 192, .size = 4, .align = 64},
+};
+#define RT_OP(id, in, out)                                                     \
+  {.op_id = (id), .name = "add1", .input_sids = {(in)}, .output_sids = {(out)}, \
+   .input_count = 1, .output_count = 1}
+static const tvmrt_op_desc_t rt_ops[5] = {
+    RT_OP(0, TVMRT_SID_INPUT(0), 0), RT_OP(1, TVMRT_SID_INPUT(0), 1),
+    RT_OP(2, TVMRT_SID_INPUT(0), 2), RT_OP(3, TVMRT_SID_INPUT(0), 3),
+    RT_OP(4, 0, TVMRT_SID_OUTPUT(0)),
+};
+static const int32_t rt_layer0[4] = {0, 1, 2, 3};
+static const int32_t rt_layer1[1] = {4};
+static const tvmrt_schedule_layer_t rt_layers[2] = {{rt_layer0, 4}, {rt_layer1, 1}};
+static const tvmrt_schedule_desc_t rt_schedule = {rt_layers, 2};
+static const tvmrt_model_desc_t rt_model = {
+    .tensor_map = rt_tmap, .tensor_count = 4, .op_descs = rt_ops, .op_count = 5,
+    .schedule = &rt_schedule, .cpu_func_table = rt_funcs, .cpu_func_count = 1};
+static int32_t rt_fail7(void *args) {
+  (void)args;
+  return 7;
+}
+
+// 等到 rt_ec 的输出写出后再执行 (有上限): 用于验证无关算子不被其阻塞
+static bool rt_saw_output;
+static int32_t rt_add1_after_output(void *args) {
+  float y = 0.0f;
+  for (long spins = 0; spins < (1L << 28) && y != rt_ec.x + 2.0f; spins++) {
+    __atomic_load(&rt_ec.y, &y, __ATOMIC_ACQUIRE);
+  }
+  rt_saw_output = y == rt_ec.x + 2.0f;
+  return rt_add1(args);
+}
+
+// 执行中触发中止: 置位 rt_token 或等到 rt_ec 的截止时刻之后，再继续执行
+// 一段时间以便调用线程在屏障处先发现中止
+static tvmrt_cancel_token_t rt_token;
+static uint64_t rt_spin_until(uint64_t t) {
+  uint64_t now;
+  while ((now = tvmrt_time_ns()) < t) tvmrt_thread_yield();
+  return now;
+}
+static int32_t rt_add1_abort(void *args) {
+  uint64_t now = tvmrt_time_ns();
+  if (rt_ec.ctx.deadline_ns) now = rt_spin_until(rt_ec.ctx.deadline_ns);
+  tvmrt_cancel(&rt_token);
+  rt_spin_until(now + 20000000u);
+  return rt_add1(args);
+}
+
+// 在独立线程中经上下文池执行一个请求
+typedef struct {
+  tvmrt_thread_t thread;
+  tvmrt_context_pool_t *pool;
+  float x, y;
+  uint64_t deadline_ns;
+  const tvmrt_cancel_token_t *cancel;
+  int ret;
+} rt_request_t;
+static void *rt_request_func(void *arg) {
+  rt_request_t *r = (rt_request_t *)arg;
+  void *in[1] = {&r->x}, *out[1] = {&r->y};
+  r->ret = tvmrt_context_pool_run_until(r->pool, in, out, r->deadline_ns, r->cancel);
+  return NULL;
+}
+
+static void rt_request_start(rt_request_t *r, tvmrt_context_pool_t *pool, float x) {
+  *r = (rt_request_t){.pool = pool, .x = x, .ret = 1};
+  tvmrt_thread_create(&r->thread, rt_request_func, r);
+}
+
+// 等到算子累计调用 n 次 (最多 2 秒)
+static bool rt_wait_calls(int n) {
+  uint64_t until = tvmrt_time_ns() + 2000000000u;
+  while (__atomic_load_n(&rt_calls, __ATOMIC_RELAXED) < n) {
+    if (tvmrt_time_ns() > until) return false;
+    tvmrt_thread_yield();
+  }
+  return true;
+}
+
+static void *rt_resize_zero_func(void *arg) {
+  *(int *)arg = tvmrt_engine_resize(0);
+  return NULL;
+}
+
+static void *rt_shutdown_func(void *arg) {
+  (void)arg;
+  tvmrt_engine_shutdown();
+  return NULL;
+}
+
+// 分页测试模型: PG_LAYERS 层各一个算子，对本层 1.5 页的常量求和。相邻层的
+// 区间按页对齐后共享一个边界页
+#define PG_LAYERS 4
+#define PG_FLOATS 1536
+typedef struct {
+  tvmrt_context_t *ctx;
+  int32_t offset;
+  float *out;
+} pg_args_t;
+
+static int32_t pg_sum(void *args) {
+  pg_args_t *a = (pg_args_t *)args;
+  const float *w = (const float *)((const uint8_t *)a->ctx->const_workspace + a->offset);
+  float sum = 0.0f;
+  for (int i = 0; i < PG_FLOATS; i++) sum += w[i];
+  *a->out = sum;
+  return 0;
+}
+
+// 在独立线程中向批处理器提交一个请求
+typedef struct {
+  tvmrt_batcher_t *batcher;
+  float x, y;
+  int ret;
+  tvmrt_thread_t thread;
+} rt_batch_submit_t;
+
+static void *rt_batch_submit_func(void *arg) {
+  rt_batch_submit_t *s = (rt_batch_submit_t *)arg;
+  void *in[1] = {&s->x}, *out[1] = {&s->y};
+  s->ret = tvmrt_batcher_submit(s->batcher, in, out);
+  return NULL;
+}
+
+static void *rt_batcher_destroy_func(void *arg) {
+  tvmrt_batcher_destroy((tvmrt_batcher_t *)arg);
+  return NULL;
+}
+
+static void rt_count_hook(int32_t layer_idx, void *user) {
+  (void)layer_idx;
+  (*(int *)user)++;
+}
+
+// 共两个执行线程的引擎: 与按 2 个切片分配的计划一致，执行时不重新分配
+static const tvmrt_engine_config_t rt_two_slots = {.num_workers = 2 - TVMRT_CALLER_PARTICIPATES};
+
+// 重新绑定 rt_ec 并编译计划 (输入为 x)，先释放上一次编译的计划
+static bool rt_ec_init(float x) {
+  tvmrt_plan_destroy(&rt_ec.plan);
+  memset(&rt_ec, 0, sizeof(rt_ec));
+  rt_ec.x = x;
+  void *in[1] = {&rt_ec.x}, *out[1] = {&rt_ec.y};
+  rt_ec.ctx = (tvmrt_context_t){.workspace = rt_ec.ws, .op_execs = rt_ec.execs, .op_count = 5,
+                                .args_storage = rt_ec.args};
+  return tvmrt_semantic_bind_args(&rt_model, rt_ec.args, in, 1, out, 1, rt_ec.ws, NULL) == 0 &&
+         tvmrt_semantic_init(&rt_ec.ctx, &rt_model) == 0 &&
+         tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0;
+}
+
+// 经 tvmrt_engine_run 执行一次 rt_ec: 成功且输出 = 输入 + 2
+static bool rt_ec_run(void) {
+  memset(rt_ec.ws, 0, sizeof(rt_ec.ws));
+  rt_ec.y = 0.0f;
+  return tvmrt_engine_run(&rt_ec.ctx, &rt_schedule) == 0 && rt_ec.y == rt_ec.x + 2.0f;
+}
+
 int main(void) {
   int passed = 0, failed = 0;
   float in, in2, out;
@@ -140,6 +564,1452 @@ int main(void) {
   tvmgen_default_mul_half(&in, &out, NULL, NULL);
   TEST("MulHalf(4.0) = 2.0", fabsf(out - 2.0f) < EPSILON);
 
+  // Phase 4: int8 量化算子 (与 fp32 结果相差不超过 1 个输出量化步长)
+  printf("\n--- Phase 4: int8 量化 ---\n");
+  {
+    // 属性块 + 常量 (权重/偏置/查找表) 共用一段常量区
+    static uint8_t cws[1024] __attribute__((aligned(16)));
+    tvmrt_qattrs_t *at = (tvmrt_qattrs_t *)cws;
+    const float sa = 0.05f, sb = 0.02f, so = 0.04f;
+    const int32_t za = 3, zb = -5, zo = -10;
+    float xf[8] = {-2.0f, -0.7f, 0.0f, 0.33f, 1.0f, 2.5f, 3.1f, -6.0f};
+    float yf[8] = {0.9f, -1.2f, 0.5f, 0.0f, -0.25f, 1.1f, -2.4f, 0.7f};
+    int8_t qa[8], qb[8], qo[8];
+    float back[8];
+    int ok;
+
+    // Quantize / Dequantize 往返
+    *at = (tvmrt_qattrs_t){.count = 8, .scale = sa, .out_zp = za, .act_min = -128,
+                           .act_max = 127};
+    tvmgen_default_quantize_s8(xf, qa, cws, NULL);
+    *at = (tvmrt_qattrs_t){.count = 8, .scale = sa, .in_zp = {za}};
+    tvmgen_default_dequantize_s8(qa, back, cws, NULL);
+    ok = 1;
+    for (int i = 0; i < 8; i++) ok &= fabsf(back[i] - xf[i]) <= sa * 0.5f + EPSILON;
+    TEST("Quantize/Dequantize 往返误差 <= scale/2", ok);
+
+    *at = (tvmrt_qattrs_t){.count = 8, .scale = sb, .out_zp = zb, .act_min = -128,
+                           .act_max = 127};
+    tvmgen_default_quantize_s8(yf, qb, cws, NULL);
+
+    // QAdd: 输入尺度不同
+    *at = (tvmrt_qattrs_t){.count = 8, .in_zp = {za, zb}, .out_zp = zo, .act_min = -128,
+                           .act_max = 127};
+    double twice_max = 2.0 * sa;
+    tvmrt_quant_multiplier(sa / twice_max, &at->in_rq[0]);
+    tvmrt_quant_multiplier(sb / twice_max, &at->in_rq[1]);
+    tvmrt_quant_multiplier(twice_max / ((double)(1 << TVMRT_QUANT_LEFT_SHIFT) * so),
+                           &at->out_rq);
+    tvmgen_default_qadd_s8(qa, qb, qo, cws, NULL);
+    ok = 1;
+    for (int i = 0; i < 8; i++) {
+      float ref = DEQ(qa[i], sa, za) + DEQ(qb[i], sb, zb);
+      float lim = fminf(fmaxf(ref, DEQ(-128, so, zo)), DEQ(127, so, zo));
+      ok &= fabsf(DEQ(qo[i], so, zo) - lim) <= so + EPSILON;
+    }
+    TEST("QAdd 与 fp32 相差 <= 1 LSB", ok);
+
+    // QMul
+    tvmrt_quant_multiplier((double)sa * sb / so, &at->out_rq);
+    tvmgen_default_qmul_s8(qa, qb, qo, cws, NULL);
+    ok = 1;
+    for (int i = 0; i < 8; i++) {
+      float ref = DEQ(qa[i], sa, za) * DEQ(qb[i], sb, zb);
+      float lim = fminf(fmaxf(ref, DEQ(-128, so, zo)), DEQ(127, so, zo));
+      ok &= fabsf(DEQ(qo[i], so, zo) - lim) <= so + EPSILON;
+    }
+    TEST("QMul 与 fp32 相差 <= 1 LSB", ok);
+
+    // QReLU6: 下界为输出零点, 上界为 6.0 对应的量化值
+    *at = (tvmrt_qattrs_t){.count = 8, .in_zp = {za}, .out_zp = zo,
+                           .act_min = zo, .act_max = zo + (int32_t)lrintf(6.0f / so)};
+    tvmrt_quant_multiplier(sa / ((double)(1 << TVMRT_QUANT_LEFT_SHIFT) * so), &at->out_rq);
+    tvmgen_default_qrelu_s8(qa, qo, cws, NULL);
+    ok = 1;
+    for (int i = 0; i < 8; i++) {
+      float ref = fminf(fmaxf(DEQ(qa[i], sa, za), 0.0f), 6.0f);
+      ok &= fabsf(DEQ(qo[i], so, zo) - ref) <= so + EPSILON;
+    }
+    TEST("QReLU6 与 fp32 相差 <= 1 LSB", ok);
+
+    // QMatMul [2,3] x [3,4] + bias, int32 累加后重量化
+    const float sw = 0.01f;
+    const int8_t w[12] = {10, -20, 30, 127, -128, 0, 5, -7, 64, 33, -90, 1};
+    const float bias_f[4] = {0.1f, -0.2f, 0.0f, 0.3f};
+    int8_t x2[6] = {12, -40, 100, 3, 90, -128};
+    *at = (tvmrt_qattrs_t){.count = 2, .n = 4, .k = 3, .weight_offset = 256,
+                           .bias_offset = 128, .in_zp = {za}, .out_zp = zo,
+                           .act_min = -128, .act_max = 127};
+    memcpy(cws + 256, w, sizeof(w));
+    int32_t *bias_q = (int32_t *)(cws + 128);
+    for (int j = 0; j < 4; j++) bias_q[j] = (int32_t)lrintf(bias_f[j] / (sa * sw));
+    tvmrt_quant_multiplier((double)sa * sw / so, &at->out_rq);
+    tvmgen_default_qmatmul_s8(x2, qo, cws, NULL);
+    ok = 1;
+    for (int i = 0; i < 2; i++) {
+      for (int j = 0; j < 4; j++) {
+        float ref = bias_q[j] * sa * sw;
+        for (int t = 0; t < 3; t++) ref += DEQ(x2[i * 3 + t], sa, za) * w[t * 4 + j] * sw;
+        float lim = fminf(fmaxf(ref, DEQ(-128, so, zo)), DEQ(127, so, zo));
+        ok &= fabsf(DEQ(qo[i * 4 + j], so, zo) - lim) <= so + EPSILON;
+      }
+    }
+    TEST("QMatMul 与 fp32 相差 <= 1 LSB", ok);
+
+    // MatMul fp32: [1,2] x [2,2] + bias
+    float wf[4] = {1.0f, 2.0f, 3.0f, 4.0f}, bf[2] = {0.5f, -0.5f};
+    float x3[2] = {1.0f, -1.0f}, y3[2];
+    *at = (tvmrt_qattrs_t){.count = 1, .n = 2, .k = 2, .weight_offset = 256,
+                           .bias_offset = 128};
+    memcpy(cws + 256, wf, sizeof(wf));
+    memcpy(cws + 128, bf, sizeof(bf));
+    tvmgen_default_matmul_f32(x3, y3, cws, NULL);
+    TEST("MatMul fp32 [1,-1]x[[1,2],[3,4]]+[0.5,-0.5] = [-1.5,-2.5]",
+         fabsf(y3[0] + 1.5f) < EPSILON && fabsf(y3[1] + 2.5f) < EPSILON);
+
+    // QSigmoid: 经 tvmrt_quant_prepare_op 按张量映射表生成查找表
+    tvmrt_tensor_map_entry_t tmap[2] = {
+        {.sid = 0, .size = 8, .align = 1, .dtype = TVMRT_DTYPE_INT8,
+         .quant = {sa, za}},
+        {.sid = 1, .offset = 8, .size = 8, .align = 1,
+         .dtype = TVMRT_DTYPE_INT8, .quant = {1.0f / 256.0f, -128}}};
+    tvmrt_op_desc_t desc = {.input_sids = {0, TVMRT_SID_CONST},
+                            .output_sids = {1},
+                            .input_count = 2,
+                            .output_count = 1,
+                            .const_size = sizeof(tvmrt_qattrs_t) + 256};
+    tvmrt_model_desc_t model = {.tensor_map = tmap, .tensor_count = 2,
+                                .op_descs = &desc, .op_count = 1};
+    memset(cws, 0, sizeof(cws));
+    at->count = 8;
+    ok = tvmrt_quant_prepare_op(&model, 0, TVMRT_QOP_SIGMOID, cws) == 0;
+    tvmgen_default_qlut_s8(qa, qo, cws, NULL);
+    for (int i = 0; ok && i < 8; i++) {
+      float ref = 1.0f / (1.0f + expf(-DEQ(qa[i], sa, za)));
+      ok &= fabsf(DEQ(qo[i], 1.0f / 256.0f, -128) - fminf(ref, DEQ(127, 1.0f / 256.0f, -128))) <=
+            1.0f / 256.0f;
+    }
+    TEST("QSigmoid 查找表与 fp32 相差 <= 1 LSB", ok);
+  }
+
+  // Phase 5: 半精度存储 (fp32 计算, 加载/写回时转换)
+  printf("\n--- Phase 5: fp16/bf16 存储 ---\n");
+  {
+    static uint8_t cws[1024] __attribute__((aligned(16)));
+    tvmrt_qattrs_t *at = (tvmrt_qattrs_t *)cws;
+    const float vals[6] = {1.0f, -2.5f, 65504.0f, 6.0e-8f, 0.1f, 1.0e6f};
+    const uint16_t f16_bits[6] = {0x3c00, 0xc100, 0x7bff, 0x0001, 0x2e66, 0x7c00};
+    const uint16_t bf16_bits[6] = {0x3f80, 0xc020, 0x4780, 0x3381, 0x3dcd, 0x4974};
+    uint16_t h[300];
+    float back[300];
+    int ok = 1;
+
+    tvmrt_convert_from_f32(vals, h, TVMRT_DTYPE_FLOAT16, 6);
+    for (int i = 0; i < 6; i++) ok &= (h[i] == f16_bits[i]);
+    TEST("fp32 -> fp16 就近偶数舍入 (含非规格化/溢出)", ok);
+
+    tvmrt_convert_from_f32(vals, h, TVMRT_DTYPE_BFLOAT16, 6);
+    ok = 1;
+    for (int i = 0; i < 6; i++) ok &= (h[i] == bf16_bits[i]);
+    TEST("fp32 -> bf16 就近偶数舍入", ok);
+
+    // 超过一个 SIMD 宽度的往返 (矢量路径 + 标量尾部)
+    float src[300];
+    for (int i = 0; i < 300; i++) src[i] = (float)(i - 150) * 0.37f;
+    tvmrt_convert_from_f32(src, h, TVMRT_DTYPE_FLOAT16, 300);
+    tvmrt_convert_to_f32(h, TVMRT_DTYPE_FLOAT16, back, 300);
+    ok = 1;
+    for (int i = 0; i < 300; i++) ok &= fabsf(back[i] - src[i]) <= fabsf(src[i]) / 1024.0f;
+    TEST("fp16 往返 300 个元素相对误差 <= 2^-10", ok);
+
+    tvmrt_convert_from_f32(src, h, TVMRT_DTYPE_BFLOAT16, 300);
+    tvmrt_convert_to_f32(h, TVMRT_DTYPE_BFLOAT16, back, 300);
+    ok = 1;
+    for (int i = 0; i < 300; i++) ok &= fabsf(back[i] - src[i]) <= fabsf(src[i]) / 256.0f;
+    TEST("bf16 往返 300 个元素相对误差 <= 2^-8", ok);
+
+    // Add: 输入 fp16 / bf16，输出 fp16
+    uint16_t a16[300], b16[300], o16[300];
+    tvmrt_convert_from_f32(src, a16, TVMRT_DTYPE_FLOAT16, 300);
+    tvmrt_convert_from_f32(src, b16, TVMRT_DTYPE_BFLOAT16, 300);
+    *at = (tvmrt_qattrs_t){.count = 300,
+                           .in_dtype = {TVMRT_DTYPE_FLOAT16, TVMRT_DTYPE_BFLOAT16},
+                           .out_dtype = TVMRT_DTYPE_FLOAT16};
+    tvmgen_default_add_f32((float *)a16, (float *)b16, (float *)o16, cws, NULL);
+    tvmrt_convert_to_f32(o16, TVMRT_DTYPE_FLOAT16, back, 300);
+    ok = 1;
+    for (int i = 0; i < 300; i++) ok &= fabsf(back[i] - 2.0f * src[i]) <= fabsf(src[i]) / 64.0f;
+    TEST("Add fp16 + bf16 -> fp16", ok);
+
+    // MatMul: fp16 权重与偏置, fp32 输入输出
+    const float wf[4] = {1.0f, 2.0f, 3.0f, 4.0f}, bf[2] = {0.5f, -0.5f};
+    float x3[2] = {1.0f, -1.0f}, y3[2];
+    *at = (tvmrt_qattrs_t){.count = 1, .n = 2, .k = 2, .weight_offset = 256,
+                           .bias_offset = 128, .weight_dtype = TVMRT_DTYPE_FLOAT16};
+    tvmrt_convert_from_f32(wf, cws + 256, TVMRT_DTYPE_FLOAT16, 4);
+    tvmrt_convert_from_f32(bf, cws + 128, TVMRT_DTYPE_FLOAT16, 2);
+    tvmgen_default_matmul_f32(x3, y3, cws, NULL);
+    TEST("MatMul fp16 权重 = [-1.5,-2.5]",
+         fabsf(y3[0] + 1.5f) < EPSILON && fabsf(y3[1] + 2.5f) < EPSILON);
+  }
+
+  // Phase 6: 自动调优候选 (分块版本与默认实现逐位一致，指令集版本乘加融合)
+  printf("\n--- Phase 6: 自动调优候选 ---\n");
+  {
+    enum { M = 19, K = 37, N = 150 };
+    static uint8_t cws[128 + 1024 + 4 * K * N] __attribute__((aligned(64)));
+    static float x[M * K], ref[M * N], y[M * N];
+    tvmrt_qattrs_t *at = (tvmrt_qattrs_t *)cws;
+    *at = (tvmrt_qattrs_t){.count = M, .n = N, .k = K, .weight_offset = 128 + 1024,
+                           .bias_offset = 128};
+    float *bias = (float *)(cws + 128), *w = (float *)(cws + 128 + 1024);
+    for (int i = 0; i < N; i++) bias[i] = (float)(i % 7) * 0.25f - 0.5f;
+    for (int i = 0; i < K * N; i++) w[i] = (float)((i * 37) % 101) / 101.0f - 0.5f;
+    for (int i = 0; i < M * K; i++) x[i] = (float)((i * 13) % 29) / 29.0f - 0.5f;
+    tvmgen_default_matmul_f32(x, ref, cws, NULL);
+
+    int32_t kernel_count = 0;
+    const tvmrt_tune_kernel_t *kernels = tvmgen_default_tune_kernels(&kernel_count);
+    tvmrt_op_args_t args = {.inputs = {x, cws}, .outputs = {y}};
+    int exact = kernel_count >= 1 && strcmp(kernels[0].kernel, "matmul_f32") == 0 &&
+                kernels[0].variant_count >= 4,
+        close = exact;
+    for (int32_t v = 0; exact && v < kernels[0].variant_count; v++) {
+      memset(y, 0, sizeof(y));
+      exact &= kernels[0].variants[v].func(&args) == 0;
+      if (strncmp(kernels[0].variants[v].name, "avx", 3) != 0) {
+        exact &= memcmp(y, ref, sizeof(y)) == 0;
+        continue;
+      }
+      for (int i = 0; i < M * N; i++) close &= fabsf(y[i] - ref[i]) <= 1e-5f;
+    }
+    TEST("MatMul [19,37]x[37,150] 各分块候选与默认实现逐位一致", exact);
+    TEST("MatMul 指令集候选与默认实现相差 <= 1e-5", close);
+
+    // 调优缓存: force 重新计时替换同键行而不是追加，其他键的行原样保留
+    static const char *cache = "/tmp/tvmrt_test_tune.cache";
+    FILE *f = fopen(cache, "w");
+    if (f) {
+      fputs("other cpu|matmul_f32|c1 n1 k1 t0.0.0.0|r4c32|5\n", f);
+      fclose(f);
+    }
+    tvmrt_op_exec_t exec = {"matmul", kernels[0].base, &args};
+    tvmrt_op_desc_t desc = {.input_sids = {TVMRT_SID_INPUT(0), TVMRT_SID_CONST},
+                            .output_sids = {TVMRT_SID_OUTPUT(0)}, .input_count = 2,
+                            .output_count = 1, .const_size = (int32_t)sizeof(cws)};
+    tvmrt_context_t ctx = {.const_workspace = cws, .op_execs = &exec, .op_count = 1};
+    tvmrt_model_desc_t model = {.op_descs = &desc, .op_count = 1};
+    tvmrt_tune_config_t cfg = {.kernels = kernels, .kernel_count = kernel_count,
+                               .cache_path = cache, .warmup = 1, .repeats = 1, .force = true};
+    tvmrt_tune_stats_t st1, st2, st3;
+    int ok = f && tvmrt_tune(&ctx, &model, &cfg, &st1) == 0 && st1.tuned == 1 &&
+             tvmrt_tune(&ctx, &model, &cfg, &st2) == 0 && st2.tuned == 1;
+    cfg.force = false;
+    ok &= tvmrt_tune(&ctx, &model, &cfg, &st3) == 0 && st3.cached == 1 && st3.tuned == 0;
+    char line[512];
+    int lines = 0, foreign = 0;
+    f = fopen(cache, "r");
+    while (f && fgets(line, sizeof(line), f)) {
+      lines++;
+      foreign += strncmp(line, "other cpu|", 10) == 0;
+    }
+    if (f) fclose(f);
+    remove(cache);
+    TEST("调优缓存 force 重测替换同键行", ok && lines == 2 && foreign == 1);
+  }
+
+  // Phase 7: 广播二元运算 (与逐元素计算下标的参考实现逐位一致)
+  printf("\n--- Phase 7: 广播二元运算 ---\n");
+  {
+    static const struct {
+      const char *name;
+      tvmrt_binary_kind_t kind;
+      int rank;
+      int shape[3], as[3], bs[3];
+      int collapsed;  // 合并后的维数
+    } cases[] = {
+        {"[4,5,37] + [4,5,37] 合并为 1 维", TVMRT_BINARY_ADD, 3, {4, 5, 37}, {4, 5, 37}, {4, 5, 37}, 1},
+        {"[9,70] * 标量", TVMRT_BINARY_MUL, 2, {9, 70}, {9, 70}, {1, 1}, 1},
+        {"[9,70] - [70] (行广播)", TVMRT_BINARY_SUB, 2, {9, 70}, {9, 70}, {1, 70}, 2},
+        {"[9,70] / [9,1] (列广播)", TVMRT_BINARY_DIV, 2, {9, 70}, {9, 70}, {9, 1}, 2},
+        {"max([3,1,40], [1,6,40])", TVMRT_BINARY_MAX, 3, {3, 6, 40}, {3, 1, 40}, {1, 6, 40}, 3},
+        {"min(标量, [6,33])", TVMRT_BINARY_MIN, 2, {6, 33}, {1, 1}, {6, 33}, 1},
+    };
+    static float a[2000], b[2000], ref[2000], out[2000];
+    tvmrt_bcast_attrs_t at;
+    for (int i = 0; i < 2000; i++) {
+      a[i] = (float)((i * 37) % 101) / 10.0f - 5.0f;
+      b[i] = (float)((i * 53) % 97) / 10.0f + 0.5f;
+    }
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      tvmrt_view_t va = {.rank = cases[c].rank}, vb = {.rank = cases[c].rank};
+      memcpy(va.shape, cases[c].as, sizeof(cases[c].as));
+      memcpy(vb.shape, cases[c].bs, sizeof(cases[c].bs));
+      int total = 1;
+      for (int d = 0; d < cases[c].rank; d++) total *= cases[c].shape[d];
+      bcast_ref(cases[c].kind, cases[c].rank, cases[c].shape, cases[c].as, cases[c].bs, a, b, ref);
+      int ok = tvmrt_broadcast_prepare(&at, cases[c].kind, &va, &vb, NULL) == 0 &&
+               at.rank == cases[c].collapsed;
+      ok &= tvmgen_default_binary_f32(a, b, out, (uint8_t *)&at, NULL) == 0 &&
+            memcmp(out, ref, (size_t)total * sizeof(float)) == 0;
+      TEST(cases[c].name, ok);
+    }
+
+    // 带步长视图: a 为 [8,6] 的转置 ([6,8], 步长 {1,6})，输出写入 [6,16] 的前 8 列
+    static const int at_strides[2] = {1, 6}, out_strides[2] = {16, 1};
+    tvmrt_view_t va = {.rank = 2, .shape = {6, 8}, .strides = at_strides};
+    tvmrt_view_t vb = {.rank = 1, .shape = {8}};
+    tvmrt_view_t vo = {.rank = 2, .shape = {6, 8}, .strides = out_strides};
+    for (int i = 0; i < 96; i++) out[i] = -1.0f;
+    int ok = tvmrt_broadcast_prepare(&at, TVMRT_BINARY_ADD, &va, &vb, &vo) == 0 &&
+             tvmgen_default_binary_f32(a, b, out, (uint8_t *)&at, NULL) == 0;
+    for (int r = 0; ok && r < 6; r++) {
+      for (int j = 0; j < 16; j++) {
+        ok &= out[r * 16 + j] == (j < 8 ? a[j * 6 + r] + b[j] : -1.0f);
+      }
+    }
+    TEST("转置视图 + [8] 写入带步长输出", ok);
+
+    tvmrt_view_t bad_a = {.rank = 2, .shape = {4, 3}}, bad_b = {.rank = 1, .shape = {4}};
+    TEST("[4,3] 与 [4] 不可广播", tvmrt_broadcast_prepare(&at, TVMRT_BINARY_ADD, &bad_a, &bad_b,
+                                                         NULL) == -1);
+
+    // 指令集候选与默认实现逐位一致 (行广播)
+    int32_t kernel_count = 0;
+    const tvmrt_tune_kernel_t *kernels = tvmgen_default_tune_kernels(&kernel_count);
+    tvmrt_view_t vr = {.rank = 2, .shape = {9, 70}}, vc = {.rank = 1, .shape = {70}};
+    tvmrt_broadcast_prepare(&at, TVMRT_BINARY_MAX, &vr, &vc, NULL);
+    tvmgen_default_binary_f32(a, b, ref, (uint8_t *)&at, NULL);
+    tvmrt_op_args_t args = {.inputs = {a, b, &at}, .outputs = {out}};
+    ok = kernel_count == 2 && strcmp(kernels[1].kernel, "binary_f32") == 0;
+    for (int32_t v = 0; ok && v < kernels[1].variant_count; v++) {
+      memset(out, 0, sizeof(out));
+      ok &= kernels[1].variants[v].func(&args) == 0 && memcmp(out, ref, 630 * sizeof(float)) == 0;
+    }
+    TEST("广播运算各指令集候选逐位一致", ok);
+  }
+
+  // Phase 8: 归约 (与参考实现比较; 拆分执行与单算子逐位一致)
+  printf("\n--- Phase 8: 归约 ---\n");
+  {
+    static const char *kind_names[4] = {"Sum", "Max", "Min", "ArgMax"};
+    static const int t_strides[2] = {1, 80}, s_strides[2] = {2, 80};
+    static const struct {
+      const char *name;
+      int rank;
+      int shape[4];
+      const int *strides;  // NULL = 连续
+      int axes[2], axis_count;
+    } cases[] = {
+        {"[37,300] axis -1", 2, {37, 300}, NULL, {-1}, 1},
+        {"[700,45] axis 0", 2, {700, 45}, NULL, {0}, 1},
+        {"[6,130,70] axis 1", 3, {6, 130, 70}, NULL, {1}, 1},
+        {"[5,9,4,33] axes {0,2}", 4, {5, 9, 4, 33}, NULL, {0, 2}, 2},
+        {"[3,1,1000] axes {1,2}", 3, {3, 1, 1000}, NULL, {1, 2}, 2},
+        {"[20,50] 全部归约", 2, {20, 50}, NULL, {0, 1}, 2},
+        {"[90000,2] axis 0 (352 块)", 2, {90000, 2}, NULL, {0}, 1},
+        {"转置视图 [80,30] axis 0", 2, {80, 30}, t_strides, {0}, 1},
+        {"隔列视图 [40,30] axis 1", 2, {40, 30}, s_strides, {1}, 1},
+    };
+    static float x[200000], ref[4000], out[4000];
+    static int32_t ref_idx[4000], out_idx[4000];
+    for (int i = 0; i < 200000; i++) x[i] = (float)((i * 37) % 101) / 10.0f - 5.0f;
+    tvmrt_reduce_attrs_t at;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      int strides[4];
+      tvmrt_view_t v = {.rank = cases[c].rank, .strides = cases[c].strides};
+      for (int d = cases[c].rank - 1, s = 1; d >= 0; d--) {
+        v.shape[d] = cases[c].shape[d];
+        strides[d] = cases[c].strides ? cases[c].strides[d] : s;
+        s *= cases[c].shape[d];
+      }
+      int ok = 1;
+      for (int k = 0; k < 4; k++) {
+        tvmrt_reduce_kind_t kind = (tvmrt_reduce_kind_t)k;
+        reduce_ref(kind, cases[c].rank, cases[c].shape, strides, cases[c].axes,
+                   cases[c].axis_count, x, ref, ref_idx);
+        ok &= tvmrt_reduce_prepare(&at, kind, &v, cases[c].axes, cases[c].axis_count, 1) == 0;
+        ok &= tvmgen_default_reduce_f32(x, kind == TVMRT_REDUCE_ARGMAX ? (void *)out_idx : out,
+                                        (uint8_t *)&at, NULL) == 0;
+        for (int32_t o = 0; ok && o < at.outputs; o++) {
+          if (kind == TVMRT_REDUCE_ARGMAX) {
+            ok &= out_idx[o] == ref_idx[o];
+          } else if (kind == TVMRT_REDUCE_SUM) {
+            ok &= fabsf(out[o] - ref[o]) <= 1e-3f;
+          } else {
+            ok &= out[o] == ref[o];
+          }
+        }
+        if (!ok) {
+          printf("    %s 不一致\n", kind_names[k]);
+          break;
+        }
+      }
+      TEST(cases[c].name, ok);
+    }
+
+    // 拆分执行 (1/2/3/8/64 个部分，逆序执行) 与单算子逐位一致
+    static const struct {
+      const char *name;
+      int shape[2], axis;
+    } big[] = {
+        {"[3,40000] axis -1 拆分执行逐位一致", {3, 40000}, -1},
+        {"[5000,40] axis 0 拆分执行逐位一致", {5000, 40}, 0},
+        {"[70000,2] axis 0 (274 块) 拆分执行逐位一致", {70000, 2}, 0},
+    };
+    static uint8_t partials[64 * 40 * 8];
+    for (size_t c = 0; c < sizeof(big) / sizeof(big[0]); c++) {
+      tvmrt_view_t v = {.rank = 2, .shape = {big[c].shape[0], big[c].shape[1]}};
+      int ok = 1;
+      for (int k = 0; k < 4; k++) {
+        void *single = (k == TVMRT_REDUCE_ARGMAX) ? (void *)ref_idx : ref;
+        void *split = (k == TVMRT_REDUCE_ARGMAX) ? (void *)out_idx : out;
+        ok &= tvmrt_reduce_prepare(&at, (tvmrt_reduce_kind_t)k, &v, &big[c].axis, 1, 1) == 0 &&
+              tvmgen_default_reduce_f32(x, single, (uint8_t *)&at, NULL) == 0;
+        static const int32_t max_parts[5] = {1, 2, 3, 8, 64};
+        for (int m = 0; ok && m < 5; m++) {
+          ok &= tvmrt_reduce_prepare(&at, (tvmrt_reduce_kind_t)k, &v, &big[c].axis, 1,
+                                     max_parts[m]) == 0 &&
+                at.parts <= max_parts[m] &&
+                tvmrt_reduce_partial_bytes(&at) <= (int64_t)sizeof(partials);
+          memset(split, 0xff, (size_t)at.outputs * 4);
+          ok &= reduce_split(&at, x, partials, split) == 0 &&
+                memcmp(split, single, (size_t)at.outputs * 4) == 0;
+        }
+      }
+      TEST(big[c].name, ok);
+    }
+
+    // 求和精度: 块间树形合并，误差远小于顺序累加
+    tvmrt_view_t v1 = {.rank = 1, .shape = {200000}};
+    int32_t axis0 = 0;
+    double exact = 0.0;
+    float seq = 0.0f;
+    for (int i = 0; i < 200000; i++) {
+      x[i] = 1.0f + (float)(i % 7) * 1e-3f;
+      exact += x[i];
+      seq += x[i];
+    }
+    tvmrt_reduce_prepare(&at, TVMRT_REDUCE_SUM, &v1, &axis0, 1, 1);
+    tvmgen_default_reduce_f32(x, out, (uint8_t *)&at, NULL);
+    printf("    200000 元素求和误差: 归约 %.3g, 顺序累加 %.3g\n", fabs(out[0] - exact),
+           fabs(seq - exact));
+    TEST("200000 元素求和误差 <= 顺序累加误差", fabs(out[0] - exact) <= fabs(seq - exact));
+
+    tvmrt_view_t v2 = {.rank = 2, .shape = {4, 5}};
+    int32_t dup[2] = {1, -1}, range[1] = {2};
+    TEST("重复维 / 越界维 / 无归约维被拒绝",
+         tvmrt_reduce_prepare(&at, TVMRT_REDUCE_SUM, &v2, dup, 2, 1) == -1 &&
+             tvmrt_reduce_prepare(&at, TVMRT_REDUCE_SUM, &v2, range, 1, 1) == -1 &&
+             tvmrt_reduce_prepare(&at, TVMRT_REDUCE_SUM, &v2, range, 0, 1) == -1);
+  }
+
+  // Phase 9: 卷积与池化 (im2col 与直接卷积逐位一致，与 double 参考实现相差在舍入误差内)
+  printf("\n--- Phase 9: 卷积与池化 ---\n");
+  {
+    static const struct {
+      const char *name;
+      tvmrt_window2d_t win;
+      int k;
+      tvmrt_conv_algo_t expect;  // AUTO 选择的路径
+    } cases[] = {
+        {"3x3 s1 p1 [1,9,11,20] -> 24", {1, 9, 11, 20, 3, 3, 1, 1, 1, 1, 1, 1}, 24,
+         TVMRT_CONV_DIRECT},
+        {"7x7 s2 p3 [1,15,13,3] -> 70", {1, 15, 13, 3, 7, 7, 2, 2, 3, 3, 3, 3}, 70,
+         TVMRT_CONV_IM2COL},
+        {"1x1 [2,5,6,32] -> 16", {2, 5, 6, 32, 1, 1, 1, 1, 0, 0, 0, 0}, 16, TVMRT_CONV_DIRECT},
+        {"3x3 s2 右下填充 [2,8,9,5] -> 9", {2, 8, 9, 5, 3, 3, 2, 2, 0, 1, 0, 1}, 9,
+         TVMRT_CONV_DIRECT},
+    };
+    static uint8_t cws[80 * 1024] __attribute__((aligned(64)));
+    static float x[16384], ref[8192], out[8192], out2[8192], scratch[16384];
+    tvmrt_conv2d_attrs_t *at = (tvmrt_conv2d_attrs_t *)cws;
+    for (int i = 0; i < 16384; i++) x[i] = (float)((i * 37) % 101) / 50.0f - 1.0f;
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+      int ok = tvmrt_conv2d_prepare(at, &cases[c].win, cases[c].k, true, TVMRT_CONV_AUTO) == 0 &&
+               at->algo == (int32_t)cases[c].expect && at->const_bytes <= (int)sizeof(cws) &&
+               (at->scratch_bytes > 0) == (at->algo == TVMRT_CONV_IM2COL);
+      float *w = (float *)(cws + at->weight_offset), *bias = (float *)(cws + at->bias_offset);
+      int kdim = cases[c].win.kh * cases[c].win.kw * cases[c].win.c;
+      for (int i = 0; i < kdim * at->k; i++) w[i] = (float)((i * 53) % 97) / 97.0f - 0.5f;
+      for (int j = 0; j < at->k; j++) bias[j] = 0.01f * (float)j;
+      int total = at->win.n * at->out_h * at->out_w * at->k;
+      conv_ref(at, x, w, bias, ref);
+      ok &= tvmgen_default_conv2d_f32(x, out, scratch, cws, NULL) == 0;
+      for (int i = 0; ok && i < total; i++) ok &= fabsf(out[i] - ref[i]) <= 1e-4f;
+      // 另一条路径: 累加次序相同，结果逐位一致
+      at->algo = (at->algo == TVMRT_CONV_DIRECT) ? TVMRT_CONV_IM2COL : TVMRT_CONV_DIRECT;
+      ok &= tvmgen_default_conv2d_f32(x, out2, scratch, cws, NULL) == 0 &&
+            memcmp(out, out2, (size_t)total * 4) == 0;
+      TEST(cases[c].name, ok);
+    }
+
+    // 融合 ReLU6 钳位; im2col 缺少临时区时报错
+    tvmrt_conv2d_prepare(at, &cases[0].win, 24, true, TVMRT_CONV_IM2COL);
+    at->act_min = 0.0f;
+    at->act_max = 6.0f;
+    int ok = tvmgen_default_conv2d_f32(x, out, scratch, cws, NULL) == 0;
+    conv_ref(at, x, (float *)(cws + at->weight_offset), (float *)(cws + at->bias_offset), ref);
+    for (int i = 0; ok && i < 9 * 11 * 24; i++) {
+      ok &= fabsf(out[i] - fminf(fmaxf(ref[i], 0.0f), 6.0f)) <= 1e-4f;
+    }
+    TEST("融合 ReLU6 钳位", ok);
+    TEST("im2col 缺少临时区返回错误", tvmgen_default_conv2d_f32(x, out, NULL, cws, NULL) == -1);
+
+    static const struct {
+      const char *name;
+      tvmrt_pool_kind_t kind;
+      tvmrt_window2d_t win;
+      int include_pad;
+    } pools[] = {
+        {"MaxPool 3x3 s2 p1 [2,9,9,70]", TVMRT_POOL_MAX, {2, 9, 9, 70, 3, 3, 2, 2, 1, 1, 1, 1}, 0},
+        {"AvgPool 2x2 s2 [1,8,6,64]", TVMRT_POOL_AVG, {1, 8, 6, 64, 2, 2, 2, 2, 0, 0, 0, 0}, 0},
+        {"AvgPool 3x3 s1 p1 不计填充", TVMRT_POOL_AVG, {1, 5, 7, 10, 3, 3, 1, 1, 1, 1, 1, 1}, 0},
+        {"AvgPool 3x3 s1 p1 计入填充", TVMRT_POOL_AVG, {1, 5, 7, 10, 3, 3, 1, 1, 1, 1, 1, 1}, 1},
+    };
+    for (size_t c = 0; c < sizeof(pools) / sizeof(pools[0]); c++) {
+      tvmrt_pool2d_attrs_t pa;
+      ok = tvmrt_pool2d_prepare(&pa, pools[c].kind, &pools[c].win) == 0;
+      pa.count_include_pad = pools[c].include_pad;
+      pool_ref(&pa, x, ref);
+      ok &= tvmgen_default_pool2d_f32(x, out, (uint8_t *)&pa, NULL) == 0 &&
+            memcmp(out, ref, (size_t)(pa.win.n * pa.out_h * pa.out_w * pa.win.c) * 4) == 0;
+      TEST(pools[c].name, ok);
+    }
+
+    tvmrt_window2d_t bad_pad = {1, 8, 8, 4, 3, 3, 1, 1, 3, 0, 0, 0};
+    tvmrt_window2d_t too_big = {1, 4, 4, 4, 7, 7, 1, 1, 1, 1, 1, 1};
+    tvmrt_pool2d_attrs_t pa;
+    TEST("填充不小于窗口 / 输出为空被拒绝",
+         tvmrt_conv2d_prepare(at, &bad_pad, 4, false, TVMRT_CONV_AUTO) == -1 &&
+             tvmrt_pool2d_prepare(&pa, TVMRT_POOL_MAX, &too_big) == -1);
+
+    // 内存规划: conv(im2col) -> pool -> conv(直接)，im2col 临时区只在第 0 层
+    // 存活，与第 1 层之后的张量共用 workspace 字节
+    tvmrt_window2d_t w0 = {1, 15, 13, 3, 7, 7, 2, 2, 3, 3, 3, 3};
+    tvmrt_conv2d_attrs_t c0, c2;
+    tvmrt_pool2d_attrs_t p1;
+    tvmrt_conv2d_prepare(&c0, &w0, 20, true, TVMRT_CONV_IM2COL);
+    tvmrt_window2d_t w1 = {1, c0.out_h, c0.out_w, 20, 2, 2, 2, 2, 0, 0, 0, 0};
+    tvmrt_pool2d_prepare(&p1, TVMRT_POOL_MAX, &w1);
+    tvmrt_window2d_t w2 = {1, p1.out_h, p1.out_w, 20, 3, 3, 1, 1, 1, 1, 1, 1};
+    tvmrt_conv2d_prepare(&c2, &w2, 8, false, TVMRT_CONV_AUTO);
+    int off2 = (c0.const_bytes + 63) & ~63, off1 = (off2 + c2.const_bytes + 63) & ~63;
+    memcpy(cws, &c0, sizeof(c0));
+    memcpy(cws + off2, &c2, sizeof(c2));
+    memcpy(cws + off1, &p1, sizeof(p1));
+    for (int i = 0; i < 7 * 7 * 3 * 20; i++) ((float *)(cws + c0.weight_offset))[i] = x[i] * 0.1f;
+    for (int i = 0; i < 20; i++) ((float *)(cws + c0.bias_offset))[i] = 0.0f;
+    for (int i = 0; i < 3 * 3 * 20 * 8; i++) ((float *)(cws + off2 + c2.weight_offset))[i] = x[i + 7];
+    int t0 = c0.out_h * c0.out_w * 20 * 4, t1 = p1.out_h * p1.out_w * 20 * 4;
+    tvmrt_tensor_map_entry_t tmap[3] = {{.sid = 0, .size = t0, .align = 64},
+                                        {.sid = 1, .size = c0.scratch_bytes, .align = 64},
+                                        {.sid = 2, .size = t1, .align = 64}};
+    tvmrt_op_desc_t descs[3] = {
+        {.input_sids = {TVMRT_SID_INPUT(0), TVMRT_SID_CONST}, .output_sids = {0, 1},
+         .input_count = 2, .output_count = 2, .const_offset = 0, .const_size = c0.const_bytes},
+        {.input_sids = {0, TVMRT_SID_CONST}, .output_sids = {2}, .input_count = 2,
+         .output_count = 1, .const_offset = off1, .const_size = (int)sizeof(p1)},
+        {.input_sids = {2, TVMRT_SID_CONST}, .output_sids = {TVMRT_SID_OUTPUT(0)},
+         .input_count = 2, .output_count = 1, .const_offset = off2, .const_size = c2.const_bytes},
+    };
+    int32_t order[3] = {0, 1, 2};
+    tvmrt_schedule_layer_t layers[3] = {{&order[0], 1}, {&order[1], 1}, {&order[2], 1}};
+    tvmrt_schedule_desc_t sched = {layers, 3};
+    tvmrt_model_desc_t model = {.tensor_map = tmap, .tensor_count = 3, .op_descs = descs,
+                                .op_count = 3, .schedule = &sched};
+    tvmrt_tensor_map_entry_t planned[3];
+    int32_t ws_size = 0;
+    ok = c0.algo == TVMRT_CONV_IM2COL && c2.algo == TVMRT_CONV_DIRECT &&
+         tvmrt_memory_plan(&model, 0, planned, &ws_size) == 0 &&
+         ws_size < t0 + c0.scratch_bytes + t1 && planned[1].offset < planned[2].offset + t1 &&
+         planned[2].offset < planned[1].offset + c0.scratch_bytes;
+    static uint8_t ws[65536] __attribute__((aligned(64)));
+    tvmrt_op_args_t args[3];
+    model.tensor_map = planned;
+    void *ins[1] = {x}, *outs[1] = {out};
+    ok &= ws_size <= (int)sizeof(ws) &&
+          tvmrt_semantic_bind_args(&model, args, ins, 1, outs, 1, ws, cws) == 0 &&
+          wrapped_conv2d_f32(&args[0]) == 0 && wrapped_pool2d_f32(&args[1]) == 0 &&
+          wrapped_conv2d_f32(&args[2]) == 0;
+    // 逐个算子直接调用 (独立缓冲区) 的结果
+    tvmgen_default_conv2d_f32(x, ref, scratch, cws, NULL);
+    tvmgen_default_pool2d_f32(ref, out2, cws + off1, NULL);
+    tvmgen_default_conv2d_f32(out2, ref, NULL, cws + off2, NULL);
+    ok &= memcmp(out, ref, (size_t)(p1.out_h * p1.out_w * 8) * 4) == 0;
+    printf("    workspace %d 字节 (不复用 %d 字节)\n", ws_size, t0 + c0.scratch_bytes + t1);
+    TEST("im2col 临时区经内存规划与后续张量复用，结果不变", ok);
+  }
+
+  // Phase 10: 稀疏 MatMul (省去零项、累加次序不变，与稠密内核结果相同)
+  printf("\n--- Phase 10: 稀疏 MatMul ---\n");
+  {
+    enum { M = 19, K = 70, N = 150, CWS = 128 + 1024 + 4 * K * N };
+    static uint8_t cws[3][CWS] __attribute__((aligned(64)));
+    static uint8_t packed[2 * CWS] __attribute__((aligned(64)));
+    static float x[M * K], ref[3][M * N], y[M * N];
+    for (int i = 0; i < M * K; i++) x[i] = (float)((i * 13) % 29) / 29.0f - 0.5f;
+    for (int p = 0; p < 3; p++) {
+      sparse_weights(cws[p], M, K, N, p);
+      tvmgen_default_matmul_f32(x, ref[p], cws[p], NULL);
+    }
+
+    int ok = 1;
+    for (int p = 0; p < 3; p++) {
+      for (int f = TVMRT_SPARSE_CSR; f <= TVMRT_SPARSE_BSR; f++) {
+        const tvmrt_qattrs_t *at = (const tvmrt_qattrs_t *)cws[p];
+        int64_t bytes = tvmrt_sparse_pack(at, (tvmrt_sparse_format_t)f, NULL, 0);
+        ok &= bytes > 0 && bytes <= (int64_t)sizeof(packed) &&
+              tvmrt_sparse_pack(at, (tvmrt_sparse_format_t)f, (tvmrt_sparse_attrs_t *)packed,
+                                sizeof(packed)) == bytes;
+        memset(y, 0, sizeof(y));
+        if (f == TVMRT_SPARSE_CSR) {
+          ok &= tvmgen_default_spmm_csr_f32(x, y, packed, NULL) == 0;
+        } else {
+          ok &= tvmgen_default_spmm_bsr_f32(x, y, packed, NULL) == 0;
+        }
+        for (int i = 0; i < M * N; i++) ok &= y[i] == ref[p][i];
+      }
+    }
+    TEST("CSR / BSR 内核 [19,70]x[70,150] (三种剪枝模式) 与稠密内核结果相同", ok);
+
+    const tvmrt_qattrs_t *a0 = (const tvmrt_qattrs_t *)cws[0];
+    const tvmrt_qattrs_t *a1 = (const tvmrt_qattrs_t *)cws[1];
+    const tvmrt_qattrs_t *a2 = (const tvmrt_qattrs_t *)cws[2];
+    float d0 = tvmrt_sparse_density(a0, TVMRT_SPARSE_CSR);
+    float b1 = tvmrt_sparse_density(a1, TVMRT_SPARSE_BSR);
+    printf("    非结构化元素密度 %.3f，块剪枝块密度 %.3f\n", d0, b1);
+    // 默认阈值下满密度权重保持稠密; 调高阈值后转换，TVMRT_SPARSE_NEVER 禁用对应格式
+    tvmrt_sparse_config_t loose = {.csr_max_density = 1.0f, .bsr_max_density = 1.0f};
+    tvmrt_sparse_config_t no_csr = {.csr_max_density = TVMRT_SPARSE_NEVER};
+    tvmrt_sparse_config_t never = {.csr_max_density = TVMRT_SPARSE_NEVER,
+                                   .bsr_max_density = TVMRT_SPARSE_NEVER};
+    TEST("密度统计与按阈值选择格式",
+         d0 > 0.1f && d0 < 0.2f && b1 > 0.15f && b1 < 0.35f &&
+             tvmrt_sparse_density(a2, TVMRT_SPARSE_CSR) == 1.0f &&
+             tvmrt_sparse_choose(a0, NULL) == TVMRT_SPARSE_CSR &&
+             tvmrt_sparse_choose(a1, NULL) == TVMRT_SPARSE_BSR &&
+             tvmrt_sparse_choose(a2, NULL) == TVMRT_SPARSE_DENSE &&
+             tvmrt_sparse_choose(a2, &loose) == TVMRT_SPARSE_BSR &&
+             tvmrt_sparse_choose(a1, &no_csr) == TVMRT_SPARSE_BSR &&
+             tvmrt_sparse_choose(a0, &never) == TVMRT_SPARSE_DENSE &&
+             tvmrt_sparse_choose(a1, &never) == TVMRT_SPARSE_DENSE);
+
+    // 上下文转换: 三个 fp32 MatMul 算子 + 一个 fp16 权重的 MatMul (不转换)
+    static uint8_t cws_half[CWS] __attribute__((aligned(64)));
+    memcpy(cws_half, cws[0], sizeof(cws_half));
+    ((tvmrt_qattrs_t *)cws_half)->weight_dtype = TVMRT_DTYPE_FLOAT16;
+    static float out[4][M * N];
+    tvmrt_op_args_t args[4];
+    tvmrt_op_exec_t execs[4];
+    for (int i = 0; i < 4; i++) {
+      args[i] = (tvmrt_op_args_t){.inputs = {x, i < 3 ? cws[i] : cws_half}, .outputs = {out[i]}};
+      execs[i] = (tvmrt_op_exec_t){"matmul", wrapped_matmul_f32, &args[i]};
+    }
+    tvmrt_context_t ctx = {.op_execs = execs, .op_count = 4};
+    tvmrt_sparse_config_t config = {.csr_max_density = 0.5f, .bsr_max_density = 0.5f};
+    tvmgen_default_sparse_kernels(&config);
+    tvmrt_sparse_t sp;
+    ok = tvmrt_sparse_init(&sp, &ctx, &config) == 0 && sp.csr == 1 && sp.bsr == 1 &&
+         sp.dense == 1 && sp.sparse_bytes < sp.dense_bytes &&
+         execs[0].func == config.csr && execs[1].func == config.bsr &&
+         execs[2].func == wrapped_matmul_f32 && execs[3].func == wrapped_matmul_f32 &&
+         args[3].inputs[1] == cws_half;
+    for (int i = 0; ok && i < 3; i++) {
+      ok &= execs[i].func(execs[i].args) == 0;
+      for (int e = 0; e < M * N; e++) ok &= out[i][e] == ref[i][e];
+    }
+    printf("    稠密权重 %lld 字节 -> 稀疏 %lld 字节\n", (long long)sp.dense_bytes,
+           (long long)sp.sparse_bytes);
+    tvmrt_sparse_destroy(&sp);
+    TEST("tvmrt_sparse_init 按密度替换算子，执行结果不变", ok);
+
+    config.format = TVMRT_SPARSE_BSR;
+    for (int i = 0; i < 4; i++) {
+      args[i].inputs[1] = i < 3 ? cws[i] : cws_half;
+      execs[i].func = wrapped_matmul_f32;
+    }
+    ok = tvmrt_sparse_init(&sp, &ctx, &config) == 0 && sp.bsr == 3 && sp.dense == 0 &&
+         execs[2].func == config.bsr && execs[3].func == wrapped_matmul_f32;
+    ok &= execs[2].func(execs[2].args) == 0;
+    for (int e = 0; e < M * N; e++) ok &= out[2][e] == ref[2][e];
+    tvmrt_sparse_destroy(&sp);
+    TEST("强制格式时稠密权重同样转换 (结果不变)", ok);
+
+    // 先调优后转换: 算子已是其他稠密候选时报错，ctx 不变
+    config.format = TVMRT_SPARSE_AUTO;
+    tvmrt_op_func_t tuned = NULL;
+    for (int32_t v = 0; v < config.tune_kernel->variant_count; v++) {
+      if (config.tune_kernel->variants[v].func != config.dense) {
+        tuned = config.tune_kernel->variants[v].func;
+      }
+    }
+    for (int i = 0; i < 4; i++) {
+      args[i].inputs[1] = i < 3 ? cws[i] : cws_half;
+      execs[i].func = wrapped_matmul_f32;
+    }
+    execs[1].func = tuned;
+    ok = tuned && tvmrt_sparse_init(&sp, &ctx, &config) == -1 && sp.storage == NULL &&
+         execs[0].func == wrapped_matmul_f32 && args[0].inputs[1] == cws[0];
+    TEST("tvmrt_tune 之后调用返回 -1 (不静默跳过)", ok);
+
+    config.format = (tvmrt_sparse_format_t)7;
+    TEST("参数无效返回 -1",
+         tvmrt_sparse_init(&sp, &ctx, &config) == -1 &&
+             tvmrt_sparse_pack(a0, TVMRT_SPARSE_DENSE, NULL, 0) == -1 &&
+             tvmrt_sparse_pack((const tvmrt_qattrs_t *)cws_half, TVMRT_SPARSE_CSR, NULL, 0) == -1 &&
+             tvmrt_sparse_density(a0, TVMRT_SPARSE_AUTO) < 0);
+  }
+
+  // Phase 11: Softmax / LayerNorm (单内核两遍，与 double 参考实现比较)
+  printf("\n--- Phase 11: Softmax / LayerNorm ---\n");
+  {
+    enum { MAXE = 8192 };
+    static float x[MAXE], y[MAXE], y2[MAXE];
+    static double ref[MAXE];
+    static uint8_t cws[64 + 2 * 4 * 4160] __attribute__((aligned(64)));
+    tvmrt_norm_attrs_t *at = (tvmrt_norm_attrs_t *)cws;
+    static const int shapes[][2] = {{3, 1}, {5, 15}, {7, 16}, {4, 100}, {2, 1000}, {1, 4099}};
+    const int nshapes = (int)(sizeof(shapes) / sizeof(shapes[0]));
+
+    int ok = 1;
+    double err = 0.0;
+    for (int t = 0; t < nshapes; t++) {
+      int rows = shapes[t][0], cols = shapes[t][1];
+      for (int i = 0; i < rows * cols; i++) x[i] = (float)((i * 7919) % 4001) / 100.0f - 20.0f;
+      ok &= tvmrt_softmax_prepare(at, rows, cols) == 0 &&
+            tvmgen_default_softmax_f32(x, y, cws, NULL) == 0;
+      softmax_ref(x, ref, rows, cols);
+      for (int r = 0; r < rows; r++) {
+        double sum = 0.0;
+        for (int c = 0; c < cols; c++) {
+          int i = r * cols + c;
+          double e = fabs(y[i] - ref[i]) / ref[i];
+          err = e > err ? e : err;
+          sum += y[i];
+        }
+        ok &= fabs(sum - 1.0) < 1e-5;
+      }
+    }
+    printf("    最大相对误差 %.2e\n", err);
+    TEST("Softmax 6 种形状 (含 16 的倍数与余数) 相对误差 <= 1e-5、行和为 1", ok && err <= 1e-5);
+
+    // 大数值 (朴素 exp 溢出) 与 -inf 掩码
+    for (int i = 0; i < 2 * 40; i++) x[i] = (float)(i % 40) * 500.0f;
+    for (int i = 40; i < 80; i += 3) x[i] = -INFINITY;
+    ok = tvmrt_softmax_prepare(at, 2, 40) == 0 && tvmgen_default_softmax_f32(x, y, cws, NULL) == 0;
+    softmax_ref(x, ref, 2, 40);
+    for (int i = 0; i < 80; i++) {
+      ok &= isinf(x[i]) ? y[i] == 0.0f : fabs(y[i] - ref[i]) <= 1e-6 + 1e-5 * ref[i];
+    }
+    TEST("Softmax 大输入不溢出，-inf 位置输出 0", ok);
+
+    // LayerNorm: 普通数据 / 大均值小方差 (单遍平方和会失去全部有效位)，有/无仿射
+    err = 0.0;
+    double err_off = 0.0;
+    ok = 1;
+    for (int t = 0; t < nshapes; t++) {
+      int rows = shapes[t][0], cols = shapes[t][1];
+      for (int off = 0; off < 2; off++) {
+        bool affine = (t + off) % 2 == 0;
+        ok &= tvmrt_layernorm_prepare(at, rows, cols, 1e-5f, affine) == 0 &&
+              at->const_bytes <= (int)sizeof(cws);
+        if (affine) {
+          for (int c = 0; c < cols; c++) {
+            ((float *)(cws + at->gamma_offset))[c] = 0.5f + (float)(c % 5) * 0.25f;
+            ((float *)(cws + at->beta_offset))[c] = (float)(c % 3) - 1.0f;
+          }
+        }
+        for (int i = 0; i < rows * cols; i++) {
+          x[i] = (off ? 10000.0f : 0.0f) + (float)((i * 7919) % 4001) / 2000.0f - 1.0f;
+        }
+        ok &= tvmgen_default_layernorm_f32(x, y, cws, NULL) == 0;
+        layernorm_ref(at, x, ref);
+        for (int i = 0; i < rows * cols; i++) {
+          double e = fabs(y[i] - ref[i]);
+          if (off) {
+            err_off = e > err_off ? e : err_off;
+          } else {
+            err = e > err ? e : err;
+          }
+        }
+      }
+    }
+    printf("    最大绝对误差 %.2e (均值 1e4: %.2e)\n", err, err_off);
+    TEST("LayerNorm 6 种形状 (有/无仿射) 绝对误差 <= 1e-5", ok && err <= 1e-5);
+    TEST("LayerNorm 均值 1e4、方差约 0.3 时绝对误差 <= 1e-5", ok && err_off <= 1e-5);
+
+    // 原地执行与异地执行逐位一致
+    for (int i = 0; i < 4 * 100; i++) x[i] = (float)((i * 31) % 97) / 10.0f;
+    ok = tvmrt_softmax_prepare(at, 4, 100) == 0 && tvmgen_default_softmax_f32(x, y, cws, NULL) == 0;
+    memcpy(y2, x, 400 * sizeof(float));
+    ok &= tvmgen_default_softmax_f32(y2, y2, cws, NULL) == 0 && memcmp(y, y2, 400 * sizeof(float)) == 0;
+    ok &= tvmrt_layernorm_prepare(at, 4, 100, 1e-5f, false) == 0 &&
+          tvmgen_default_layernorm_f32(x, y, cws, NULL) == 0;
+    memcpy(y2, x, 400 * sizeof(float));
+    ok &= tvmgen_default_layernorm_f32(y2, y2, cws, NULL) == 0 && memcmp(y, y2, 400 * sizeof(float)) == 0;
+    TEST("输出与输入为同一张量时结果不变", ok);
+
+    // 作为图中的算子: Softmax -> LayerNorm，属性块经 TVMRT_SID_CONST 引用
+    tvmrt_norm_attrs_t sm, ln;
+    ok = tvmrt_softmax_prepare(&sm, 4, 100) == 0 && tvmrt_layernorm_prepare(&ln, 4, 100, 1e-5f, true) == 0;
+    int off_ln = (sm.const_bytes + 63) & ~63;
+    memcpy(cws, &sm, sizeof(sm));
+    memcpy(cws + off_ln, &ln, sizeof(ln));
+    for (int c = 0; c < 100; c++) {
+      ((float *)(cws + off_ln + ln.gamma_offset))[c] = 1.0f + (float)c / 100.0f;
+      ((float *)(cws + off_ln + ln.beta_offset))[c] = (float)c / 50.0f;
+    }
+    tvmrt_tensor_map_entry_t tmap[1] = {{.sid = 0, .offset = 0, .size = 400 * 4, .align = 64}};
+    tvmrt_op_desc_t descs[2] = {
+        {.input_sids = {TVMRT_SID_INPUT(0), TVMRT_SID_CONST}, .output_sids = {0},
+         .input_count = 2, .output_count = 1, .const_offset = 0, .const_size = sm.const_bytes},
+        {.input_sids = {0, TVMRT_SID_CONST}, .output_sids = {TVMRT_SID_OUTPUT(0)},
+         .input_count = 2, .output_count = 1, .const_offset = off_ln, .const_size = ln.const_bytes},
+    };
+    tvmrt_model_desc_t model = {.tensor_map = tmap, .tensor_count = 1, .op_descs = descs,
+                                .op_count = 2};
+    static uint8_t ws[400 * 4] __attribute__((aligned(64)));
+    tvmrt_op_args_t args[2];
+    void *ins[1] = {x}, *outs[1] = {y};
+    ok &= tvmrt_semantic_bind_args(&model, args, ins, 1, outs, 1, ws, cws) == 0 &&
+          wrapped_softmax_f32(&args[0]) == 0 && wrapped_layernorm_f32(&args[1]) == 0;
+    tvmgen_default_softmax_f32(x, y2, cws, NULL);
+    tvmgen_default_layernorm_f32(y2, y2, cws + off_ln, NULL);
+    ok &= memcmp(y, y2, 400 * sizeof(float)) == 0;
+    TEST("Softmax -> LayerNorm 作为图中算子执行，结果与直接调用一致", ok);
+
+    tvmrt_norm_attrs_t bad;
+    TEST("参数无效返回 -1",
+         tvmrt_softmax_prepare(&bad, 0, 4) == -1 && tvmrt_softmax_prepare(&bad, 4, 0) == -1 &&
+             tvmrt_layernorm_prepare(&bad, 1, 4, -1.0f, false) == -1 &&
+             tvmrt_layernorm_prepare(&bad, 1, 4, NAN, false) == -1 &&
+             tvmgen_default_softmax_f32(x, y, (uint8_t *)&ln, NULL) == -1 &&
+             tvmgen_default_layernorm_f32(x, y, (uint8_t *)&sm, NULL) == -1);
+  }
+
+  // 运行时
+  printf("\n--- 运行时 ---\n");
+
+  // Workspace 内存池: 对齐、容量不足、准备上下文 (常量拷贝与预取缺页)
+  {
+    tvmrt_arena_t arena;
+    uint64_t page = tvmrt_page_size();
+    bool ok = tvmrt_arena_init(&arena, 100000, TVMRT_HUGEPAGE_NONE) == 0 &&
+              arena.capacity % page == 0 && arena.capacity >= 100000 &&
+              arena.hugepage == TVMRT_HUGEPAGE_NONE;
+    uint8_t *a = (uint8_t *)tvmrt_arena_alloc(&arena, 10, 1);
+    uint8_t *b = (uint8_t *)tvmrt_arena_alloc(&arena, 10, TVMRT_ARENA_ALIGN_PAGE);
+    ok &= a && b && (uintptr_t)a % TVMRT_CACHE_LINE_SIZE == 0 && (uintptr_t)b % page == 0 && b > a;
+    uint64_t used = arena.used;
+    ok &= tvmrt_arena_alloc(&arena, arena.capacity, 64) == NULL && arena.used == used;
+    static const uint8_t consts[100] = {1, 2, 3, 4, 5};
+    tvmrt_context_t ctx = {0};
+    ok &= tvmrt_arena_prepare_context(&arena, &ctx, 5000, consts, sizeof(consts), true) == 0 &&
+          (uintptr_t)ctx.workspace % page == 0 &&
+          (uintptr_t)ctx.const_workspace % TVMRT_CACHE_LINE_SIZE == 0 &&
+          memcmp(ctx.const_workspace, consts, sizeof(consts)) == 0 && ctx.workspace[4999] == 0;
+    ok &= tvmrt_arena_prepare_context(&arena, &ctx, arena.capacity, NULL, 0, false) == -1;
+    tvmrt_arena_destroy(&arena);
+
+    // 透明大页: 基址与容量按大页对齐 (不支持 madvise 时回退为普通页)
+    uint64_t huge = tvmrt_huge_page_size();
+    ok &= tvmrt_arena_init(&arena, 1 << 20, TVMRT_HUGEPAGE_TRANSPARENT) == 0 &&
+          (uintptr_t)arena.base % huge == 0 && arena.capacity % huge == 0 &&
+          (arena.hugepage == TVMRT_HUGEPAGE_TRANSPARENT ? arena.page_size == huge
+                                                        : arena.page_size == page);
+    tvmrt_arena_prefault(&arena);
+    tvmrt_arena_destroy(&arena);
+    ok &= tvmrt_arena_init(&arena, 0, TVMRT_HUGEPAGE_NONE) == -1 &&
+          tvmrt_arena_alloc(NULL, 1, 64) == NULL;
+    TEST("内存池: 分配按缓存行/页对齐，容量不足返回 NULL，常量拷贝到池内", ok);
+  }
+
+  // 通用参数绑定: SID 经张量映射表解析，外部输入输出直接指向调用方缓冲区
+  {
+    static uint8_t ws[RT_WS_SIZE] __attribute__((aligned(64)));
+    tvmrt_op_args_t args[5];
+    float x = 1.0f, y = 0.0f;
+    void *in[1] = {&x}, *out[1] = {&y};
+    bool ok = tvmrt_semantic_bind_args(&rt_model, args, in, 1, out, 1, ws, NULL) == 0 &&
+              args[0].inputs[0] == &x && args[0].outputs[0] == ws &&
+              args[3].outputs[0] == ws + 192 && args[4].inputs[0] == ws &&
+              args[4].outputs[0] == &y && args[4].inputs[1] == NULL && args[0].ws == ws;
+    // 由绑定好的参数逐个调用: 输出 = 输入 + 2
+    for (int i = 0; i < 5; i++) ok &= rt_add1(&args[i]) == 0;
+    ok &= y == 3.0f;
+    // 缺少外部输入、映射表中没有的 SID: 返回 -1
+    ok &= tvmrt_semantic_bind_args(&rt_model, args, in, 0, out, 1, ws, NULL) == -1;
+    tvmrt_op_desc_t bad_ops[5];
+    memcpy(bad_ops, rt_ops, sizeof(bad_ops));
+    bad_ops[4].input_sids[0] = 9;
+    tvmrt_model_desc_t bad = rt_model;
+    bad.op_descs = bad_ops;
+    ok &= tvmrt_semantic_bind_args(&bad, args, in, 1, out, 1, ws, NULL) == -1 &&
+          tvmrt_semantic_resolve_sid(ws, rt_tmap, 4, 2) == ws + 128 &&
+          tvmrt_semantic_resolve_sid(ws, rt_tmap, 4, 9) == NULL;
+    TEST("参数绑定: SID 解析到 workspace 与外部缓冲区，无法解析返回 -1", ok);
+  }
+
+  // 扁平执行计划: 按调度顺序执行并触发层级回调，跳过空函数，返回首个失败算子的返回值
+  {
+    int hooks = 0;
+    bool ok = rt_ec_init(2.0f);
+    rt_ec.ctx.layer_hook = rt_count_hook;
+    rt_ec.ctx.layer_hook_user = &hooks;
+    rt_seq_n = 0;
+    ok &= tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0 &&
+          rt_ec.plan.op_count == 5 && rt_ec.plan.layer_begin[1] == 4 &&
+          tvmrt_plan_run(&rt_ec.plan) == 0 && rt_ec.y == 4.0f && hooks == 2;
+    for (int i = 0; i < 5; i++) ok &= rt_seq[i] == i;
+    // 上下文带计划时串行路径按计划执行
+    rt_ec.y = 0.0f;
+    rt_ec.ctx.plan = &rt_ec.plan;
+    ok &= tvmrt_engine_run_single(&rt_ec.ctx, &rt_schedule) == 0 && rt_ec.y == 4.0f;
+    // 算子 1 无函数、算子 2 失败: 算子 3 与第 1 层不再执行
+    rt_ec.execs[1].func = NULL;
+    rt_ec.execs[2].func = rt_fail7;
+    rt_ec.y = 0.0f;
+    rt_seq_n = 0;
+    memset(rt_seq, -1, sizeof(rt_seq));
+    ok &= tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0 &&
+          rt_ec.plan.op_count == 4 && tvmrt_plan_run(&rt_ec.plan) == 7 && rt_ec.y == 0.0f &&
+          rt_seq[0] == 0 && rt_seq[3] == -1 && rt_seq[4] == -1;
+    // 没有函数表符号名时无法生成 C 源码
+    ok &= tvmrt_plan_emit_c(&rt_ec.plan, &rt_model, "f", stdout) == -1;
+    TEST("扁平计划: 按调度顺序执行，跳过空函数，算子失败返回其返回值", ok);
+  }
+
+  // 静态切片: 每个切片的算子总由同一个执行线程执行 (不经共享队列竞争出队)
+  {
+    bool ok = tvmrt_engine_init(&rt_two_slots) == 0 && rt_ec_init(5.0f);
+    rt_ec.ctx.plan = &rt_ec.plan;
+    // 等代价两个切片: 第 0 层为 {0, 2} 与 {1, 3}
+    ok &= tvmrt_plan_assign(&rt_ec.plan, NULL, 2) == 0;
+    const void *first[4] = {NULL};
+    for (int run = 0; run < 20 && ok; run++) {
+      ok &= rt_ec_run();
+      if (run == 0) memcpy(first, rt_owner, sizeof(first));
+      for (int k = 0; k < 4; k++) ok &= rt_owner[k] == first[k];
+    }
+    ok &= first[0] == first[2] && first[1] == first[3] && first[0] != first[1];
+    ok &= tvmrt_plan_assign(&rt_ec.plan, NULL, 0) == -1 &&
+          tvmrt_plan_assign(&rt_ec.plan, NULL, TVMRT_PLAN_MAX_SLOTS + 1) == -1;
+    // 第 0 层的算子 2 失败: 返回其错误码，第 1 层不再执行
+    rt_ec.execs[2].func = rt_fail7;
+    rt_ec.y = 0.0f;
+    ok &= tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0 &&
+          tvmrt_plan_assign(&rt_ec.plan, NULL, 2) == 0 &&
+          tvmrt_engine_run(&rt_ec.ctx, &rt_schedule) == 7 && rt_ec.y == 0.0f;
+    tvmrt_engine_shutdown();
+    TEST("静态切片: 切片到执行线程的对应固定，算子失败返回其错误码并跳过后续层", ok);
+  }
+
+  // 执行线程多于计划切片: 没分到切片的 Worker 醒来时计划可能已被重新编译或
+  // 释放，它不能再读计划 (在 -fsanitize=thread 下检查)
+  {
+    tvmrt_engine_config_t wide = {.num_workers = 6 - TVMRT_CALLER_PARTICIPATES};
+    bool ok = tvmrt_engine_init(&wide) == 0;
+    for (int run = 0; run < 200 && ok; run++) {
+      ok &= rt_ec_init(1.0f);
+      rt_ec.ctx.plan = &rt_ec.plan;
+      ok &= tvmrt_plan_assign(&rt_ec.plan, NULL, 4) == 0;
+      if (run & 1) ok &= tvmrt_plan_build_deps(&rt_ec.plan, &rt_model) == 0;
+      ok &= rt_ec_run();
+    }
+    tvmrt_engine_shutdown();
+    TEST("执行线程多于切片: 每次重新编译计划，层屏障与依赖模式结果都正确", ok);
+  }
+
+  // 调用线程参与执行: 切片 0 由调用线程执行，其余切片交给 Worker
+  {
+    bool ok = tvmrt_engine_init(&rt_two_slots) == 0 && rt_ec_init(7.0f);
+    rt_ec.ctx.plan = &rt_ec.plan;
+    ok &= tvmrt_plan_assign(&rt_ec.plan, NULL, 2) == 0 &&
+          tvmrt_plan_assign(&rt_ec.plan, NULL, TVMRT_PLAN_MAX_SLOTS) == 0 &&
+          tvmrt_plan_assign(&rt_ec.plan, NULL, 2) == 0;
+    for (int run = 0; run < 5 && ok; run++) {
+      ok &= rt_ec_run();
+      // 切片 0 = {0, 2}，切片 1 = {1, 3}
+      bool caller0 = rt_owner[0] == &rt_tls && rt_owner[2] == &rt_tls;
+      ok &= TVMRT_CALLER_PARTICIPATES ? caller0 : rt_owner[0] != &rt_tls;
+      ok &= rt_owner[1] != &rt_tls && rt_owner[3] == rt_owner[1];
+    }
+    tvmrt_engine_shutdown();
+    TEST("调用线程参与: 切片 0 在调用线程上执行，其余切片由 Worker 执行", ok);
+  }
+
+  // 逐层自适应: 探测运行交替两种方式，之后取实测较快者，每 interval 次运行重新探测
+  {
+    enum { WARMUP = 4, INTERVAL = 6, RUNS = 20 };
+    bool ok = tvmrt_engine_init(&rt_two_slots) == 0 && rt_ec_init(9.0f);
+    rt_ec.ctx.plan = &rt_ec.plan;
+    ok &= tvmrt_plan_set_adaptive(&rt_ec.plan, 1, 0) == -1 &&
+          tvmrt_plan_set_adaptive(&rt_ec.plan, WARMUP, -1) == -1 &&
+          tvmrt_plan_assign(&rt_ec.plan, NULL, 2) == 0 &&
+          tvmrt_plan_set_adaptive(&rt_ec.plan, WARMUP, INTERVAL) == 0 &&
+          rt_ec.plan.layer_mode[0] == TVMRT_LAYER_FANOUT;
+    int probed[2] = {0, 0};   // 热身之后的探测运行中两种方式各执行的次数
+    for (int run = 0; run < RUNS && ok; run++) {
+      ok &= rt_ec_run();
+      // 切片 1 = {1, 3}: 在调用线程上执行即本次第 0 层为串行
+      int executed = rt_owner[1] == &rt_tls ? TVMRT_LAYER_INLINE : TVMRT_LAYER_FANOUT;
+      const uint64_t *cost = rt_ec.plan.layer_cost_ns[0];
+      int faster = cost[TVMRT_LAYER_INLINE] <= cost[TVMRT_LAYER_FANOUT] ? TVMRT_LAYER_INLINE
+                                                                       : TVMRT_LAYER_FANOUT;
+      bool probe = run < WARMUP || run % INTERVAL < 2;
+      if (probe) {
+        ok &= executed == ((run & 1) ? TVMRT_LAYER_INLINE : TVMRT_LAYER_FANOUT);
+        if (run >= WARMUP) probed[executed]++;
+      } else {
+        ok &= executed == rt_ec.plan.layer_mode[0];
+      }
+      if (run >= WARMUP - 1) {
+        ok &= cost[0] > 0 && cost[1] > 0 && rt_ec.plan.layer_mode[0] == faster;
+      }
+    }
+    // 第 6/7、12/13、18/19 次重新探测，两种方式各执行一次
+    ok &= probed[TVMRT_LAYER_FANOUT] == 3 && probed[TVMRT_LAYER_INLINE] == 3 &&
+          rt_ec.plan.adapt_runs == RUNS;
+    ok &= tvmrt_plan_set_adaptive(&rt_ec.plan, 0, 0) == 0 &&
+          rt_ec.plan.layer_mode[0] == TVMRT_LAYER_FANOUT && rt_ec_run() &&
+          rt_owner[1] != &rt_tls;
+    tvmrt_engine_shutdown();
+    TEST("逐层自适应: 选择与实测较快者一致，按周期重新探测，非法参数返回 -1", ok);
+  }
+
+  // 依赖标志: 算子只等待自己的前驱，而非整层
+  {
+    bool ok = tvmrt_engine_init(&rt_two_slots) == 0 && rt_ec_init(3.0f);
+    rt_ec.ctx.plan = &rt_ec.plan;
+    // 算子 1 在另一切片上等到输出写出才完成: 有层屏障时算子 4 无法先于它执行
+    rt_ec.execs[1].func = rt_add1_after_output;
+    ok &= tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0 &&
+          tvmrt_plan_assign(&rt_ec.plan, NULL, 2) == 0 &&
+          tvmrt_plan_build_deps(&rt_ec.plan, &rt_model) == 0 && rt_ec.plan.dataflow;
+    // 算子 4 只读槽位 0: 唯一前驱为算子 0，第 0 层的其余算子互不依赖
+    ok &= rt_ec.plan.dep_begin[4] == 0 && rt_ec.plan.dep_begin[5] == 1 &&
+          rt_ec.plan.dep_list[0] == 0;
+    for (int run = 0; run < 5 && ok; run++) {
+      rt_saw_output = false;
+      ok &= rt_ec_run() && rt_saw_output && rt_seq[4] > rt_seq[0] && rt_seq[4] < rt_seq[1];
+    }
+    // 前驱失败: 返回其错误码，后继跳过执行
+    rt_ec.execs[0].func = rt_fail7;
+    rt_ec.execs[1].func = rt_add1;
+    ok &= tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0 &&
+          tvmrt_plan_assign(&rt_ec.plan, NULL, 2) == 0 &&
+          tvmrt_plan_build_deps(&rt_ec.plan, &rt_model) == 0;
+    memset(rt_seq, -1, sizeof(rt_seq));
+    rt_ec.y = 0.0f;
+    ok &= tvmrt_engine_run(&rt_ec.ctx, &rt_schedule) == 7 && rt_seq[4] == -1 && rt_ec.y == 0.0f;
+    // 带层级回调的计划 (如附加了分页器) 拒绝启用，保持层屏障且回调照常触发
+    int hooks = 0;
+    rt_ec.execs[0].func = rt_add1;
+    rt_ec.ctx.layer_hook = rt_count_hook;
+    rt_ec.ctx.layer_hook_user = &hooks;
+    ok &= tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0 &&
+          tvmrt_plan_build_deps(&rt_ec.plan, &rt_model) == -1 && !rt_ec.plan.dataflow &&
+          rt_ec_run() && hooks == 2;
+    rt_ec.ctx.layer_hook = NULL;
+    tvmrt_engine_shutdown();
+    TEST("依赖标志: 后继只等待前驱，不受同层无关算子阻塞，前驱失败时跳过，带层级回调时拒绝",
+         ok);
+  }
+
+  // 截止时刻与取消 (延迟模式): 执行中到期/被取消时等待在途算子完成后返回，后续层跳过
+  for (int variant = 0; variant < 2; variant++) {
+    tvmrt_engine_config_t ecfg = {.num_workers = 1, .mode = TVMRT_ENGINE_LATENCY};
+    bool ok = tvmrt_engine_init(&ecfg) == 0 && rt_ec_init(4.0f);
+    memset(&rt_token, 0, sizeof(rt_token));
+    if (variant == 0) {
+      rt_ec.ctx.deadline_ns = tvmrt_time_ns() + 10000000u;
+    } else {
+      rt_ec.ctx.cancel = &rt_token;
+    }
+    rt_ec.execs[3].func = rt_add1_abort;
+    ok &= tvmrt_plan_compile(&rt_ec.plan, &rt_ec.ctx, &rt_schedule) == 0;
+    rt_ec.ctx.plan = &rt_ec.plan;
+    int ret = tvmrt_engine_run(&rt_ec.ctx, &rt_schedule);
+    ok &= ret == (variant == 0 ? TVMRT_ERR_TIMEOUT : TVMRT_ERR_CANCELLED) &&
+          *(float *)(rt_ec.ws + 192) == 5.0f && rt_ec.y == 0.0f;
+    tvmrt_engine_shutdown();
+    TEST(variant == 0 ? "执行中到期: 在途算子完成后返回 TIMEOUT，后续层不执行"
+                      : "执行中取消: 在途算子完成后返回 CANCELLED，后续层不执行",
+         ok);
+  }
+
+  // 截止时刻与取消 (吞吐模式): 排队中的请求到期/被取消时直接返回，不等待 Worker
+  {
+    tvmrt_engine_config_t ecfg = {.num_workers = 1, .mode = TVMRT_ENGINE_THROUGHPUT};
+    tvmrt_context_pool_config_t pcfg = {.context_count = 3, .input_count = 1,
+                                        .output_count = 1, .workspace_size = RT_WS_SIZE};
+    tvmrt_context_pool_t pool;
+    bool ok = tvmrt_engine_init(&ecfg) == 0 && tvmrt_context_pool_init(&pool, &rt_model, &pcfg) == 0;
+    memset(&rt_token, 0, sizeof(rt_token));
+    // 请求 0 占住唯一的 Worker，直到放开 rt_gate
+    rt_request_t busy = {.pool = &pool, .x = 1.0f};
+    __atomic_store_n(&rt_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&rt_gate, 1, __ATOMIC_RELEASE);
+    tvmrt_thread_create(&busy.thread, rt_request_func, &busy);
+    while (ok && __atomic_load_n(&rt_calls, __ATOMIC_RELAXED) == 0) tvmrt_thread_yield();
+    // 排队中到期: 在截止时刻返回 TIMEOUT
+    rt_request_t late = {.pool = &pool, .x = 2.0f, .deadline_ns = tvmrt_time_ns() + 10000000u};
+    rt_request_func(&late);
+    ok &= late.ret == TVMRT_ERR_TIMEOUT && tvmrt_time_ns() >= late.deadline_ns;
+    // 排队中取消: 另一线程排队后置位令牌
+    rt_request_t cancelled = {.pool = &pool, .x = 3.0f, .cancel = &rt_token};
+    tvmrt_thread_create(&cancelled.thread, rt_request_func, &cancelled);
+    rt_spin_until(tvmrt_time_ns() + 10000000u);
+    tvmrt_cancel(&rt_token);
+    tvmrt_thread_join(&cancelled.thread);
+    ok &= cancelled.ret == TVMRT_ERR_CANCELLED;
+    // 两者都在 Worker 仍被占用时返回，且没有执行任何算子
+    ok &= __atomic_load_n(&rt_calls, __ATOMIC_RELAXED) == 1 && late.y == 0.0f && cancelled.y == 0.0f;
+    __atomic_store_n(&rt_gate, 0, __ATOMIC_RELEASE);
+    tvmrt_thread_join(&busy.thread);
+    ok &= busy.ret == 0 && busy.y == 3.0f;
+    tvmrt_context_pool_destroy(&pool);
+    tvmrt_engine_shutdown();
+    TEST("排队中到期返回 TIMEOUT，排队中取消返回 CANCELLED，均不占用 Worker", ok);
+  }
+
+  // 吞吐模式缩容到 0 / 停机: 排队中的请求由提交线程接手执行，不会永久阻塞
+  for (int variant = 0; variant < 2; variant++) {
+    tvmrt_engine_config_t ecfg = {.num_workers = 1, .mode = TVMRT_ENGINE_THROUGHPUT};
+    tvmrt_context_pool_config_t pcfg = {.context_count = 3, .input_count = 1,
+                                        .output_count = 1, .workspace_size = RT_WS_SIZE};
+    tvmrt_context_pool_t pool;
+    bool ok = tvmrt_engine_init(&ecfg) == 0 && tvmrt_context_pool_init(&pool, &rt_model, &pcfg) == 0;
+    rt_request_t req[3];
+    tvmrt_thread_t ctl;
+    int resized = -1;
+    __atomic_store_n(&rt_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&rt_gate, 1, __ATOMIC_RELEASE);
+    rt_request_start(&req[0], &pool, 1.0f);
+    ok &= rt_wait_calls(1);   // 唯一的 Worker 停在第一个请求中
+    rt_request_start(&req[1], &pool, 2.0f);
+    rt_request_start(&req[2], &pool, 3.0f);
+    rt_spin_until(tvmrt_time_ns() + 20000000u);
+    if (variant == 0) {
+      tvmrt_thread_create(&ctl, rt_resize_zero_func, &resized);
+    } else {
+      tvmrt_thread_create(&ctl, rt_shutdown_func, NULL);
+    }
+    rt_spin_until(tvmrt_time_ns() + 20000000u);
+    __atomic_store_n(&rt_gate, 0, __ATOMIC_RELEASE);
+    tvmrt_thread_join(&ctl);
+    for (int r = 0; r < 3; r++) {
+      tvmrt_thread_join(&req[r].thread);
+      ok &= req[r].ret == 0 && req[r].y == req[r].x + 2.0f;
+    }
+    if (variant == 0) {
+      ok &= resized == 0 && tvmrt_engine_num_workers() == 0;
+      tvmrt_engine_shutdown();
+    }
+    tvmrt_context_pool_destroy(&pool);
+    TEST(variant == 0 ? "吞吐模式缩容到 0: 排队请求由提交线程执行完成"
+                      : "吞吐模式停机: 排队请求由提交线程执行完成",
+         ok);
+  }
+
+  // 延迟模式: 同一优先级的等待者按到达顺序获得引擎
+  {
+    tvmrt_engine_config_t ecfg = {.num_workers = 1, .mode = TVMRT_ENGINE_LATENCY};
+    tvmrt_context_pool_config_t pcfg = {.context_count = 5, .input_count = 1,
+                                        .output_count = 1, .workspace_size = RT_WS_SIZE};
+    tvmrt_context_pool_t pool;
+    bool ok = tvmrt_engine_init(&ecfg) == 0 && tvmrt_context_pool_init(&pool, &rt_model, &pcfg) == 0;
+    rt_request_t req[5];
+    __atomic_store_n(&rt_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&rt_trace_n, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&rt_gate, 1, __ATOMIC_RELEASE);
+    rt_request_start(&req[0], &pool, 0.0f);
+    ok &= rt_wait_calls(1);   // 第一个请求占住引擎
+    for (int r = 1; r < 5; r++) {
+      rt_spin_until(tvmrt_time_ns() + 10000000u);
+      rt_request_start(&req[r], &pool, 10.0f * r);
+    }
+    rt_spin_until(tvmrt_time_ns() + 10000000u);
+    __atomic_store_n(&rt_gate, 0, __ATOMIC_RELEASE);
+    for (int r = 0; r < 5; r++) {
+      tvmrt_thread_join(&req[r].thread);
+      ok &= req[r].ret == 0 && req[r].y == req[r].x + 2.0f;
+    }
+    // 第 r 个请求第 0 层的输入为 10r (第 1 层为 10r + 1): 各 10r 首次出现
+    // 的顺序就是获得引擎的顺序
+    float next = 0.0f;
+    int n = __atomic_load_n(&rt_trace_n, __ATOMIC_RELAXED);
+    for (int t = 0; t < n && t < RT_TRACE_MAX; t++) {
+      if (fmodf(rt_trace[t], 10.0f) != 0.0f) continue;
+      if (rt_trace[t] == next) next += 10.0f;
+      else ok &= rt_trace[t] < next;
+    }
+    ok &= next == 50.0f;
+    tvmrt_context_pool_destroy(&pool);
+    tvmrt_engine_shutdown();
+    TEST("延迟模式: 同级等待者按到达顺序获得引擎", ok);
+  }
+
+  // 批处理器: 并发提交的请求合批执行，各自得到正确结果
+  {
+    tvmrt_engine_config_t ecfg = {.num_workers = 2, .mode = TVMRT_ENGINE_LATENCY};
+    tvmrt_batcher_config_t bcfg = {.max_batch = 4, .max_delay_ns = 5000000, .input_count = 1,
+                                   .output_count = 1, .workspace_size = RT_WS_SIZE};
+    tvmrt_batcher_t batcher;
+    bool ok = tvmrt_engine_init(&ecfg) == 0 && tvmrt_batcher_init(&batcher, &rt_model, &bcfg) == 0;
+    rt_batch_submit_t req[8];
+    for (int r = 0; r < 8; r++) {
+      req[r] = (rt_batch_submit_t){.batcher = &batcher, .x = (float)r, .ret = 1};
+      tvmrt_thread_create(&req[r].thread, rt_batch_submit_func, &req[r]);
+    }
+    for (int r = 0; r < 8; r++) {
+      tvmrt_thread_join(&req[r].thread);
+      ok &= req[r].ret == 0 && req[r].y == req[r].x + 2.0f;
+    }
+    ok &= batcher.request_count == 8 && batcher.batch_count >= 2 && batcher.batch_count <= 8;
+    tvmrt_batcher_destroy(&batcher);
+    tvmrt_engine_shutdown();
+    TEST("批处理器: 8 个并发请求合批执行，结果正确", ok);
+
+    // 函数表下标越界: 绑定失败，状态清零，destroy 可以安全调用
+    tvmrt_model_desc_t bad = rt_model;
+    bad.cpu_func_count = 0;
+    ok = tvmrt_batcher_init(&batcher, &bad, &bcfg) == -1 && batcher.plans == NULL &&
+         batcher.storage == NULL;
+    tvmrt_batcher_destroy(&batcher);
+    bcfg.max_batch = 0;
+    ok &= tvmrt_batcher_init(&batcher, &rt_model, &bcfg) == -1;
+    TEST("批处理器: 初始化失败返回 -1 并清零状态，随后 destroy 无操作", ok);
+  }
+
+  // 批处理器关闭时仍有提交线程阻塞: 执行中的请求完成，排队的请求返回 -1，
+  // destroy 等提交线程全部离开后才释放，之后的提交返回 -1
+  {
+    tvmrt_engine_config_t ecfg = {.num_workers = 1, .mode = TVMRT_ENGINE_LATENCY};
+    tvmrt_batcher_config_t bcfg = {.max_batch = 1, .input_count = 1, .output_count = 1,
+                                   .workspace_size = RT_WS_SIZE};
+    tvmrt_batcher_t batcher;
+    bool ok = tvmrt_engine_init(&ecfg) == 0 && tvmrt_batcher_init(&batcher, &rt_model, &bcfg) == 0;
+    rt_batch_submit_t req[4];
+    __atomic_store_n(&rt_calls, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&rt_gate, 1, __ATOMIC_RELEASE);
+    for (int r = 0; r < 4; r++) {
+      req[r] = (rt_batch_submit_t){.batcher = &batcher, .x = (float)r, .ret = 1};
+      tvmrt_thread_create(&req[r].thread, rt_batch_submit_func, &req[r]);
+    }
+    ok &= rt_wait_calls(1);   // 第一批停在算子中，其余请求排队等待
+    rt_spin_until(tvmrt_time_ns() + 10000000u);
+    tvmrt_thread_t closer;
+    tvmrt_thread_create(&closer, rt_batcher_destroy_func, &batcher);
+    rt_spin_until(tvmrt_time_ns() + 10000000u);
+    __atomic_store_n(&rt_gate, 0, __ATOMIC_RELEASE);
+    tvmrt_thread_join(&closer);
+    int done = 0, rejected = 0;
+    for (int r = 0; r < 4; r++) {
+      tvmrt_thread_join(&req[r].thread);
+      done += req[r].ret == 0 && req[r].y == req[r].x + 2.0f;
+      rejected += req[r].ret == -1;
+    }
+    float x = 1.0f, y = 0.0f;
+    void *in[1] = {&x}, *out[1] = {&y};
+    ok &= done == 1 && rejected == 3 && batcher.plans == NULL &&
+          tvmrt_batcher_submit(&batcher, in, out) == -1 && y == 0.0f;
+    tvmrt_batcher_destroy(&batcher);
+    tvmrt_engine_shutdown();
+    TEST("批处理器: 提交线程阻塞时关闭，等其全部返回后释放，之后提交返回 -1", ok);
+  }
+
+  // 执行计划: LPT 切片分配与依赖表 (分配数组随计划预留，重复建立依赖不再占用 arena)
+  {
+    static uint8_t ws[RT_WS_SIZE] __attribute__((aligned(64)));
+    tvmrt_op_exec_t execs[5];
+    tvmrt_op_args_t args[5];
+    float x = 1.0f, y = 0.0f;
+    void *in[1] = {&x}, *out[1] = {&y};
+    tvmrt_context_t ctx = {.workspace = ws, .op_execs = execs, .op_count = 5, .args_storage = args};
+    tvmrt_arena_t arena;
+    tvmrt_plan_t plan = {0};
+    bool ok = tvmrt_arena_init(&arena, 1 << 20, TVMRT_HUGEPAGE_NONE) == 0 &&
+              tvmrt_semantic_bind_args(&rt_model, args, in, 1, out, 1, ws, NULL) == 0 &&
+              tvmrt_semantic_init(&ctx, &rt_model) == 0 &&
+              tvmrt_plan_reserve(&plan, &ctx, &rt_schedule, &arena) == 0 &&
+              tvmrt_plan_compile(&plan, &ctx, &rt_schedule) == 0;
+    // 第 0 层代价 4,3,2,1: LPT 得到 {0,3} 与 {1,2}，两个切片负载均为 5
+    uint64_t cost[5] = {4, 3, 2, 1, 1};
+    ok &= tvmrt_plan_assign(&plan, cost, 2) == 0 && plan.slot_count == 2 && plan.slot_active == 2;
+    const int32_t *row = plan.slice_begin;
+    ok &= row[1] - row[0] == 2 && row[2] - row[1] == 2 && plan.slice_pos[row[0]] == 0 &&
+          plan.slice_pos[row[0] + 1] == 3 && plan.slice_pos[row[1]] == 1 &&
+          plan.slice_pos[row[1] + 1] == 2;
+    ok &= tvmrt_plan_assign(&plan, cost, 0) == -1 &&
+          tvmrt_plan_assign(&plan, cost, TVMRT_PLAN_MAX_SLOTS + 1) == -1;
+    TEST("LPT 切片分配按代价均衡，切片数越界返回 -1", ok);
+
+    // 第 1 层的算子只读槽位 0: 唯一的前驱是写槽位 0 的算子
+    ok = tvmrt_plan_build_deps(&plan, &rt_model) == 0 && plan.dataflow &&
+         plan.dep_begin[5] == 1 && plan.dep_begin[4] == 0 && plan.dep_list[0] == 0;
+    uint64_t used = arena.used;
+    ok &= tvmrt_plan_build_deps(&plan, &rt_model) == 0 && arena.used == used &&
+          plan.dep_begin[5] == 1;
+    ok &= tvmrt_plan_run(&plan) == 0 && y == 3.0f;
+    tvmrt_plan_destroy(&plan);
+    tvmrt_arena_destroy(&arena);
+    TEST("依赖表: 前驱正确，重复建立不再从 arena 分配", ok);
+  }
+
+  // 线程池扩缩容: 已分配切片的计划在下次执行时按新的切片数重新分配
+  {
+    bool ok = tvmrt_engine_resize(2) == -1 && tvmrt_engine_num_workers() == 0 &&
+              tvmrt_cpu_count() >= 1;
+    tvmrt_engine_config_t ecfg = {.num_workers = 1, .mode = TVMRT_ENGINE_LATENCY};
+    tvmrt_context_pool_config_t cfg1 = {.context_count = 1, .input_count = 1,
+                                        .output_count = 1, .workspace_size = RT_WS_SIZE};
+    tvmrt_context_pool_t pool;
+    ok &= tvmrt_engine_init(&ecfg) == 0 && tvmrt_context_pool_init(&pool, &rt_model, &cfg1) == 0 &&
+          pool.plans[0].slot_count == 1 + TVMRT_CALLER_PARTICIPATES;
+    float x = 1.0f, y = 0.0f;
+    void *in[1] = {&x}, *out[1] = {&y};
+    // 最宽层 4 个算子: 切片数截断到 4
+    const int32_t sizes[4] = {3, 8, 0, 1};
+    for (int k = 0; k < 4; k++) {
+      int32_t want = sizes[k] + TVMRT_CALLER_PARTICIPATES;
+      if (sizes[k] == 0) want = pool.plans[0].slot_count;   // 没有 Worker 时串行执行，计划不变
+      if (want > 4) want = 4;
+      y = 0.0f;
+      ok &= tvmrt_engine_resize(sizes[k]) == 0 && tvmrt_engine_num_workers() == sizes[k] &&
+            tvmrt_context_pool_run(&pool, in, out) == 0 && y == 3.0f &&
+            pool.plans[0].slot_count == want;
+    }
+    tvmrt_context_pool_destroy(&pool);
+    tvmrt_engine_shutdown();
+    TEST("扩缩容后计划切片数跟随线程池，结果不变；未初始化时 resize 返回 -1", ok);
+  }
+
+  // 逐算子剖析: 多个提交线程各用自己的计数器组，调用次数完整计入
+  {
+    tvmrt_engine_config_t ecfg = {.num_workers = 1, .mode = TVMRT_ENGINE_LATENCY};
+    tvmrt_context_pool_config_t pcfg = {.context_count = 3, .input_count = 1,
+                                        .output_count = 1, .workspace_size = RT_WS_SIZE};
+    tvmrt_context_pool_t pool;
+    tvmrt_profile_t prof;
+    bool ok = tvmrt_engine_init(&ecfg) == 0 && tvmrt_context_pool_init(&pool, &rt_model, &pcfg) == 0 &&
+              tvmrt_profile_init(&prof, rt_model.op_count, NULL) == 0;
+    tvmrt_engine_set_profile(&prof);
+    rt_request_t req[3];
+    for (int round = 0; round < 10; round++) {
+      for (int r = 0; r < 3; r++) rt_request_start(&req[r], &pool, (float)r);
+      for (int r = 0; r < 3; r++) {
+        tvmrt_thread_join(&req[r].thread);
+        ok &= req[r].ret == 0 && req[r].y == req[r].x + 2.0f;
+      }
+    }
+    tvmrt_engine_set_profile(NULL);
+    for (int i = 0; i < rt_model.op_count; i++) {
+      ok &= prof.ops[i].calls == 30 && prof.ops[i].counted_calls <= prof.ops[i].calls &&
+            prof.ops[i].scaled_calls <= prof.ops[i].counted_calls;
+    }
+    tvmrt_profile_destroy(&prof);
+    tvmrt_context_pool_destroy(&pool);
+    tvmrt_engine_shutdown();
+    TEST("剖析: 30 个提交线程的请求逐算子计入 30 次调用", ok);
+  }
+
+  // 内存规划: 同层并发写入的张量互不重叠，separation 让各输出独占缓存行
+  {
+    tvmrt_tensor_map_entry_t planned[4];
+    int32_t ws_size = 0;
+    bool ok = tvmrt_memory_plan(&rt_model, 0, planned, &ws_size) == 0;
+    for (int i = 0; i < 4 && ok; i++) {
+      ok &= planned[i].sid == i && planned[i].offset % 64 == 0 &&
+            planned[i].offset + planned[i].size <= ws_size;
+      for (int j = 0; j < i; j++) ok &= planned[i].offset != planned[j].offset;
+    }
+    int32_t compact = ws_size;
+    ok &= tvmrt_memory_plan(&rt_model, 64, planned, &ws_size) == 0 && ws_size >= 4 * 64 &&
+          ws_size >= compact;
+    for (int i = 0; i < 4; i++) ok &= planned[i].offset % 64 == 0;
+    ok &= tvmrt_memory_plan(&rt_model, 48, planned, &ws_size) == -1 &&
+          tvmrt_memory_plan(&rt_model, -64, planned, &ws_size) == -1 &&
+          tvmrt_memory_plan(NULL, 0, planned, &ws_size) == -1;
+    TEST("内存规划: 生命周期重叠的张量不共享偏移，非法 separation 返回 -1", ok);
+  }
+
+  // 常量分页: 预取请求排队不丢失，内存上限下释放已完成层，结果不变
+  {
+    const char *path = "/tmp/tvmrt_test_pager.bin";
+    static float w[PG_LAYERS * PG_FLOATS];
+    for (int i = 0; i < PG_LAYERS * PG_FLOATS; i++) w[i] = (float)(i / PG_FLOATS + 1);
+    FILE *f = fopen(path, "wb");
+    bool ok = f && fwrite(w, sizeof(w), 1, f) == 1;
+    if (f) fclose(f);
+
+    tvmrt_op_desc_t descs[PG_LAYERS];
+    int32_t order[PG_LAYERS];
+    tvmrt_schedule_layer_t layers[PG_LAYERS];
+    tvmrt_op_exec_t execs[PG_LAYERS];
+    pg_args_t args[PG_LAYERS];
+    float sums[PG_LAYERS];
+    for (int l = 0; l < PG_LAYERS; l++) {
+      descs[l] = (tvmrt_op_desc_t){.op_id = l, .name = "pg_sum", .output_count = 1,
+                                   .const_offset = l * PG_FLOATS * 4,
+                                   .const_size = PG_FLOATS * 4};
+      order[l] = l;
+      layers[l] = (tvmrt_schedule_layer_t){&order[l], 1};
+    }
+    tvmrt_schedule_desc_t sched = {layers, PG_LAYERS};
+    tvmrt_model_desc_t model = {.op_descs = descs, .op_count = PG_LAYERS, .schedule = &sched};
+    uint64_t page = tvmrt_page_size();
+
+    for (int io = 0; io <= 1 && ok; io++) {
+      tvmrt_pager_config_t cfg = {.path = path, .memory_cap = 1, .io_thread = io != 0};
+      tvmrt_pager_t pager;
+      ok &= tvmrt_pager_open(&pager, &cfg, &model) == 0;
+      if (!ok) break;
+      tvmrt_context_t ctx = {.op_execs = execs, .op_count = PG_LAYERS};
+      tvmrt_pager_attach(&pager, &ctx);
+      for (int l = 0; l < PG_LAYERS; l++) {
+        args[l] = (pg_args_t){&ctx, descs[l].const_offset, &sums[l]};
+        execs[l] = (tvmrt_op_exec_t){"pg_sum", pg_sum, &args[l]};
+      }
+      // 4KB 页时相邻层共享边界页 (大页系统上各层可能落在同一页内)
+      if (page == 4096) {
+        ok &= pager.spans[1].begin == 4096 && pager.spans[0].end == 8192;
+      }
+      for (int r = 0; r < 3 && ok; r++) {
+        ok &= tvmrt_engine_run_single(&ctx, &sched) == 0;
+        for (int l = 0; l < PG_LAYERS; l++) ok &= sums[l] == (float)((l + 1) * PG_FLOATS);
+      }
+      // 最后一层执行时只保留当前层与下一次推理的第 0 层
+      ok &= pager.release_count > 0 && pager.resident[0] && pager.resident[PG_LAYERS - 1] &&
+            !pager.resident[1] && !pager.resident[2] &&
+            pager.peak_resident_bytes >= pager.resident_bytes;
+      if (io) {
+        // 第 1、2 层已被释放: 一次回调连续请求两层，两个请求都排队，由 I/O 线程逐个取走
+        ctx.layer_hook(1, ctx.layer_hook_user);
+        tvmrt_mutex_lock(&pager.mutex);
+        ok &= pager.io_count <= PG_LAYERS;
+        tvmrt_mutex_unlock(&pager.mutex);
+        uint64_t until = tvmrt_time_ns() + 2000000000u;
+        int32_t left = 1;
+        while (left > 0 && tvmrt_time_ns() < until) {
+          tvmrt_mutex_lock(&pager.mutex);
+          left = pager.io_count;
+          tvmrt_mutex_unlock(&pager.mutex);
+          tvmrt_thread_yield();
+        }
+        ok &= left == 0 && pager.resident[1] && pager.resident[2];
+      }
+      tvmrt_pager_close(&pager);
+    }
+    tvmrt_pager_config_t missing = {.path = "/tmp/tvmrt_test_pager_missing.bin"};
+    tvmrt_pager_t pager;
+    ok &= tvmrt_pager_open(&pager, &missing, &model) == -1 &&
+          tvmrt_pager_open(&pager, NULL, &model) == -1;
+    remove(path);
+    TEST("常量分页: 内存上限下逐层释放，预取请求全部完成，文件不存在返回 -1", ok);
+  }
+
   // 汇总
   printf("\n========================================\n");
   printf("  测试结果: %d 通过, %d 失败\n", passed, failed);
@@ -9,6 +9,8 @@
  */
 
 #include "tvmrt.h"
+#include <math.h>
+#include <stdio.h>
 #include <string.h>
 #include <stdint.h>
 
@@ -117,284 +119,4307 @@ void* tvmrt_semantic_resolve_sid(
     return NULL;
 }
 
+// 张量映射表是否按 SID 严格升序 (生成的模型均如此, 可二分查找)
+static bool semantic_map_sorted(const tvmrt_tensor_map_entry_t* map, int32_t count) {
+    for (int32_t i = 1; i < count; i++) {
+        if (map[i - 1].sid >= map[i].sid) return false;
+    }
+    return true;
+}
+
+// 查找 SID 所在条目下标，未找到返回 -1 (有序时二分，否则线性)
+static int32_t semantic_find_sid(
+    const tvmrt_tensor_map_entry_t* map, int32_t count, bool sorted, int32_t sid
+) {
+    if (!sorted) {
+        for (int32_t i = 0; i < count; i++) {
+            if (map[i].sid == sid) return i;
+        }
+        return -1;
+    }
+    int32_t lo = 0, hi = count;
+    while (lo < hi) {
+        int32_t mid = lo + (hi - lo) / 2;
+        if (map[mid].sid < sid) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < count && map[lo].sid == sid) ? lo : -1;
+}
+
 int tvmrt_semantic_init(
     tvmrt_context_t* ctx,
     const tvmrt_model_desc_t* model
 ) {
-    if (!ctx || !model) {
+    if (!ctx || !model || !ctx->op_execs || !ctx->args_storage) {
         return -1;
     }
     
-    // 基本初始化（具体参数填充由 model_data.c 中的函数完成）
+    tvmrt_op_args_t* args = (tvmrt_op_args_t*)ctx->args_storage;
+    for (int32_t i = 0; i < model->op_count; i++) {
+        const tvmrt_op_desc_t* desc = &model->op_descs[i];
+        if (desc->func_entry_id < 0 || desc->func_entry_id >= model->cpu_func_count) {
+            return -1;
+        }
+        ctx->op_execs[i].name = desc->name;
+        ctx->op_execs[i].func = model->cpu_func_table[desc->func_entry_id];
+        ctx->op_execs[i].args = &args[i];
+    }
     ctx->op_count = model->op_count;
     
     return 0;
 }
 
-// ============================================================
-// 调度引擎实现
-// ============================================================
-
-#if TVMRT_NUM_WORKERS > 0
+// 解析单个 SID: 外部输入/输出缓冲区、算子常量区或 workspace 槽位
+static void* semantic_resolve_io(
+    const tvmrt_model_desc_t* model,
+    bool sorted,
+    int32_t sid,
+    void* const* inputs,
+    int32_t input_count,
+    void* const* outputs,
+    int32_t output_count,
+    uint8_t* workspace,
+    const uint8_t* op_const
+) {
+    if (sid == TVMRT_SID_CONST) {
+        return (void*)op_const;
+    }
+    if (sid <= TVMRT_SID_OUTPUT_BASE) {
+        int32_t idx = TVMRT_SID_OUTPUT_BASE - sid;
+        return (idx < output_count) ? outputs[idx] : NULL;
+    }
+    if (sid <= TVMRT_SID_INPUT_BASE) {
+        int32_t idx = TVMRT_SID_INPUT_BASE - sid;
+        return (idx < input_count) ? inputs[idx] : NULL;
+    }
+    if (!model->tensor_map || !workspace || sid < 0) {
+        return NULL;
+    }
+    int32_t t = semantic_find_sid(model->tensor_map, model->tensor_count, sorted, sid);
+    return (t >= 0) ? workspace + model->tensor_map[t].offset : NULL;
+}
 
-typedef struct {
-    tvmrt_thread_t workers[TVMRT_NUM_WORKERS];
-    tvmrt_layer_queue_t task_queue;
-    tvmrt_barrier_t layer_barrier;
-    
-    tvmrt_context_t* current_ctx;
-    const tvmrt_schedule_desc_t* current_schedule;
-    int32_t current_layer_idx;
-    
-    bool shutdown;
-    bool initialized;
-} engine_state_t;
+int tvmrt_semantic_bind_args(
+    const tvmrt_model_desc_t* model,
+    tvmrt_op_args_t* args,
+    void* const* inputs,
+    int32_t input_count,
+    void* const* outputs,
+    int32_t output_count,
+    uint8_t* workspace,
+    const uint8_t* const_workspace
+) {
+    if (!model || !args) {
+        return -1;
+    }
 
-static engine_state_t g_engine = {0};
+    bool sorted = model->tensor_map && semantic_map_sorted(model->tensor_map, model->tensor_count);
+    for (int32_t i = 0; i < model->op_count; i++) {
+        const tvmrt_op_desc_t* desc = &model->op_descs[i];
+        tvmrt_op_args_t* a = &args[i];
+        memset(a, 0, sizeof(*a));
 
-// Worker 线程函数
-static void* worker_func(void* arg) {
-    int worker_id = (int)(intptr_t)arg;
-    
-    while (1) {
-        int32_t op_id = -1;
-        
-        // 阻塞获取任务
-        tvmrt_mutex_lock(&g_engine.task_queue.mutex);
-        
-        while (g_engine.task_queue.count == 0 && !g_engine.shutdown) {
-            tvmrt_cond_wait(&g_engine.task_queue.cond, &g_engine.task_queue.mutex);
-        }
-        
-        if (g_engine.shutdown) {
-            tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
-            break;
+        if (desc->input_count > TVMRT_MAX_OP_INPUTS ||
+            desc->output_count > TVMRT_MAX_OP_OUTPUTS) {
+            return -1;
         }
-        
-        // 从队列头取任务
-        op_id = g_engine.task_queue.tasks[g_engine.task_queue.head];
-        g_engine.task_queue.head++;
-        g_engine.task_queue.count--;
-        
-        // 链式唤醒下一个 Worker
-        if (g_engine.task_queue.count > 0) {
-            tvmrt_cond_signal(&g_engine.task_queue.cond);
+        const uint8_t* op_const = const_workspace ? const_workspace + desc->const_offset : NULL;
+        for (int32_t k = 0; k < desc->input_count; k++) {
+            a->inputs[k] = semantic_resolve_io(model, sorted, desc->input_sids[k], inputs, input_count,
+                                               outputs, output_count, workspace, op_const);
+            if (!a->inputs[k]) return -1;
         }
-        
-        tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
-        
-        // 执行算子（在锁外）
-        tvmrt_context_t* ctx = g_engine.current_ctx;
-        if (op_id >= 0 && op_id < ctx->op_count) {
-            tvmrt_op_exec_t* exec = &ctx->op_execs[op_id];
-            if (exec->func) {
-                // 调度引擎日志已禁用，由包装函数中的参数日志替代
-                // TVMRT_LOG_OP_START(op_id, exec->name, worker_id);
-                int32_t ret = exec->func(exec->args);
-                // TVMRT_LOG_OP_END(op_id, exec->name, worker_id, ret);
-                (void)ret;  // 避免未使用变量警告
-            }
+        for (int32_t k = 0; k < desc->output_count; k++) {
+            a->outputs[k] = semantic_resolve_io(model, sorted, desc->output_sids[k], inputs, input_count,
+                                                outputs, output_count, workspace, NULL);
+            if (!a->outputs[k]) return -1;
         }
-        
-        // 通知完成
-        tvmrt_barrier_arrive(&g_engine.layer_barrier);
+        a->const_ws = (uint8_t*)const_workspace;
+        a->ws = workspace;
     }
-    
-    return NULL;
+
+    return 0;
 }
 
-#endif  // TVMRT_NUM_WORKERS > 0
+// ============================================================
+// 内存规划实现
+// ============================================================
 
-// 引擎 API 实现
-int tvmrt_engine_init(void) {
-#if TVMRT_NUM_WORKERS > 0
-    if (g_engine.initialized) {
-        return 0;
-    }
-    
-    // 初始化任务队列
-    if (tvmrt_mutex_init(&g_engine.task_queue.mutex) != TVMRT_OK) {
+static int32_t mem_plan_round_up(int32_t v, int32_t a) {
+    return (v + a - 1) / a * a;
+}
+
+int tvmrt_tensor_map_retype(
+    const tvmrt_tensor_map_entry_t* map,
+    int32_t count,
+    const tvmrt_dtype_t* dtypes,
+    tvmrt_tensor_map_entry_t* out_map
+) {
+    if (!map || !dtypes || !out_map || count < 0) {
         return -1;
     }
-    if (tvmrt_cond_init(&g_engine.task_queue.cond) != TVMRT_OK) {
-        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+    for (int32_t i = 0; i < count; i++) {
+        int32_t from = tvmrt_dtype_size(map[i].dtype);
+        int32_t to = tvmrt_dtype_size(dtypes[i]);
+        if (map[i].size % from != 0) {
+            return -1;
+        }
+        out_map[i] = map[i];
+        out_map[i].size = map[i].size / from * to;
+        out_map[i].dtype = dtypes[i];
+    }
+    return 0;
+}
+
+int tvmrt_memory_plan(
+    const tvmrt_model_desc_t* model,
+    int32_t separation,
+    tvmrt_tensor_map_entry_t* out_map,
+    int32_t* out_ws_size
+) {
+    if (!model || !model->schedule || !out_map || !out_ws_size || model->tensor_count < 0 ||
+        separation < 0 || (separation & (separation - 1)) != 0) {
         return -1;
     }
-    g_engine.task_queue.head = 0;
-    g_engine.task_queue.tail = 0;
-    g_engine.task_queue.count = 0;
-    
-    // 初始化 barrier
-    if (tvmrt_barrier_init(&g_engine.layer_barrier) != TVMRT_OK) {
-        tvmrt_cond_destroy(&g_engine.task_queue.cond);
-        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+
+    // 临时数组一次分配: first/last/align/reserve/order/offset 各 n 个 int32, hot/placed 各 n 个 bool
+    int32_t n = model->tensor_count;
+    int32_t* first = (int32_t*)tvmrt_mem_alloc((uint64_t)(n ? n : 1) * (6 * sizeof(int32_t) + 2), 8);
+    if (!first) {
         return -1;
     }
-    
-    g_engine.shutdown = false;
-    g_engine.current_schedule = NULL;
-    g_engine.current_ctx = NULL;
-    
-    // 创建 Worker 线程
-    for (int i = 0; i < TVMRT_NUM_WORKERS; i++) {
-        if (tvmrt_thread_create(&g_engine.workers[i], worker_func, (void*)(intptr_t)i) != TVMRT_OK) {
-            g_engine.shutdown = true;
-            tvmrt_cond_broadcast(&g_engine.task_queue.cond);
-            for (int j = 0; j < i; j++) {
-                tvmrt_thread_join(&g_engine.workers[j]);
-            }
-            tvmrt_barrier_destroy(&g_engine.layer_barrier);
-            tvmrt_cond_destroy(&g_engine.task_queue.cond);
-            tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
-            return -1;
+    int32_t* last = first + n;
+    int32_t* align = last + n;
+    int32_t* reserve = align + n;
+    int32_t* order = reserve + n;
+    int32_t* offset = order + n;
+    bool* hot = (bool*)(offset + n);
+    bool* placed = hot + n;
+    bool sorted = semantic_map_sorted(model->tensor_map, n);
+    for (int32_t i = 0; i < n; i++) {
+        first[i] = INT32_MAX;
+        last[i] = -1;
+        hot[i] = false;
+    }
+
+    // 生命周期: 以层为时间单位，读写都延长区间
+    const tvmrt_schedule_desc_t* schedule = model->schedule;
+    for (int32_t l = 0; l < schedule->layer_count; l++) {
+        const tvmrt_schedule_layer_t* layer = &schedule->layers[l];
+        for (int32_t k = 0; k < layer->count; k++) {
+            int32_t op_idx = layer->op_indices[k];
+            if (op_idx < 0 || op_idx >= model->op_count) continue;
+            const tvmrt_op_desc_t* desc = &model->op_descs[op_idx];
+            for (int32_t a = 0; a < desc->input_count + desc->output_count; a++) {
+                bool is_out = (a >= desc->input_count);
+                int32_t sid = is_out ? desc->output_sids[a - desc->input_count] : desc->input_sids[a];
+                int32_t t = semantic_find_sid(model->tensor_map, n, sorted, sid);
+                if (t < 0) continue;  // 外部输入/输出
+                first[t] = (l < first[t]) ? l : first[t];
+                last[t] = (l > last[t]) ? l : last[t];
+                hot[t] |= (is_out && layer->count > 1);
+            }
         }
     }
-    
-    g_engine.initialized = true;
-#endif
+
+    // 每个张量实际占用的对齐与字节数
+    for (int32_t i = 0; i < n; i++) {
+        const tvmrt_tensor_map_entry_t* e = &model->tensor_map[i];
+        align[i] = (e->align > 0) ? e->align : 1;
+        reserve[i] = e->size;
+        if (hot[i] && separation > 0) {
+            align[i] = (align[i] > separation) ? align[i] : separation;
+            reserve[i] = mem_plan_round_up(e->size, separation);
+        }
+        if (last[i] < 0) {
+            first[i] = 0;  // 未被访问: 保守地视为全程存活
+            last[i] = schedule->layer_count;
+        }
+        // 按占用字节降序 (插入排序)
+        int32_t j = i;
+        while (j > 0 && reserve[order[j - 1]] < reserve[i]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    // 首次适配: 在生命周期相交的已放置张量之间找最低可用偏移
+    memset(placed, 0, (size_t)n * sizeof(bool));
+    int32_t ws_size = 0;
+    for (int32_t k = 0; k < n; k++) {
+        int32_t t = order[k];
+        int32_t off = 0;
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            off = mem_plan_round_up(off, align[t]);
+            for (int32_t o = 0; o < n; o++) {
+                if (!placed[o] || last[o] < first[t] || last[t] < first[o]) continue;
+                if (off < offset[o] + reserve[o] && offset[o] < off + reserve[t]) {
+                    off = offset[o] + reserve[o];
+                    moved = true;
+                }
+            }
+        }
+        offset[t] = off;
+        placed[t] = true;
+        ws_size = (off + reserve[t] > ws_size) ? off + reserve[t] : ws_size;
+    }
+
+    for (int32_t i = 0; i < n; i++) {
+        out_map[i] = model->tensor_map[i];
+        out_map[i].offset = offset[i];
+        out_map[i].align = align[i];
+    }
+    *out_ws_size = ws_size;
+    tvmrt_mem_free(first);
+
     return 0;
 }
 
-void tvmrt_engine_shutdown(void) {
-#if TVMRT_NUM_WORKERS > 0
-    if (!g_engine.initialized) {
-        return;
+// ============================================================
+// 量化实现
+// ============================================================
+
+int tvmrt_quant_multiplier(double real, tvmrt_requant_t* out) {
+    if (!out || !(real > 0.0) || real >= (double)(1 << 30)) {
+        return -1;
     }
-    
-    // 发送停机信号
-    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
-    g_engine.shutdown = true;
-    tvmrt_cond_broadcast(&g_engine.task_queue.cond);
-    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
-    
-    // 等待所有 Worker 完成
-    for (int i = 0; i < TVMRT_NUM_WORKERS; i++) {
-        tvmrt_thread_join(&g_engine.workers[i]);
+    int exp = 0;
+    double q = frexp(real, &exp);  // real = q * 2^exp, q ∈ [0.5, 1)
+    int64_t m = llround(q * (double)(1ll << 31));
+    if (m == (1ll << 31)) {
+        m /= 2;
+        exp++;
     }
-    
-    // 清理
-    tvmrt_barrier_destroy(&g_engine.layer_barrier);
-    tvmrt_cond_destroy(&g_engine.task_queue.cond);
-    tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
-    
-    g_engine.initialized = false;
-#endif
+    out->multiplier = (int32_t)m;
+    out->shift = -exp;
+    // 右移总位数 31 + shift 需在 [1, 62] 内，过小的乘子视为 0
+    if (31 + out->shift > 62) {
+        out->multiplier = 0;
+        out->shift = 31;
+    }
+    return 0;
 }
 
-#if TVMRT_NUM_WORKERS > 0
-// 辅助函数：加载下一层任务到队列
-static void load_next_layer(void) {
-    const tvmrt_schedule_layer_t* layer = 
-        &g_engine.current_schedule->layers[g_engine.current_layer_idx];
-    
-    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
-    
-    // 填充队列
-    g_engine.task_queue.head = 0;
-    g_engine.task_queue.tail = layer->count;
-    g_engine.task_queue.count = layer->count;
-    for (int32_t i = 0; i < layer->count; i++) {
-        g_engine.task_queue.tasks[i] = layer->op_indices[i];
-    }
-    
-    // 唤醒一个 Worker 开始链式执行
-    if (g_engine.task_queue.count > 0) {
-        tvmrt_cond_signal(&g_engine.task_queue.cond);
+// 映射表中的 int8 张量，找不到或类型不符返回 NULL
+static const tvmrt_tensor_map_entry_t* quant_find_int8(const tvmrt_model_desc_t* model, int32_t sid) {
+    if (!model->tensor_map || sid < 0) return NULL;
+    bool sorted = semantic_map_sorted(model->tensor_map, model->tensor_count);
+    int32_t t = semantic_find_sid(model->tensor_map, model->tensor_count, sorted, sid);
+    if (t < 0 || model->tensor_map[t].dtype != TVMRT_DTYPE_INT8 ||
+        !(model->tensor_map[t].quant.scale > 0.0f)) {
+        return NULL;
     }
-    
-    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
-    
-    g_engine.current_layer_idx++;
+    return &model->tensor_map[t];
 }
-#endif
 
-int tvmrt_engine_run(
-    tvmrt_context_t* ctx,
-    const tvmrt_schedule_desc_t* schedule
+static int32_t quant_clamp_s8(double v) {
+    long r = lround(v);
+    return (int32_t)(r < -128 ? -128 : (r > 127 ? 127 : r));
+}
+
+int tvmrt_quant_prepare_op(
+    const tvmrt_model_desc_t* model,
+    int32_t op_idx,
+    tvmrt_qop_kind_t kind,
+    uint8_t* const_workspace
 ) {
-    if (!ctx || !schedule) {
+    if (!model || !const_workspace || op_idx < 0 || op_idx >= model->op_count) {
         return -1;
     }
-    
-#if TVMRT_NUM_WORKERS > 0
-    if (!g_engine.initialized) {
-        return tvmrt_engine_run_single(ctx, schedule);
+    const tvmrt_op_desc_t* d = &model->op_descs[op_idx];
+    if (d->const_size < (int32_t)sizeof(tvmrt_qattrs_t) || d->output_count < 1) {
+        return -1;
     }
-    
-    // 设置全局状态
-    g_engine.current_ctx = ctx;
-    g_engine.current_schedule = schedule;
-    g_engine.current_layer_idx = 0;
-    
-    // 逐层执行
-    for (int32_t layer_idx = 0; layer_idx < schedule->layer_count; layer_idx++) {
-        const tvmrt_schedule_layer_t* layer = &schedule->layers[layer_idx];
+    tvmrt_qattrs_t* at = (tvmrt_qattrs_t*)(const_workspace + d->const_offset);
+    const tvmrt_tensor_map_entry_t* in0 = quant_find_int8(model, d->input_sids[0]);
+    const tvmrt_tensor_map_entry_t* out = quant_find_int8(model, d->output_sids[0]);
+    at->act_min = -128;
+    at->act_max = 127;
 
-        // 层边界标记
-        printf("=== Layer %d (%d op%s) ===\n",
-               layer_idx + 1, layer->count, layer->count == 1 ? "" : "s");
+    switch (kind) {
+    case TVMRT_QOP_QUANTIZE:
+        if (!out) return -1;
+        at->scale = out->quant.scale;
+        at->out_zp = out->quant.zero_point;
+        return 0;
+    case TVMRT_QOP_DEQUANTIZE:
+        if (!in0) return -1;
+        at->scale = in0->quant.scale;
+        at->in_zp[0] = in0->quant.zero_point;
+        return 0;
+    default:
+        break;
+    }
+    if (!in0 || !out) return -1;
+    double s_in = in0->quant.scale, s_out = out->quant.scale;
+    at->in_zp[0] = in0->quant.zero_point;
+    at->out_zp = out->quant.zero_point;
 
-        if (layer->count == 0) {
-            continue;
+    switch (kind) {
+    case TVMRT_QOP_ADD:
+    case TVMRT_QOP_MUL: {
+        const tvmrt_tensor_map_entry_t* in1 =
+            (d->input_count >= 2) ? quant_find_int8(model, d->input_sids[1]) : NULL;
+        if (!in1) return -1;
+        double s_in1 = in1->quant.scale;
+        at->in_zp[1] = in1->quant.zero_point;
+        if (kind == TVMRT_QOP_MUL) {
+            return tvmrt_quant_multiplier(s_in * s_in1 / s_out, &at->out_rq);
         }
-
-        if (layer->count == 1) {
-            // 单任务: 直接执行
-            int32_t op_idx = layer->op_indices[0];
-            if (op_idx >= 0 && op_idx < ctx->op_count) {
-                tvmrt_op_exec_t* exec = &ctx->op_execs[op_idx];
-                if (exec->func) {
-                    // 调度引擎日志已禁用，由包装函数中的参数日志替代
-                    // TVMRT_LOG_OP_START(op_idx, exec->name, -1);
-                    int32_t ret = exec->func(exec->args);
-                    // TVMRT_LOG_OP_END(op_idx, exec->name, -1, ret);
-                    if (ret != 0) return ret;
-                }
-            }
-        } else {
-            // 多任务: 填充队列并等待完成
-            tvmrt_barrier_reset(&g_engine.layer_barrier, layer->count);
-            load_next_layer();
-            tvmrt_barrier_sync(&g_engine.layer_barrier);
+        // 两输入先对齐到 2 × 较大尺度，再从该尺度 (含左移) 重量化到输出
+        double twice_max = 2.0 * (s_in > s_in1 ? s_in : s_in1);
+        int ret = tvmrt_quant_multiplier(s_in / twice_max, &at->in_rq[0]);
+        ret |= tvmrt_quant_multiplier(s_in1 / twice_max, &at->in_rq[1]);
+        ret |= tvmrt_quant_multiplier(twice_max / ((double)(1 << TVMRT_QUANT_LEFT_SHIFT) * s_out),
+                                      &at->out_rq);
+        return ret;
+    }
+    case TVMRT_QOP_RELU:
+    case TVMRT_QOP_RELU6:
+        at->act_min = quant_clamp_s8(at->out_zp);
+        if (kind == TVMRT_QOP_RELU6) {
+            at->act_max = quant_clamp_s8(at->out_zp + 6.0 / s_out);
         }
+        return tvmrt_quant_multiplier(s_in / ((double)(1 << TVMRT_QUANT_LEFT_SHIFT) * s_out),
+                                      &at->out_rq);
+    case TVMRT_QOP_SIGMOID:
+    case TVMRT_QOP_TANH: {
+        if (at->weight_offset == 0) at->weight_offset = (int32_t)sizeof(tvmrt_qattrs_t);
+        if (at->weight_offset + 256 > d->const_size) return -1;
+        int8_t* lut = (int8_t*)at + at->weight_offset;
+        for (int32_t q = -128; q <= 127; q++) {
+            double x = s_in * (q - at->in_zp[0]);
+            double y = (kind == TVMRT_QOP_SIGMOID) ? 1.0 / (1.0 + exp(-x)) : tanh(x);
+            lut[q + 128] = (int8_t)quant_clamp_s8(y / s_out + at->out_zp);
+        }
+        return 0;
     }
-    
-    return 0;
-#else
-    return tvmrt_engine_run_single(ctx, schedule);
-#endif
-}
-
-int tvmrt_engine_run_single(
-    tvmrt_context_t* ctx,
-    const tvmrt_schedule_desc_t* schedule
-) {
-    if (!ctx || !schedule) {
+    case TVMRT_QOP_MATMUL:
+    case TVMRT_QOP_MATMUL_RELU:
+        if (!(d->weight_quant.scale > 0.0f)) return -1;
+        at->weight_zp = d->weight_quant.zero_point;
+        if (kind == TVMRT_QOP_MATMUL_RELU) {
+            at->act_min = quant_clamp_s8(at->out_zp);
+        }
+        return tvmrt_quant_multiplier(s_in * d->weight_quant.scale / s_out, &at->out_rq);
+    default:
         return -1;
     }
+}
 
-    // 简单串行执行
-    for (int32_t layer_idx = 0; layer_idx < schedule->layer_count; layer_idx++) {
-        const tvmrt_schedule_layer_t* layer = &schedule->layers[layer_idx];
-
-        // 层边界标记
-        printf("=== Layer %d (%d op%s) ===\n",
-               layer_idx + 1, layer->count, layer->count == 1 ? "" : "s");
+// ============================================================
+// 半精度存储实现
+// ============================================================
 
-        for (int32_t task_idx = 0; task_idx < layer->count; task_idx++) {
-            int32_t op_idx = layer->op_indices[task_idx];
-            if (op_idx >= 0 && op_idx < ctx->op_count) {
-                tvmrt_op_exec_t* exec = &ctx->op_execs[op_idx];
-                if (exec->func) {
-                    // 调度引擎日志已禁用，由包装函数中的参数日志替代
-                    // TVMRT_LOG_OP_START(op_idx, exec->name, -1);
-                    int32_t ret = exec->func(exec->args);
-                    // TVMRT_LOG_OP_END(op_idx, exec->name, -1, ret);
-                    if (ret != 0) return ret;
-                }
-            }
-        }
+int32_t tvmrt_dtype_size(tvmrt_dtype_t dtype) {
+    switch (dtype) {
+    case TVMRT_DTYPE_INT8:
+        return 1;
+    case TVMRT_DTYPE_FLOAT16:
+    case TVMRT_DTYPE_BFLOAT16:
+        return 2;
+    default:
+        return 4;
     }
+}
 
-    return 0;
+static uint32_t half_bits_of(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+static float half_float_of(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static float half_f16_to_f32(uint16_t h) {
+    uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+    uint32_t exp = (h >> 10) & 0x1fu;
+    uint32_t man = h & 0x3ffu;
+    if (exp == 0x1fu) {
+        return half_float_of(sign | 0x7f800000u | (man << 13));  // Inf / NaN
+    }
+    if (exp == 0) {
+        // 零与非规格化数: man * 2^-24
+        float v = (float)man * (1.0f / 16777216.0f);
+        return sign ? -v : v;
+    }
+    return half_float_of(sign | ((exp + 112u) << 23) | (man << 13));
+}
+
+static uint16_t half_f32_to_f16(float f) {
+    uint32_t u = half_bits_of(f);
+    uint16_t sign = (uint16_t)((u >> 16) & 0x8000u);
+    uint32_t abs = u & 0x7fffffffu;
+    if (abs >= 0x7f800000u) {
+        return sign | 0x7c00u | (abs > 0x7f800000u ? 0x200u : 0);  // Inf / NaN
+    }
+    if (abs >= 0x477ff000u) {
+        return sign | 0x7c00u;  // 舍入后超出 65504: 溢出为 Inf
+    }
+    if (abs < 0x38800000u) {
+        // 非规格化结果: 按 2^-24 为单位就近偶数舍入
+        float v = half_float_of(abs) * 16777216.0f;
+        return sign | (uint16_t)lrintf(v);
+    }
+    uint32_t man = abs + 0xfffu + ((abs >> 13) & 1u);  // 就近偶数
+    return sign | (uint16_t)((man - 0x38000000u) >> 13);
+}
+
+static uint16_t half_f32_to_bf16(float f) {
+    uint32_t u = half_bits_of(f);
+    if ((u & 0x7fffffffu) > 0x7f800000u) {
+        return (uint16_t)((u >> 16) | 0x40u);  // NaN 保持为静默 NaN
+    }
+    return (uint16_t)((u + 0x7fffu + ((u >> 16) & 1u)) >> 16);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+
+__attribute__((target("f16c,avx"))) static int32_t half_f16_load_f16c(const uint16_t* src,
+                                                                     float* dst, int32_t n) {
+    int32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i*)&src[i]);
+        _mm256_storeu_ps(&dst[i], _mm256_cvtph_ps(h));
+    }
+    return i;
+}
+
+__attribute__((target("f16c,avx"))) static int32_t half_f16_store_f16c(const float* src,
+                                                                      uint16_t* dst, int32_t n) {
+    int32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(&src[i]), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128((__m128i*)&dst[i], h);
+    }
+    return i;
+}
+
+#if defined(__GNUC__) && (__GNUC__ >= 10 || defined(__clang__))
+#define HALF_HAVE_AVX512BF16 1
+__attribute__((target("avx512bf16,avx512f"))) static int32_t half_bf16_store_avx512(
+    const float* src, uint16_t* dst, int32_t n) {
+    int32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256bh h = _mm512_cvtneps_pbh(_mm512_loadu_ps(&src[i]));
+        _mm256_storeu_si256((__m256i*)&dst[i], (__m256i)h);
+    }
+    return i;
+}
+#endif
+
+// CPU 特性检测结果 (首次转换时确定，多线程重复检测结果相同)
+static int g_half_has_f16c = -1;
+static int g_half_has_avx512bf16 = -1;
+
+static void half_detect(void) {
+    if (__atomic_load_n(&g_half_has_f16c, __ATOMIC_RELAXED) >= 0) return;
+    __builtin_cpu_init();
+#ifdef HALF_HAVE_AVX512BF16
+    __atomic_store_n(&g_half_has_avx512bf16, __builtin_cpu_supports("avx512bf16") ? 1 : 0,
+                     __ATOMIC_RELAXED);
+#else
+    __atomic_store_n(&g_half_has_avx512bf16, 0, __ATOMIC_RELAXED);
+#endif
+    __atomic_store_n(&g_half_has_f16c, __builtin_cpu_supports("f16c") ? 1 : 0, __ATOMIC_RELAXED);
+}
+#endif  // x86
+
+void tvmrt_convert_to_f32(const void* src, tvmrt_dtype_t dtype, float* dst, int32_t n) {
+    const uint16_t* h = (const uint16_t*)src;
+    int32_t i = 0;
+    switch (dtype) {
+    case TVMRT_DTYPE_FLOAT16:
+#if defined(__x86_64__) || defined(__i386__)
+        half_detect();
+        if (g_half_has_f16c) i = half_f16_load_f16c(h, dst, n);
+#endif
+        for (; i < n; i++) dst[i] = half_f16_to_f32(h[i]);
+        break;
+    case TVMRT_DTYPE_BFLOAT16:
+        // bf16 即 fp32 的高 16 位: 移位即可 (编译器自动矢量化)
+        for (; i < n; i++) dst[i] = half_float_of((uint32_t)h[i] << 16);
+        break;
+    default:
+        memcpy(dst, src, (size_t)n * sizeof(float));
+        break;
+    }
+}
+
+void tvmrt_convert_from_f32(const float* src, void* dst, tvmrt_dtype_t dtype, int32_t n) {
+    uint16_t* h = (uint16_t*)dst;
+    int32_t i = 0;
+    switch (dtype) {
+    case TVMRT_DTYPE_FLOAT16:
+#if defined(__x86_64__) || defined(__i386__)
+        half_detect();
+        if (g_half_has_f16c) i = half_f16_store_f16c(src, h, n);
+#endif
+        for (; i < n; i++) h[i] = half_f32_to_f16(src[i]);
+        break;
+    case TVMRT_DTYPE_BFLOAT16:
+#ifdef HALF_HAVE_AVX512BF16
+        half_detect();
+        if (g_half_has_avx512bf16) i = half_bf16_store_avx512(src, h, n);
+#endif
+        for (; i < n; i++) h[i] = half_f32_to_bf16(src[i]);
+        break;
+    default:
+        memcpy(dst, src, (size_t)n * sizeof(float));
+        break;
+    }
+}
+
+// 算子某个张量的存储类型: 映射表中的 dtype，外部输入输出为 fp32
+static tvmrt_dtype_t storage_dtype_of(const tvmrt_model_desc_t* model, bool sorted, int32_t sid) {
+    if (sid < 0 || !model->tensor_map) return TVMRT_DTYPE_FLOAT32;
+    int32_t t = semantic_find_sid(model->tensor_map, model->tensor_count, sorted, sid);
+    return (t >= 0) ? model->tensor_map[t].dtype : TVMRT_DTYPE_FLOAT32;
+}
+
+int tvmrt_storage_prepare_op(
+    const tvmrt_model_desc_t* model,
+    int32_t op_idx,
+    uint8_t* const_workspace
+) {
+    if (!model || !const_workspace || op_idx < 0 || op_idx >= model->op_count) {
+        return -1;
+    }
+    const tvmrt_op_desc_t* d = &model->op_descs[op_idx];
+    if (d->const_size < (int32_t)sizeof(tvmrt_qattrs_t)) {
+        return -1;
+    }
+    tvmrt_qattrs_t* at = (tvmrt_qattrs_t*)(const_workspace + d->const_offset);
+    bool sorted = model->tensor_map && semantic_map_sorted(model->tensor_map, model->tensor_count);
+    for (int32_t k = 0; k < 2; k++) {
+        at->in_dtype[k] = (k < d->input_count) ? storage_dtype_of(model, sorted, d->input_sids[k])
+                                               : TVMRT_DTYPE_FLOAT32;
+    }
+    at->out_dtype = storage_dtype_of(model, sorted, d->output_sids[0]);
+    return 0;
+}
+
+// ============================================================
+// 广播二元运算实现
+// ============================================================
+
+// 视图按 rank 右对齐后第 d 维的长度与步长 (缺失的前导维为 1)
+static void bcast_dim(const tvmrt_view_t* v, int32_t rank, int32_t d, int32_t* size,
+                      int32_t* stride) {
+    int32_t i = d - (rank - v->rank);
+    *size = 1;
+    *stride = 0;
+    if (i < 0) {
+        return;
+    }
+    *size = v->shape[i];
+    if (v->strides) {
+        *stride = v->strides[i];
+        return;
+    }
+    *stride = 1;
+    for (int32_t j = i + 1; j < v->rank; j++) *stride *= v->shape[j];
+}
+
+int tvmrt_broadcast_prepare(
+    tvmrt_bcast_attrs_t* attrs,
+    tvmrt_binary_kind_t kind,
+    const tvmrt_view_t* a,
+    const tvmrt_view_t* b,
+    const tvmrt_view_t* out
+) {
+    const tvmrt_view_t* views[3] = {a, b, out};
+    if (!attrs || !a || !b) {
+        return -1;
+    }
+    int32_t rank = 0;
+    for (int32_t t = 0; t < 3; t++) {
+        if (views[t] && (views[t]->rank < 0 || views[t]->rank > TVMRT_BCAST_MAX_DIMS)) {
+            return -1;
+        }
+        rank = (views[t] && views[t]->rank > rank) ? views[t]->rank : rank;
+    }
+    if (out && out->rank != rank) {
+        return -1;
+    }
+
+    // 1. 广播形状与各张量步长 (长度为 1 的维步长置 0)
+    int32_t shape[TVMRT_BCAST_MAX_DIMS], strides[3][TVMRT_BCAST_MAX_DIMS];
+    int64_t total = 1;
+    for (int32_t d = 0; d < rank; d++) {
+        int32_t n = 1, size[3], stride[3];
+        for (int32_t t = 0; t < 3; t++) {
+            if (!views[t]) continue;
+            bcast_dim(views[t], rank, d, &size[t], &stride[t]);
+            if (size[t] < 0 || (size[t] != 1 && n != 1 && size[t] != n)) return -1;
+            n = (size[t] != 1) ? size[t] : n;
+        }
+        if (out && size[2] != n) {
+            return -1;
+        }
+        shape[d] = n;
+        total *= n;
+        for (int32_t t = 0; t < 3; t++) {
+            strides[t][d] = (views[t] && size[t] != 1) ? stride[t] : 0;
+        }
+    }
+    if (total > INT32_MAX) {
+        return -1;
+    }
+    for (int32_t d = rank - 1, s = 1; !out && d >= 0; d--) {
+        strides[2][d] = (shape[d] != 1) ? s : 0;
+        s *= shape[d];
+    }
+
+    // 2. 去掉长度为 1 的维，合并三个张量中都连续的相邻维
+    memset(attrs, 0, sizeof(*attrs));
+    attrs->kind = kind;
+    int32_t r = 0;
+    for (int32_t d = 0; d < rank; d++) {
+        if (shape[d] == 1) continue;
+        bool merge = (r > 0);
+        for (int32_t t = 0; t < 3 && merge; t++) {
+            int32_t* prev = (t == 0) ? attrs->a_strides : (t == 1) ? attrs->b_strides
+                                                                   : attrs->out_strides;
+            merge = (prev[r - 1] == strides[t][d] * shape[d]);
+        }
+        if (!merge) {
+            attrs->shape[r++] = 1;
+        }
+        attrs->shape[r - 1] *= shape[d];
+        attrs->a_strides[r - 1] = strides[0][d];
+        attrs->b_strides[r - 1] = strides[1][d];
+        attrs->out_strides[r - 1] = strides[2][d];
+    }
+    if (total == 0) {
+        r = 0;
+    }
+    if (r == 0) {
+        attrs->shape[0] = (total == 0) ? 0 : 1;
+        r = 1;
+    }
+    attrs->rank = r;
+    return 0;
+}
+
+// ============================================================
+// 归约实现
+// ============================================================
+
+// 追加一维 (与上一维可连续寻址时合并)
+static void reduce_push_dim(int32_t* rank, int32_t* shape, int32_t* strides, int32_t n,
+                            int32_t stride) {
+    if (*rank > 0 && strides[*rank - 1] == stride * n) {
+        shape[*rank - 1] *= n;
+        strides[*rank - 1] = stride;
+        return;
+    }
+    shape[*rank] = n;
+    strides[*rank] = stride;
+    (*rank)++;
+}
+
+int tvmrt_reduce_prepare(
+    tvmrt_reduce_attrs_t* attrs,
+    tvmrt_reduce_kind_t kind,
+    const tvmrt_view_t* in,
+    const int32_t* axes,
+    int32_t axis_count,
+    int32_t max_parts
+) {
+    if (!attrs || !in || !axes || in->rank < 1 || in->rank > TVMRT_BCAST_MAX_DIMS ||
+        axis_count < 1 || axis_count > in->rank) {
+        return -1;
+    }
+    bool reduced[TVMRT_BCAST_MAX_DIMS] = {false};
+    for (int32_t i = 0; i < axis_count; i++) {
+        int32_t ax = (axes[i] < 0) ? axes[i] + in->rank : axes[i];
+        if (ax < 0 || ax >= in->rank || reduced[ax]) return -1;
+        reduced[ax] = true;
+    }
+
+    memset(attrs, 0, sizeof(*attrs));
+    attrs->kind = kind;
+    attrs->part = -1;
+    int64_t outputs = 1, count = 1;
+    int32_t contiguous[TVMRT_BCAST_MAX_DIMS];
+    for (int32_t d = in->rank - 1, s = 1; d >= 0; d--) {
+        contiguous[d] = s;
+        s *= in->shape[d];
+    }
+    for (int32_t d = 0; d < in->rank; d++) {
+        int32_t n = in->shape[d];
+        int32_t stride = in->strides ? in->strides[d] : contiguous[d];
+        if (n < 0) return -1;
+        if (reduced[d]) {
+            count *= n;
+        } else {
+            outputs *= n;
+        }
+        if (n == 1) continue;
+        if (reduced[d]) {
+            reduce_push_dim(&attrs->red_rank, attrs->red_shape, attrs->red_strides, n, stride);
+        } else {
+            reduce_push_dim(&attrs->keep_rank, attrs->keep_shape, attrs->keep_strides, n, stride);
+        }
+    }
+    if (count == 0 || outputs == 0 || count > INT32_MAX || outputs > INT32_MAX) {
+        return -1;
+    }
+    if (attrs->red_rank == 0) {
+        attrs->red_rank = 1;
+        attrs->red_shape[0] = 1;
+        attrs->red_strides[0] = 1;
+    }
+
+    // 部分 = 按 2 的幂对齐的块组 (块组越大部分越少)
+    attrs->outputs = (int32_t)outputs;
+    attrs->reduce_count = (int32_t)count;
+    attrs->blocks = (int32_t)((count + TVMRT_REDUCE_BLOCK - 1) / TVMRT_REDUCE_BLOCK);
+    int32_t limit = (max_parts > 1) ? max_parts : 1;
+    attrs->group_blocks = 1;
+    while ((attrs->blocks + attrs->group_blocks - 1) / attrs->group_blocks > limit) {
+        attrs->group_blocks *= 2;
+    }
+    attrs->parts = (attrs->blocks + attrs->group_blocks - 1) / attrs->group_blocks;
+    return 0;
+}
+
+int64_t tvmrt_reduce_partial_bytes(const tvmrt_reduce_attrs_t* attrs) {
+    if (!attrs) {
+        return 0;
+    }
+    int64_t size = (attrs->kind == TVMRT_REDUCE_ARGMAX) ? (int64_t)sizeof(tvmrt_argmax_t)
+                                                        : (int64_t)sizeof(float);
+    return (int64_t)attrs->parts * attrs->outputs * size;
+}
+
+// ============================================================
+// 卷积与池化实现
+// ============================================================
+
+// 一个方向的输出长度 (填充须小于窗口，保证每个窗口至少覆盖一个输入位置)
+static int32_t window_out_len(int32_t in, int32_t k, int32_t stride, int32_t pad0, int32_t pad1) {
+    if (in < 1 || k < 1 || stride < 1 || pad0 < 0 || pad1 < 0 || pad0 >= k || pad1 >= k) {
+        return -1;
+    }
+    int32_t span = in + pad0 + pad1 - k;
+    return (span < 0) ? -1 : span / stride + 1;
+}
+
+static int window_prepare(const tvmrt_window2d_t* win, int32_t* out_h, int32_t* out_w) {
+    if (!win || win->n < 1 || win->c < 1) {
+        return -1;
+    }
+    *out_h = window_out_len(win->h, win->kh, win->stride_h, win->pad_top, win->pad_bottom);
+    *out_w = window_out_len(win->w, win->kw, win->stride_w, win->pad_left, win->pad_right);
+    if (*out_h < 1 || *out_w < 1 ||
+        (int64_t)win->n * win->h * win->w * win->c > INT32_MAX / 4) {
+        return -1;
+    }
+    return 0;
+}
+
+int tvmrt_conv2d_prepare(
+    tvmrt_conv2d_attrs_t* attrs,
+    const tvmrt_window2d_t* win,
+    int32_t out_channels,
+    bool bias,
+    tvmrt_conv_algo_t algo
+) {
+    if (!attrs || out_channels < 1 || algo < TVMRT_CONV_AUTO || algo > TVMRT_CONV_DIRECT) {
+        return -1;
+    }
+    memset(attrs, 0, sizeof(*attrs));
+    if (window_prepare(win, &attrs->out_h, &attrs->out_w) != 0) {
+        return -1;
+    }
+    int64_t kdim = (int64_t)win->kh * win->kw * win->c;
+    int64_t pixels = (int64_t)win->n * attrs->out_h * attrs->out_w;
+    if (pixels * out_channels > INT32_MAX / 4 || kdim * out_channels > INT32_MAX / 8 ||
+        kdim * TVMRT_CONV_PANEL > INT32_MAX / 4) {
+        return -1;
+    }
+    if (algo == TVMRT_CONV_AUTO) {
+        // im2col 每个输出像素展开 kh*kw*c 个元素，分摊到 k 个输出通道的乘加上
+        algo = (out_channels >= TVMRT_CONV_IM2COL_MIN_K) ? TVMRT_CONV_IM2COL : TVMRT_CONV_DIRECT;
+    }
+
+    attrs->win = *win;
+    attrs->k = out_channels;
+    attrs->algo = algo;
+    attrs->weight_offset = mem_plan_round_up((int32_t)sizeof(*attrs), 64);
+    attrs->const_bytes = attrs->weight_offset + (int32_t)(kdim * out_channels) * 4;
+    if (bias) {
+        attrs->bias_offset = mem_plan_round_up(attrs->const_bytes, 64);
+        attrs->const_bytes = attrs->bias_offset + out_channels * 4;
+    }
+    if (algo == TVMRT_CONV_IM2COL) {
+        int64_t rows = (pixels < TVMRT_CONV_PANEL) ? pixels : TVMRT_CONV_PANEL;
+        attrs->scratch_bytes = (int32_t)(rows * kdim * 4);
+    }
+    attrs->act_min = -INFINITY;
+    attrs->act_max = INFINITY;
+    return 0;
+}
+
+int tvmrt_pool2d_prepare(
+    tvmrt_pool2d_attrs_t* attrs,
+    tvmrt_pool_kind_t kind,
+    const tvmrt_window2d_t* win
+) {
+    if (!attrs || (kind != TVMRT_POOL_MAX && kind != TVMRT_POOL_AVG)) {
+        return -1;
+    }
+    memset(attrs, 0, sizeof(*attrs));
+    if (window_prepare(win, &attrs->out_h, &attrs->out_w) != 0) {
+        return -1;
+    }
+    attrs->win = *win;
+    attrs->kind = kind;
+    return 0;
+}
+
+// ============================================================
+// 稀疏权重实现
+// ============================================================
+
+static int64_t sparse_round(int64_t x) {
+    return (x + 63) & ~(int64_t)63;
+}
+
+static bool sparse_eligible(const tvmrt_qattrs_t* at) {
+    return at && at->count > 0 && at->n > 0 && at->k > 0 &&
+           at->weight_offset >= (int32_t)sizeof(*at) && at->weight_dtype == TVMRT_DTYPE_FLOAT32;
+}
+
+// 遍历非零项 (面板 → 规约行 → 面板内列/块)，返回项数; out 非 NULL 时写入
+// ptr/idx/values (BSR 块中越过 n 的列补 0)
+static int64_t sparse_walk(const tvmrt_qattrs_t* dense, int32_t format, tvmrt_sparse_attrs_t* out) {
+    const float* w = (const float*)((const uint8_t*)dense + dense->weight_offset);
+    int32_t n = dense->n, k = dense->k;
+    int32_t bc = (format == TVMRT_SPARSE_BSR) ? TVMRT_SPARSE_BLOCK_COLS : 1;
+    int32_t* ptr = out ? (int32_t*)((uint8_t*)out + out->ptr_offset) : NULL;
+    int32_t* idx = out ? (int32_t*)((uint8_t*)out + out->idx_offset) : NULL;
+    float* val = out ? (float*)((uint8_t*)out + out->val_offset) : NULL;
+    int64_t nnz = 0;
+    for (int32_t j0 = 0, p = 0; j0 < n; j0 += TVMRT_SPARSE_PANEL, p++) {
+        int32_t pw = (n - j0 < TVMRT_SPARSE_PANEL) ? n - j0 : TVMRT_SPARSE_PANEL;
+        for (int32_t t = 0; t < k; t++) {
+            const float* row = w + (int64_t)t * n + j0;
+            if (ptr) ptr[(int64_t)p * k + t] = (int32_t)nnz;
+            for (int32_t b = 0; b * bc < pw; b++) {
+                int32_t len = (pw - b * bc < bc) ? pw - b * bc : bc;
+                bool nonzero = false;
+                for (int32_t j = 0; j < len; j++) nonzero |= (row[b * bc + j] != 0.0f);
+                if (!nonzero) continue;
+                if (out) {
+                    idx[nnz] = b;
+                    for (int32_t j = 0; j < bc; j++) {
+                        val[nnz * bc + j] = (j < len) ? row[b * bc + j] : 0.0f;
+                    }
+                }
+                nnz++;
+            }
+        }
+    }
+    if (ptr) ptr[(int64_t)out->panels * k] = (int32_t)nnz;
+    return nnz;
+}
+
+float tvmrt_sparse_density(const tvmrt_qattrs_t* dense, tvmrt_sparse_format_t format) {
+    if (!sparse_eligible(dense) || (format != TVMRT_SPARSE_CSR && format != TVMRT_SPARSE_BSR)) {
+        return -1.0f;
+    }
+    int32_t bc = (format == TVMRT_SPARSE_BSR) ? TVMRT_SPARSE_BLOCK_COLS : 1;
+    int64_t per_row = 0;
+    for (int32_t j0 = 0; j0 < dense->n; j0 += TVMRT_SPARSE_PANEL) {
+        int32_t pw = (dense->n - j0 < TVMRT_SPARSE_PANEL) ? dense->n - j0 : TVMRT_SPARSE_PANEL;
+        per_row += (pw + bc - 1) / bc;
+    }
+    return (float)((double)sparse_walk(dense, format, NULL) / ((double)per_row * dense->k));
+}
+
+tvmrt_sparse_format_t tvmrt_sparse_choose(
+    const tvmrt_qattrs_t* dense,
+    const tvmrt_sparse_config_t* config
+) {
+    // 负阈值 (TVMRT_SPARSE_NEVER) 低于任何密度，对应格式不会被选中
+    float bsr_max = (config && config->bsr_max_density != 0) ? config->bsr_max_density
+                                                             : TVMRT_SPARSE_BSR_DENSITY;
+    float csr_max = (config && config->csr_max_density != 0) ? config->csr_max_density
+                                                             : TVMRT_SPARSE_CSR_DENSITY;
+    float bd = tvmrt_sparse_density(dense, TVMRT_SPARSE_BSR);
+    if (bd < 0) {
+        return TVMRT_SPARSE_DENSE;
+    }
+    float cd = tvmrt_sparse_density(dense, TVMRT_SPARSE_CSR);
+    if (cd <= csr_max && cd <= TVMRT_SPARSE_CSR_RATIO * bd) {
+        return TVMRT_SPARSE_CSR;
+    }
+    if (bd <= bsr_max) {
+        return TVMRT_SPARSE_BSR;
+    }
+    return (cd <= csr_max) ? TVMRT_SPARSE_CSR : TVMRT_SPARSE_DENSE;
+}
+
+int64_t tvmrt_sparse_pack(
+    const tvmrt_qattrs_t* dense,
+    tvmrt_sparse_format_t format,
+    tvmrt_sparse_attrs_t* out,
+    int64_t capacity
+) {
+    if (!sparse_eligible(dense) || (format != TVMRT_SPARSE_CSR && format != TVMRT_SPARSE_BSR)) {
+        return -1;
+    }
+    tvmrt_sparse_attrs_t h = {
+        .format = format, .m = dense->count, .n = dense->n, .k = dense->k,
+        .panels = (dense->n + TVMRT_SPARSE_PANEL - 1) / TVMRT_SPARSE_PANEL,
+    };
+    int64_t bc = (format == TVMRT_SPARSE_BSR) ? TVMRT_SPARSE_BLOCK_COLS : 1;
+    int64_t nnz = sparse_walk(dense, format, NULL);
+    int64_t ptr = sparse_round(sizeof(h));
+    int64_t idx = sparse_round(ptr + ((int64_t)h.panels * h.k + 1) * 4);
+    int64_t val = sparse_round(idx + nnz * 4);
+    int64_t end = val + nnz * bc * 4;
+    int64_t bias = 0;
+    if (dense->bias_offset) {
+        bias = sparse_round(end);
+        end = bias + (int64_t)h.n * 4;
+    }
+    if (end > INT32_MAX) {
+        return -1;
+    }
+    if (!out || capacity < end) {
+        return end;
+    }
+    h.nnz = (int32_t)nnz;
+    h.ptr_offset = (int32_t)ptr;
+    h.idx_offset = (int32_t)idx;
+    h.val_offset = (int32_t)val;
+    h.bias_offset = (int32_t)bias;
+    h.bytes = (int32_t)end;
+    *out = h;
+    sparse_walk(dense, format, out);
+    if (bias) {
+        memcpy((uint8_t*)out + bias, (const uint8_t*)dense + dense->bias_offset,
+               (size_t)h.n * 4);
+    }
+    return end;
+}
+
+int tvmrt_sparse_init(
+    tvmrt_sparse_t* sp,
+    tvmrt_context_t* ctx,
+    const tvmrt_sparse_config_t* config
+) {
+    if (!sp || !ctx || !ctx->op_execs || !config || !config->dense || !config->csr ||
+        !config->bsr || config->format < TVMRT_SPARSE_AUTO || config->format > TVMRT_SPARSE_DENSE) {
+        return -1;
+    }
+    memset(sp, 0, sizeof(*sp));
+    int32_t op_count = ctx->op_count;
+    tvmrt_sparse_format_t* fmt = (tvmrt_sparse_format_t*)tvmrt_mem_alloc(
+        (uint64_t)(op_count ? op_count : 1) * sizeof(tvmrt_sparse_format_t), 8);
+    if (!fmt) {
+        return -1;
+    }
+
+    // 1. 选择格式并计算总大小
+    int64_t total = 0;
+    for (int32_t i = 0; i < op_count; i++) {
+        const tvmrt_op_exec_t* ex = &ctx->op_execs[i];
+        const tvmrt_op_args_t* args = (const tvmrt_op_args_t*)ex->args;
+        const tvmrt_qattrs_t* at = args ? (const tvmrt_qattrs_t*)args->inputs[1] : NULL;
+        fmt[i] = TVMRT_SPARSE_DENSE;
+        if (!sparse_eligible(at) || at->in_dtype[0] != TVMRT_DTYPE_FLOAT32 ||
+            at->out_dtype != TVMRT_DTYPE_FLOAT32) {
+            continue;
+        }
+        if (ex->func != config->dense) {
+            // 已被 tvmrt_tune 换成其他稠密候选: 次序错误，不静默跳过
+            const tvmrt_tune_kernel_t* tk = config->tune_kernel;
+            for (int32_t v = 0; tk && v < tk->variant_count; v++) {
+                if (tk->variants[v].func == ex->func) {
+                    tvmrt_mem_free(fmt);
+                    memset(sp, 0, sizeof(*sp));
+                    return -1;
+                }
+            }
+            continue;
+        }
+        tvmrt_sparse_format_t f = (config->format == TVMRT_SPARSE_AUTO)
+                                      ? tvmrt_sparse_choose(at, config)
+                                      : config->format;
+        int64_t bytes = (f == TVMRT_SPARSE_DENSE) ? -1 : tvmrt_sparse_pack(at, f, NULL, 0);
+        if (bytes < 0) {
+            sp->dense++;
+            continue;
+        }
+        fmt[i] = f;
+        total += sparse_round(bytes);
+    }
+
+    // 2. 一次分配，转换并替换属性块与执行函数
+    uint8_t* base = (uint8_t*)tvmrt_mem_alloc((uint64_t)(total ? total : 1), 64);
+    if (!base) {
+        tvmrt_mem_free(fmt);
+        memset(sp, 0, sizeof(*sp));
+        return -1;
+    }
+    int64_t off = 0;
+    for (int32_t i = 0; i < op_count; i++) {
+        if (fmt[i] == TVMRT_SPARSE_DENSE) {
+            continue;
+        }
+        tvmrt_op_exec_t* ex = &ctx->op_execs[i];
+        tvmrt_op_args_t* args = (tvmrt_op_args_t*)ex->args;
+        const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)args->inputs[1];
+        tvmrt_sparse_attrs_t* blk = (tvmrt_sparse_attrs_t*)(base + off);
+        int64_t bytes = tvmrt_sparse_pack(at, fmt[i], blk, total - off);
+        sp->dense_bytes += (int64_t)at->n * at->k * 4;
+        sp->sparse_bytes += bytes;
+        off += sparse_round(bytes);
+        args->inputs[1] = blk;
+        if (fmt[i] == TVMRT_SPARSE_CSR) {
+            ex->func = config->csr;
+            sp->csr++;
+        } else {
+            ex->func = config->bsr;
+            sp->bsr++;
+        }
+    }
+    tvmrt_mem_free(fmt);
+    sp->storage = base;
+    return 0;
+}
+
+void tvmrt_sparse_destroy(tvmrt_sparse_t* sp) {
+    if (!sp) {
+        return;
+    }
+    tvmrt_mem_free(sp->storage);
+    memset(sp, 0, sizeof(*sp));
+}
+
+// ============================================================
+// Softmax 与 LayerNorm 实现
+// ============================================================
+
+static int norm_shape_ok(int32_t rows, int32_t cols) {
+    return rows >= 1 && cols >= 1 && (int64_t)rows * cols <= INT32_MAX / 4;
+}
+
+int tvmrt_softmax_prepare(tvmrt_norm_attrs_t* attrs, int32_t rows, int32_t cols) {
+    if (!attrs || !norm_shape_ok(rows, cols)) {
+        return -1;
+    }
+    *attrs = (tvmrt_norm_attrs_t){.kind = TVMRT_NORM_SOFTMAX, .rows = rows, .cols = cols,
+                                  .const_bytes = (int32_t)sizeof(*attrs)};
+    return 0;
+}
+
+int tvmrt_layernorm_prepare(
+    tvmrt_norm_attrs_t* attrs,
+    int32_t rows,
+    int32_t cols,
+    float eps,
+    bool affine
+) {
+    if (!attrs || !norm_shape_ok(rows, cols) || !(eps >= 0.0f)) {
+        return -1;
+    }
+    *attrs = (tvmrt_norm_attrs_t){.kind = TVMRT_NORM_LAYERNORM, .rows = rows, .cols = cols,
+                                  .eps = eps, .const_bytes = (int32_t)sizeof(*attrs)};
+    if (affine) {
+        attrs->gamma_offset = mem_plan_round_up(attrs->const_bytes, 64);
+        attrs->beta_offset = mem_plan_round_up(attrs->gamma_offset + cols * 4, 64);
+        attrs->const_bytes = attrs->beta_offset + cols * 4;
+    }
+    return 0;
+}
+
+// ============================================================
+// 调度引擎实现
+// ============================================================
+
+// 截止时刻/取消令牌检查: 返回 0、TVMRT_ERR_TIMEOUT 或 TVMRT_ERR_CANCELLED
+static int32_t engine_abort_reason(uint64_t deadline_ns, const tvmrt_cancel_token_t* cancel) {
+    if (cancel && __atomic_load_n(&cancel->cancelled, __ATOMIC_RELAXED)) {
+        return TVMRT_ERR_CANCELLED;
+    }
+    if (deadline_ns && tvmrt_time_ns() >= deadline_ns) {
+        return TVMRT_ERR_TIMEOUT;
+    }
+    return 0;
+}
+
+// 阻塞等待时下一次醒来检查的时刻: 截止时刻与取消轮询间隔中较早者
+static uint64_t engine_abort_wake(uint64_t deadline_ns, const tvmrt_cancel_token_t* cancel) {
+    uint64_t wake = cancel ? tvmrt_time_ns() + TVMRT_CANCEL_POLL_NS : UINT64_MAX;
+    return (deadline_ns && deadline_ns < wake) ? deadline_ns : wake;
+}
+
+void tvmrt_cancel(tvmrt_cancel_token_t* token) {
+    if (token) {
+        __atomic_store_n(&token->cancelled, 1, __ATOMIC_RELAXED);
+    }
+}
+
+#if TVMRT_NUM_WORKERS > 0
+
+// 剖析时最多为多少个调用线程各开一组计数器 (更多的调用线程只计时)
+#define ENGINE_PERF_CALLERS 16
+
+// 吞吐模式下排队的整个请求 (位于提交线程的栈上)
+typedef struct engine_request {
+    tvmrt_plan_t* plan;
+    int32_t priority;
+    int32_t next_op;        // 被让出后从此算子继续
+    uint64_t deadline_ns;
+    const tvmrt_cancel_token_t* cancel;
+    int32_t status;
+    bool started;           // 已被 Worker 取出 (此后不能再从队列撤回)
+    bool queued;            // 位于请求队列中 (未在执行)
+    bool done;
+    struct engine_request* next;
+} engine_request_t;
+
+// 延迟模式下等待获得引擎的请求 (位于提交线程的栈上)，同级按到达顺序排队
+typedef struct engine_run_waiter {
+    struct engine_run_waiter* next;
+} engine_run_waiter_t;
+
+typedef struct {
+    tvmrt_thread_t workers[TVMRT_MAX_WORKERS];
+    uint32_t start_generation[TVMRT_MAX_WORKERS];   // 创建时的 generation, 新 Worker 不重放旧发布
+    int32_t num_workers;    // 当前 Worker 数; 编号 >= num_workers 的 Worker 退出 (受 task_queue.mutex 保护)
+    tvmrt_layer_queue_t task_queue;
+    tvmrt_barrier_t layer_barrier;
+    
+    tvmrt_context_t* current_ctx;
+    const tvmrt_schedule_desc_t* current_schedule;
+    int32_t current_layer_idx;
+
+    // 静态分配模式: 发布 (plan, layer) 后 generation 自增，Worker 据此
+    // 识别新层并执行自己的切片
+    tvmrt_plan_t* static_plan;
+    int32_t static_layer;   // -1 = 依赖模式, 整个计划一次发布
+    uint32_t static_epoch;  // 依赖模式本次执行的 epoch
+    uint32_t generation;
+    // 本次发布中有算子的切片。没有算子的 Worker 不计入屏障，调用线程不会
+    // 等它，因此它只能读这里而不能再读计划 (计划可能已被重新编译或释放)
+    bool static_busy[TVMRT_PLAN_MAX_SLOTS];
+
+    int32_t status;         // 本次执行中首个失败算子的返回值 (受 task_queue.mutex 保护)
+    uint64_t deadline_ns;   // 本次执行的截止时刻与取消令牌 (发布前写入)
+    const tvmrt_cancel_token_t* cancel;
+
+    // 上下文池请求: 吞吐模式下按优先级排队由空闲 Worker 整体执行 (受 task_queue.mutex
+    // 保护)，request_top 为非空的最高优先级 (-1 = 无), 执行中的 Worker 在算子边界读取
+    tvmrt_engine_mode_t mode;
+    engine_request_t* request_head[TVMRT_PRIORITY_LEVELS];
+    engine_request_t* request_tail[TVMRT_PRIORITY_LEVELS];
+    int32_t request_top;
+    int32_t idle_workers;
+    int32_t request_waiters;    // 正在等待请求完成的提交线程数 (停机时等其全部返回)
+    tvmrt_cond_t request_done;
+
+    // 延迟模式: 请求互斥执行，等待者按优先级获得引擎，同级只有队首可以
+    // 获得 (受 run_lock 保护)
+    tvmrt_mutex_t run_lock;
+    tvmrt_cond_t run_cond;
+    bool run_busy;
+    engine_run_waiter_t* run_head[TVMRT_PRIORITY_LEVELS];
+    engine_run_waiter_t* run_tail[TVMRT_PRIORITY_LEVELS];
+
+    // 逐算子剖析: 每个执行线程一组计数器。下标 < TVMRT_MAX_WORKERS 为 Worker，
+    // 其后为调用线程 (批处理线程、上下文池提交线程等)，按首次执行算子的先后登记
+    tvmrt_profile_t* profile;
+    tvmrt_perf_group_t perf[TVMRT_MAX_WORKERS + ENGINE_PERF_CALLERS];
+    int8_t perf_state[TVMRT_MAX_WORKERS + ENGINE_PERF_CALLERS];   // 0 = 未打开, 1 = 可用, -1 = 不可用
+    int32_t perf_callers;       // 已登记的调用线程数
+    uint32_t perf_epoch;        // 每次停机 +1, 调用线程的登记随之失效
+    
+    bool shutdown;
+    bool initialized;
+} engine_state_t;
+
+static engine_state_t g_engine = {0};
+
+#define ENGINE_CALLER_THREAD TVMRT_MAX_WORKERS
+
+// 本线程作为调用线程登记的计数器组下标 (-1 = 未登记, -2 = 名额已满)
+static __thread int32_t t_perf_slot = -1;
+static __thread uint32_t t_perf_epoch;
+
+// 计数器组只统计打开它的线程: 调用线程不共用一组，各自登记一个下标
+static int32_t engine_caller_perf_slot(void) {
+    uint32_t epoch = __atomic_load_n(&g_engine.perf_epoch, __ATOMIC_RELAXED);
+    if (t_perf_slot == -1 || t_perf_epoch != epoch) {
+        int32_t k = __atomic_fetch_add(&g_engine.perf_callers, 1, __ATOMIC_RELAXED);
+        t_perf_slot = (k < ENGINE_PERF_CALLERS) ? TVMRT_MAX_WORKERS + k : -2;
+        t_perf_epoch = epoch;
+    }
+    return t_perf_slot;
+}
+
+// 剖析模式下执行算子: 计时并把本线程计数器的增量计入该算子。计数器组被
+// 分时复用 (运行时间小于启用时间) 时按两者之比缩放增量
+static int32_t engine_call_op_profiled(
+    tvmrt_profile_t* prof, int32_t thread, int32_t op_id, tvmrt_op_func_t func, void* args
+) {
+    int32_t slot = (thread == ENGINE_CALLER_THREAD) ? engine_caller_perf_slot() : thread;
+    if (slot >= 0 && g_engine.perf_state[slot] == 0) {
+        g_engine.perf_state[slot] =
+            (tvmrt_perf_group_open(&g_engine.perf[slot]) == TVMRT_OK) ? 1 : -1;
+    }
+
+    tvmrt_perf_sample_t before, after;
+    bool counted = slot >= 0 && g_engine.perf_state[slot] > 0 &&
+                   tvmrt_perf_group_read(&g_engine.perf[slot], &before) == TVMRT_OK;
+    uint64_t t0 = tvmrt_time_ns();
+    int32_t ret = func(args);
+    uint64_t dt = tvmrt_time_ns() - t0;
+    counted = counted && tvmrt_perf_group_read(&g_engine.perf[slot], &after) == TVMRT_OK;
+
+    // 同一算子每次执行只在一个线程上，层/依赖同步保证记录不会并发写
+    tvmrt_profile_op_t* rec = &prof->ops[op_id];
+    rec->calls++;
+    rec->time_ns += dt;
+    uint64_t enabled = counted ? after.time_enabled - before.time_enabled : 0;
+    uint64_t running = counted ? after.time_running - before.time_running : 0;
+    if (running > 0) {   // 执行期间组从未上 PMU 时没有数据
+        uint32_t mask = g_engine.perf[slot].mask;
+        bool scaled = running < enabled;
+        for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) {
+            if (!(mask & (1u << e))) continue;
+            uint64_t delta = after.values[e] - before.values[e];
+            rec->counters[e] += scaled ? (uint64_t)((double)delta * (double)enabled / (double)running)
+                                       : delta;
+        }
+        rec->counter_mask |= mask;
+        rec->counted_calls++;
+        rec->scaled_calls += scaled ? 1 : 0;
+    }
+    return ret;
+}
+
+// 执行单个算子 (thread: Worker 编号或 ENGINE_CALLER_THREAD)
+static inline int32_t engine_call_op(int32_t thread, int32_t op_id, tvmrt_op_func_t func, void* args) {
+    tvmrt_profile_t* prof = g_engine.profile;
+    if (!prof || op_id >= prof->op_count) {
+        return func(args);
+    }
+    return engine_call_op_profiled(prof, thread, op_id, func, args);
+}
+
+// 记录首个失败返回值 (其他执行线程在 engine_aborted 中无锁读取)
+static void engine_record_status(int32_t ret) {
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    if (g_engine.status == 0) {
+        __atomic_store_n(&g_engine.status, ret, __ATOMIC_RELAXED);
+    }
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+}
+
+// 本次执行是否已中止 (算子失败、到期或取消)，首次发现到期/取消时记录原因
+static bool engine_aborted(void) {
+    if (__atomic_load_n(&g_engine.status, __ATOMIC_RELAXED) != 0) {
+        return true;
+    }
+    if (!g_engine.deadline_ns && !g_engine.cancel) {
+        return false;
+    }
+    int32_t reason = engine_abort_reason(g_engine.deadline_ns, g_engine.cancel);
+    if (reason != 0) {
+        engine_record_status(reason);
+        return true;
+    }
+    return false;
+}
+
+// 等待层屏障。设置了截止时刻或取消令牌时按时醒来检查，中止后不再抛弃
+// 在途算子: 其余线程会跳过未开始的算子，继续等待它们到达即可
+static void engine_barrier_wait(void) {
+    while ((g_engine.deadline_ns || g_engine.cancel) && !engine_aborted()) {
+        uint64_t wake = engine_abort_wake(g_engine.deadline_ns, g_engine.cancel);
+        if (tvmrt_barrier_timedsync(&g_engine.layer_barrier, wake) == TVMRT_OK) {
+            return;
+        }
+    }
+    tvmrt_barrier_sync(&g_engine.layer_barrier);
+}
+
+// 静态分配模式: 执行该层的第 slot 个切片
+// (调用线程参与时切片 0 归调用线程，Worker w 执行切片 w + 1)
+static void engine_run_slice(const tvmrt_plan_t* plan, int32_t layer_idx, int32_t slot, int32_t thread) {
+    if (slot >= plan->slot_count) {
+        return;
+    }
+    const int32_t* row = &plan->slice_begin[layer_idx * plan->slice_stride];
+    int32_t begin = row[slot];
+    int32_t end = row[slot + 1];
+    if (begin == end) {
+        return;  // 空切片不计入屏障目标
+    }
+    for (int32_t i = begin; i < end && !engine_aborted(); i++) {
+        int32_t ret = engine_call_op(thread, plan->op_ids[plan->slice_pos[i]],
+                                     plan->slice_ops[i].func, plan->slice_ops[i].args);
+        if (ret != 0) {
+            engine_record_status(ret);
+            break;
+        }
+    }
+    tvmrt_barrier_arrive(&g_engine.layer_barrier);
+}
+
+// 从队列头取任务 (调用方持有 task_queue.mutex)，队列为空返回 -1
+static int32_t queue_pop_locked(void) {
+    if (g_engine.task_queue.count == 0) {
+        return -1;
+    }
+    int32_t op_id = g_engine.task_queue.tasks[g_engine.task_queue.head];
+    g_engine.task_queue.head++;
+    g_engine.task_queue.count--;
+    
+    // 链式唤醒下一个 Worker
+    if (g_engine.task_queue.count > 0) {
+        tvmrt_cond_signal(&g_engine.task_queue.cond);
+    }
+    return op_id;
+}
+
+// 执行出队的算子并通知屏障
+static void engine_exec_queued(int32_t op_id, int32_t thread) {
+    tvmrt_context_t* ctx = g_engine.current_ctx;
+    // 已中止时只出队并通知屏障，不再执行
+    if (op_id >= 0 && op_id < ctx->op_count && !engine_aborted()) {
+        tvmrt_op_exec_t* exec = &ctx->op_execs[op_id];
+        if (exec->func) {
+            // 调度引擎日志已禁用，由包装函数中的参数日志替代
+            // TVMRT_LOG_OP_START(op_id, exec->name, worker_id);
+            int32_t ret = engine_call_op(thread, op_id, exec->func, exec->args);
+            // TVMRT_LOG_OP_END(op_id, exec->name, worker_id, ret);
+            if (ret != 0) {
+                engine_record_status(ret);
+            }
+        }
+    }
+    
+    // 通知完成
+    tvmrt_barrier_arrive(&g_engine.layer_barrier);
+}
+
+// 依赖模式: 按层顺序走完第 slot 个切片的所有算子，每个算子先等前驱完成
+static void engine_run_dataflow_slot(tvmrt_plan_t* plan, int32_t slot, uint32_t epoch, int32_t thread) {
+    if (slot >= plan->slot_count) {
+        return;
+    }
+    bool any = false;
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        const int32_t* row = &plan->slice_begin[l * plan->slice_stride];
+        for (int32_t k = row[slot]; k < row[slot + 1]; k++) {
+            int32_t pos = plan->slice_pos[k];
+            for (int32_t d = plan->dep_begin[pos]; d < plan->dep_begin[pos + 1]; d++) {
+                const uint32_t* flag = &plan->done_epoch[plan->dep_list[d]];
+                int32_t spins = 0;
+                while (__atomic_load_n(flag, __ATOMIC_ACQUIRE) != epoch) {
+                    if (++spins >= TVMRT_DEP_SPIN_COUNT) {
+                        tvmrt_thread_yield();
+                        spins = 0;
+                    }
+                }
+            }
+            // 已中止时跳过执行，但仍置完成标志以免后继永久等待
+            if (!engine_aborted()) {
+                int32_t ret = engine_call_op(thread, plan->op_ids[pos], plan->slice_ops[k].func,
+                                             plan->slice_ops[k].args);
+                if (ret != 0) {
+                    engine_record_status(ret);
+                }
+            }
+            __atomic_store_n(&plan->done_epoch[pos], epoch, __ATOMIC_RELEASE);
+            any = true;
+        }
+    }
+    if (any) {
+        tvmrt_barrier_arrive(&g_engine.layer_barrier);
+    }
+}
+
+// 请求入队 (调用方持有 task_queue.mutex)，front 为真时放在本级队首
+static void engine_request_push_locked(engine_request_t* req, bool front) {
+    int32_t p = req->priority;
+    if (front) {
+        req->next = g_engine.request_head[p];
+        g_engine.request_head[p] = req;
+        if (!g_engine.request_tail[p]) {
+            g_engine.request_tail[p] = req;
+        }
+    } else {
+        req->next = NULL;
+        if (g_engine.request_tail[p]) {
+            g_engine.request_tail[p]->next = req;
+        } else {
+            g_engine.request_head[p] = req;
+        }
+        g_engine.request_tail[p] = req;
+    }
+    req->queued = true;
+    if (p > g_engine.request_top) {
+        __atomic_store_n(&g_engine.request_top, p, __ATOMIC_RELAXED);
+    }
+}
+
+// 取出优先级最高的请求 (调用方持有 task_queue.mutex 且 request_top >= 0)
+static engine_request_t* engine_request_pop_locked(void) {
+    int32_t p = g_engine.request_top;
+    engine_request_t* req = g_engine.request_head[p];
+    g_engine.request_head[p] = req->next;
+    if (!req->next) {
+        g_engine.request_tail[p] = NULL;
+    }
+    while (p >= 0 && !g_engine.request_head[p]) {
+        p--;
+    }
+    __atomic_store_n(&g_engine.request_top, p, __ATOMIC_RELAXED);
+    req->started = true;
+    req->queued = false;
+    return req;
+}
+
+// 从队列中撤回尚未开始的请求 (调用方持有 task_queue.mutex)
+static void engine_request_remove_locked(engine_request_t* req) {
+    int32_t p = req->priority;
+    engine_request_t* prev = NULL;
+    for (engine_request_t* r = g_engine.request_head[p]; r; prev = r, r = r->next) {
+        if (r != req) continue;
+        if (prev) {
+            prev->next = r->next;
+        } else {
+            g_engine.request_head[p] = r->next;
+        }
+        if (g_engine.request_tail[p] == r) {
+            g_engine.request_tail[p] = prev;
+        }
+        break;
+    }
+    req->queued = false;
+    int32_t top = g_engine.request_top;
+    while (top >= 0 && !g_engine.request_head[top]) {
+        top--;
+    }
+    __atomic_store_n(&g_engine.request_top, top, __ATOMIC_RELAXED);
+}
+
+// 从断点起串行执行请求的计划。执行完 (或失败) 返回 true; preemptible 为真时
+// 队列中出现更高优先级请求且没有空闲 Worker 则在算子边界停下并返回 false
+static bool engine_run_request_ops(engine_request_t* req, bool preemptible) {
+    const tvmrt_plan_t* plan = req->plan;
+    bool abortable = req->deadline_ns || req->cancel;
+    for (int32_t i = req->next_op; i < plan->op_count; i++) {
+        int32_t ret = abortable ? engine_abort_reason(req->deadline_ns, req->cancel) : 0;
+        if (ret == 0) {
+            ret = plan->ops[i].func(plan->ops[i].args);
+        }
+        if (ret != 0) {
+            req->status = ret;
+            return true;
+        }
+        if (preemptible &&
+            __atomic_load_n(&g_engine.request_top, __ATOMIC_RELAXED) > req->priority &&
+            __atomic_load_n(&g_engine.idle_workers, __ATOMIC_RELAXED) == 0 &&
+            i + 1 < plan->op_count) {
+            req->next_op = i + 1;
+            return false;
+        }
+    }
+    req->status = 0;
+    return true;
+}
+
+// Worker 线程函数
+static void* worker_func(void* arg) {
+    int worker_id = (int)(intptr_t)arg;
+    uint32_t seen_generation = g_engine.start_generation[worker_id];
+    
+    while (1) {
+        // 阻塞获取任务
+        tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+        
+        g_engine.idle_workers++;
+        while (g_engine.task_queue.count == 0 && g_engine.request_top < 0 &&
+               seen_generation == g_engine.generation && !g_engine.shutdown &&
+               worker_id < g_engine.num_workers) {
+            tvmrt_cond_wait(&g_engine.task_queue.cond, &g_engine.task_queue.mutex);
+        }
+        g_engine.idle_workers--;
+        
+        // 停机或缩容后编号超出范围时退出
+        if (g_engine.shutdown || worker_id >= g_engine.num_workers) {
+            tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+            break;
+        }
+
+        // 静态分配模式: 不出队，直接执行本 Worker 的切片 (切片为空时不碰计划)
+        if (seen_generation != g_engine.generation) {
+            seen_generation = g_engine.generation;
+            if (!g_engine.static_busy[worker_id + TVMRT_CALLER_PARTICIPATES]) {
+                tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+                continue;
+            }
+            tvmrt_plan_t* plan = g_engine.static_plan;
+            int32_t layer_idx = g_engine.static_layer;
+            uint32_t epoch = g_engine.static_epoch;
+            tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+            if (layer_idx < 0) {
+                engine_run_dataflow_slot(plan, worker_id + TVMRT_CALLER_PARTICIPATES, epoch,
+                                         worker_id);
+            } else {
+                engine_run_slice(plan, layer_idx, worker_id + TVMRT_CALLER_PARTICIPATES, worker_id);
+            }
+            continue;
+        }
+
+        // 吞吐模式: 层任务优先，其次串行执行优先级最高的排队请求;
+        // 被更高优先级让出的请求回到本级队首
+        if (g_engine.task_queue.count == 0 && g_engine.request_top >= 0) {
+            engine_request_t* req = engine_request_pop_locked();
+            tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+
+            bool finished = engine_run_request_ops(req, true);
+
+            tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+            if (finished) {
+                req->done = true;
+                tvmrt_cond_broadcast(&g_engine.request_done);
+            } else {
+                engine_request_push_locked(req, true);
+            }
+            tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+            continue;
+        }
+        
+        int32_t op_id = queue_pop_locked();
+        tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+        
+        // 执行算子（在锁外）
+        engine_exec_queued(op_id, worker_id);
+    }
+    
+    return NULL;
+}
+
+// 解析请求的 Worker 数: TVMRT_WORKERS_AUTO 按可用 CPU 数确定，结果截断到 [0, TVMRT_MAX_WORKERS]
+static int32_t engine_resolve_workers(int32_t requested) {
+    if (requested < 0) {
+        requested = tvmrt_cpu_count() - TVMRT_CALLER_PARTICIPATES;
+    }
+    if (requested < 0) {
+        requested = 0;
+    }
+    return requested > TVMRT_MAX_WORKERS ? TVMRT_MAX_WORKERS : requested;
+}
+
+// 扩容到 target 个 Worker (两次推理之间调用)
+static int engine_grow(int32_t target) {
+    for (int32_t i = g_engine.num_workers; i < target; i++) {
+        // 先发布新容量再创建线程，否则新 Worker 会看到自己越界而立即退出
+        tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+        g_engine.start_generation[i] = g_engine.generation;
+        g_engine.num_workers = i + 1;
+        tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+        if (tvmrt_thread_create(&g_engine.workers[i], worker_func, (void*)(intptr_t)i) != TVMRT_OK) {
+            tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+            g_engine.num_workers = i;
+            tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// 缩容到 target 个 Worker: 多出的 Worker 退出后回收，并关闭其计数器组
+static void engine_shrink(int32_t target) {
+    int32_t old = g_engine.num_workers;
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    g_engine.num_workers = target;
+    tvmrt_cond_broadcast(&g_engine.task_queue.cond);
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+
+    for (int32_t i = target; i < old; i++) {
+        tvmrt_thread_join(&g_engine.workers[i]);
+        if (g_engine.perf_state[i] > 0) {
+            tvmrt_perf_group_close(&g_engine.perf[i]);
+        }
+        g_engine.perf_state[i] = 0;
+    }
+
+    // 退出的 Worker 可能把让出的请求放回了队列; 缩容到 0 后由提交线程自己执行
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    tvmrt_cond_broadcast(&g_engine.request_done);
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+}
+
+#endif  // TVMRT_NUM_WORKERS > 0
+
+// 引擎 API 实现
+int tvmrt_engine_init(const tvmrt_engine_config_t* config) {
+#if TVMRT_NUM_WORKERS > 0
+    if (g_engine.initialized) {
+        return 0;
+    }
+    int32_t target = engine_resolve_workers(config ? config->num_workers : TVMRT_NUM_WORKERS);
+    
+    // 初始化任务队列
+    if (tvmrt_mutex_init(&g_engine.task_queue.mutex) != TVMRT_OK) {
+        return -1;
+    }
+    if (tvmrt_cond_init(&g_engine.task_queue.cond) != TVMRT_OK) {
+        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+        return -1;
+    }
+    g_engine.task_queue.head = 0;
+    g_engine.task_queue.tail = 0;
+    g_engine.task_queue.count = 0;
+    
+    // 初始化 barrier
+    if (tvmrt_barrier_init(&g_engine.layer_barrier) != TVMRT_OK) {
+        tvmrt_cond_destroy(&g_engine.task_queue.cond);
+        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+        return -1;
+    }
+
+    // 上下文池请求的同步
+    if (tvmrt_cond_init(&g_engine.request_done) != TVMRT_OK) {
+        tvmrt_barrier_destroy(&g_engine.layer_barrier);
+        tvmrt_cond_destroy(&g_engine.task_queue.cond);
+        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+        return -1;
+    }
+    if (tvmrt_mutex_init(&g_engine.run_lock) != TVMRT_OK) {
+        tvmrt_cond_destroy(&g_engine.request_done);
+        tvmrt_barrier_destroy(&g_engine.layer_barrier);
+        tvmrt_cond_destroy(&g_engine.task_queue.cond);
+        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+        return -1;
+    }
+    if (tvmrt_cond_init(&g_engine.run_cond) != TVMRT_OK) {
+        tvmrt_mutex_destroy(&g_engine.run_lock);
+        tvmrt_cond_destroy(&g_engine.request_done);
+        tvmrt_barrier_destroy(&g_engine.layer_barrier);
+        tvmrt_cond_destroy(&g_engine.task_queue.cond);
+        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+        return -1;
+    }
+    g_engine.mode = config ? config->mode : TVMRT_ENGINE_LATENCY;
+    for (int32_t p = 0; p < TVMRT_PRIORITY_LEVELS; p++) {
+        g_engine.request_head[p] = NULL;
+        g_engine.request_tail[p] = NULL;
+        g_engine.run_head[p] = NULL;
+        g_engine.run_tail[p] = NULL;
+    }
+    g_engine.request_top = -1;
+    g_engine.idle_workers = 0;
+    g_engine.request_waiters = 0;
+    g_engine.run_busy = false;
+    
+    g_engine.shutdown = false;
+    g_engine.current_schedule = NULL;
+    g_engine.current_ctx = NULL;
+    g_engine.static_plan = NULL;
+    g_engine.generation = 0;
+    g_engine.status = 0;
+    g_engine.num_workers = 0;
+    
+    // 创建 Worker 线程
+    if (engine_grow(target) != 0) {
+        engine_shrink(0);
+        tvmrt_cond_destroy(&g_engine.run_cond);
+        tvmrt_mutex_destroy(&g_engine.run_lock);
+        tvmrt_cond_destroy(&g_engine.request_done);
+        tvmrt_barrier_destroy(&g_engine.layer_barrier);
+        tvmrt_cond_destroy(&g_engine.task_queue.cond);
+        tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+        return -1;
+    }
+    
+    __atomic_store_n(&g_engine.initialized, true, __ATOMIC_RELEASE);
+#else
+    (void)config;
+#endif
+    return 0;
+}
+
+int tvmrt_engine_resize(int32_t num_workers) {
+#if TVMRT_NUM_WORKERS > 0
+    if (!__atomic_load_n(&g_engine.initialized, __ATOMIC_ACQUIRE)) {
+        return -1;
+    }
+    int32_t target = engine_resolve_workers(num_workers);
+    int32_t current = tvmrt_engine_num_workers();
+    if (target > current) {
+        return engine_grow(target);
+    }
+    if (target < current) {
+        engine_shrink(target);
+    }
+    return 0;
+#else
+    return num_workers == 0 ? 0 : -1;
+#endif
+}
+
+int32_t tvmrt_engine_num_workers(void) {
+#if TVMRT_NUM_WORKERS > 0
+    if (!__atomic_load_n(&g_engine.initialized, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    int32_t workers = g_engine.shutdown ? 0 : g_engine.num_workers;
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+    return workers;
+#else
+    return 0;
+#endif
+}
+
+int32_t tvmrt_engine_slot_count(void) {
+    int32_t workers = tvmrt_engine_num_workers();
+    return workers > 0 ? workers + TVMRT_CALLER_PARTICIPATES : 1;
+}
+
+tvmrt_engine_mode_t tvmrt_engine_mode(void) {
+#if TVMRT_NUM_WORKERS > 0
+    return g_engine.initialized ? g_engine.mode : TVMRT_ENGINE_LATENCY;
+#else
+    return TVMRT_ENGINE_LATENCY;
+#endif
+}
+
+void tvmrt_engine_shutdown(void) {
+#if TVMRT_NUM_WORKERS > 0
+    if (!g_engine.initialized) {
+        return;
+    }
+    
+    // 发送停机信号
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    g_engine.shutdown = true;
+    tvmrt_cond_broadcast(&g_engine.task_queue.cond);
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+    
+    // 等待所有 Worker 完成
+    for (int32_t i = 0; i < g_engine.num_workers; i++) {
+        tvmrt_thread_join(&g_engine.workers[i]);
+    }
+
+    // 仍在排队的请求由各自的提交线程接手执行，等它们全部离开请求队列
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    g_engine.num_workers = 0;
+    tvmrt_cond_broadcast(&g_engine.request_done);
+    while (g_engine.request_waiters > 0) {
+        tvmrt_cond_wait(&g_engine.request_done, &g_engine.task_queue.mutex);
+    }
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+    __atomic_store_n(&g_engine.initialized, false, __ATOMIC_RELEASE);
+    
+    // 清理
+    tvmrt_cond_destroy(&g_engine.run_cond);
+    tvmrt_mutex_destroy(&g_engine.run_lock);
+    tvmrt_cond_destroy(&g_engine.request_done);
+    tvmrt_barrier_destroy(&g_engine.layer_barrier);
+    tvmrt_cond_destroy(&g_engine.task_queue.cond);
+    tvmrt_mutex_destroy(&g_engine.task_queue.mutex);
+
+    for (int i = 0; i < TVMRT_MAX_WORKERS + ENGINE_PERF_CALLERS; i++) {
+        if (g_engine.perf_state[i] > 0) {
+            tvmrt_perf_group_close(&g_engine.perf[i]);
+        }
+        g_engine.perf_state[i] = 0;
+    }
+    g_engine.perf_callers = 0;
+    g_engine.perf_epoch++;
+#endif
+}
+
+void tvmrt_engine_set_profile(tvmrt_profile_t* prof) {
+#if TVMRT_NUM_WORKERS > 0
+    g_engine.profile = prof;
+#else
+    (void)prof;
+#endif
+}
+
+int tvmrt_profile_init(tvmrt_profile_t* prof, int32_t op_count, tvmrt_arena_t* arena) {
+    if (!prof || op_count < 0) {
+        return -1;
+    }
+    uint64_t bytes = (uint64_t)(op_count ? op_count : 1) * sizeof(tvmrt_profile_op_t);
+    prof->ops = arena ? (tvmrt_profile_op_t*)tvmrt_arena_alloc(arena, bytes, TVMRT_CACHE_LINE_SIZE)
+                      : (tvmrt_profile_op_t*)tvmrt_mem_alloc(bytes, TVMRT_CACHE_LINE_SIZE);
+    if (!prof->ops) {
+        prof->op_count = 0;
+        return -1;
+    }
+    prof->op_count = op_count;
+    prof->owned = (arena == NULL);
+    tvmrt_profile_reset(prof);
+    return 0;
+}
+
+void tvmrt_profile_destroy(tvmrt_profile_t* prof) {
+    if (!prof) {
+        return;
+    }
+    if (prof->owned) {
+        tvmrt_mem_free(prof->ops);
+    }
+    prof->ops = NULL;
+    prof->op_count = 0;
+    prof->owned = false;
+}
+
+void tvmrt_profile_reset(tvmrt_profile_t* prof) {
+    if (prof && prof->ops) {
+        memset(prof->ops, 0, (size_t)prof->op_count * sizeof(tvmrt_profile_op_t));
+    }
+}
+
+// 每千条指令的事件数; 事件或指令数缺失时返回 -1
+static double profile_mpki(const tvmrt_profile_op_t* rec, int32_t event) {
+    uint32_t need = (1u << event) | (1u << TVMRT_PERF_INSTRUCTIONS);
+    uint64_t instr = rec->counters[TVMRT_PERF_INSTRUCTIONS];
+    if ((rec->counter_mask & need) != need || instr == 0) return -1.0;
+    return (double)rec->counters[event] * 1000.0 / (double)instr;
+}
+
+static void profile_print_metric(FILE* out, double v) {
+    if (v < 0) {
+        fprintf(out, " %9s", "-");
+    } else {
+        fprintf(out, " %9.2f", v);
+    }
+}
+
+void tvmrt_profile_report(const tvmrt_profile_t* prof, const tvmrt_context_t* ctx, FILE* out) {
+    if (!prof || !out) {
+        return;
+    }
+
+    bool any_counted = false, any_scaled = false;
+    for (int32_t i = 0; i < prof->op_count; i++) {
+        any_counted |= (prof->ops[i].counted_calls > 0);
+        any_scaled |= (prof->ops[i].scaled_calls > 0);
+    }
+
+    fprintf(out, "%-4s %-16s %8s %10s %9s %9s %9s %9s\n",
+            "ID", "Op", "Calls", "Avg(ns)", "IPC", "L1D-MPKI", "LLC-MPKI", "BR-MPKI");
+    for (int32_t i = 0; i < prof->op_count; i++) {
+        const tvmrt_profile_op_t* rec = &prof->ops[i];
+        if (rec->calls == 0) continue;
+
+        const char* name = (ctx && i < ctx->op_count && ctx->op_execs[i].name)
+                               ? ctx->op_execs[i].name : "?";
+        fprintf(out, "%-4d %-16s %8llu %10.1f", i, name, (unsigned long long)rec->calls,
+                (double)rec->time_ns / (double)rec->calls);
+
+        uint32_t ipc_need = (1u << TVMRT_PERF_CYCLES) | (1u << TVMRT_PERF_INSTRUCTIONS);
+        double ipc = ((rec->counter_mask & ipc_need) == ipc_need && rec->counters[TVMRT_PERF_CYCLES])
+                         ? (double)rec->counters[TVMRT_PERF_INSTRUCTIONS] /
+                               (double)rec->counters[TVMRT_PERF_CYCLES]
+                         : -1.0;
+        profile_print_metric(out, ipc);
+        profile_print_metric(out, profile_mpki(rec, TVMRT_PERF_L1D_READ_MISSES));
+        profile_print_metric(out, profile_mpki(rec, TVMRT_PERF_CACHE_MISSES));
+        profile_print_metric(out, profile_mpki(rec, TVMRT_PERF_BRANCH_MISSES));
+        fprintf(out, "%s\n", rec->scaled_calls ? " *" : "");
+    }
+    if (!any_counted) {
+        fprintf(out, "(硬件计数器不可用: 非 Linux、无 PMU 或权限受限，仅报告耗时)\n");
+    }
+    if (any_scaled) {
+        fprintf(out, "(* 计数器被分时复用: 按 time_enabled / time_running 缩放的估计值)\n");
+    }
+}
+
+#if TVMRT_NUM_WORKERS > 0
+// 辅助函数：加载指定层任务到队列
+// (层号由调用方传入: 单算子层在调用线程内联执行，不经过队列)
+static void load_next_layer(int32_t layer_idx) {
+    const tvmrt_schedule_layer_t* layer = &g_engine.current_schedule->layers[layer_idx];
+    
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    
+    // 填充队列 (直接引用调度表中的算子序列)
+    g_engine.task_queue.tasks = layer->op_indices;
+    g_engine.task_queue.head = 0;
+    g_engine.task_queue.tail = layer->count;
+    g_engine.task_queue.count = layer->count;
+    
+    // 唤醒一个 Worker 开始链式执行
+    if (g_engine.task_queue.count > 0) {
+        tvmrt_cond_signal(&g_engine.task_queue.cond);
+    }
+    
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+    
+    g_engine.current_layer_idx = layer_idx + 1;
+}
+
+// 发布计划 (调用方持有 task_queue.mutex): layer_idx < 0 为依赖模式，
+// 切片在任一层有算子即为有任务
+static void engine_publish_plan(tvmrt_plan_t* plan, int32_t layer_idx) {
+    int32_t first = (layer_idx < 0) ? 0 : layer_idx;
+    int32_t last = (layer_idx < 0) ? plan->layer_count : layer_idx + 1;
+    for (int32_t slot = 0; slot < TVMRT_PLAN_MAX_SLOTS; slot++) {
+        bool busy = false;
+        for (int32_t l = first; slot < plan->slot_count && l < last && !busy; l++) {
+            const int32_t* row = &plan->slice_begin[l * plan->slice_stride];
+            busy = row[slot] != row[slot + 1];
+        }
+        g_engine.static_busy[slot] = busy;
+    }
+    g_engine.static_plan = plan;
+    g_engine.static_layer = layer_idx;
+    g_engine.generation++;
+}
+
+// 静态分配模式: 多算子层只发布层号，Worker 各自执行预先分配的切片
+static int engine_fanout_slices(tvmrt_plan_t* plan, int32_t layer_idx) {
+    tvmrt_barrier_reset(&g_engine.layer_barrier, plan->slice_active[layer_idx]);
+
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    engine_publish_plan(plan, layer_idx);
+    tvmrt_cond_broadcast(&g_engine.task_queue.cond);
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+
+#if TVMRT_CALLER_PARTICIPATES
+    engine_run_slice(plan, layer_idx, 0, ENGINE_CALLER_THREAD);
+#endif
+    engine_barrier_wait();
+    return g_engine.status;
+}
+
+// 自适应: 记录一次探测样本 (平滑系数 1/4)
+static void engine_adapt_record(tvmrt_plan_t* plan, int32_t layer_idx, int32_t mode, uint64_t ns) {
+    uint64_t* cost = &plan->layer_cost_ns[layer_idx][mode];
+    *cost = (*cost == 0) ? (ns ? ns : 1) : (*cost * 3 + ns) / 4;
+}
+
+// 自适应: 两种方式都有样本的层取较快者
+static void engine_adapt_decide(tvmrt_plan_t* plan) {
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        uint64_t fanout = plan->layer_cost_ns[l][TVMRT_LAYER_FANOUT];
+        uint64_t inl = plan->layer_cost_ns[l][TVMRT_LAYER_INLINE];
+        if (fanout && inl) {
+            plan->layer_mode[l] = (inl <= fanout) ? TVMRT_LAYER_INLINE : TVMRT_LAYER_FANOUT;
+        }
+    }
+}
+
+// 依赖模式: 一次发布整个计划，只在最后等待所有切片走完
+static int engine_run_dataflow(tvmrt_plan_t* plan) {
+    uint32_t epoch = plan->run_epoch + 1;
+    if (epoch == 0) {
+        // 回绕: 清零完成标志，保证旧标志不会与新 epoch 相等
+        memset(plan->done_epoch, 0, (size_t)plan->op_count * sizeof(uint32_t));
+        epoch = 1;
+    }
+
+    tvmrt_barrier_reset(&g_engine.layer_barrier, plan->slot_active);
+
+    tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+    plan->run_epoch = epoch;
+    g_engine.static_epoch = epoch;
+    engine_publish_plan(plan, -1);
+    tvmrt_cond_broadcast(&g_engine.task_queue.cond);
+    tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+
+#if TVMRT_CALLER_PARTICIPATES
+    engine_run_dataflow_slot(plan, 0, epoch, ENGINE_CALLER_THREAD);
+#endif
+    engine_barrier_wait();
+    return g_engine.status;
+}
+
+// 按计划执行: 每层按 layer_mode 串行或分发给静态切片
+static int engine_run_plan(tvmrt_plan_t* plan) {
+    if (plan->dataflow) {
+        return engine_run_dataflow(plan);
+    }
+
+    uint32_t run = plan->adapt_runs;
+    bool probe = plan->adapt_warmup > 0 &&
+                 (run < (uint32_t)plan->adapt_warmup ||
+                  (plan->adapt_interval > 0 && run % (uint32_t)plan->adapt_interval < 2));
+
+    for (int32_t layer_idx = 0; layer_idx < plan->layer_count; layer_idx++) {
+        int32_t begin = plan->layer_begin[layer_idx];
+        int32_t count = plan->layer_begin[layer_idx + 1] - begin;
+
+        TVMRT_LOG_LAYER(layer_idx, count);
+
+        if (plan->layer_hook) {
+            plan->layer_hook(layer_idx, plan->layer_hook_user);
+        }
+
+        if (count == 0) {
+            continue;
+        }
+        if (engine_aborted()) {
+            return g_engine.status;
+        }
+
+        int32_t mode = plan->layer_mode[layer_idx];
+        bool sample = probe && count > 1;
+        uint64_t t0 = 0;
+        if (sample) {
+            mode = (run & 1) ? TVMRT_LAYER_INLINE : TVMRT_LAYER_FANOUT;
+            t0 = tvmrt_time_ns();
+        }
+
+        if (count == 1 || mode == TVMRT_LAYER_INLINE) {
+            // 调用线程串行执行
+            for (int32_t i = begin; i < begin + count; i++) {
+                if (i > begin && engine_aborted()) {
+                    return g_engine.status;
+                }
+                int32_t ret = engine_call_op(ENGINE_CALLER_THREAD, plan->op_ids[i],
+                                             plan->ops[i].func, plan->ops[i].args);
+                if (ret != 0) return ret;
+            }
+        } else {
+            int ret = engine_fanout_slices(plan, layer_idx);
+            if (ret != 0) return ret;
+        }
+
+        if (sample) {
+            engine_adapt_record(plan, layer_idx, mode, tvmrt_time_ns() - t0);
+        }
+    }
+
+    if (plan->adapt_warmup > 0) {
+        if (probe) {
+            engine_adapt_decide(plan);
+        }
+        plan->adapt_runs = run + 1;
+    }
+    return 0;
+}
+#endif
+
+int tvmrt_engine_run(
+    tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule
+) {
+    if (!ctx || !schedule) {
+        return -1;
+    }
+    
+#if TVMRT_NUM_WORKERS > 0
+    if (tvmrt_engine_num_workers() == 0) {
+        return tvmrt_engine_run_single(ctx, schedule);
+    }
+    
+    g_engine.status = 0;
+    g_engine.deadline_ns = ctx->deadline_ns;
+    g_engine.cancel = ctx->cancel;
+    if (engine_aborted()) {
+        return g_engine.status;  // 开始前已到期或被取消
+    }
+
+    if (ctx->plan && ctx->plan->slot_count > 0) {
+        // 线程池扩缩容后切片数与执行线程数不符: 按原代价重新分配
+        int32_t slots = tvmrt_engine_slot_count();
+        if (slots > ctx->plan->slice_stride - 1) {
+            slots = ctx->plan->slice_stride - 1;   // 与 tvmrt_plan_assign 的截断一致
+        }
+        if (ctx->plan->slot_count != slots &&
+            tvmrt_plan_assign(ctx->plan, ctx->plan->assign_cost, slots) != 0) {
+            return -1;
+        }
+        return engine_run_plan(ctx->plan);
+    }
+
+    // 设置全局状态
+    g_engine.current_ctx = ctx;
+    g_engine.current_schedule = schedule;
+    g_engine.current_layer_idx = 0;
+    
+    // 逐层执行
+    for (int32_t layer_idx = 0; layer_idx < schedule->layer_count; layer_idx++) {
+        const tvmrt_schedule_layer_t* layer = &schedule->layers[layer_idx];
+
+        // 层边界标记
+        TVMRT_LOG_LAYER(layer_idx, layer->count);
+
+        if (ctx->layer_hook) {
+            ctx->layer_hook(layer_idx, ctx->layer_hook_user);
+        }
+
+        if (layer->count == 0) {
+            continue;
+        }
+        if (engine_aborted()) {
+            return g_engine.status;
+        }
+
+        if (layer->count == 1) {
+            // 单任务: 直接执行
+            int32_t op_idx = layer->op_indices[0];
+            if (op_idx >= 0 && op_idx < ctx->op_count) {
+                tvmrt_op_exec_t* exec = &ctx->op_execs[op_idx];
+                if (exec->func) {
+                    // 调度引擎日志已禁用，由包装函数中的参数日志替代
+                    // TVMRT_LOG_OP_START(op_idx, exec->name, -1);
+                    int32_t ret = engine_call_op(ENGINE_CALLER_THREAD, op_idx, exec->func, exec->args);
+                    // TVMRT_LOG_OP_END(op_idx, exec->name, -1, ret);
+                    if (ret != 0) return ret;
+                }
+            }
+        } else {
+            // 多任务: 填充队列并等待完成
+            tvmrt_barrier_reset(&g_engine.layer_barrier, layer->count);
+            load_next_layer(layer_idx);
+#if TVMRT_CALLER_PARTICIPATES
+            // 调用线程一同出队执行，队列取空后只等待仍在执行的 Worker
+            while (1) {
+                tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+                int32_t op_id = queue_pop_locked();
+                tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+                if (op_id < 0) break;
+                engine_exec_queued(op_id, ENGINE_CALLER_THREAD);
+            }
+#endif
+            engine_barrier_wait();
+            if (g_engine.status != 0) {
+                return g_engine.status;
+            }
+        }
+    }
+    
+    return 0;
+#else
+    return tvmrt_engine_run_single(ctx, schedule);
+#endif
+}
+
+#if TVMRT_NUM_WORKERS > 0
+// 等待者离开本级队列 (调用方持有 run_lock)，到期/被取消的等待者可能不在队首
+static void engine_run_waiter_remove_locked(engine_run_waiter_t* w, int32_t priority) {
+    engine_run_waiter_t* prev = NULL;
+    for (engine_run_waiter_t* r = g_engine.run_head[priority]; r; prev = r, r = r->next) {
+        if (r != w) continue;
+        if (prev) {
+            prev->next = r->next;
+        } else {
+            g_engine.run_head[priority] = r->next;
+        }
+        if (g_engine.run_tail[priority] == r) {
+            g_engine.run_tail[priority] = prev;
+        }
+        break;
+    }
+}
+#endif
+
+// 执行上下文池的一个请求 (ctx->plan 已编译): 按引擎工作方式排队或按优先级
+// 互斥分发，没有 Worker 时在调用线程上串行执行。设置了截止时刻或取消令牌
+// 时，排队期间到期/被取消的请求直接撤回 (不占用 Worker)。排队期间线程池
+// 缩容到 0 或停机时，请求撤回到调用线程上从断点继续执行
+static int32_t engine_run_request(tvmrt_context_t* ctx, const tvmrt_schedule_desc_t* schedule,
+                                  int32_t priority) {
+    bool abortable = ctx->deadline_ns || ctx->cancel;
+#if TVMRT_NUM_WORKERS > 0
+    bool pooled = false;
+    if (__atomic_load_n(&g_engine.initialized, __ATOMIC_ACQUIRE)) {
+        tvmrt_mutex_lock(&g_engine.task_queue.mutex);
+        pooled = g_engine.num_workers > 0 && !g_engine.shutdown;
+        if (pooled && g_engine.mode == TVMRT_ENGINE_THROUGHPUT) {
+            engine_request_t req = {.plan = ctx->plan, .priority = priority,
+                                    .deadline_ns = ctx->deadline_ns, .cancel = ctx->cancel};
+            bool orphaned = false;
+            g_engine.request_waiters++;
+            engine_request_push_locked(&req, false);
+            tvmrt_cond_signal(&g_engine.task_queue.cond);
+            while (!req.done) {
+                if (req.queued && (g_engine.num_workers == 0 || g_engine.shutdown)) {
+                    // 没有 Worker 会再取出它
+                    engine_request_remove_locked(&req);
+                    orphaned = true;
+                    break;
+                }
+                if (!abortable || req.started) {
+                    // 已开始的请求由 Worker 在算子边界检查
+                    tvmrt_cond_wait(&g_engine.request_done, &g_engine.task_queue.mutex);
+                    continue;
+                }
+                tvmrt_cond_timedwait(&g_engine.request_done, &g_engine.task_queue.mutex,
+                                     engine_abort_wake(ctx->deadline_ns, ctx->cancel));
+                int32_t reason = engine_abort_reason(ctx->deadline_ns, ctx->cancel);
+                if (reason != 0 && !req.started && !req.done) {
+                    engine_request_remove_locked(&req);
+                    req.status = reason;
+                    break;
+                }
+            }
+            if (--g_engine.request_waiters == 0 && g_engine.shutdown) {
+                tvmrt_cond_broadcast(&g_engine.request_done);   // 停机在等提交线程离开
+            }
+            tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+            if (orphaned) {
+                engine_run_request_ops(&req, false);
+            }
+            return req.status;
+        }
+        tvmrt_mutex_unlock(&g_engine.task_queue.mutex);
+    }
+    if (pooled) {
+        // 引擎空闲、本请求位于本级队首且没有更高优先级的等待者时获得引擎
+        int32_t reason = 0;
+        engine_run_waiter_t self = {NULL};
+        tvmrt_mutex_lock(&g_engine.run_lock);
+        if (g_engine.run_tail[priority]) {
+            g_engine.run_tail[priority]->next = &self;
+        } else {
+            g_engine.run_head[priority] = &self;
+        }
+        g_engine.run_tail[priority] = &self;
+        while (1) {
+            bool blocked = g_engine.run_busy || g_engine.run_head[priority] != &self;
+            for (int32_t p = priority + 1; p < TVMRT_PRIORITY_LEVELS && !blocked; p++) {
+                blocked = g_engine.run_head[p] != NULL;
+            }
+            if (!blocked) break;
+            if (!abortable) {
+                tvmrt_cond_wait(&g_engine.run_cond, &g_engine.run_lock);
+                continue;
+            }
+            tvmrt_cond_timedwait(&g_engine.run_cond, &g_engine.run_lock,
+                                 engine_abort_wake(ctx->deadline_ns, ctx->cancel));
+            if ((reason = engine_abort_reason(ctx->deadline_ns, ctx->cancel)) != 0) {
+                break;
+            }
+        }
+        engine_run_waiter_remove_locked(&self, priority);
+        if (reason != 0) {
+            // 本等待者可能正挡着同级后到或低优先级的请求
+            tvmrt_cond_broadcast(&g_engine.run_cond);
+            tvmrt_mutex_unlock(&g_engine.run_lock);
+            return reason;
+        }
+        g_engine.run_busy = true;
+        tvmrt_mutex_unlock(&g_engine.run_lock);
+
+        int32_t ret = tvmrt_engine_run(ctx, schedule);
+
+        tvmrt_mutex_lock(&g_engine.run_lock);
+        g_engine.run_busy = false;
+        tvmrt_cond_broadcast(&g_engine.run_cond);
+        tvmrt_mutex_unlock(&g_engine.run_lock);
+        return ret;
+    }
+#endif
+    (void)priority;
+    return abortable ? tvmrt_engine_run_single(ctx, schedule) : tvmrt_plan_run(ctx->plan);
+}
+
+int tvmrt_engine_run_single(
+    tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule
+) {
+    if (!ctx || !schedule) {
+        return -1;
+    }
+
+    // 已编译计划: 走扁平紧凑循环 (设置了截止时刻/取消令牌时逐算子检查, 走下方循环)
+    bool abortable = ctx->deadline_ns || ctx->cancel;
+    if (ctx->plan && !abortable) {
+        return tvmrt_plan_run(ctx->plan);
+    }
+
+    // 简单串行执行
+    for (int32_t layer_idx = 0; layer_idx < schedule->layer_count; layer_idx++) {
+        const tvmrt_schedule_layer_t* layer = &schedule->layers[layer_idx];
+
+        // 层边界标记
+        TVMRT_LOG_LAYER(layer_idx, layer->count);
+
+        if (ctx->layer_hook) {
+            ctx->layer_hook(layer_idx, ctx->layer_hook_user);
+        }
+
+        for (int32_t task_idx = 0; task_idx < layer->count; task_idx++) {
+            int32_t op_idx = layer->op_indices[task_idx];
+            if (op_idx >= 0 && op_idx < ctx->op_count) {
+                tvmrt_op_exec_t* exec = &ctx->op_execs[op_idx];
+                if (exec->func) {
+                    int32_t reason = abortable ? engine_abort_reason(ctx->deadline_ns, ctx->cancel) : 0;
+                    if (reason != 0) return reason;
+                    // 调度引擎日志已禁用，由包装函数中的参数日志替代
+                    // TVMRT_LOG_OP_START(op_idx, exec->name, -1);
+                    int32_t ret = exec->func(exec->args);
+                    // TVMRT_LOG_OP_END(op_idx, exec->name, -1, ret);
+                    if (ret != 0) return ret;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+// ============================================================
+// 执行计划实现
+// ============================================================
+
+// 调度表规模: 算子总数 (各层 count 之和) 与最宽层
+static void plan_schedule_extent(const tvmrt_schedule_desc_t* schedule, int32_t* ops, int32_t* width) {
+    *ops = 0;
+    *width = 1;
+    for (int32_t l = 0; l < schedule->layer_count; l++) {
+        int32_t count = schedule->layers[l].count;
+        if (count <= 0) continue;
+        *ops += count;
+        *width = (count > *width) ? count : *width;
+    }
+}
+
+typedef uint64_t plan_cost_pair_t[2];
+
+// 计划数组布局 (每个数组缓存行对齐): base 为 NULL 时只计算总字节数
+static uint64_t plan_layout(
+    tvmrt_plan_t* plan, uint8_t* base, int32_t ops, int32_t layers, int32_t slots, int32_t width,
+    int32_t ids
+) {
+    uint64_t off = 0;
+#define PLAN_CARVE(field, type, count)                                                  \
+    do {                                                                                \
+        if (base) plan->field = (type*)(base + off);                                    \
+        off += ((uint64_t)(count) * sizeof(type) + TVMRT_CACHE_LINE_SIZE - 1) &         \
+               ~(uint64_t)(TVMRT_CACHE_LINE_SIZE - 1);                                  \
+    } while (0)
+    PLAN_CARVE(ops, tvmrt_plan_op_t, ops);
+    PLAN_CARVE(slice_ops, tvmrt_plan_op_t, ops);
+    PLAN_CARVE(layer_begin, int32_t, layers + 1);
+    PLAN_CARVE(op_ids, int32_t, ops);
+    PLAN_CARVE(slice_pos, int32_t, ops);
+    PLAN_CARVE(slice_begin, int32_t, (uint64_t)layers * (uint64_t)(slots + 1));
+    PLAN_CARVE(slice_active, int32_t, layers);
+    PLAN_CARVE(assign_cost, uint64_t, ids);
+    PLAN_CARVE(assign_scratch, int32_t, 2 * width);
+    PLAN_CARVE(assign_load, uint64_t, slots);
+    PLAN_CARVE(layer_mode, uint8_t, layers);
+    PLAN_CARVE(layer_cost_ns, plan_cost_pair_t, layers);
+    PLAN_CARVE(dep_begin, int32_t, ops + 1);
+    PLAN_CARVE(done_epoch, uint32_t, ops);
+#undef PLAN_CARVE
+    return off;
+}
+
+int tvmrt_plan_reserve(
+    tvmrt_plan_t* plan,
+    const tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule,
+    tvmrt_arena_t* arena
+) {
+    if (!plan || !ctx || !schedule || schedule->layer_count < 0 || ctx->op_count < 0) {
+        return -1;
+    }
+
+    int32_t ops, width;
+    plan_schedule_extent(schedule, &ops, &width);
+    int32_t slots = (width < TVMRT_PLAN_MAX_SLOTS) ? width : TVMRT_PLAN_MAX_SLOTS;
+    int32_t layers = schedule->layer_count;
+    int32_t ids = ctx->op_count;
+
+    tvmrt_plan_destroy(plan);
+    uint64_t bytes = plan_layout(plan, NULL, ops, layers, slots, width, ids);
+    uint8_t* base = arena ? (uint8_t*)tvmrt_arena_alloc(arena, bytes, TVMRT_CACHE_LINE_SIZE)
+                          : (uint8_t*)tvmrt_mem_alloc(bytes, TVMRT_CACHE_LINE_SIZE);
+    if (!base) {
+        return -1;
+    }
+    plan_layout(plan, base, ops, layers, slots, width, ids);
+    plan->arena = arena;
+    plan->storage = arena ? NULL : base;
+    plan->op_capacity = ops;
+    plan->layer_capacity = layers;
+    plan->id_capacity = ids;
+    plan->slice_stride = slots + 1;
+    return 0;
+}
+
+void tvmrt_plan_destroy(tvmrt_plan_t* plan) {
+    if (!plan) {
+        return;
+    }
+    if (!plan->arena) {
+        tvmrt_mem_free(plan->storage);
+        tvmrt_mem_free(plan->dep_storage);
+    }
+    memset(plan, 0, sizeof(*plan));
+}
+
+int tvmrt_plan_compile(
+    tvmrt_plan_t* plan,
+    const tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule
+) {
+    if (!plan || !ctx || !schedule || schedule->layer_count < 0) {
+        return -1;
+    }
+
+    // 容量不足时 (含首次编译) 按上次的分配来源重新分配
+    int32_t ops, width;
+    plan_schedule_extent(schedule, &ops, &width);
+    int32_t slots = (width < TVMRT_PLAN_MAX_SLOTS) ? width : TVMRT_PLAN_MAX_SLOTS;
+    bool fits = plan->ops && ops <= plan->op_capacity &&
+                schedule->layer_count <= plan->layer_capacity &&
+                ctx->op_count <= plan->id_capacity && slots < plan->slice_stride;
+    if (!fits && tvmrt_plan_reserve(plan, ctx, schedule, plan->arena) != 0) {
+        return -1;
+    }
+
+    int32_t n = 0;
+    for (int32_t l = 0; l < schedule->layer_count; l++) {
+        const tvmrt_schedule_layer_t* layer = &schedule->layers[l];
+        plan->layer_begin[l] = n;
+
+        for (int32_t i = 0; i < layer->count; i++) {
+            int32_t op_idx = layer->op_indices[i];
+            if (op_idx < 0 || op_idx >= ctx->op_count) continue;
+
+            const tvmrt_op_exec_t* exec = &ctx->op_execs[op_idx];
+            if (!exec->func) continue;
+
+            plan->ops[n].func = exec->func;
+            plan->ops[n].args = exec->args;
+            plan->op_ids[n] = op_idx;
+            n++;
+        }
+    }
+    plan->layer_begin[schedule->layer_count] = n;
+    plan->op_count = n;
+    plan->layer_count = schedule->layer_count;
+    plan->id_count = ctx->op_count;
+    plan->layer_hook = ctx->layer_hook;
+    plan->layer_hook_user = ctx->layer_hook_user;
+    plan->slot_count = 0;  // 重新编译后需重新分配切片
+    plan->adapt_warmup = 0;
+    plan->adapt_interval = 0;
+    plan->adapt_runs = 0;
+    plan->dataflow = false;
+    plan->dep_begin[0] = 0;
+    plan->run_epoch = 0;
+    memset(plan->done_epoch, 0, (size_t)n * sizeof(uint32_t));
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        int32_t count = plan->layer_begin[l + 1] - plan->layer_begin[l];
+        plan->layer_mode[l] = (count > 1) ? TVMRT_LAYER_FANOUT : TVMRT_LAYER_INLINE;
+        plan->layer_cost_ns[l][0] = 0;
+        plan->layer_cost_ns[l][1] = 0;
+    }
+
+    return 0;
+}
+
+int tvmrt_plan_run(const tvmrt_plan_t* plan) {
+    if (!plan) {
+        return -1;
+    }
+
+    const tvmrt_plan_op_t* op = plan->ops;
+
+#if !TVMRT_LOG_ENABLE
+    // 热路径: 无层边界处理
+    if (!plan->layer_hook) {
+        const tvmrt_plan_op_t* end = plan->ops + plan->op_count;
+        for (; op < end; op++) {
+            int32_t ret = op->func(op->args);
+            if (ret != 0) return ret;
+        }
+        return 0;
+    }
+#endif
+
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        const tvmrt_plan_op_t* layer_end = plan->ops + plan->layer_begin[l + 1];
+
+        TVMRT_LOG_LAYER(l, plan->layer_begin[l + 1] - plan->layer_begin[l]);
+        if (plan->layer_hook) {
+            plan->layer_hook(l, plan->layer_hook_user);
+        }
+
+        for (; op < layer_end; op++) {
+            int32_t ret = op->func(op->args);
+            if (ret != 0) return ret;
+        }
+    }
+
+    return 0;
+}
+
+int tvmrt_plan_measure(const tvmrt_plan_t* plan, int32_t iters, uint64_t* cost_ns) {
+    if (!plan || !cost_ns || iters <= 0) {
+        return -1;
+    }
+
+    memset(cost_ns, 0, sizeof(uint64_t) * (size_t)plan->id_count);
+    for (int32_t it = 0; it < iters; it++) {
+        for (int32_t i = 0; i < plan->op_count; i++) {
+            uint64_t t0 = tvmrt_time_ns();
+            int32_t ret = plan->ops[i].func(plan->ops[i].args);
+            cost_ns[plan->op_ids[i]] += tvmrt_time_ns() - t0;
+            if (ret != 0) return ret;
+        }
+    }
+    for (int32_t i = 0; i < plan->op_count; i++) {
+        cost_ns[plan->op_ids[i]] /= (uint64_t)iters;
+    }
+
+    return 0;
+}
+
+int tvmrt_plan_assign(tvmrt_plan_t* plan, const uint64_t* op_cost, int32_t slots) {
+    if (!plan || !plan->ops || slots <= 0 || slots > TVMRT_PLAN_MAX_SLOTS) {
+        return -1;
+    }
+    if (slots > plan->slice_stride - 1) {
+        slots = plan->slice_stride - 1;  // 多出的切片不会分到算子
+    }
+
+    uint64_t* load = plan->assign_load;
+    int32_t n = 0;
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        int32_t begin = plan->layer_begin[l];
+        int32_t count = plan->layer_begin[l + 1] - begin;
+        int32_t* order = plan->assign_scratch;
+        int32_t* owner = plan->assign_scratch + count;
+        uint64_t* cost = plan->assign_cost;  // 按算子 ID
+
+        // 按代价降序排列本层算子 (插入排序, 相同代价保持原顺序)
+        for (int32_t k = 0; k < count; k++) {
+            int32_t id = plan->op_ids[begin + k];
+            uint64_t c = op_cost ? op_cost[id] : 1;
+            cost[id] = c ? c : 1;
+            int32_t j = k;
+            while (j > 0 && cost[plan->op_ids[begin + order[j - 1]]] < cost[id]) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = k;
+        }
+
+        // LPT: 依次交给当前负载最小的切片
+        memset(load, 0, (size_t)slots * sizeof(uint64_t));
+        for (int32_t k = 0; k < count; k++) {
+            int32_t best = 0;
+            for (int32_t w = 1; w < slots; w++) {
+                if (load[w] < load[best]) best = w;
+            }
+            owner[order[k]] = best;
+            load[best] += cost[plan->op_ids[begin + order[k]]];
+        }
+
+        // 按切片收集，切片内保持原调度顺序
+        int32_t* row = &plan->slice_begin[l * plan->slice_stride];
+        plan->slice_active[l] = 0;
+        for (int32_t w = 0; w < slots; w++) {
+            row[w] = n;
+            for (int32_t k = 0; k < count; k++) {
+                if (owner[k] == w) {
+                    plan->slice_pos[n] = begin + k;
+                    plan->slice_ops[n++] = plan->ops[begin + k];
+                }
+            }
+            if (n > row[w]) {
+                plan->slice_active[l]++;
+            }
+        }
+        row[slots] = n;
+    }
+
+    // 至少在一层分到算子的切片数
+    plan->slot_active = 0;
+    for (int32_t w = 0; w < slots; w++) {
+        bool used = false;
+        for (int32_t l = 0; l < plan->layer_count && !used; l++) {
+            const int32_t* row = &plan->slice_begin[l * plan->slice_stride];
+            used = row[w + 1] > row[w];
+        }
+        plan->slot_active += used ? 1 : 0;
+    }
+    plan->slot_count = slots;
+
+    return 0;
+}
+
+int tvmrt_plan_set_adaptive(tvmrt_plan_t* plan, int32_t warmup, int32_t interval) {
+    if (!plan || warmup < 0 || warmup == 1 || interval < 0) {
+        return -1;
+    }
+    if (warmup > 0 && plan->slot_count == 0 &&
+        tvmrt_plan_assign(plan, NULL, tvmrt_engine_slot_count()) != 0) {
+        return -1;
+    }
+
+    plan->adapt_warmup = warmup;
+    plan->adapt_interval = interval;
+    plan->adapt_runs = 0;
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        int32_t count = plan->layer_begin[l + 1] - plan->layer_begin[l];
+        plan->layer_mode[l] = (count > 1) ? TVMRT_LAYER_FANOUT : TVMRT_LAYER_INLINE;
+        plan->layer_cost_ns[l][0] = 0;
+        plan->layer_cost_ns[l][1] = 0;
+    }
+    return 0;
+}
+
+// 算子的一次张量访问: SID 与其在 workspace 中的字节区间 (lo < 0 表示外部输入输出或未知 SID)
+typedef struct {
+    int32_t sid;
+    int32_t lo;
+    int32_t hi;
+} plan_access_t;
+
+#define PLAN_ACCESS_STRIDE (TVMRT_MAX_OP_INPUTS + TVMRT_MAX_OP_OUTPUTS)
+
+// 两次访问的内存区间是否重叠 / a 是否完全覆盖 b
+// (外部输入输出以 SID 身份区分，不与 workspace 重叠)
+static bool plan_access_overlap(const plan_access_t* a, const plan_access_t* b, bool* covers) {
+    *covers = false;
+    if (a->sid == b->sid) {
+        *covers = true;
+        return true;
+    }
+    if (a->lo < 0 || b->lo < 0) {
+        return false;
+    }
+    *covers = (a->lo <= b->lo && a->hi >= b->hi);
+    return a->lo < b->hi && b->lo < a->hi;
+}
+
+// 回溯每个位置的前驱: record 为假时只统计边数，否则同时写入 plan->dep_list
+// 与 plan->dep_begin。mark[i] == j + 1 表示 i 已记为 j 的前驱 (去重)
+static int32_t plan_deps_scan(tvmrt_plan_t* plan, const tvmrt_model_desc_t* model,
+                              const plan_access_t* access, int32_t* mark, bool record) {
+    int32_t n = 0;
+    int32_t layer = 0;
+    for (int32_t j = 0; j < plan->op_count; j++) {
+        mark[j] = 0;
+    }
+    for (int32_t j = 0; j < plan->op_count; j++) {
+        while (plan->layer_begin[layer + 1] <= j) layer++;
+        const tvmrt_op_desc_t* dj = &model->op_descs[plan->op_ids[j]];
+        if (record) {
+            plan->dep_begin[j] = n;
+        }
+
+        // 逐个访问向前回溯 (只看更早的层，同层算子无冒险)
+        int32_t accesses = dj->input_count + dj->output_count;
+        for (int32_t a = 0; a < accesses; a++) {
+            bool j_writes = (a >= dj->input_count);
+            const plan_access_t* acc = &access[j * PLAN_ACCESS_STRIDE + a];
+
+            for (int32_t i = plan->layer_begin[layer] - 1; i >= 0; i--) {
+                const tvmrt_op_desc_t* di = &model->op_descs[plan->op_ids[i]];
+                const plan_access_t* ai = &access[i * PLAN_ACCESS_STRIDE];
+                bool dep = false, stop = false;
+                for (int32_t k = 0; k < di->output_count; k++) {
+                    bool covers;
+                    if (plan_access_overlap(&ai[di->input_count + k], acc, &covers)) {
+                        dep = true;            // RAW / WAW
+                        stop |= covers;        // 更早的访问已由 i 传递排序
+                    }
+                }
+                if (!dep && j_writes) {
+                    for (int32_t k = 0; k < di->input_count; k++) {
+                        bool covers;
+                        if (plan_access_overlap(&ai[k], acc, &covers)) {
+                            dep = true;        // WAR
+                        }
+                    }
+                }
+                if (dep && mark[i] != j + 1) {
+                    mark[i] = j + 1;
+                    if (record) {
+                        plan->dep_list[n] = i;
+                    }
+                    n++;
+                }
+                if (stop) break;
+            }
+        }
+    }
+    if (record) {
+        plan->dep_begin[plan->op_count] = n;
+    }
+    return n;
+}
+
+int tvmrt_plan_build_deps(tvmrt_plan_t* plan, const tvmrt_model_desc_t* model) {
+    // 依赖标志模式没有层边界，层级回调 (如分页器按层换入) 无处触发
+    if (!plan || !model || plan->layer_hook) {
+        return -1;
+    }
+    if (plan->slot_count == 0 && tvmrt_plan_assign(plan, NULL, tvmrt_engine_slot_count()) != 0) {
+        return -1;
+    }
+
+    // 预先解析每个位置的访问区间，回溯时不再查表 (mark 紧随其后)
+    int32_t positions = plan->op_count ? plan->op_count : 1;
+    uint64_t access_bytes = (uint64_t)positions * PLAN_ACCESS_STRIDE * sizeof(plan_access_t);
+    plan_access_t* access = (plan_access_t*)tvmrt_mem_alloc(
+        access_bytes + (uint64_t)positions * sizeof(int32_t), 8);
+    if (!access) {
+        return -1;
+    }
+    int32_t* mark = (int32_t*)((uint8_t*)access + access_bytes);
+    bool sorted = model->tensor_map && semantic_map_sorted(model->tensor_map, model->tensor_count);
+    for (int32_t i = 0; i < plan->op_count; i++) {
+        const tvmrt_op_desc_t* d = &model->op_descs[plan->op_ids[i]];
+        for (int32_t a = 0; a < d->input_count + d->output_count; a++) {
+            plan_access_t* acc = &access[i * PLAN_ACCESS_STRIDE + a];
+            acc->sid = (a < d->input_count) ? d->input_sids[a] : d->output_sids[a - d->input_count];
+            acc->lo = acc->hi = -1;
+            int32_t t = (acc->sid >= 0 && model->tensor_map)
+                            ? semantic_find_sid(model->tensor_map, model->tensor_count, sorted, acc->sid)
+                            : -1;
+            if (t >= 0) {
+                acc->lo = model->tensor_map[t].offset;
+                acc->hi = acc->lo + model->tensor_map[t].size;
+            }
+        }
+    }
+
+    // 先统计边数，容量不足时按计划的分配来源一次分配，再写入前驱表
+    int32_t n = plan_deps_scan(plan, model, access, mark, false);
+    if (n > plan->dep_capacity) {
+        int32_t* dst = plan->arena
+                           ? (int32_t*)tvmrt_arena_alloc(plan->arena, (uint64_t)n * sizeof(int32_t), 8)
+                           : (int32_t*)tvmrt_mem_alloc((uint64_t)n * sizeof(int32_t), 8);
+        if (!dst) {
+            tvmrt_mem_free(access);
+            return -1;
+        }
+        if (!plan->arena) {
+            tvmrt_mem_free(plan->dep_storage);
+            plan->dep_storage = dst;
+        }
+        plan->dep_list = dst;
+        plan->dep_capacity = n;
+    }
+    plan_deps_scan(plan, model, access, mark, true);
+    tvmrt_mem_free(access);
+    plan->dataflow = true;
+
+    return 0;
+}
+
+void tvmrt_plan_dump(const tvmrt_plan_t* plan, FILE* out) {
+    if (!plan || !out) {
+        return;
+    }
+    fprintf(out, "Layer  Ops  Mode     Inline(ns)  Fanout(ns)\n");
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        int32_t count = plan->layer_begin[l + 1] - plan->layer_begin[l];
+        bool inl = (count <= 1 || plan->layer_mode[l] == TVMRT_LAYER_INLINE);
+        fprintf(out, "%5d  %3d  %-7s  %10llu  %10llu\n", l + 1, count,
+                inl ? "inline" : "fanout",
+                (unsigned long long)plan->layer_cost_ns[l][TVMRT_LAYER_INLINE],
+                (unsigned long long)plan->layer_cost_ns[l][TVMRT_LAYER_FANOUT]);
+    }
+}
+
+int tvmrt_plan_emit_c(
+    const tvmrt_plan_t* plan,
+    const tvmrt_model_desc_t* model,
+    const char* func_name,
+    FILE* out
+) {
+    if (!plan || !model || !model->cpu_func_names || !func_name || !out) {
+        return -1;
+    }
+
+    // 由函数指针回查函数表索引
+    int32_t* entry = (int32_t*)tvmrt_mem_alloc(
+        (uint64_t)(plan->op_count ? plan->op_count : 1) * sizeof(int32_t), 8);
+    if (!entry) {
+        return -1;
+    }
+    for (int32_t i = 0; i < plan->op_count; i++) {
+        entry[i] = -1;
+        for (int32_t f = 0; f < model->cpu_func_count; f++) {
+            if (model->cpu_func_table[f] == plan->ops[i].func) {
+                entry[i] = f;
+                break;
+            }
+        }
+        if (entry[i] < 0) {
+            tvmrt_mem_free(entry);
+            return -1;
+        }
+    }
+
+    fprintf(out, "/**\n * @brief %s - 直线展开的执行函数 (由 tvmrt_plan_emit_c 生成, 请勿手改)\n"
+                 " *\n * %d 算子 / %d 层\n */\n\n",
+            func_name, plan->op_count, plan->layer_count);
+    fprintf(out, "#include \"tvmrt.h\"\n\n");
+
+    // 声明用到的包装函数 (去重)
+    for (int32_t f = 0; f < model->cpu_func_count; f++) {
+        for (int32_t i = 0; i < plan->op_count; i++) {
+            if (entry[i] == f) {
+                fprintf(out, "extern int32_t %s(void *args);\n", model->cpu_func_names[f]);
+                break;
+            }
+        }
+    }
+
+    fprintf(out, "\nint32_t %s(tvmrt_op_args_t *args) {\n  int32_t ret;\n", func_name);
+    for (int32_t l = 0; l < plan->layer_count; l++) {
+        fprintf(out, "\n  // Layer %d\n", l + 1);
+        for (int32_t i = plan->layer_begin[l]; i < plan->layer_begin[l + 1]; i++) {
+            int32_t op_id = plan->op_ids[i];
+            const char* name = (op_id < model->op_count) ? model->op_descs[op_id].name : "?";
+            fprintf(out, "  if ((ret = %s(&args[%d])) != 0) return ret; // %s\n",
+                    model->cpu_func_names[entry[i]], op_id, name);
+        }
+    }
+    fprintf(out, "\n  return 0;\n}\n");
+    tvmrt_mem_free(entry);
+
+    return 0;
+}
+
+// ============================================================
+// 请求槽位 (批处理器与上下文池共用)
+// ============================================================
+//
+// 每个槽位一份参数区/执行表/workspace，按占位地址预先绑定，执行前只把
+// 请求的输入输出指针写入记录下来的字段。
+
+// 绑定时占位的输入输出地址 (执行前由请求的指针覆盖)
+static uint8_t g_slot_placeholder;
+
+// SID 对应的模型输入输出编号 (见 io_patch_t.io)，workspace SID 返回 false
+static bool slot_io_index(int32_t sid, int32_t* io) {
+    if (sid <= TVMRT_SID_OUTPUT_BASE) {
+        *io = -1 - (TVMRT_SID_OUTPUT_BASE - sid);
+        return true;
+    }
+    if (sid <= TVMRT_SID_INPUT_BASE) {
+        *io = TVMRT_SID_INPUT_BASE - sid;
+        return true;
+    }
+    return false;
+}
+
+// 每个槽位需要按请求改写的字段数
+static int32_t slot_patch_count(const tvmrt_model_desc_t* model) {
+    int32_t count = 0;
+    for (int32_t i = 0; i < model->op_count; i++) {
+        const tvmrt_op_desc_t* d = &model->op_descs[i];
+        for (int32_t a = 0; a < d->input_count + d->output_count; a++) {
+            int32_t io;
+            int32_t sid = (a < d->input_count) ? d->input_sids[a] : d->output_sids[a - d->input_count];
+            count += slot_io_index(sid, &io) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+static uint64_t slot_workspace_stride(uint64_t workspace_size) {
+    return (workspace_size + TVMRT_CACHE_LINE_SIZE - 1) & ~(uint64_t)(TVMRT_CACHE_LINE_SIZE - 1);
+}
+
+// 绑定 slots 个槽位: 槽位 s 的算子 i 位于 args/execs[s * op_count + i]，
+// 改写字段位于 patches[s * slot_patch_count(model) ...]
+static int slot_bind_all(
+    const tvmrt_model_desc_t* model,
+    int32_t slots,
+    int32_t input_count,
+    int32_t output_count,
+    uint8_t* workspaces,
+    uint64_t workspace_stride,
+    const uint8_t* const_workspace,
+    tvmrt_op_args_t* args,
+    tvmrt_op_exec_t* execs,
+    tvmrt_io_patch_t* patches
+) {
+    int32_t n = model->op_count;
+    int32_t io_count = (input_count > output_count) ? input_count : output_count;
+    void** placeholder = (void**)tvmrt_mem_alloc((uint64_t)(io_count ? io_count : 1) * sizeof(void*),
+                                                 sizeof(void*));
+    int ret = placeholder ? 0 : -1;
+    for (int32_t k = 0; placeholder && k < io_count; k++) {
+        placeholder[k] = &g_slot_placeholder;
+    }
+    int32_t np = 0;
+    for (int32_t s = 0; s < slots && ret == 0; s++) {
+        uint8_t* ws = workspaces + (uint64_t)s * workspace_stride;
+        tvmrt_op_args_t* slot_args = &args[s * n];
+        tvmrt_context_t slot_ctx = {.op_execs = &execs[s * n], .args_storage = slot_args};
+        ret |= tvmrt_semantic_bind_args(model, slot_args, placeholder, input_count, placeholder,
+                                        output_count, ws, const_workspace);
+        ret |= tvmrt_semantic_init(&slot_ctx, model);
+        for (int32_t i = 0; i < n; i++) {
+            const tvmrt_op_desc_t* d = &model->op_descs[i];
+            for (int32_t a = 0; a < d->input_count + d->output_count; a++) {
+                bool is_out = (a >= d->input_count);
+                int32_t sid = is_out ? d->output_sids[a - d->input_count] : d->input_sids[a];
+                int32_t io;
+                if (!slot_io_index(sid, &io)) continue;
+                patches[np].field =
+                    is_out ? &slot_args[i].outputs[a - d->input_count] : &slot_args[i].inputs[a];
+                patches[np++].io = io;
+            }
+        }
+    }
+    tvmrt_mem_free(placeholder);
+    return ret;
+}
+
+// 在 base 起的一次分配中依次划出缓存行对齐的数组 (base 为 NULL 时只累计 off)
+#define SLOT_CARVE(obj, base, off, field, type, count)                                  \
+    do {                                                                                \
+        if (base) (obj)->field = (type*)((base) + (off));                               \
+        (off) += ((uint64_t)(count) * sizeof(type) + TVMRT_CACHE_LINE_SIZE - 1) &       \
+                 ~(uint64_t)(TVMRT_CACHE_LINE_SIZE - 1);                                \
+    } while (0)
+
+// 把请求的输入输出指针写入一个槽位
+static void slot_apply(const tvmrt_io_patch_t* p, int32_t count, void* const* inputs,
+                       void* const* outputs) {
+    for (int32_t k = 0; k < count; k++) {
+        *p[k].field = (p[k].io >= 0) ? inputs[p[k].io] : outputs[-1 - p[k].io];
+    }
+}
+
+// ============================================================
+// 动态批处理实现
+// ============================================================
+
+// 各批大小的计划逐层自适应 串行/分发: 小批通常由批处理线程直接执行更快
+#define BATCHER_ADAPT_WARMUP 8
+#define BATCHER_ADAPT_INTERVAL 1000
+
+// 批处理器存储布局: base 为 NULL 时只计算总字节数
+static uint64_t batcher_layout(tvmrt_batcher_t* b, uint8_t* base, int32_t ops, int32_t layers,
+                               int32_t layer_ops) {
+    int32_t slots = b->config.max_batch;
+    uint64_t off = 0;
+    SLOT_CARVE(b, base, off, workspaces, uint8_t, (uint64_t)slots * b->workspace_stride);
+    SLOT_CARVE(b, base, off, args, tvmrt_op_args_t, (uint64_t)slots * ops);
+    SLOT_CARVE(b, base, off, execs, tvmrt_op_exec_t, (uint64_t)slots * ops);
+    SLOT_CARVE(b, base, off, patches, tvmrt_io_patch_t, (uint64_t)slots * b->patch_count);
+    SLOT_CARVE(b, base, off, layers, tvmrt_schedule_layer_t, (uint64_t)slots * layers);
+    SLOT_CARVE(b, base, off, layer_ops, int32_t, (uint64_t)slots * layer_ops);
+    SLOT_CARVE(b, base, off, plans, tvmrt_plan_t, slots);
+    SLOT_CARVE(b, base, off, batch, tvmrt_batch_request_t*, slots);
+    return off;
+}
+
+// 执行一批: 把请求指针写入各槽位参数区，再按批大小对应的计划执行一次
+static int32_t batcher_run(tvmrt_batcher_t* b, tvmrt_batch_request_t* const* reqs, int32_t count) {
+    for (int32_t s = 0; s < count; s++) {
+        slot_apply(&b->patches[s * b->patch_count], b->patch_count, reqs[s]->inputs, reqs[s]->outputs);
+    }
+
+    const tvmrt_schedule_desc_t* model_schedule = b->model->schedule;
+    tvmrt_schedule_desc_t schedule = {&b->layers[(count - 1) * model_schedule->layer_count],
+                                      model_schedule->layer_count};
+    tvmrt_context_t ctx = {.op_execs = b->execs, .op_count = count * b->model->op_count,
+                           .plan = &b->plans[count - 1]};
+    return tvmrt_engine_run(&ctx, &schedule);
+}
+
+static void* batcher_thread_func(void* arg) {
+    tvmrt_batcher_t* b = (tvmrt_batcher_t*)arg;
+    int32_t max_batch = b->config.max_batch;
+    tvmrt_batch_request_t** reqs = b->batch;
+
+    tvmrt_mutex_lock(&b->mutex);
+    while (1) {
+        while (!b->head && !b->shutdown) {
+            tvmrt_cond_wait(&b->cond, &b->mutex);
+        }
+        if (b->shutdown) {
+            break;
+        }
+
+        // 攒批: 满批或首个请求等待到期即执行
+        uint64_t deadline = b->head->arrival_ns + b->config.max_delay_ns;
+        while (b->pending < max_batch && !b->shutdown && tvmrt_time_ns() < deadline) {
+            tvmrt_cond_timedwait(&b->cond, &b->mutex, deadline);
+        }
+
+        int32_t count = 0;
+        while (b->head && count < max_batch) {
+            reqs[count++] = b->head;
+            b->head = b->head->next;
+        }
+        if (!b->head) {
+            b->tail = NULL;
+        }
+        b->pending -= count;
+        tvmrt_mutex_unlock(&b->mutex);
+
+        int32_t ret = batcher_run(b, reqs, count);
+
+        tvmrt_mutex_lock(&b->mutex);
+        for (int32_t i = 0; i < count; i++) {
+            reqs[i]->status = ret;
+            reqs[i]->done = true;
+        }
+        b->batch_count++;
+        b->request_count += (uint64_t)count;
+        tvmrt_cond_broadcast(&b->done_cond);
+    }
+
+    // 停机: 未执行的请求返回失败
+    for (tvmrt_batch_request_t* r = b->head; r; r = r->next) {
+        r->status = -1;
+        r->done = true;
+    }
+    b->head = b->tail = NULL;
+    b->pending = 0;
+    tvmrt_cond_broadcast(&b->done_cond);
+    tvmrt_mutex_unlock(&b->mutex);
+    return NULL;
+}
+
+int tvmrt_batcher_init(
+    tvmrt_batcher_t* b,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_batcher_config_t* config
+) {
+    if (!b || !model || !model->schedule || !config || config->max_batch < 1 ||
+        config->input_count < 0 || config->output_count < 0) {
+        return -1;
+    }
+
+    memset(b, 0, sizeof(*b));
+    b->model = model;
+    b->config = *config;
+
+    const tvmrt_schedule_desc_t* schedule = model->schedule;
+    int32_t n = model->op_count;
+    int32_t layers = schedule->layer_count;
+    int32_t slots = config->max_batch;
+    int32_t layer_ops = 0;
+    for (int32_t l = 0; l < layers; l++) {
+        layer_ops += (schedule->layers[l].count > 0) ? schedule->layers[l].count : 0;
+    }
+    b->patch_count = slot_patch_count(model);
+    b->workspace_stride = slot_workspace_stride(config->workspace_size);
+
+    uint64_t bytes = batcher_layout(b, NULL, n, layers, layer_ops);
+    uint8_t* base = config->arena
+                        ? (uint8_t*)tvmrt_arena_alloc(config->arena, bytes, TVMRT_CACHE_LINE_SIZE)
+                        : (uint8_t*)tvmrt_mem_alloc(bytes, TVMRT_CACHE_LINE_SIZE);
+    if (!base) {
+        return -1;
+    }
+    memset(base, 0, (size_t)bytes);
+    batcher_layout(b, base, n, layers, layer_ops);
+    b->storage = config->arena ? NULL : base;
+
+    int ret = slot_bind_all(model, slots, config->input_count, config->output_count, b->workspaces,
+                            b->workspace_stride, config->const_workspace, b->args, b->execs,
+                            b->patches);
+
+    // 批大小 b 的第 l 层: 前 b 个槽位的该层算子依次排列 (越界 ID 保持越界, 由编译跳过)
+    int32_t off = 0;
+    for (int32_t l = 0; l < layers; l++) {
+        const tvmrt_schedule_layer_t* layer = &schedule->layers[l];
+        int32_t count = (layer->count > 0) ? layer->count : 0;
+        for (int32_t s = 0; s < slots; s++) {
+            for (int32_t k = 0; k < count; k++) {
+                int32_t op = layer->op_indices[k];
+                b->layer_ops[off + s * count + k] = (op >= 0 && op < n) ? s * n + op : -1;
+            }
+        }
+        for (int32_t bs = 1; bs <= slots; bs++) {
+            b->layers[(bs - 1) * layers + l] =
+                (tvmrt_schedule_layer_t){&b->layer_ops[off], count * bs};
+        }
+        off += slots * count;
+    }
+    for (int32_t bs = 1; bs <= slots && ret == 0; bs++) {
+        tvmrt_schedule_desc_t sched = {&b->layers[(bs - 1) * layers], layers};
+        tvmrt_context_t ctx = {.op_execs = b->execs, .op_count = bs * n};
+        ret |= tvmrt_plan_reserve(&b->plans[bs - 1], &ctx, &sched, config->arena);
+        ret |= tvmrt_plan_compile(&b->plans[bs - 1], &ctx, &sched);
+        ret |= tvmrt_plan_assign(&b->plans[bs - 1], NULL, tvmrt_engine_slot_count());
+        ret |= tvmrt_plan_set_adaptive(&b->plans[bs - 1], BATCHER_ADAPT_WARMUP, BATCHER_ADAPT_INTERVAL);
+    }
+
+    if (ret != 0 || tvmrt_mutex_init(&b->mutex) != TVMRT_OK) {
+        goto fail;
+    }
+    if (tvmrt_cond_init(&b->cond) != TVMRT_OK) {
+        tvmrt_mutex_destroy(&b->mutex);
+        goto fail;
+    }
+    if (tvmrt_cond_init(&b->done_cond) != TVMRT_OK) {
+        tvmrt_cond_destroy(&b->cond);
+        tvmrt_mutex_destroy(&b->mutex);
+        goto fail;
+    }
+    if (tvmrt_thread_create(&b->thread, batcher_thread_func, b) != TVMRT_OK) {
+        tvmrt_cond_destroy(&b->done_cond);
+        tvmrt_cond_destroy(&b->cond);
+        tvmrt_mutex_destroy(&b->mutex);
+        goto fail;
+    }
+    return 0;
+
+fail:
+    for (int32_t s = 0; s < slots; s++) {
+        tvmrt_plan_destroy(&b->plans[s]);
+    }
+    tvmrt_mem_free(b->storage);
+    memset(b, 0, sizeof(*b));   // plans 为 NULL: 之后的 tvmrt_batcher_destroy 什么也不做
+    return -1;
+}
+
+int tvmrt_batcher_submit(tvmrt_batcher_t* b, void* const* inputs, void* const* outputs) {
+    if (!b || !b->plans) {
+        return -1;   // 未初始化或已关闭 (destroy 已清零)
+    }
+    tvmrt_batch_request_t req = {.inputs = inputs, .outputs = outputs, .arrival_ns = tvmrt_time_ns()};
+
+    tvmrt_mutex_lock(&b->mutex);
+    if (b->shutdown) {
+        tvmrt_mutex_unlock(&b->mutex);
+        return -1;
+    }
+    if (b->tail) {
+        b->tail->next = &req;
+    } else {
+        b->head = &req;
+    }
+    b->tail = &req;
+    b->pending++;
+    b->waiters++;
+    // 只在批处理线程可能空等 (首个请求) 或批已满时唤醒
+    if (b->pending == 1 || b->pending >= b->config.max_batch) {
+        tvmrt_cond_signal(&b->cond);
+    }
+    while (!req.done) {
+        tvmrt_cond_wait(&b->done_cond, &b->mutex);
+    }
+    if (--b->waiters == 0 && b->shutdown) {
+        tvmrt_cond_broadcast(&b->done_cond);   // 关闭在等提交线程离开
+    }
+    tvmrt_mutex_unlock(&b->mutex);
+    return req.status;
+}
+
+void tvmrt_batcher_destroy(tvmrt_batcher_t* b) {
+    if (!b || !b->plans) {
+        return;
+    }
+    tvmrt_mutex_lock(&b->mutex);
+    b->shutdown = true;
+    tvmrt_cond_broadcast(&b->cond);
+    tvmrt_mutex_unlock(&b->mutex);
+    tvmrt_thread_join(&b->thread);
+
+    // 批处理线程退出前已完成全部请求; 被唤醒的提交线程仍要重新持锁才能
+    // 离开 submit，等它们全部离开后才能销毁互斥锁与条件变量
+    tvmrt_mutex_lock(&b->mutex);
+    while (b->waiters > 0) {
+        tvmrt_cond_wait(&b->done_cond, &b->mutex);
+    }
+    tvmrt_mutex_unlock(&b->mutex);
+
+    tvmrt_cond_destroy(&b->done_cond);
+    tvmrt_cond_destroy(&b->cond);
+    tvmrt_mutex_destroy(&b->mutex);
+    for (int32_t s = 0; s < b->config.max_batch; s++) {
+        tvmrt_plan_destroy(&b->plans[s]);
+    }
+    tvmrt_mem_free(b->storage);
+    memset(b, 0, sizeof(*b));   // plans 为 NULL: 之后的 submit 返回 -1，destroy 什么也不做
+}
+
+// ============================================================
+// 上下文池实现
+// ============================================================
+
+// 各上下文计划在延迟模式下的自适应参数 (与批处理器相同)
+#define POOL_ADAPT_WARMUP BATCHER_ADAPT_WARMUP
+#define POOL_ADAPT_INTERVAL BATCHER_ADAPT_INTERVAL
+
+// 上下文池存储布局: base 为 NULL 时只计算总字节数
+static uint64_t pool_layout(tvmrt_context_pool_t* pool, uint8_t* base, int32_t ops) {
+    int32_t count = pool->config.context_count;
+    uint64_t off = 0;
+    SLOT_CARVE(pool, base, off, contexts, tvmrt_context_t, count);
+    SLOT_CARVE(pool, base, off, plans, tvmrt_plan_t, count);
+    SLOT_CARVE(pool, base, off, workspaces, uint8_t, (uint64_t)count * pool->workspace_stride);
+    SLOT_CARVE(pool, base, off, args, tvmrt_op_args_t, (uint64_t)count * ops);
+    SLOT_CARVE(pool, base, off, execs, tvmrt_op_exec_t, (uint64_t)count * ops);
+    SLOT_CARVE(pool, base, off, patches, tvmrt_io_patch_t, (uint64_t)count * pool->patch_count);
+    SLOT_CARVE(pool, base, off, free_list, int32_t, count);
+    return off;
+}
+
+int tvmrt_context_pool_init(
+    tvmrt_context_pool_t* pool,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_context_pool_config_t* config
+) {
+    if (!pool || !model || !model->schedule || !config || config->context_count < 1 ||
+        config->input_count < 0 || config->output_count < 0 || config->priority < 0 ||
+        config->priority >= TVMRT_PRIORITY_LEVELS) {
+        return -1;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->model = model;
+    pool->config = *config;
+    pool->mode = tvmrt_engine_mode();
+    pool->patch_count = slot_patch_count(model);
+    pool->workspace_stride = slot_workspace_stride(config->workspace_size);
+
+    int32_t n = model->op_count;
+    int32_t count = config->context_count;
+    uint64_t bytes = pool_layout(pool, NULL, n);
+    uint8_t* base = config->arena
+                        ? (uint8_t*)tvmrt_arena_alloc(config->arena, bytes, TVMRT_CACHE_LINE_SIZE)
+                        : (uint8_t*)tvmrt_mem_alloc(bytes, TVMRT_CACHE_LINE_SIZE);
+    if (!base) {
+        return -1;
+    }
+    memset(base, 0, (size_t)bytes);
+    pool_layout(pool, base, n);
+    pool->storage = config->arena ? NULL : base;
+
+    int ret = slot_bind_all(model, count, config->input_count, config->output_count,
+                            pool->workspaces, pool->workspace_stride, config->const_workspace,
+                            pool->args, pool->execs, pool->patches);
+    for (int32_t c = 0; c < count && ret == 0; c++) {
+        tvmrt_context_t* ctx = &pool->contexts[c];
+        *ctx = (tvmrt_context_t){.workspace = pool->workspaces + (uint64_t)c * pool->workspace_stride,
+                                 .const_workspace = config->const_workspace,
+                                 .op_execs = &pool->execs[c * n],
+                                 .op_count = n,
+                                 .args_storage = &pool->args[c * n],
+                                 .plan = &pool->plans[c]};
+        ret |= tvmrt_plan_reserve(ctx->plan, ctx, model->schedule, config->arena);
+        ret |= tvmrt_plan_compile(ctx->plan, ctx, model->schedule);
+        if (pool->mode == TVMRT_ENGINE_LATENCY) {
+            ret |= tvmrt_plan_assign(ctx->plan, NULL, tvmrt_engine_slot_count());
+            ret |= tvmrt_plan_set_adaptive(ctx->plan, POOL_ADAPT_WARMUP, POOL_ADAPT_INTERVAL);
+        }
+        pool->free_list[c] = c;
+    }
+    pool->free_count = count;
+
+    if (ret != 0 || tvmrt_mutex_init(&pool->mutex) != TVMRT_OK) {
+        goto fail;
+    }
+    if (tvmrt_cond_init(&pool->cond) != TVMRT_OK) {
+        tvmrt_mutex_destroy(&pool->mutex);
+        goto fail;
+    }
+    return 0;
+
+fail:
+    for (int32_t c = 0; c < count; c++) {
+        tvmrt_plan_destroy(&pool->plans[c]);
+    }
+    tvmrt_mem_free(pool->storage);
+    pool->storage = NULL;
+    pool->contexts = NULL;
+    return -1;
+}
+
+int tvmrt_context_pool_run(tvmrt_context_pool_t* pool, void* const* inputs, void* const* outputs) {
+    return tvmrt_context_pool_run_until(pool, inputs, outputs, 0, NULL);
+}
+
+int tvmrt_context_pool_run_until(
+    tvmrt_context_pool_t* pool,
+    void* const* inputs,
+    void* const* outputs,
+    uint64_t deadline_ns,
+    const tvmrt_cancel_token_t* cancel
+) {
+    if (!pool || !pool->contexts) {
+        return -1;
+    }
+
+    bool abortable = deadline_ns || cancel;
+    tvmrt_mutex_lock(&pool->mutex);
+    while (pool->free_count == 0) {
+        if (!abortable) {
+            tvmrt_cond_wait(&pool->cond, &pool->mutex);
+            continue;
+        }
+        tvmrt_cond_timedwait(&pool->cond, &pool->mutex, engine_abort_wake(deadline_ns, cancel));
+        int32_t reason = engine_abort_reason(deadline_ns, cancel);
+        if (reason != 0 && pool->free_count == 0) {
+            tvmrt_mutex_unlock(&pool->mutex);
+            return reason;
+        }
+    }
+    int32_t c = pool->free_list[--pool->free_count];
+    tvmrt_mutex_unlock(&pool->mutex);
+
+    tvmrt_context_t* ctx = &pool->contexts[c];
+    ctx->deadline_ns = deadline_ns;
+    ctx->cancel = cancel;
+    slot_apply(&pool->patches[c * pool->patch_count], pool->patch_count, inputs, outputs);
+    int32_t ret = engine_run_request(ctx, pool->model->schedule, pool->config.priority);
+
+    tvmrt_mutex_lock(&pool->mutex);
+    pool->free_list[pool->free_count++] = c;
+    tvmrt_cond_signal(&pool->cond);
+    tvmrt_mutex_unlock(&pool->mutex);
+    return ret;
+}
+
+void tvmrt_context_pool_destroy(tvmrt_context_pool_t* pool) {
+    if (!pool || !pool->contexts) {
+        return;
+    }
+    tvmrt_cond_destroy(&pool->cond);
+    tvmrt_mutex_destroy(&pool->mutex);
+    for (int32_t c = 0; c < pool->config.context_count; c++) {
+        tvmrt_plan_destroy(&pool->plans[c]);
+    }
+    tvmrt_mem_free(pool->storage);
+    pool->storage = NULL;
+    pool->contexts = NULL;
+}
+
+// ============================================================
+// 分块执行实现
+// ============================================================
+
+// 一个分块任务: 在本块上依次执行段内各算子的参数视图
+typedef struct {
+    const tvmrt_plan_op_t* ops;
+    int32_t count;
+} tiled_task_t;
+
+static int32_t tiled_task_run(void* p) {
+    const tiled_task_t* t = (const tiled_task_t*)p;
+    for (int32_t i = 0; i < t->count; i++) {
+        int32_t ret = t->ops[i].func(t->ops[i].args);
+        if (ret != 0) return ret;
+    }
+    return 0;
+}
+
+// 可分块算子的元素数 (不可分块返回 0)
+static int32_t tiled_op_elems(const tvmrt_model_desc_t* model, const tvmrt_context_t* ctx,
+                              int32_t op_idx) {
+    if (op_idx < 0 || op_idx >= model->op_count || !ctx->const_workspace ||
+        !ctx->op_execs[op_idx].func) {
+        return 0;
+    }
+    const tvmrt_op_desc_t* d = &model->op_descs[op_idx];
+    if (!(d->flags & TVMRT_OP_ELEMENTWISE) || d->input_count < 1 ||
+        d->input_sids[d->input_count - 1] != TVMRT_SID_CONST ||
+        d->const_size < (int32_t)sizeof(tvmrt_qattrs_t)) {
+        return 0;
+    }
+    const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)(ctx->const_workspace + d->const_offset);
+    return (at->count > 0) ? at->count : 0;
+}
+
+// 层内所有算子可分块且元素数相同时返回元素数，否则返回 0
+static int32_t tiled_layer_elems(const tvmrt_model_desc_t* model, const tvmrt_context_t* ctx,
+                                 const tvmrt_schedule_layer_t* layer) {
+    int32_t elems = 0;
+    for (int32_t k = 0; k < layer->count; k++) {
+        int32_t e = tiled_op_elems(model, ctx, layer->op_indices[k]);
+        if (e == 0 || (elems != 0 && e != elems)) return 0;
+        elems = e;
+    }
+    return elems;
+}
+
+// SID 的元素字节数与映射表下标 (外部输入输出按 fp32，下标为 -1)
+static int32_t tiled_elem_size(const tvmrt_model_desc_t* model, bool sorted, int32_t sid,
+                               int32_t* t) {
+    *t = (sid >= 0 && model->tensor_map)
+             ? semantic_find_sid(model->tensor_map, model->tensor_count, sorted, sid)
+             : -1;
+    return (*t >= 0) ? tvmrt_dtype_size(model->tensor_map[*t].dtype) : (int32_t)sizeof(float);
+}
+
+// 段内每元素的工作集字节数 (不同张量各计一次)。workspace 张量部分重叠时
+// 分块会改变读写次序，返回 -1
+static int32_t tiled_segment_bytes(const tvmrt_model_desc_t* model, bool sorted,
+                                   const tvmrt_schedule_desc_t* schedule, int32_t first,
+                                   int32_t count, int32_t* sids) {
+    int32_t n = 0;
+    for (int32_t l = first; l < first + count; l++) {
+        const tvmrt_schedule_layer_t* layer = &schedule->layers[l];
+        for (int32_t k = 0; k < layer->count; k++) {
+            const tvmrt_op_desc_t* d = &model->op_descs[layer->op_indices[k]];
+            for (int32_t a = 0; a < d->input_count + d->output_count; a++) {
+                int32_t sid = (a < d->input_count) ? d->input_sids[a]
+                                                   : d->output_sids[a - d->input_count];
+                bool seen = (sid == TVMRT_SID_CONST);
+                for (int32_t j = 0; j < n && !seen; j++) seen = (sids[j] == sid);
+                if (!seen) sids[n++] = sid;
+            }
+        }
+    }
+    int32_t bytes = 0;
+    for (int32_t i = 0; i < n; i++) {
+        int32_t ti;
+        bytes += tiled_elem_size(model, sorted, sids[i], &ti);
+        for (int32_t j = 0; ti >= 0 && j < i; j++) {
+            int32_t tj;
+            tiled_elem_size(model, sorted, sids[j], &tj);
+            if (tj < 0) continue;
+            const tvmrt_tensor_map_entry_t* x = &model->tensor_map[ti];
+            const tvmrt_tensor_map_entry_t* y = &model->tensor_map[tj];
+            bool same = (x->offset == y->offset && x->size == y->size && x->dtype == y->dtype);
+            if (!same && x->offset < y->offset + y->size && y->offset < x->offset + x->size) {
+                return -1;
+            }
+        }
+    }
+    return bytes;
+}
+
+// 分块调度的各数组 (单块分配中依次划出)
+typedef struct {
+    tvmrt_op_exec_t* execs;
+    tiled_task_t* tasks;
+    tvmrt_plan_op_t* ops;
+    tvmrt_op_args_t* views;
+    uint8_t* consts;
+    tvmrt_schedule_layer_t* layers;
+    int32_t* ids;
+    tvmrt_tile_segment_t* segments;
+} tiled_layout_t;
+
+static uint64_t tiled_carve(tiled_layout_t* lay, uint8_t* base, int32_t execs, int32_t tiles,
+                            int32_t views, uint64_t const_bytes, int32_t layers,
+                            int32_t segments) {
+    uint64_t off = 0;
+    SLOT_CARVE(lay, base, off, views, tvmrt_op_args_t, views);
+    SLOT_CARVE(lay, base, off, ops, tvmrt_plan_op_t, views);
+    SLOT_CARVE(lay, base, off, tasks, tiled_task_t, tiles);
+    SLOT_CARVE(lay, base, off, execs, tvmrt_op_exec_t, execs);
+    SLOT_CARVE(lay, base, off, consts, uint8_t, const_bytes);
+    SLOT_CARVE(lay, base, off, layers, tvmrt_schedule_layer_t, layers);
+    SLOT_CARVE(lay, base, off, ids, int32_t, tiles);
+    SLOT_CARVE(lay, base, off, segments, tvmrt_tile_segment_t, segments);
+    return off;
+}
+
+static uint64_t tiled_round64(int32_t v) {
+    return ((uint64_t)v + 63) & ~(uint64_t)63;
+}
+
+int tvmrt_tiled_init(
+    tvmrt_tiled_t* tiled,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule,
+    int64_t cache_bytes
+) {
+    if (!tiled || !model || !ctx || !ctx->op_execs || !schedule || cache_bytes < 0) {
+        return -1;
+    }
+    memset(tiled, 0, sizeof(*tiled));
+    if (cache_bytes == 0) {
+        int64_t l1 = tvmrt_cache_size(1);
+        cache_bytes = (l1 > 0) ? l1 / 2 : 16 * 1024;
+    }
+
+    // 1. 找出分块段: 连续至少两层可分块且元素数相同
+    int32_t nl = schedule->layer_count;
+    int32_t max_ops = 0;
+    for (int32_t l = 0; l < nl; l++) max_ops += schedule->layers[l].count;
+    tvmrt_tile_segment_t* segs = (tvmrt_tile_segment_t*)tvmrt_mem_alloc(
+        (uint64_t)(nl / 2 + 1) * sizeof(tvmrt_tile_segment_t), 8);
+    int32_t* sids = (int32_t*)tvmrt_mem_alloc(
+        (uint64_t)(max_ops ? max_ops : 1) * (TVMRT_MAX_OP_INPUTS + TVMRT_MAX_OP_OUTPUTS) *
+            sizeof(int32_t), 8);
+    if (!segs || !sids) {
+        tvmrt_mem_free(segs);
+        tvmrt_mem_free(sids);
+        return -1;
+    }
+    bool sorted = model->tensor_map && semantic_map_sorted(model->tensor_map, model->tensor_count);
+    int32_t nseg = 0, tiles = 0, views = 0, out_layers = nl;
+    uint64_t const_bytes = 0;
+    for (int32_t l = 0; l < nl;) {
+        int32_t elems = tiled_layer_elems(model, ctx, &schedule->layers[l]);
+        int32_t end = l + 1;
+        while (elems > 0 && end < nl &&
+               tiled_layer_elems(model, ctx, &schedule->layers[end]) == elems) {
+            end++;
+        }
+        int32_t bpe = (elems > 0 && end - l >= 2)
+                          ? tiled_segment_bytes(model, sorted, schedule, l, end - l, sids)
+                          : -1;
+        if (bpe > 0) {
+            tvmrt_tile_segment_t* g = &segs[nseg++];
+            int64_t tile = cache_bytes / bpe / 64 * 64;
+            tile = (tile < 64) ? 64 : tile;
+            g->first_layer = l;
+            g->layer_count = end - l;
+            g->elems = elems;
+            g->tile_elems = (tile < elems) ? (int32_t)tile : elems;
+            g->tile_count = (elems + g->tile_elems - 1) / g->tile_elems;
+            int32_t seg_ops = 0;
+            uint64_t seg_const = 0;
+            for (int32_t s = l; s < end; s++) {
+                for (int32_t k = 0; k < schedule->layers[s].count; k++) {
+                    seg_ops++;
+                    seg_const += tiled_round64(model->op_descs[schedule->layers[s].op_indices[k]].const_size);
+                }
+            }
+            tiles += g->tile_count;
+            views += g->tile_count * seg_ops;
+            const_bytes += (uint64_t)g->tile_count * seg_const;
+            out_layers -= g->layer_count - 1;
+        }
+        l = end;
+    }
+    tvmrt_mem_free(sids);
+
+    // 2. 一次分配全部数组
+    tiled_layout_t lay;
+    int32_t op_count = ctx->op_count;
+    uint64_t size = tiled_carve(&lay, NULL, op_count + tiles, tiles, views, const_bytes,
+                                out_layers, nseg);
+    uint8_t* base = (uint8_t*)tvmrt_mem_alloc(size ? size : 1, TVMRT_CACHE_LINE_SIZE);
+    if (!base) {
+        tvmrt_mem_free(segs);
+        return -1;
+    }
+    tiled_carve(&lay, base, op_count + tiles, tiles, views, const_bytes, out_layers, nseg);
+    memcpy(lay.execs, ctx->op_execs, (size_t)op_count * sizeof(tvmrt_op_exec_t));
+    memcpy(lay.segments, segs, (size_t)nseg * sizeof(tvmrt_tile_segment_t));
+    tvmrt_mem_free(segs);
+
+    // 3. 生成视图与分块调度
+    int32_t exec = op_count, task = 0, pos = 0, layer_out = 0, s = 0;
+    uint64_t coff = 0;
+    for (int32_t l = 0; l < nl; l++) {
+        if (s >= nseg || l != lay.segments[s].first_layer) {
+            lay.layers[layer_out++] = schedule->layers[l];
+            continue;
+        }
+        const tvmrt_tile_segment_t* g = &lay.segments[s++];
+        int32_t* ids = &lay.ids[task];
+        for (int32_t i = 0; i < g->tile_count; i++) {
+            int32_t start = i * g->tile_elems;
+            int32_t len = (g->elems - start < g->tile_elems) ? g->elems - start : g->tile_elems;
+            tiled_task_t* t = &lay.tasks[task];
+            *t = (tiled_task_t){.ops = &lay.ops[pos], .count = 0};
+            for (int32_t sl = g->first_layer; sl < g->first_layer + g->layer_count; sl++) {
+                const tvmrt_schedule_layer_t* layer = &schedule->layers[sl];
+                for (int32_t k = 0; k < layer->count; k++) {
+                    int32_t op = layer->op_indices[k];
+                    const tvmrt_op_desc_t* d = &model->op_descs[op];
+                    tvmrt_op_args_t* v = &lay.views[pos];
+                    *v = *(const tvmrt_op_args_t*)ctx->op_execs[op].args;
+                    for (int32_t a = 0; a < d->input_count + d->output_count; a++) {
+                        bool is_out = (a >= d->input_count);
+                        int32_t sid = is_out ? d->output_sids[a - d->input_count] : d->input_sids[a];
+                        void** field = is_out ? &v->outputs[a - d->input_count] : &v->inputs[a];
+                        if (sid == TVMRT_SID_CONST) {
+                            uint8_t* copy = lay.consts + coff;
+                            memcpy(copy, ctx->const_workspace + d->const_offset, (size_t)d->const_size);
+                            ((tvmrt_qattrs_t*)copy)->count = len;
+                            coff += tiled_round64(d->const_size);
+                            *field = copy;
+                        } else {
+                            int32_t ti;
+                            *field = (uint8_t*)*field +
+                                     (int64_t)start * tiled_elem_size(model, sorted, sid, &ti);
+                        }
+                    }
+                    lay.ops[pos++] = (tvmrt_plan_op_t){ctx->op_execs[op].func, v};
+                    t->count++;
+                }
+            }
+            lay.execs[exec] = (tvmrt_op_exec_t){.name = "tile", .func = tiled_task_run, .args = t};
+            lay.ids[task++] = exec++;
+        }
+        lay.layers[layer_out++] = (tvmrt_schedule_layer_t){ids, g->tile_count};
+        l += g->layer_count - 1;
+    }
+
+    tiled->execs = lay.execs;
+    tiled->exec_count = op_count + tiles;
+    tiled->schedule = (tvmrt_schedule_desc_t){lay.layers, out_layers};
+    tiled->segments = lay.segments;
+    tiled->segment_count = nseg;
+    tiled->storage = base;
+    return 0;
+}
+
+void tvmrt_tiled_destroy(tvmrt_tiled_t* tiled) {
+    if (!tiled) {
+        return;
+    }
+    tvmrt_mem_free(tiled->storage);
+    memset(tiled, 0, sizeof(*tiled));
+}
+
+// ============================================================
+// 自动调优实现
+// ============================================================
+
+#define TUNE_SHAPE_LEN 96
+
+// 一组 (内核, 形状) 的调优结果，同键算子共用
+typedef struct {
+    const tvmrt_tune_kernel_t* kernel;
+    char shape[TUNE_SHAPE_LEN];
+    int32_t op;             // 计时所用的算子
+    int32_t choice;         // 选中的候选 (-1 = 尚未确定)
+    uint64_t ns;
+    bool measured;          // 本次计时得到 (需追加到缓存)
+} tune_entry_t;
+
+// 执行函数所属的候选组 (已调优过的算子按候选函数匹配)
+static const tvmrt_tune_kernel_t* tune_find_kernel(const tvmrt_tune_config_t* config,
+                                                   tvmrt_op_func_t func) {
+    for (int32_t k = 0; k < config->kernel_count; k++) {
+        const tvmrt_tune_kernel_t* kn = &config->kernels[k];
+        if (kn->base == func) return kn;
+        for (int32_t v = 0; v < kn->variant_count; v++) {
+            if (kn->variants[v].func == func) return kn;
+        }
+    }
+    return NULL;
+}
+
+static void tune_shape_key(const tvmrt_model_desc_t* model, const tvmrt_context_t* ctx, bool sorted,
+                           int32_t op_idx, char* buf, size_t size) {
+    const tvmrt_op_desc_t* d = &model->op_descs[op_idx];
+    if (d->input_count > 0 && d->input_sids[d->input_count - 1] == TVMRT_SID_CONST &&
+        ctx->const_workspace && d->const_size >= (int32_t)sizeof(tvmrt_qattrs_t)) {
+        const tvmrt_qattrs_t* at = (const tvmrt_qattrs_t*)(ctx->const_workspace + d->const_offset);
+        snprintf(buf, size, "c%d n%d k%d t%d.%d.%d.%d", at->count, at->n, at->k,
+                 at->in_dtype[0], at->in_dtype[1], at->out_dtype, at->weight_dtype);
+        return;
+    }
+    size_t len = (size_t)snprintf(buf, size, "b");
+    for (int32_t a = 0; a < d->input_count + d->output_count && len < size; a++) {
+        int32_t sid = (a < d->input_count) ? d->input_sids[a] : d->output_sids[a - d->input_count];
+        int32_t t = (sid >= 0 && model->tensor_map)
+                        ? semantic_find_sid(model->tensor_map, model->tensor_count, sorted, sid)
+                        : -1;
+        len += (t >= 0) ? (size_t)snprintf(buf + len, size - len, " %d", model->tensor_map[t].size)
+                        : (size_t)snprintf(buf + len, size - len, " x");
+    }
+}
+
+// 读取缓存: 每行 "CPU 型号|内核名|形状|候选名|纳秒"
+static void tune_load_cache(const char* path, const char* cpu, tune_entry_t* entries,
+                            int32_t count) {
+    FILE* f = fopen(path, "r");
+    if (!f) return;
+    char line[512];
+    while (fgets(line, sizeof(line), f)) {
+        char* field[5];
+        char* p = line;
+        int32_t n = 0;
+        line[strcspn(line, "\r\n")] = '\0';
+        while (n < 5 && p) {
+            field[n++] = p;
+            p = strchr(p, '|');
+            if (p) *p++ = '\0';
+        }
+        if (n != 5 || strcmp(field[0], cpu) != 0) continue;
+        for (int32_t e = 0; e < count; e++) {
+            tune_entry_t* en = &entries[e];
+            if (strcmp(en->kernel->kernel, field[1]) != 0 || strcmp(en->shape, field[2]) != 0) {
+                continue;
+            }
+            for (int32_t v = 0; v < en->kernel->variant_count; v++) {
+                if (strcmp(en->kernel->variants[v].name, field[3]) == 0) {
+                    en->choice = v;
+                    en->ns = strtoull(field[4], NULL, 10);
+                }
+            }
+        }
+    }
+    fclose(f);
+}
+
+// 写回缓存: 保留其他键的行，本次计时的键只保留新结果 (写入临时文件后改名)
+static void tune_save_cache(const char* path, const char* cpu, const tune_entry_t* entries,
+                            int32_t count) {
+    char tmp[512];
+    if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp)) return;
+    FILE* out = fopen(tmp, "w");
+    if (!out) return;
+    FILE* in = fopen(path, "r");
+    char line[512], key[512];
+    while (in && fgets(line, sizeof(line), in)) {
+        // 键为前三个字段 "CPU 型号|内核名|形状"
+        memcpy(key, line, sizeof(line));
+        char* p = key;
+        for (int32_t n = 0; n < 3 && p; n++) {
+            p = strchr(p, '|');
+            if (p) p++;
+        }
+        bool stale = false;
+        if (p) {
+            p[-1] = '\0';
+            for (int32_t e = 0; e < count && !stale; e++) {
+                const tune_entry_t* en = &entries[e];
+                char cur[512];
+                snprintf(cur, sizeof(cur), "%s|%s|%s", cpu, en->kernel->kernel, en->shape);
+                stale = en->measured && strcmp(key, cur) == 0;
+            }
+        }
+        if (!stale) fputs(line, out);
+    }
+    if (in) fclose(in);
+    for (int32_t e = 0; e < count; e++) {
+        const tune_entry_t* en = &entries[e];
+        if (!en->measured) continue;
+        fprintf(out, "%s|%s|%s|%s|%llu\n", cpu, en->kernel->kernel, en->shape,
+                en->kernel->variants[en->choice].name, (unsigned long long)en->ns);
+    }
+    if (fclose(out) != 0 || rename(tmp, path) != 0) {
+        remove(tmp);
+    }
+}
+
+// 逐个候选计时 (取最小值)，返回是否有候选成功
+static bool tune_measure(tune_entry_t* en, void* args, int32_t warmup, int32_t repeats) {
+    en->choice = -1;
+    for (int32_t v = 0; v < en->kernel->variant_count; v++) {
+        tvmrt_op_func_t func = en->kernel->variants[v].func;
+        bool failed = false;
+        for (int32_t w = 0; w < warmup && !failed; w++) failed = (func(args) != 0);
+        uint64_t best = UINT64_MAX;
+        for (int32_t r = 0; r < repeats && !failed; r++) {
+            uint64_t t0 = tvmrt_time_ns();
+            failed = (func(args) != 0);
+            uint64_t dt = tvmrt_time_ns() - t0;
+            best = (dt < best) ? dt : best;
+        }
+        if (!failed && (en->choice < 0 || best < en->ns)) {
+            en->choice = v;
+            en->ns = best;
+        }
+    }
+    en->measured = true;
+    return en->choice >= 0;
+}
+
+int tvmrt_tune(
+    tvmrt_context_t* ctx,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_tune_config_t* config,
+    tvmrt_tune_stats_t* stats
+) {
+    if (!ctx || !ctx->op_execs || !model || !config ||
+        (config->kernel_count > 0 && !config->kernels)) {
+        return -1;
+    }
+    int32_t op_count = (ctx->op_count < model->op_count) ? ctx->op_count : model->op_count;
+    tvmrt_tune_stats_t st = {0};
+    uint64_t n = (uint64_t)(op_count ? op_count : 1);
+    tune_entry_t* entries = (tune_entry_t*)tvmrt_mem_alloc(n * sizeof(tune_entry_t), 8);
+    int32_t* op_entry = (int32_t*)tvmrt_mem_alloc(n * sizeof(int32_t), 8);
+    if (!entries || !op_entry) {
+        tvmrt_mem_free(entries);
+        tvmrt_mem_free(op_entry);
+        return -1;
+    }
+
+    // 1. 按 (内核, 形状) 归并算子
+    bool sorted = model->tensor_map && semantic_map_sorted(model->tensor_map, model->tensor_count);
+    int32_t count = 0;
+    for (int32_t i = 0; i < op_count; i++) {
+        const tvmrt_tune_kernel_t* kn = tune_find_kernel(config, ctx->op_execs[i].func);
+        op_entry[i] = -1;
+        if (!kn || kn->variant_count <= 0) {
+            st.skipped++;
+            continue;
+        }
+        char shape[TUNE_SHAPE_LEN];
+        tune_shape_key(model, ctx, sorted, i, shape, sizeof(shape));
+        for (int32_t e = 0; e < count && op_entry[i] < 0; e++) {
+            if (entries[e].kernel == kn && strcmp(entries[e].shape, shape) == 0) op_entry[i] = e;
+        }
+        if (op_entry[i] < 0) {
+            tune_entry_t* en = &entries[count];
+            *en = (tune_entry_t){.kernel = kn, .op = i, .choice = -1};
+            memcpy(en->shape, shape, sizeof(shape));
+            op_entry[i] = count++;
+        }
+    }
+
+    // 2. 读缓存，未命中的逐个计时
+    char cpu[128];
+    tvmrt_cpu_model(cpu, (int32_t)sizeof(cpu));
+    if (config->cache_path && !config->force) {
+        tune_load_cache(config->cache_path, cpu, entries, count);
+    }
+    int32_t warmup = config->warmup > 0 ? config->warmup : 2;
+    int32_t repeats = config->repeats > 0 ? config->repeats : 10;
+    uint64_t t0 = tvmrt_time_ns();
+    int ret = 0;
+    for (int32_t e = 0; e < count && ret == 0; e++) {
+        if (entries[e].choice < 0 &&
+            !tune_measure(&entries[e], ctx->op_execs[entries[e].op].args, warmup, repeats)) {
+            ret = -1;
+        }
+    }
+    st.tune_ns = tvmrt_time_ns() - t0;
+
+    // 3. 写入执行函数并追加新结果
+    for (int32_t i = 0; i < op_count && ret == 0; i++) {
+        if (op_entry[i] < 0) continue;
+        const tune_entry_t* en = &entries[op_entry[i]];
+        ctx->op_execs[i].func = en->kernel->variants[en->choice].func;
+        if (en->measured) {
+            st.tuned++;
+        } else {
+            st.cached++;
+        }
+    }
+    if (ret == 0 && config->cache_path && st.tuned > 0) {
+        tune_save_cache(config->cache_path, cpu, entries, count);
+    }
+    if (stats) *stats = st;
+    tvmrt_mem_free(entries);
+    tvmrt_mem_free(op_entry);
+    return ret;
+}
+
+// ============================================================
+// 常量分页实现
+// ============================================================
+
+static void pager_prefetch_span(tvmrt_pager_t* pager, const tvmrt_pager_span_t* span) {
+    if (span->end <= span->begin) return;
+
+    tvmrt_mem_advise(pager->base + span->begin, span->end - span->begin,
+                     TVMRT_ADVISE_WILLNEED);
+
+    if (pager->io_thread) {
+        // 逐页读取一个字节，确保页面真正载入 (不依赖内核预读策略)
+        volatile uint8_t sink = 0;
+        for (uint64_t off = span->begin; off < span->end; off += pager->page_size) {
+            sink ^= pager->base[off];
+        }
+        (void)sink;
+    }
+}
+
+static void* pager_io_thread_func(void* arg) {
+    tvmrt_pager_t* pager = (tvmrt_pager_t*)arg;
+
+    tvmrt_mutex_lock(&pager->mutex);
+    while (1) {
+        while (pager->io_count == 0 && !pager->io_shutdown) {
+            tvmrt_cond_wait(&pager->cond, &pager->mutex);
+        }
+        if (pager->io_shutdown) break;
+
+        int32_t layer = pager->io_queue[0];
+        pager->io_count--;
+        memmove(pager->io_queue, pager->io_queue + 1, (size_t)pager->io_count * sizeof(int32_t));
+        pager->io_pending[layer] = false;
+        tvmrt_mutex_unlock(&pager->mutex);
+
+        pager_prefetch_span(pager, &pager->spans[layer]);
+
+        tvmrt_mutex_lock(&pager->mutex);
+    }
+    tvmrt_mutex_unlock(&pager->mutex);
+
+    return NULL;
+}
+
+// 标记某层为常驻并发起预取 (I/O 线程模式下入队异步执行，请求不会互相覆盖)
+static void pager_load_layer(tvmrt_pager_t* pager, int32_t layer) {
+    if (pager->resident[layer]) return;
+
+    const tvmrt_pager_span_t* span = &pager->spans[layer];
+    pager->resident[layer] = true;
+    pager->resident_bytes += span->end - span->begin;
+    if (pager->resident_bytes > pager->peak_resident_bytes) {
+        pager->peak_resident_bytes = pager->resident_bytes;
+    }
+    pager->prefetch_count++;
+
+    if (pager->io_thread) {
+        tvmrt_mutex_lock(&pager->mutex);
+        if (!pager->io_pending[layer]) {
+            pager->io_pending[layer] = true;
+            pager->io_queue[pager->io_count++] = layer;
+            tvmrt_cond_signal(&pager->cond);
+        }
+        tvmrt_mutex_unlock(&pager->mutex);
+    } else {
+        pager_prefetch_span(pager, span);
+    }
+}
+
+// 撤销尚未被 I/O 线程取走的预取请求，避免释放后又被读回
+static void pager_cancel_layer(tvmrt_pager_t* pager, int32_t layer) {
+    if (!pager->io_thread) return;
+
+    tvmrt_mutex_lock(&pager->mutex);
+    if (pager->io_pending[layer]) {
+        int32_t i = 0;
+        while (pager->io_queue[i] != layer) i++;
+        pager->io_count--;
+        memmove(pager->io_queue + i, pager->io_queue + i + 1,
+                (size_t)(pager->io_count - i) * sizeof(int32_t));
+        pager->io_pending[layer] = false;
+    }
+    tvmrt_mutex_unlock(&pager->mutex);
+}
+
+// 释放 [begin, end) 中不与受保护区间重叠的部分
+static void pager_release_range(tvmrt_pager_t* pager, uint64_t begin, uint64_t end,
+                                const tvmrt_pager_span_t* keep, int32_t keep_count) {
+    if (end <= begin) return;
+
+    for (int32_t i = 0; i < keep_count; i++) {
+        if (keep[i].begin < end && keep[i].end > begin) {
+            // 与受保护区间重叠: 拆成左右两段递归处理
+            pager_release_range(pager, begin, keep[i].begin, keep + i + 1, keep_count - i - 1);
+            pager_release_range(pager, keep[i].end, end, keep + i + 1, keep_count - i - 1);
+            return;
+        }
+    }
+
+    tvmrt_mem_advise(pager->base + begin, end - begin, TVMRT_ADVISE_DONTNEED);
+}
+
+static void pager_layer_hook(int32_t layer_idx, void* user) {
+    tvmrt_pager_t* pager = (tvmrt_pager_t*)user;
+    int32_t n = pager->layer_count;
+    if (layer_idx < 0 || layer_idx >= n) return;
+
+    int32_t next = (layer_idx + 1) % n;  // 最后一层时预取下一次推理的第 0 层
+
+    pager_load_layer(pager, layer_idx);
+    pager_load_layer(pager, next);
+
+    if (pager->memory_cap == 0) return;
+
+    // 超出上限时释放已完成层。循环访问模式下，刚执行完的层距离下次使用最远，
+    // 因此从 layer_idx - 1 向前释放 (Belady 最优顺序)。
+    for (int32_t step = 1; step < n - 1 && pager->resident_bytes > pager->memory_cap; step++) {
+        int32_t victim = (layer_idx - step + n) % n;
+        if (!pager->resident[victim] || victim == next) continue;
+
+        // 与其他常驻层 (含当前层与下一层) 共享的边界页保留，只释放本层独占的页
+        const tvmrt_pager_span_t* span = &pager->spans[victim];
+        int32_t keep_count = 0;
+        for (int32_t l = 0; l < n; l++) {
+            const tvmrt_pager_span_t* other = &pager->spans[l];
+            if (l != victim && pager->resident[l] && other->begin < span->end &&
+                other->end > span->begin) {
+                pager->keep[keep_count++] = *other;
+            }
+        }
+        pager_cancel_layer(pager, victim);
+        pager_release_range(pager, span->begin, span->end, pager->keep, keep_count);
+        pager->resident[victim] = false;
+        pager->resident_bytes -= span->end - span->begin;
+        pager->release_count++;
+    }
+}
+
+int tvmrt_pager_open(
+    tvmrt_pager_t* pager,
+    const tvmrt_pager_config_t* config,
+    const tvmrt_model_desc_t* model
+) {
+    if (!pager || !config || !model || !model->schedule) {
+        return -1;
+    }
+
+    const tvmrt_schedule_desc_t* schedule = model->schedule;
+
+    memset(pager, 0, sizeof(*pager));
+
+    // spans/keep 各 layers 项，io_queue 为 int32，resident/io_pending 为 bool，一次分配
+    int32_t layers = schedule->layer_count > 0 ? schedule->layer_count : 1;
+    pager->spans = (tvmrt_pager_span_t*)tvmrt_mem_alloc(
+        (uint64_t)layers * (2 * sizeof(tvmrt_pager_span_t) + sizeof(int32_t) + 2 * sizeof(bool)),
+        8);
+    if (!pager->spans) {
+        return -1;
+    }
+    pager->keep = pager->spans + layers;
+    pager->io_queue = (int32_t*)(pager->keep + layers);
+    pager->resident = (bool*)(pager->io_queue + layers);
+    pager->io_pending = pager->resident + layers;
+    memset(pager->resident, 0, (size_t)layers * 2 * sizeof(bool));
+
+    void* base = NULL;
+    if (tvmrt_file_map_readonly(config->path, &base, &pager->size) != TVMRT_OK) {
+        tvmrt_mem_free(pager->spans);
+        pager->spans = NULL;
+        return -1;
+    }
+    pager->base = (uint8_t*)base;
+    pager->page_size = tvmrt_page_size();
+    pager->memory_cap = config->memory_cap;
+    pager->layer_count = schedule->layer_count;
+
+    // 合并每层算子的常量区间并按页对齐
+    for (int32_t l = 0; l < schedule->layer_count; l++) {
+        const tvmrt_schedule_layer_t* layer = &schedule->layers[l];
+        uint64_t begin = UINT64_MAX;
+        uint64_t end = 0;
+
+        for (int32_t i = 0; i < layer->count; i++) {
+            int32_t op_idx = layer->op_indices[i];
+            if (op_idx < 0 || op_idx >= model->op_count) continue;
+
+            const tvmrt_op_desc_t* op = &model->op_descs[op_idx];
+            if (op->const_size <= 0) continue;
+
+            uint64_t op_begin = (uint64_t)op->const_offset;
+            uint64_t op_end = op_begin + (uint64_t)op->const_size;
+            if (op_begin < begin) begin = op_begin;
+            if (op_end > end) end = op_end;
+        }
+
+        if (end > pager->size) end = pager->size;
+        if (begin >= end) {
+            pager->spans[l].begin = 0;
+            pager->spans[l].end = 0;
+            continue;
+        }
+        pager->spans[l].begin = begin & ~(pager->page_size - 1);
+        pager->spans[l].end = (end + pager->page_size - 1) & ~(pager->page_size - 1);
+        if (pager->spans[l].end > pager->size) {
+            pager->spans[l].end = pager->size;
+        }
+    }
+
+    if (config->io_thread) {
+        if (tvmrt_mutex_init(&pager->mutex) != TVMRT_OK) {
+            tvmrt_file_unmap(pager->base, pager->size);
+            tvmrt_mem_free(pager->spans);
+            return -1;
+        }
+        if (tvmrt_cond_init(&pager->cond) != TVMRT_OK) {
+            tvmrt_mutex_destroy(&pager->mutex);
+            tvmrt_file_unmap(pager->base, pager->size);
+            tvmrt_mem_free(pager->spans);
+            return -1;
+        }
+        if (tvmrt_thread_create(&pager->thread, pager_io_thread_func, pager) != TVMRT_OK) {
+            tvmrt_cond_destroy(&pager->cond);
+            tvmrt_mutex_destroy(&pager->mutex);
+            tvmrt_file_unmap(pager->base, pager->size);
+            tvmrt_mem_free(pager->spans);
+            return -1;
+        }
+        pager->io_thread = true;
+    }
+
+    return 0;
+}
+
+void tvmrt_pager_attach(tvmrt_pager_t* pager, tvmrt_context_t* ctx) {
+    if (!pager || !ctx) return;
+    ctx->const_workspace = pager->base;
+    ctx->layer_hook = pager_layer_hook;
+    ctx->layer_hook_user = pager;
+}
+
+void tvmrt_pager_close(tvmrt_pager_t* pager) {
+    if (!pager || !pager->base) return;
+
+    if (pager->io_thread) {
+        tvmrt_mutex_lock(&pager->mutex);
+        pager->io_shutdown = true;
+        tvmrt_cond_broadcast(&pager->cond);
+        tvmrt_mutex_unlock(&pager->mutex);
+
+        tvmrt_thread_join(&pager->thread);
+        tvmrt_cond_destroy(&pager->cond);
+        tvmrt_mutex_destroy(&pager->mutex);
+        pager->io_thread = false;
+    }
+
+    tvmrt_file_unmap(pager->base, pager->size);
+    pager->base = NULL;
+    pager->size = 0;
+    tvmrt_mem_free(pager->spans);
+    pager->spans = NULL;
+    pager->keep = NULL;
+    pager->io_queue = NULL;
+    pager->resident = NULL;
+    pager->io_pending = NULL;
+}
+
+// ============================================================
+// Workspace 内存池实现
+// ============================================================
+
+static uint64_t arena_round_up(uint64_t value, uint64_t align) {
+    return (value + align - 1) & ~(align - 1);
+}
+
+int tvmrt_arena_init(tvmrt_arena_t* arena, uint64_t capacity, tvmrt_hugepage_mode_t hugepage) {
+    if (!arena || capacity == 0) {
+        return -1;
+    }
+    memset(arena, 0, sizeof(*arena));
+
+    uint64_t huge = tvmrt_huge_page_size();
+    void* base = NULL;
+
+    // 显式大页: 需要系统预留 hugetlb 页，失败时回退到透明大页
+    if (hugepage == TVMRT_HUGEPAGE_EXPLICIT) {
+        uint64_t size = arena_round_up(capacity, huge);
+        if (tvmrt_mem_map_anon(size, true, &base) == TVMRT_OK) {
+            arena->base = (uint8_t*)base;
+            arena->capacity = size;
+            arena->page_size = huge;
+            arena->hugepage = TVMRT_HUGEPAGE_EXPLICIT;
+            return 0;
+        }
+        hugepage = TVMRT_HUGEPAGE_TRANSPARENT;
+    }
+
+    if (hugepage == TVMRT_HUGEPAGE_TRANSPARENT) {
+        // 多映射一个大页再裁剪首尾，使基址按大页对齐 (透明大页只作用于对齐区间)
+        uint64_t size = arena_round_up(capacity, huge);
+        if (tvmrt_mem_map_anon(size + huge, false, &base) != TVMRT_OK) {
+            return -1;
+        }
+        uintptr_t raw = (uintptr_t)base;
+        uintptr_t aligned = (uintptr_t)arena_round_up(raw, huge);
+        if (aligned > raw) {
+            tvmrt_mem_unmap(base, aligned - raw);
+        }
+        uint64_t tail = (raw + size + huge) - (aligned + size);
+        if (tail > 0) {
+            tvmrt_mem_unmap((void*)(aligned + size), tail);
+        }
+
+        arena->base = (uint8_t*)aligned;
+        arena->capacity = size;
+        if (tvmrt_mem_advise(arena->base, size, TVMRT_ADVISE_HUGEPAGE) == TVMRT_OK) {
+            arena->page_size = huge;
+            arena->hugepage = TVMRT_HUGEPAGE_TRANSPARENT;
+        } else {
+            arena->page_size = tvmrt_page_size();
+            arena->hugepage = TVMRT_HUGEPAGE_NONE;
+        }
+        return 0;
+    }
+
+    uint64_t page = tvmrt_page_size();
+    uint64_t size = arena_round_up(capacity, page);
+    if (tvmrt_mem_map_anon(size, false, &base) != TVMRT_OK) {
+        return -1;
+    }
+    arena->base = (uint8_t*)base;
+    arena->capacity = size;
+    arena->page_size = page;
+    arena->hugepage = TVMRT_HUGEPAGE_NONE;
+    return 0;
+}
+
+void* tvmrt_arena_alloc(tvmrt_arena_t* arena, uint64_t size, uint64_t align) {
+    if (!arena || !arena->base) {
+        return NULL;
+    }
+    if (align == TVMRT_ARENA_ALIGN_PAGE) {
+        align = tvmrt_page_size();
+    }
+    if (align < TVMRT_CACHE_LINE_SIZE) {
+        align = TVMRT_CACHE_LINE_SIZE;
+    }
+
+    uint64_t offset = arena_round_up(arena->used, align);
+    if (offset + size > arena->capacity) {
+        return NULL;
+    }
+    arena->used = offset + size;
+    return arena->base + offset;
+}
+
+void tvmrt_arena_prefault(tvmrt_arena_t* arena) {
+    if (!arena || !arena->base) return;
+
+    // 按基页步进写入: 大页模式下每个大页只在首次写入时缺页一次
+    uint64_t step = tvmrt_page_size();
+    volatile uint8_t* p = arena->base;
+    for (uint64_t off = 0; off < arena->used; off += step) {
+        p[off] = p[off];
+    }
+}
+
+int tvmrt_arena_prepare_context(
+    tvmrt_arena_t* arena,
+    tvmrt_context_t* ctx,
+    uint64_t workspace_size,
+    const uint8_t* const_src,
+    uint64_t const_size,
+    bool prefault
+) {
+    if (!arena || !ctx) {
+        return -1;
+    }
+
+    uint8_t* ws = (uint8_t*)tvmrt_arena_alloc(arena, workspace_size, TVMRT_ARENA_ALIGN_PAGE);
+    if (!ws) {
+        return -1;
+    }
+
+    if (const_src && const_size > 0) {
+        uint8_t* cws = (uint8_t*)tvmrt_arena_alloc(arena, const_size, TVMRT_CACHE_LINE_SIZE);
+        if (!cws) {
+            return -1;
+        }
+        memcpy(cws, const_src, (size_t)const_size);
+        ctx->const_workspace = cws;
+    }
+
+    if (prefault) {
+        tvmrt_arena_prefault(arena);
+    }
+
+    ctx->workspace = ws;
+    return 0;
+}
+
+void tvmrt_arena_destroy(tvmrt_arena_t* arena) {
+    if (!arena || !arena->base) return;
+    tvmrt_mem_unmap(arena->base, arena->capacity);
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
 }
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,11 +21,16 @@ extern "C" {
 // 配置宏
 // ============================================================
 
-/** Worker 线程数 (0 = 单线程模式) */
+/** 默认 Worker 线程数 (tvmrt_engine_init(NULL) 使用; 0 = 不编译线程池, 单线程模式) */
 #ifndef TVMRT_NUM_WORKERS
 #define TVMRT_NUM_WORKERS 4
 #endif
 
+/** 运行时可配置的 Worker 线程数上限 */
+#ifndef TVMRT_MAX_WORKERS
+#define TVMRT_MAX_WORKERS 128
+#endif
+
 /** 启用日志 (设为 0 可完全禁用) */
 #ifndef TVMRT_LOG_ENABLE
 #define TVMRT_LOG_ENABLE 1
@@ -45,19 +51,33 @@ extern "C" {
 #define TVMRT_MAX_OP_OUTPUTS 2
 #endif
 
-/** 模型中的最大算子数 */
-#ifndef TVMRT_MAX_OPS
-#define TVMRT_MAX_OPS 64
+/** 调用线程参与多算子层的执行 (有效并行度 = Worker 数 + 1) */
+#ifndef TVMRT_CALLER_PARTICIPATES
+#define TVMRT_CALLER_PARTICIPATES 1
+#endif
+
+/** 静态分配模式下每层的最大切片数 (每个执行线程一个切片, 调用线程占切片 0) */
+#define TVMRT_PLAN_MAX_SLOTS \
+    (TVMRT_NUM_WORKERS > 0 ? TVMRT_MAX_WORKERS + TVMRT_CALLER_PARTICIPATES : 1)
+
+/** 依赖模式下等待前驱时, 每轮让出 CPU 之前的自旋次数 */
+#ifndef TVMRT_DEP_SPIN_COUNT
+#define TVMRT_DEP_SPIN_COUNT 128
+#endif
+
+/** 设置了取消令牌时，阻塞等待中检查令牌的间隔 (纳秒) */
+#ifndef TVMRT_CANCEL_POLL_NS
+#define TVMRT_CANCEL_POLL_NS 1000000
 #endif
 
-/** 静态调度中的最大层数 */
-#ifndef TVMRT_MAX_LAYERS
-#define TVMRT_MAX_LAYERS 32
+/** 上下文池请求的优先级级数 (0 最低) */
+#ifndef TVMRT_PRIORITY_LEVELS
+#define TVMRT_PRIORITY_LEVELS 4
 #endif
 
-/** 每层的最大算子数 */
-#ifndef TVMRT_MAX_OPS_PER_LAYER
-#define TVMRT_MAX_OPS_PER_LAYER 16
+/** 缓存行大小 (字节) */
+#ifndef TVMRT_CACHE_LINE_SIZE
+#define TVMRT_CACHE_LINE_SIZE 64
 #endif
 
 // ============================================================
@@ -67,6 +87,7 @@ extern "C" {
 #define TVMRT_OK           0
 #define TVMRT_ERR_GENERIC  (-1)
 #define TVMRT_ERR_TIMEOUT  (-2)
+#define TVMRT_ERR_CANCELLED (-3)
 
 // ============================================================
 // OS 抽象层 - 平台检测与类型定义
@@ -156,6 +177,7 @@ void tvmrt_mutex_destroy(tvmrt_mutex_t* m);
 // 条件变量 API
 int tvmrt_cond_init(tvmrt_cond_t* c);
 int tvmrt_cond_wait(tvmrt_cond_t* c, tvmrt_mutex_t* m);
+int tvmrt_cond_timedwait(tvmrt_cond_t* c, tvmrt_mutex_t* m, uint64_t deadline_ns);  // 截止时刻以 tvmrt_time_ns 计, 超时返回 TVMRT_ERR_TIMEOUT
 int tvmrt_cond_signal(tvmrt_cond_t* c);
 int tvmrt_cond_broadcast(tvmrt_cond_t* c);
 void tvmrt_cond_destroy(tvmrt_cond_t* c);
@@ -163,14 +185,86 @@ void tvmrt_cond_destroy(tvmrt_cond_t* c);
 // 线程 API
 int tvmrt_thread_create(tvmrt_thread_t* t, tvmrt_thread_func_t func, void* arg);
 int tvmrt_thread_join(tvmrt_thread_t* t);
+void tvmrt_thread_yield(void);
 
 // 屏障 API (用于 BSP 同步)
 int tvmrt_barrier_init(tvmrt_barrier_t* b);
 void tvmrt_barrier_reset(tvmrt_barrier_t* b, int32_t target);
 void tvmrt_barrier_arrive(tvmrt_barrier_t* b);
 void tvmrt_barrier_sync(tvmrt_barrier_t* b);
+int tvmrt_barrier_timedsync(tvmrt_barrier_t* b, uint64_t deadline_ns);  // 截止时刻前未到齐返回 TVMRT_ERR_TIMEOUT
 void tvmrt_barrier_destroy(tvmrt_barrier_t* b);
 
+// 内存映射 API (用于常量分页)
+typedef enum {
+    TVMRT_ADVISE_WILLNEED = 0,  // 预读: 异步将页面读入内存
+    TVMRT_ADVISE_DONTNEED = 1,  // 释放: 丢弃常驻页面 (只读映射再次访问时从文件重新载入)
+    TVMRT_ADVISE_HUGEPAGE = 2   // 透明大页: 请求内核以大页支撑该区间
+} tvmrt_mem_advice_t;
+
+uint64_t tvmrt_page_size(void);
+int tvmrt_file_map_readonly(const char* path, void** addr, uint64_t* size);
+void tvmrt_file_unmap(void* addr, uint64_t size);
+int tvmrt_mem_advise(void* addr, uint64_t len, tvmrt_mem_advice_t advice);
+
+// 匿名页分配 API (用于 workspace 内存池)
+uint64_t tvmrt_huge_page_size(void);     // 透明大页大小 (sysfs hpage_pmd_size，读取失败为 2MB)
+int tvmrt_mem_map_anon(uint64_t size, bool explicit_huge, void** addr);
+void tvmrt_mem_unmap(void* addr, uint64_t size);
+
+// 堆分配 API (仅在 prepare 阶段按模型规模一次性分配, 推理路径不调用)
+void* tvmrt_mem_alloc(uint64_t size, uint64_t align);   // align 为 2 的幂, 失败返回 NULL
+void tvmrt_mem_free(void* addr);
+
+// 时钟 API (单调时钟, 用于剖析与调度开销测量)
+uint64_t tvmrt_time_ns(void);
+
+// CPU 探测 API: 本进程可用的 CPU 数 (亲和性掩码与 cgroup CPU 配额取小, 至少为 1)
+int32_t tvmrt_cpu_count(void);
+
+// 缓存容量 API: level 为 1 (L1D)、2、3，未知返回 0
+int64_t tvmrt_cache_size(int32_t level);
+
+// CPU 型号 API: 写入以 NUL 结尾的型号字符串 (未知为 "unknown")
+void tvmrt_cpu_model(char* buf, int32_t size);
+
+// 硬件性能计数器 API (统计当前进程用户态, 含打开之后创建的线程)
+typedef enum {
+    TVMRT_PERF_CYCLES = 0,
+    TVMRT_PERF_INSTRUCTIONS,
+    TVMRT_PERF_CACHE_REFERENCES,
+    TVMRT_PERF_CACHE_MISSES,        // 末级缓存未命中
+    TVMRT_PERF_L1D_READ_MISSES,
+    TVMRT_PERF_BRANCH_MISSES,
+    TVMRT_PERF_EVENT_COUNT
+} tvmrt_perf_event_t;
+
+typedef struct {
+    int32_t fd;                     // -1 = 未打开
+} tvmrt_perf_counter_t;
+
+int tvmrt_perf_open(tvmrt_perf_counter_t* c, tvmrt_perf_event_t event);  // 平台不支持返回 TVMRT_ERR_GENERIC
+uint64_t tvmrt_perf_read(const tvmrt_perf_counter_t* c);
+void tvmrt_perf_close(tvmrt_perf_counter_t* c);
+
+// 线程级计数器组: 只统计打开它的线程, 一次读取所有事件
+typedef struct {
+    int32_t fds[TVMRT_PERF_EVENT_COUNT];    // -1 = 该事件不可用
+    uint32_t mask;                          // 可用事件位图 (1u << tvmrt_perf_event_t)
+} tvmrt_perf_group_t;
+
+// 一次读取的累计值。PMU 被多个组分时复用时 time_running < time_enabled，
+// 此时原始计数只覆盖 time_running 内的事件，需按 time_enabled / time_running 缩放
+typedef struct {
+    uint64_t values[TVMRT_PERF_EVENT_COUNT];
+    uint64_t time_enabled;
+    uint64_t time_running;
+} tvmrt_perf_sample_t;
+
+int tvmrt_perf_group_open(tvmrt_perf_group_t* g);   // 全部事件不可用时返回 TVMRT_ERR_GENERIC
+int tvmrt_perf_group_read(const tvmrt_perf_group_t* g, tvmrt_perf_sample_t* sample);
+void tvmrt_perf_group_close(tvmrt_perf_group_t* g);
+
 // ============================================================
 // 日志系统 - 类型定义
 // ============================================================
@@ -268,6 +362,11 @@ int32_t tvmrt_log_count(void);
         tvmrt_log_push(&_rec); \
     } while(0)
 
+// 层边界标记 (调度引擎每层开始时打印)
+#define TVMRT_LOG_LAYER(layer_idx_, count_) \
+    printf("=== Layer %d (%d op%s) ===\n", \
+           (int)(layer_idx_) + 1, (int)(count_), (count_) == 1 ? "" : "s")
+
 #else
 
 // 日志禁用时，完全展开为空 (零变量、零函数调用)
@@ -276,6 +375,7 @@ int32_t tvmrt_log_count(void);
 #define TVMRT_LOG_OP_END(op_id, op_name, worker_id, ret_code) ((void)0)
 #define TVMRT_LOG_PARAMS(name_, p0_, p1_, out_ptr_) ((void)0)
 #define TVMRT_LOG_RESULT(name_, out_ptr_) ((void)0)
+#define TVMRT_LOG_LAYER(layer_idx_, count_) ((void)0)
 
 #endif  // TVMRT_LOG_ENABLE
 
@@ -293,17 +393,45 @@ typedef enum {
 // Runtime 核心类型 - 张量内存映射
 // ============================================================
 
+// 特殊 SID: 不对应 workspace，而是未使用槽位或模型外部输入/输出缓冲区
+#define TVMRT_SID_NONE          (-1)
+#define TVMRT_SID_CONST         (-3)     // 算子自身的常量区 (const_workspace + const_offset)
+#define TVMRT_SID_INPUT_BASE    (-1000)
+#define TVMRT_SID_OUTPUT_BASE   (-2000)
+#define TVMRT_SID_INPUT(i)      (TVMRT_SID_INPUT_BASE - (i))    // 第 i 个模型输入
+#define TVMRT_SID_OUTPUT(i)     (TVMRT_SID_OUTPUT_BASE - (i))   // 第 i 个模型输出
+
+/** 张量元素类型 (零初始化即 fp32, 与未标注类型的模型兼容) */
+typedef enum {
+    TVMRT_DTYPE_FLOAT32 = 0,
+    TVMRT_DTYPE_INT8 = 1,
+    TVMRT_DTYPE_INT32 = 2,
+    TVMRT_DTYPE_FLOAT16 = 3,    // 仅存储: 算子加载时转为 fp32 计算, 写回时转换
+    TVMRT_DTYPE_BFLOAT16 = 4    // 同上
+} tvmrt_dtype_t;
+
+/** 仿射量化参数: 实数值 = scale * (q - zero_point) */
+typedef struct {
+    float scale;
+    int32_t zero_point;
+} tvmrt_quant_param_t;
+
 typedef struct {
     int32_t sid;
     int32_t offset;
     int32_t size;
     int32_t align;
+    tvmrt_dtype_t dtype;
+    tvmrt_quant_param_t quant;  // 仅 dtype 为 INT8 时有效
 } tvmrt_tensor_map_entry_t;
 
 // ============================================================
 // Runtime 核心类型 - 算子描述
 // ============================================================
 
+/** 逐元素算子: 输出第 i 个元素只依赖各输入的第 i 个元素 (可分块执行) */
+#define TVMRT_OP_ELEMENTWISE 0x1u
+
 typedef struct {
     int32_t op_id;
     const char* name;
@@ -313,6 +441,10 @@ typedef struct {
     int32_t output_sids[TVMRT_MAX_OP_OUTPUTS];
     int32_t input_count;
     int32_t output_count;
+    int32_t const_offset;   // 读取的常量区间起点 (相对 const_workspace)
+    int32_t const_size;     // 常量区间字节数 (0 = 不读取常量)
+    tvmrt_quant_param_t weight_quant;  // 常量区中 int8 权重的量化参数 (仅量化 MatMul)
+    uint32_t flags;         // TVMRT_OP_* 属性标志
 } tvmrt_op_desc_t;
 
 // ============================================================
@@ -335,16 +467,135 @@ typedef struct {
 
 typedef int32_t (*tvmrt_op_func_t)(void* args);
 
+/** 层级回调: 每层执行前在调用线程中触发 (layer_idx 从 0 开始) */
+typedef void (*tvmrt_layer_hook_t)(int32_t layer_idx, void* user);
+
 typedef struct {
     const char* name;
     tvmrt_op_func_t func;
     void* args;
 } tvmrt_op_exec_t;
 
+/**
+ * 统一算子参数 (所有包装函数的 args 均指向该结构)
+ *
+ * 由 tvmrt_semantic_bind_args() 根据算子描述的 input_sids/output_sids
+ * 经张量映射表解析填充。未使用的槽位为 NULL，可变输入算子据此确定
+ * 实际输入个数。默认配置下恰好占一个缓存行，按算子 ID 连续存放。
+ */
+typedef struct {
+    void* inputs[TVMRT_MAX_OP_INPUTS];
+    void* outputs[TVMRT_MAX_OP_OUTPUTS];
+    uint8_t* const_ws;
+    uint8_t* ws;
+} __attribute__((aligned(TVMRT_CACHE_LINE_SIZE))) tvmrt_op_args_t;
+
+// ============================================================
+// Runtime 核心类型 - 扁平执行计划
+// ============================================================
+
+/** 多算子层的执行方式 */
+typedef enum {
+    TVMRT_LAYER_FANOUT = 0,   // 分发给 Worker (共享队列或静态切片)
+    TVMRT_LAYER_INLINE = 1    // 在调用线程串行执行, 不唤醒 Worker
+} tvmrt_layer_mode_t;
+
+/** 热路径记录: 仅函数指针与参数 (16 字节, 4 条/缓存行) */
+typedef struct {
+    tvmrt_op_func_t func;
+    void* args;
+} tvmrt_plan_op_t;
+
+/**
+ * 由调度表"编译"得到的扁平执行计划
+ *
+ * ops[] 按调度顺序连续存放，已剔除越界 ID 和空函数，串行执行时只需
+ * 一个紧凑循环。名称等冷数据通过 op_ids[] 回查。
+ *
+ * 所有数组按模型规模 (算子数、层数、最宽层) 在 tvmrt_plan_reserve 中
+ * 一次性分配，推理路径不再分配内存。
+ */
+typedef struct tvmrt_arena tvmrt_arena_t;
+
+typedef struct {
+    tvmrt_plan_op_t* ops;                           // 热数据 [op_capacity]
+    int32_t* layer_begin;                           // 第 l 层 = ops[layer_begin[l], layer_begin[l+1])
+    int32_t* op_ids;                                // 冷数据: 展开位置 → 算子 ID
+    int32_t op_count;
+    int32_t layer_count;
+    int32_t id_count;                               // 算子 ID 空间 (= 编译时 ctx->op_count)
+
+    tvmrt_layer_hook_t layer_hook;                  // 编译时从上下文复制
+    void* layer_hook_user;
+
+    // 静态分配 (tvmrt_plan_assign): 第 l 层第 w 个切片为
+    // slice_ops[slice_begin[l * slice_stride + w], slice_begin[l * slice_stride + w + 1])
+    tvmrt_plan_op_t* slice_ops;
+    int32_t* slice_pos;                             // slice_ops[k] 在 ops[] 中的位置
+    int32_t* slice_begin;                           // [layer_capacity][slice_stride]
+    int32_t slice_stride;                           // = 切片容量 + 1
+    int32_t* slice_active;                          // 非空切片数 (屏障目标)
+    int32_t slot_active;                            // 至少有一个算子的切片数 (依赖模式屏障目标)
+    int32_t slot_count;                             // 0 = 未分配, 多线程路径使用共享队列
+    uint64_t* assign_cost;                          // 分配时使用的代价 (按算子编号, 线程池缩容后据此重新分配)
+    int32_t* assign_scratch;                        // [2 * 最宽层] 分配时的排序/归属临时区
+    uint64_t* assign_load;                          // [切片容量] 分配时各切片的负载
+
+    // 自适应执行 (tvmrt_plan_set_adaptive): 按实测耗时逐层选择执行方式
+    uint8_t* layer_mode;                            // tvmrt_layer_mode_t
+    uint64_t (*layer_cost_ns)[2];                   // [层][模式] 平滑后的实测耗时, 0 = 未测
+    int32_t adapt_warmup;                           // 0 = 不自适应
+    int32_t adapt_interval;
+    uint32_t adapt_runs;
+
+    // 点对点依赖 (tvmrt_plan_build_deps): ops[i] 的前驱为
+    // ops[dep_list[dep_begin[i]] .. dep_list[dep_begin[i+1]-1]]
+    int32_t* dep_list;                              // [dep_capacity], 建立依赖时按边数分配
+    int32_t* dep_begin;
+    bool dataflow;                                  // true: 以完成标志代替层屏障
+    uint32_t run_epoch;                             // 每次执行 +1
+    uint32_t* done_epoch;                           // == run_epoch 表示本次已完成
+
+    // 存储: arena 非 NULL 时从中分配 (随 arena 释放)，否则为 tvmrt_mem_alloc 的单块
+    tvmrt_arena_t* arena;
+    void* storage;
+    void* dep_storage;
+    int32_t op_capacity;
+    int32_t layer_capacity;
+    int32_t id_capacity;
+    int32_t dep_capacity;
+} tvmrt_plan_t;
+
+// ============================================================
+// Runtime 核心类型 - 逐算子剖析
+// ============================================================
+
+/** 单个算子的累计统计 */
+typedef struct {
+    uint64_t calls;
+    uint64_t time_ns;
+    uint64_t counted_calls;                         // 有计数器数据的调用次数
+    uint64_t scaled_calls;                          // 其中计数器被复用、按运行时间比例缩放的次数
+    uint64_t counters[TVMRT_PERF_EVENT_COUNT];      // 各事件累计增量
+    uint32_t counter_mask;                          // 出现过的事件位图
+} tvmrt_profile_op_t;
+
+/** 剖析结果 (按算子 ID 索引, 由 tvmrt_profile_init 按算子数分配) */
+typedef struct {
+    tvmrt_profile_op_t* ops;
+    int32_t op_count;
+    bool owned;                                     // ops 由 tvmrt_mem_alloc 分配
+} tvmrt_profile_t;
+
 // ============================================================
 // Runtime 核心类型 - 运行时上下文
 // ============================================================
 
+/** 取消令牌: 由任意线程调用 tvmrt_cancel() 置位，引擎在算子边界检查 */
+typedef struct {
+    int32_t cancelled;
+} tvmrt_cancel_token_t;
+
 typedef struct {
     uint8_t* workspace;
     const uint8_t* const_workspace;
@@ -352,7 +603,17 @@ typedef struct {
     tvmrt_op_exec_t* op_execs;
     int32_t op_count;
     
-    void* args_storage;
+    void* args_storage;     // tvmrt_op_args_t[op_count] (由 tvmrt_semantic_init 使用)
+
+    tvmrt_layer_hook_t layer_hook;   // 可选, NULL 表示不回调
+    void* layer_hook_user;
+
+    tvmrt_plan_t* plan;              // 可选, 非 NULL 时按计划执行 (自适应统计会写回计划)
+
+    // 可选: 截止时刻 (tvmrt_time_ns, 0 = 不限) 与取消令牌。到期或被取消后
+    // 尚未开始的算子全部跳过，执行返回 TVMRT_ERR_TIMEOUT / TVMRT_ERR_CANCELLED
+    uint64_t deadline_ns;
+    const tvmrt_cancel_token_t* cancel;
 } tvmrt_context_t;
 
 // ============================================================
@@ -360,7 +621,7 @@ typedef struct {
 // ============================================================
 
 typedef struct {
-    int32_t tasks[TVMRT_MAX_OPS_PER_LAYER];
+    const int32_t* tasks;   // 指向当前层的 op_indices, 不复制
     int32_t head;
     int32_t tail;
     int32_t count;
@@ -383,30 +644,76 @@ typedef struct {
     
     const tvmrt_op_func_t* cpu_func_table;
     int32_t cpu_func_count;
+    const char* const* cpu_func_names;  // 可选: 函数表符号名 (用于生成 C 代码)
 } tvmrt_model_desc_t;
 
 // ============================================================
 // 调度引擎 API
 // ============================================================
 
+/** num_workers 取该值时按 tvmrt_cpu_count() 自动确定 */
+#define TVMRT_WORKERS_AUTO (-1)
+
+/** 引擎工作方式 (按部署选择, 影响 tvmrt_context_pool_run) */
+typedef enum {
+    TVMRT_ENGINE_LATENCY = 0,       // 单个请求的多算子层分发到全部 Worker (默认)
+    TVMRT_ENGINE_THROUGHPUT = 1,    // 每个请求整体交给一个 Worker 串行执行, 多个请求并行
+} tvmrt_engine_mode_t;
+
+typedef struct {
+    int32_t num_workers;    // Worker 线程数 (0..TVMRT_MAX_WORKERS)，或 TVMRT_WORKERS_AUTO:
+                            // 可用 CPU 数 (调用线程参与执行时再减 1)
+    tvmrt_engine_mode_t mode;
+} tvmrt_engine_config_t;
+
 /**
  * @brief 初始化执行引擎
  * 
  * 创建线程池和同步原语。应在启动时调用一次。
+ * @param config NULL 表示使用 TVMRT_NUM_WORKERS 个 Worker
  * @return 成功返回 0
  */
-int tvmrt_engine_init(void);
+int tvmrt_engine_init(const tvmrt_engine_config_t* config);
+
+/**
+ * @brief 在两次推理之间扩容或缩容线程池
+ *
+ * 不得与 tvmrt_engine_run 并发调用。缩容时多出的 Worker 退出并回收；
+ * 已分配切片的计划在下次执行时按原代价重新分配到新的切片数。吞吐模式下缩容
+ * 到 0 时，仍在排队的上下文池请求由各自的提交线程接手串行执行。
+ * @param num_workers 新的 Worker 数，或 TVMRT_WORKERS_AUTO
+ * @return 成功返回 0
+ */
+int tvmrt_engine_resize(int32_t num_workers);
+
+/** @brief 当前 Worker 数 (未初始化时为 0) */
+int32_t tvmrt_engine_num_workers(void);
+
+/** @brief 当前可用的执行切片数 (Worker 数 + 参与执行的调用线程，至少为 1) */
+int32_t tvmrt_engine_slot_count(void);
+
+/** @brief 初始化时选择的工作方式 (未初始化时为 TVMRT_ENGINE_LATENCY) */
+tvmrt_engine_mode_t tvmrt_engine_mode(void);
 
 /**
  * @brief 关闭执行引擎
  * 
- * 销毁线程池并释放资源。
+ * 销毁线程池并释放资源。吞吐模式下仍在排队的上下文池请求由各自的
+ * 提交线程接手执行，返回前等待这些线程离开请求队列; 不得与新的
+ * tvmrt_context_pool_run 调用并发。
  */
 void tvmrt_engine_shutdown(void);
 
 /**
  * @brief 按静态调度表执行模型
  * 
+ * 若 ctx->plan 已经 tvmrt_plan_assign 分配切片，多算子层按静态切片
+ * 执行 (无共享队列)；否则逐层填充共享队列由 Worker 竞争出队。
+ * TVMRT_CALLER_PARTICIPATES 为 1 时调用线程也参与执行 (出队或执行
+ * 切片 0)，之后只等待尚未完成的 Worker。
+ * 任一算子失败、ctx->deadline_ns 到期或 ctx->cancel 被置位后，所有执行
+ * 线程跳过尚未开始的算子，等待层屏障时也会按时检查; 已在执行的算子
+ * 结束后返回首个错误 (算子返回值、TVMRT_ERR_TIMEOUT 或 TVMRT_ERR_CANCELLED)。
  * @param ctx 已填充算子的运行时上下文
  * @param schedule 静态调度描述符
  * @return 成功返回 0，错误返回负数
@@ -416,10 +723,52 @@ int tvmrt_engine_run(
     const tvmrt_schedule_desc_t* schedule
 );
 
+/**
+ * @brief 开启/关闭逐算子剖析
+ *
+ * 非 NULL 时 tvmrt_engine_run 中每个由 Worker 或调用线程执行的算子都会
+ * 计时；在 Linux 上各执行线程首次执行算子时打开自己的硬件计数器组
+ * (cycles / instructions / L1D / LLC / 分支未命中)，并把执行前后的增量
+ * 计入该算子。计数器不可用 (容器、虚拟机、权限限制) 时只记录耗时。
+ * 计数器组只统计打开它的线程: 每个调用线程 (批处理线程、上下文池的各
+ * 提交线程等) 各自打开一组，至多 16 个，更多的调用线程只计时。计数器
+ * 被分时复用时增量按 time_enabled / time_running 缩放，报告中以 * 标出。
+ * @param prof 累计目标 (经 tvmrt_profile_init 分配并清零)，NULL 关闭剖析
+ */
+void tvmrt_engine_set_profile(tvmrt_profile_t* prof);
+
+/**
+ * @brief 按算子数分配剖析结果
+ *
+ * @param arena 非 NULL 时从中分配，否则使用 tvmrt_mem_alloc
+ * @return 成功返回 0 (结果已清零)
+ */
+int tvmrt_profile_init(tvmrt_profile_t* prof, int32_t op_count, tvmrt_arena_t* arena);
+
+/** @brief 释放 tvmrt_profile_init 分配的内存 */
+void tvmrt_profile_destroy(tvmrt_profile_t* prof);
+
+/** @brief 清零剖析结果 */
+void tvmrt_profile_reset(tvmrt_profile_t* prof);
+
+/**
+ * @brief 输出剖析报告
+ *
+ * 每个算子一行: 调用次数、平均耗时，以及计数器可用时的 IPC 与每千条
+ * 指令的 L1D / LLC / 分支未命中数 (MPKI)。
+ * @param ctx 可选, 用于显示算子名称
+ */
+void tvmrt_profile_report(const tvmrt_profile_t* prof, const tvmrt_context_t* ctx, FILE* out);
+
+/** @brief 置位取消令牌 (可由任意线程调用) */
+void tvmrt_cancel(tvmrt_cancel_token_t* token);
+
 /**
  * @brief 单线程模式执行模型 (不使用线程池)
  * 
- * 适用于调试或不支持线程的环境。
+ * 适用于调试或不支持线程的环境。ctx->plan 非 NULL 且未设置截止时刻/
+ * 取消令牌时执行该计划 (计划编译时的调度)，不读取 schedule；否则按
+ * schedule 逐层执行。只需执行已编译计划时直接调用 tvmrt_plan_run。
  * @param ctx 已填充算子的运行时上下文
  * @param schedule 静态调度描述符
  * @return 成功返回 0，错误返回负数
@@ -429,6 +778,1146 @@ int tvmrt_engine_run_single(
     const tvmrt_schedule_desc_t* schedule
 );
 
+// ============================================================
+// 执行计划 API
+// ============================================================
+
+/**
+ * @brief 按模型规模为执行计划一次性分配全部数组
+ *
+ * 容量取自调度表: 算子数为各层 count 之和，切片容量为最宽层与
+ * TVMRT_PLAN_MAX_SLOTS 的较小者，算子 ID 空间为 ctx->op_count。
+ * plan 须零初始化；已有存储时先释放 (arena 中的旧空间随 arena 回收)。
+ * @param arena 非 NULL 时从中分配，否则以 tvmrt_mem_alloc 分配单块内存
+ * @return 成功返回 0，内存不足返回 -1
+ */
+int tvmrt_plan_reserve(
+    tvmrt_plan_t* plan,
+    const tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule,
+    tvmrt_arena_t* arena
+);
+
+/** @brief 释放计划的存储 (来自 arena 时只清空指针) */
+void tvmrt_plan_destroy(tvmrt_plan_t* plan);
+
+/**
+ * @brief 将调度表编译为扁平执行计划
+ *
+ * 按层展开 op_indices，解析 ctx->op_execs 中的函数与参数，
+ * 跳过越界 ID 与空函数。ctx 的层级回调一并记录。
+ * 容量不足时按上次的分配来源自动 tvmrt_plan_reserve，容量足够时
+ * 不分配内存 (可在每次推理前重新编译)。
+ * @return 成功返回 0，内存不足返回 -1
+ */
+int tvmrt_plan_compile(
+    tvmrt_plan_t* plan,
+    const tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule
+);
+
+/**
+ * @brief 串行执行扁平计划
+ *
+ * 无日志、无层级回调时为单个紧凑循环。
+ * @return 成功返回 0，否则返回首个失败算子的返回值
+ */
+int tvmrt_plan_run(const tvmrt_plan_t* plan);
+
+/**
+ * @brief 串行测量每个算子的平均耗时
+ *
+ * 按计划顺序执行 iters 次，cost_ns[op_id] 为该算子的平均纳秒数
+ * (数组长度至少为 plan->id_count，未出现的算子置 0)。
+ * @return 成功返回 0，否则返回首个失败算子的返回值
+ */
+int tvmrt_plan_measure(const tvmrt_plan_t* plan, int32_t iters, uint64_t* cost_ns);
+
+/**
+ * @brief 为多线程路径预先计算每层的 Worker 切片
+ *
+ * 每层按代价降序做 LPT (最长处理时间优先) 贪心分配：每个算子交给
+ * 当前负载最小的切片。分配后 tvmrt_engine_run 对多算子层不再使用
+ * 共享队列，第 w 个 Worker 直接执行自己的切片后到达屏障。
+ * @param op_cost 按算子 ID 索引的代价 (可来自 tvmrt_plan_measure)，
+ *                NULL 表示等代价 (退化为轮转)
+ * @param slots 切片数 (1..TVMRT_PLAN_MAX_SLOTS)，通常取 tvmrt_engine_slot_count()；
+ *              超过最宽层的部分不会有算子，按切片容量截断。与执行时的
+ *              tvmrt_engine_slot_count() 不同时 tvmrt_engine_run 按本次代价重新分配
+ * @return 成功返回 0
+ */
+int tvmrt_plan_assign(tvmrt_plan_t* plan, const uint64_t* op_cost, int32_t slots);
+
+/**
+ * @brief 启用逐层自适应的 串行/分发 选择
+ *
+ * 前 warmup 次 tvmrt_engine_run 为探测运行：多算子层交替以调用线程串行
+ * 和分发给 Worker 两种方式执行并计时，之后每层取较快者。此后每
+ * interval 次运行再连续探测两次 (每种方式一次) 以跟踪负载变化。
+ * 尚未分配切片时按 tvmrt_engine_slot_count() 等代价自动分配。
+ * @param warmup 探测运行次数 (>= 2)，0 表示关闭自适应并恢复为全部分发
+ * @param interval 重新评估周期 (运行次数)，0 表示不重新评估
+ * @return 成功返回 0
+ */
+int tvmrt_plan_set_adaptive(tvmrt_plan_t* plan, int32_t warmup, int32_t interval);
+
+/**
+ * @brief 由算子描述推导点对点依赖，多线程路径改用完成标志同步
+ *
+ * 依据 input_sids/output_sids 在张量映射表中的字节区间判定冒险：
+ * RAW (读前序写)、WAR (写前序读, 槽位复用)、WAW (写前序写)。对每个
+ * 访问只回溯到最近一个完全覆盖它的写者为止，更早的访问已由该写者
+ * 传递排序。
+ * 启用后切片分配不变，但各执行线程一次性走完自己跨所有层的切片，
+ * 每个算子只等待自己的前驱完成，不再有层屏障。没有层边界就无法触发
+ * 层级回调，因此计划带 layer_hook (编译时上下文设置了回调，如已附加
+ * 分页器) 时拒绝启用。
+ * 将 plan->dataflow 置 false 即恢复层屏障。尚未分配切片时按
+ * tvmrt_engine_slot_count() 等代价分配。
+ * 前驱表按实际边数分配 (来源与 tvmrt_plan_reserve 相同)。
+ * @return 成功返回 0，计划带层级回调或内存不足返回 -1 (计划保持层屏障)
+ */
+int tvmrt_plan_build_deps(tvmrt_plan_t* plan, const tvmrt_model_desc_t* model);
+
+/**
+ * @brief 打印每层当前选择的执行方式与实测耗时 (用于检查)
+ */
+void tvmrt_plan_dump(const tvmrt_plan_t* plan, FILE* out);
+
+/**
+ * @brief 为执行计划生成直线展开的 C 源码
+ *
+ * 生成函数 `int32_t <func_name>(tvmrt_op_args_t* args)`，按计划顺序
+ * 直接调用包装函数 (args 以算子 ID 索引，与 tvmrt_semantic_init 一致)。
+ * 需要 model->cpu_func_names。
+ * @return 成功返回 0
+ */
+int tvmrt_plan_emit_c(
+    const tvmrt_plan_t* plan,
+    const tvmrt_model_desc_t* model,
+    const char* func_name,
+    FILE* out
+);
+
+// ============================================================
+// 动态批处理 (Batcher)
+// ============================================================
+//
+// 多个线程各自提交单样本请求，批处理线程在 max_delay_ns 内攒够至多
+// max_batch 个请求后一次执行: 每个请求占一个预先绑定好参数的槽位
+// (独占 workspace)，b 个槽位的同层算子合并为一层，整批只经历一次逐层
+// 分发与屏障。请求的输入输出指针直接写入参数区中对应字段，无需重新
+// 绑定或拷贝。批处理线程独占调度引擎，期间不得另行调用 tvmrt_engine_run。
+
+typedef struct {
+    int32_t max_batch;              // 每批最多请求数 (>= 1)
+    uint64_t max_delay_ns;          // 批内首个请求最长等待时间 (0 = 不等待, 立即执行已到达的请求)
+    int32_t input_count;            // 模型输入/输出个数 (对应 TVMRT_SID_INPUT/OUTPUT 编号)
+    int32_t output_count;
+    uint64_t workspace_size;        // 每个槽位独占一份 workspace
+    const uint8_t* const_workspace; // 所有槽位共享
+    tvmrt_arena_t* arena;           // 可选: 槽位与计划的存储来源, NULL 使用 tvmrt_mem_alloc
+} tvmrt_batcher_config_t;
+
+/** 排队中的请求 (位于提交线程的栈上) */
+typedef struct tvmrt_batch_request {
+    void* const* inputs;
+    void* const* outputs;
+    uint64_t arrival_ns;
+    int32_t status;
+    bool done;
+    struct tvmrt_batch_request* next;
+} tvmrt_batch_request_t;
+
+/** 参数区中指向模型输入输出的字段 */
+typedef struct {
+    void** field;
+    int32_t io;                     // >= 0: 第 io 个输入; < 0: 第 (-1 - io) 个输出
+} tvmrt_io_patch_t;
+
+typedef struct {
+    const tvmrt_model_desc_t* model;
+    tvmrt_batcher_config_t config;
+
+    // 槽位 s 的算子 i 位于 execs/args[s * op_count + i]
+    uint8_t* workspaces;
+    uint64_t workspace_stride;      // 缓存行对齐, 槽位间不共享缓存行
+    tvmrt_op_exec_t* execs;
+    tvmrt_op_args_t* args;
+    tvmrt_io_patch_t* patches;   // [max_batch][patch_count]
+    int32_t patch_count;
+
+    // 批大小 b 的调度为 layers[(b-1) * layer_count ...]，计划为 plans[b-1] (初始化时编译)
+    tvmrt_schedule_layer_t* layers;
+    int32_t* layer_ops;
+    tvmrt_plan_t* plans;
+    tvmrt_batch_request_t** batch;  // [max_batch] 批处理线程取出的本批请求
+
+    // 请求队列 (FIFO)
+    tvmrt_batch_request_t* head;
+    tvmrt_batch_request_t* tail;
+    int32_t pending;
+    tvmrt_mutex_t mutex;
+    tvmrt_cond_t cond;              // 新请求到达 / 停机
+    tvmrt_cond_t done_cond;         // 一批完成
+    tvmrt_thread_t thread;
+    bool shutdown;
+    int32_t waiters;                // 正在 submit 中等待的提交线程数 (关闭时等其全部返回)
+    void* storage;
+
+    // 统计
+    uint64_t batch_count;
+    uint64_t request_count;
+} tvmrt_batcher_t;
+
+/**
+ * @brief 创建批处理器
+ *
+ * 为 max_batch 个槽位分配 workspace 与参数区并逐槽位绑定，编译每种
+ * 批大小的执行计划 (按当前 tvmrt_engine_slot_count() 分配切片并启用
+ * 逐层自适应)，然后启动批处理线程。调度引擎须已初始化 (未初始化时串行执行)。
+ * @return 成功返回 0；失败返回 -1 且 *batcher 被清零 (之后 tvmrt_batcher_destroy 无操作)
+ */
+int tvmrt_batcher_init(
+    tvmrt_batcher_t* batcher,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_batcher_config_t* config
+);
+
+/**
+ * @brief 提交一个请求并阻塞等待结果
+ *
+ * 可由任意多个线程并发调用。inputs/outputs 在返回前须保持有效。
+ * @return 所在批的执行结果 (批内任一算子失败时整批返回该错误)，
+ *         批处理器已关闭返回 -1
+ */
+int tvmrt_batcher_submit(tvmrt_batcher_t* batcher, void* const* inputs, void* const* outputs);
+
+/**
+ * @brief 关闭批处理器: 停止批处理线程，尚未执行的请求返回 -1
+ *
+ * 等所有仍在 tvmrt_batcher_submit 中的提交线程返回后才销毁同步原语，
+ * 然后清零 *batcher: 之后再调用 submit 返回 -1，再次 destroy 无操作。
+ */
+void tvmrt_batcher_destroy(tvmrt_batcher_t* batcher);
+
+// ============================================================
+// 上下文池 (吞吐模式)
+// ============================================================
+//
+// 预先准备 context_count 个独立上下文 (各自的 workspace、参数区与执行
+// 计划)，多个线程并发提交请求时各占一个空闲上下文。请求如何执行取决于
+// 引擎的工作方式:
+// - TVMRT_ENGINE_LATENCY: 请求依次独占引擎，多算子层分发到全部 Worker
+// - TVMRT_ENGINE_THROUGHPUT: 请求进入引擎的请求队列，由空闲 Worker
+//   整体串行执行，同时执行的请求数至多为 Worker 数
+// 上下文数大于 Worker 数时，多出的请求在队列中等待而不必等待上下文。
+//
+// 多个模型各建一个上下文池即可共用同一线程池。每个池带优先级:
+// - 吞吐模式: 请求按优先级出队; 没有空闲 Worker 时，执行低优先级请求的
+//   Worker 在算子边界发现更高优先级请求排队即让出，被让出的请求回到本级
+//   队首，稍后由任意 Worker 从断点继续
+// - 延迟模式: 请求整体互斥执行，等待者按优先级 (同级按到达顺序) 获得引擎
+
+typedef struct {
+    int32_t context_count;          // 上下文数 = 最大并发请求数 (>= 1)
+    int32_t input_count;            // 模型输入/输出个数 (对应 TVMRT_SID_INPUT/OUTPUT 编号)
+    int32_t output_count;
+    uint64_t workspace_size;        // 每个上下文独占一份 workspace
+    const uint8_t* const_workspace; // 所有上下文共享
+    tvmrt_arena_t* arena;           // 可选: 存储来源, NULL 使用 tvmrt_mem_alloc
+    int32_t priority;               // 0 (最低) .. TVMRT_PRIORITY_LEVELS - 1
+} tvmrt_context_pool_config_t;
+
+typedef struct {
+    const tvmrt_model_desc_t* model;
+    tvmrt_context_pool_config_t config;
+    tvmrt_engine_mode_t mode;       // 创建时的引擎工作方式 (决定计划是否分配切片)
+
+    // 上下文 c 的算子 i 位于 execs/args[c * op_count + i]
+    tvmrt_context_t* contexts;
+    tvmrt_plan_t* plans;
+    uint8_t* workspaces;
+    uint64_t workspace_stride;
+    tvmrt_op_exec_t* execs;
+    tvmrt_op_args_t* args;
+    tvmrt_io_patch_t* patches;      // [context_count][patch_count]
+    int32_t patch_count;
+
+    // 空闲上下文栈
+    int32_t* free_list;
+    int32_t free_count;
+    tvmrt_mutex_t mutex;
+    tvmrt_cond_t cond;              // 有上下文归还
+    void* storage;
+} tvmrt_context_pool_t;
+
+/**
+ * @brief 创建上下文池
+ *
+ * 逐个绑定上下文并编译计划。引擎为 TVMRT_ENGINE_LATENCY 时计划按
+ * tvmrt_engine_slot_count() 分配切片并启用逐层自适应；吞吐模式下计划
+ * 只用于串行执行。引擎须先初始化，且之后不得切换工作方式。
+ * @return 成功返回 0
+ */
+int tvmrt_context_pool_init(
+    tvmrt_context_pool_t* pool,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_context_pool_config_t* config
+);
+
+/**
+ * @brief 执行一个请求并阻塞等待结果
+ *
+ * 可由任意多个线程并发调用; 没有空闲上下文时等待。延迟模式下请求之间
+ * 互斥执行，调用方不得另行并发调用 tvmrt_engine_run。引擎没有 Worker
+ * 时在调用线程上串行执行。
+ * @return 请求中首个失败算子的返回值，成功返回 0
+ */
+int tvmrt_context_pool_run(tvmrt_context_pool_t* pool, void* const* inputs, void* const* outputs);
+
+/**
+ * @brief 带截止时刻与取消令牌执行一个请求
+ *
+ * 等待空闲上下文、等待引擎或在请求队列中排队期间到期/被取消时直接返回，
+ * 不再占用 Worker (过载时丢弃而不是积压)；执行中到期/被取消时跳过剩余
+ * 算子。
+ * @param deadline_ns 截止时刻 (tvmrt_time_ns)，0 表示不限
+ * @param cancel 可选的取消令牌
+ * @return 同 tvmrt_context_pool_run，到期返回 TVMRT_ERR_TIMEOUT，被取消返回
+ *         TVMRT_ERR_CANCELLED
+ */
+int tvmrt_context_pool_run_until(
+    tvmrt_context_pool_t* pool,
+    void* const* inputs,
+    void* const* outputs,
+    uint64_t deadline_ns,
+    const tvmrt_cancel_token_t* cancel
+);
+
+/** @brief 释放上下文池 (须无正在执行的请求) */
+void tvmrt_context_pool_destroy(tvmrt_context_pool_t* pool);
+
+// ============================================================
+// 分块执行 (Tiled Execution)
+// ============================================================
+//
+// 张量很大时逐层执行会让每个中间结果整体流经内存。分块执行把连续若干层
+// 逐元素算子组成的段按元素切块: 第 i 块上依次执行段内所有算子后再处理
+// 第 i + 1 块，块大小按缓存容量确定，中间结果留在缓存中。
+//
+// 沿用现有包装函数，不需要融合代码生成: 每块每个算子一份参数视图 (输入
+// 输出指针前移到块起点，算子常量区复制一份并把属性块的 count 改为块长)，
+// 段在调度中替换为一层互相独立的分块任务，可串行或分发给 Worker。
+//
+// 可分块的层: 所有算子带 TVMRT_OP_ELEMENTWISE 标志、以 TVMRT_SID_CONST
+// 引用 tvmrt_qattrs_t 属性块且元素数相同; 至少连续两层才组成一段。段内
+// workspace 张量除完全重合外不得互相重叠 (否则该段不分块)。模型外部输入
+// 输出按 fp32 计，workspace 张量按映射表的 dtype 计元素大小。
+
+/** 一个分块段 */
+typedef struct {
+    int32_t first_layer;    // 原调度中的起始层
+    int32_t layer_count;
+    int32_t elems;          // 元素数
+    int32_t tile_elems;     // 每块元素数 (最后一块可能更短)
+    int32_t tile_count;
+} tvmrt_tile_segment_t;
+
+typedef struct {
+    tvmrt_op_exec_t* execs;           // [0, op_count) 为原算子，其后为分块任务
+    int32_t exec_count;
+    tvmrt_schedule_desc_t schedule;   // 分块后的调度 (每段合并为一层分块任务)
+    tvmrt_tile_segment_t* segments;
+    int32_t segment_count;
+    void* storage;                    // 单块分配 (视图、常量副本、调度数组)
+} tvmrt_tiled_t;
+
+/**
+ * @brief 为已绑定参数的上下文生成分块调度
+ *
+ * 参数视图在此时由 ctx 的参数区复制，输入输出指针或常量改变后需重新生成。
+ * 执行时令 ctx->op_execs = tiled->execs、ctx->op_count = tiled->exec_count，
+ * 再以 &tiled->schedule 调用 tvmrt_engine_run/run_single 或编译执行计划
+ * (不适用于依赖标志模式)。
+ * @param cache_bytes 每块工作集上限 (段内各张量的块之和)；0 = L1D 容量的一半
+ *                    (bench_runtime tiled 中各档预算里最快，更大的块让中间
+ *                    结果溢出 L1，L2/2 时几乎没有收益)
+ * @return 成功返回 0 (没有可分块的段时 segment_count 为 0、调度与原调度相同)，
+ *         参数无效或内存不足返回 -1
+ */
+int tvmrt_tiled_init(
+    tvmrt_tiled_t* tiled,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_context_t* ctx,
+    const tvmrt_schedule_desc_t* schedule,
+    int64_t cache_bytes
+);
+
+/** @brief 释放分块调度 */
+void tvmrt_tiled_destroy(tvmrt_tiled_t* tiled);
+
+// ============================================================
+// 自动调优 (Autotuning)
+// ============================================================
+//
+// 同一算子可能有多个可互换实现 (分块大小、展开、指令集版本)，最快者因
+// 机器与形状而异。准备阶段可对每个算子在其已绑定的参数上逐一计时候选
+// 实现，把最快者写入 ctx->op_execs[i].func。结果按 CPU 型号 + 内核名 +
+// 形状写入调优缓存文件，之后启动时命中缓存直接选用，不再计时。
+//
+// 算子的形状: 以 TVMRT_SID_CONST 引用 tvmrt_qattrs_t 属性块的算子取
+// count/n/k 与各存储类型，其余取各输入输出张量的字节数。
+// 缓存文件为文本，每行 "CPU 型号|内核名|形状|候选名|纳秒"，每个键只有一行:
+// 新测得的结果 (含 force 重新计时) 替换文件中的同键行。读取时若仍有重复
+// (如手工编辑)，后出现的行覆盖先出现的。
+
+/** 一个候选实现 */
+typedef struct {
+    const char* name;           // 稳定名称 (写入缓存，不含 '|')
+    tvmrt_op_func_t func;
+} tvmrt_tune_variant_t;
+
+/** 一组可互换实现: 执行函数为 base 的算子参与调优 */
+typedef struct {
+    const char* kernel;         // 内核名 (缓存键的一部分，不含 '|')
+    tvmrt_op_func_t base;
+    const tvmrt_tune_variant_t* variants;
+    int32_t variant_count;
+} tvmrt_tune_kernel_t;
+
+typedef struct {
+    const tvmrt_tune_kernel_t* kernels;
+    int32_t kernel_count;
+    const char* cache_path;     // NULL 不读写缓存
+    int32_t warmup;             // 每个候选的预热次数 (0 = 2)
+    int32_t repeats;            // 计时次数, 取最小值 (0 = 10)
+    bool force;                 // 忽略缓存重新计时
+} tvmrt_tune_config_t;
+
+typedef struct {
+    int32_t tuned;              // 计时选出的算子数 (同键算子只计时一次)
+    int32_t cached;             // 命中缓存的算子数
+    int32_t skipped;            // 无候选的算子数
+    uint64_t tune_ns;           // 计时耗时
+} tvmrt_tune_stats_t;
+
+/**
+ * @brief 为已绑定参数的上下文选择每个算子的最快实现
+ *
+ * 计时直接在算子的参数上执行候选实现，会改写 workspace 与输出缓冲区，
+ * 须在推理开始前调用。返回后再编译执行计划 (tvmrt_plan_compile 复制的是
+ * 当时的函数指针)。候选返回非 0 时不参与选择。
+ * @param stats 可为 NULL
+ * @return 成功返回 0；参数无效、内存不足或所有候选均失败返回 -1
+ *         (缓存文件无法读写不视为错误)
+ */
+int tvmrt_tune(
+    tvmrt_context_t* ctx,
+    const tvmrt_model_desc_t* model,
+    const tvmrt_tune_config_t* config,
+    tvmrt_tune_stats_t* stats
+);
+
+// ============================================================
+// 常量分页 (Weight Paging)
+// ============================================================
+//
+// 当常量区过大、无法与 workspace 一起常驻内存时，将常量文件只读映射，
+// 按调度层流式加载: 第 k 层执行时预取第 k+1 层的常量页，已完成层的
+// 页面在超出 memory_cap 时释放。相邻层的区间按页对齐后可能共享边界页，
+// 释放时只丢弃没有其他常驻层使用的页。
+
+typedef struct {
+    const char* path;       // 常量文件路径 (内容布局与 const_workspace 一致)
+    uint64_t memory_cap;    // 常驻常量字节上限 (0 = 不限制, 从不释放)
+    bool io_thread;         // true: 由 I/O 线程逐页读取预取; false: 仅 madvise 预读
+} tvmrt_pager_config_t;
+
+typedef struct {
+    uint64_t begin;         // 页对齐区间 [begin, end)
+    uint64_t end;
+} tvmrt_pager_span_t;
+
+typedef struct {
+    uint8_t* base;
+    uint64_t size;
+    uint64_t page_size;
+    uint64_t memory_cap;
+
+    tvmrt_pager_span_t* spans;  // [layer_count], 打开时分配
+    tvmrt_pager_span_t* keep;   // [layer_count], 释放时的受保护区间 (临时)
+    bool* resident;
+    int32_t layer_count;
+
+    // 统计: 常驻字节为各常驻层区间之和 (共享的边界页按层重复计入)，
+    // 是估计值而非实测 RSS
+    uint64_t resident_bytes;
+    uint64_t peak_resident_bytes;
+    int32_t prefetch_count;
+    int32_t release_count;
+
+    // I/O 线程 (io_thread = true 时使用)
+    bool io_thread;
+    bool io_shutdown;
+    int32_t* io_queue;      // [layer_count] 待预取的层 (按请求顺序)
+    bool* io_pending;       // [layer_count] 已入队尚未被 I/O 线程取走
+    int32_t io_count;
+    tvmrt_thread_t thread;
+    tvmrt_mutex_t mutex;
+    tvmrt_cond_t cond;
+} tvmrt_pager_t;
+
+/**
+ * @brief 打开常量文件并按调度表计算每层常量区间
+ *
+ * 每层区间由该层算子的 const_offset/const_size 合并并按页对齐得到。
+ * @return 成功返回 0
+ */
+int tvmrt_pager_open(
+    tvmrt_pager_t* pager,
+    const tvmrt_pager_config_t* config,
+    const tvmrt_model_desc_t* model
+);
+
+/**
+ * @brief 将分页器挂接到运行时上下文
+ *
+ * 设置 ctx->const_workspace 为映射基址，并安装层级回调。
+ */
+void tvmrt_pager_attach(tvmrt_pager_t* pager, tvmrt_context_t* ctx);
+
+/**
+ * @brief 关闭分页器，停止 I/O 线程并解除映射
+ */
+void tvmrt_pager_close(tvmrt_pager_t* pager);
+
+// ============================================================
+// Workspace 内存池 (Arena)
+// ============================================================
+//
+// 以页为单位一次性映射的线性分配器，用于承载大尺寸 workspace 与常量区。
+// 支持缓存行/页对齐、透明大页或显式大页 (hugetlb)，并可在 prepare
+// 阶段预先触发缺页，避免首次推理承担缺页开销。
+
+typedef enum {
+    TVMRT_HUGEPAGE_NONE = 0,        // 普通页
+    TVMRT_HUGEPAGE_TRANSPARENT = 1, // 透明大页 (madvise)
+    TVMRT_HUGEPAGE_EXPLICIT = 2     // 显式大页 (hugetlb), 不可用时回退到透明大页
+} tvmrt_hugepage_mode_t;
+
+/** 对齐方式: 页对齐 */
+#define TVMRT_ARENA_ALIGN_PAGE 0
+
+struct tvmrt_arena {
+    uint8_t* base;
+    uint64_t capacity;
+    uint64_t used;
+    uint64_t page_size;             // 实际生效的页大小 (大页模式下为大页大小)
+    tvmrt_hugepage_mode_t hugepage; // 实际生效的大页模式 (可能因回退而不同于请求)
+};
+
+/**
+ * @brief 创建内存池
+ *
+ * @param capacity 容量 (按页大小向上取整)
+ * @param hugepage 请求的大页模式
+ * @return 成功返回 0
+ */
+int tvmrt_arena_init(tvmrt_arena_t* arena, uint64_t capacity, tvmrt_hugepage_mode_t hugepage);
+
+/**
+ * @brief 从内存池分配
+ *
+ * @param align 对齐字节数 (2 的幂)，TVMRT_ARENA_ALIGN_PAGE 表示按页对齐
+ * @return 成功返回指针，空间不足返回 NULL
+ */
+void* tvmrt_arena_alloc(tvmrt_arena_t* arena, uint64_t size, uint64_t align);
+
+/**
+ * @brief 预先触发已分配区间的缺页 (逐页写入)
+ */
+void tvmrt_arena_prefault(tvmrt_arena_t* arena);
+
+/**
+ * @brief 在内存池中准备运行时上下文
+ *
+ * 分配页对齐的 workspace；若给出 const_src，则将常量区拷贝到缓存行对齐的
+ * 池内区间。prefault 为 true 时预先触发缺页。成功后设置
+ * ctx->workspace / ctx->const_workspace。
+ * @return 成功返回 0
+ */
+int tvmrt_arena_prepare_context(
+    tvmrt_arena_t* arena,
+    tvmrt_context_t* ctx,
+    uint64_t workspace_size,
+    const uint8_t* const_src,
+    uint64_t const_size,
+    bool prefault
+);
+
+/**
+ * @brief 释放内存池
+ */
+void tvmrt_arena_destroy(tvmrt_arena_t* arena);
+
+// ============================================================
+// 内存规划 (Memory Planning)
+// ============================================================
+//
+// 按调度表推导每个 SID 的生命周期 [首次访问层, 末次访问层]，生命周期
+// 相交的张量不得共享字节，其余按大小降序首次适配复用同一区间。
+
+/**
+ * @brief 按张量的新存储类型换算映射表中的字节数 (元素数不变)
+ *
+ * 用于把部分张量改为 fp16/bf16 存放: dtypes[i] 为第 i 项的新类型，结果
+ * 写入 out_map (可与 map 相同) 后再经 tvmrt_memory_plan 重新排布偏移。
+ * @return 成功返回 0，字节数不是元素大小整数倍返回 -1
+ */
+int tvmrt_tensor_map_retype(
+    const tvmrt_tensor_map_entry_t* map,
+    int32_t count,
+    const tvmrt_dtype_t* dtypes,
+    tvmrt_tensor_map_entry_t* out_map
+);
+
+/**
+ * @brief 为模型的张量映射表重新规划 workspace 偏移
+ *
+ * 按需调用: 默认路径 (default_lib0/default_lib1) 仍使用生成器写好的偏移与
+ * 固定大小的 global_workspace。调用方规划后把 out_map 作为 model->tensor_map、
+ * 按 out_ws_size 分配 workspace，再绑定参数。
+ *
+ * @param model 提供 tensor_map (SID/大小/对齐)、op_descs 与 schedule
+ * @param separation 0 = 紧凑排布；64/128 等 2 的幂 = 多算子层中各算子的
+ *                   输出独占整块 separation 字节 (缓存行/扇区)，避免并发
+ *                   写入落在同一缓存行 (伪共享)
+ * @param out_map 输出映射表 (model->tensor_count 项，SID 顺序与输入一致)
+ * @param out_ws_size 规划后的 workspace 字节数
+ * @return 成功返回 0，参数非法或内存不足返回 -1
+ */
+int tvmrt_memory_plan(
+    const tvmrt_model_desc_t* model,
+    int32_t separation,
+    tvmrt_tensor_map_entry_t* out_map,
+    int32_t* out_ws_size
+);
+
+// ============================================================
+// 量化 (int8)
+// ============================================================
+//
+// 量化算子的属性、偏置、权重或查找表放在算子自身的常量区，算子描述以
+// TVMRT_SID_CONST 作为最后一个输入引用它，包装函数由此取得属性块。
+// 形状字段与常量布局由模型生成器写入; tvmrt_quant_prepare_op() 再根据
+// 张量映射表 (及 weight_quant) 中的量化参数补全重量化字段。
+// 累加一律为 int32，结尾经定点乘数重量化到输出尺度并钳位。
+
+/** 逐元素加法/激活先左移该位数再重量化，保留输入尺度差异带来的精度 */
+#define TVMRT_QUANT_LEFT_SHIFT 20
+
+/** 定点重量化: x * real ≈ (x * multiplier) >> (31 + shift)，multiplier ∈ [2^30, 2^31) */
+typedef struct {
+    int32_t multiplier;
+    int32_t shift;
+} tvmrt_requant_t;
+
+typedef enum {
+    TVMRT_QOP_QUANTIZE = 0,     // fp32 -> int8 (输出张量的量化参数)
+    TVMRT_QOP_DEQUANTIZE = 1,   // int8 -> fp32 (输入张量的量化参数)
+    TVMRT_QOP_ADD = 2,
+    TVMRT_QOP_MUL = 3,
+    TVMRT_QOP_RELU = 4,
+    TVMRT_QOP_RELU6 = 5,
+    TVMRT_QOP_SIGMOID = 6,      // 256 项查找表
+    TVMRT_QOP_TANH = 7,         // 256 项查找表
+    TVMRT_QOP_MATMUL = 8,
+    TVMRT_QOP_MATMUL_RELU = 9   // MatMul + 融合 ReLU (仅收紧钳位区间)
+} tvmrt_qop_kind_t;
+
+/**
+ * 算子常量区起始处的属性块 (fp32 矢量算子同样使用其中的形状字段)
+ *
+ * MatMul: [M,K] x [K,N] -> [M,N]，权重按行主序 [K,N] 存放; 偏置为 N 个
+ * int32 (fp32 版本为 float)，尺度为 输入尺度 × 权重尺度、零点为 0。
+ */
+typedef struct {
+    // 形状与常量布局 (模型生成器写入)
+    int32_t count;              // 逐元素算子元素数; MatMul 为 M
+    int32_t n;                  // MatMul 输出列数
+    int32_t k;                  // MatMul 规约维
+    int32_t weight_offset;      // 权重/查找表相对属性块起点的字节偏移
+    int32_t bias_offset;        // 偏置相对属性块起点的字节偏移 (0 = 无偏置)
+    // 量化字段 (tvmrt_quant_prepare_op 填充)
+    float scale;                // 量化/反量化算子使用的尺度
+    int32_t in_zp[2];
+    int32_t weight_zp;
+    int32_t out_zp;
+    tvmrt_requant_t in_rq[2];   // 加法: 各输入到公共中间尺度
+    tvmrt_requant_t out_rq;     // int32 累加结果到输出尺度
+    int32_t act_min;            // 输出钳位 (量化域, 含融合激活)
+    int32_t act_max;
+    // 存储类型 (fp32 矢量算子加载/写回时转换; 零初始化即 fp32)
+    tvmrt_dtype_t in_dtype[2];  // tvmrt_storage_prepare_op 按张量映射表填充
+    tvmrt_dtype_t out_dtype;    // 同上
+    tvmrt_dtype_t weight_dtype; // 权重与偏置 (模型生成器写入权重时一并写入)
+} tvmrt_qattrs_t;
+
+/**
+ * @brief 把正实数乘子分解为定点乘数与移位
+ * @return 成功返回 0，real 非正或过大 (>= 2^30) 返回 -1
+ */
+int tvmrt_quant_multiplier(double real, tvmrt_requant_t* out);
+
+/**
+ * @brief 按张量映射表的量化参数补全算子属性块的量化字段
+ *
+ * 属性块位于 const_workspace + op_descs[op_idx].const_offset，其形状字段须
+ * 已写好。SIGMOID/TANH 同时在 weight_offset (为 0 时取属性块之后) 处生成
+ * 256 字节查找表，调用方需保证常量区足够。
+ * @return 成功返回 0，张量不在映射表、类型不符或参数无效返回 -1
+ */
+int tvmrt_quant_prepare_op(
+    const tvmrt_model_desc_t* model,
+    int32_t op_idx,
+    tvmrt_qop_kind_t kind,
+    uint8_t* const_workspace
+);
+
+// ============================================================
+// 半精度存储 (fp16 / bf16)
+// ============================================================
+//
+// workspace 张量与常量可按张量以 fp16/bf16 存放，计算仍为 fp32: 矢量算子
+// 分块加载时转换为 fp32，写回时再转换。转换按运行时检测到的 CPU 特性
+// 选择 F16C / AVX-512-BF16 指令，不支持时使用标量实现 (舍入均为就近偶数)。
+
+/** 元素字节数 */
+int32_t tvmrt_dtype_size(tvmrt_dtype_t dtype);
+
+/** @brief n 个 dtype 元素转换为 fp32 (dtype 为 FLOAT32/FLOAT16/BFLOAT16) */
+void tvmrt_convert_to_f32(const void* src, tvmrt_dtype_t dtype, float* dst, int32_t n);
+
+/** @brief n 个 fp32 转换为 dtype 元素 (dtype 为 FLOAT32/FLOAT16/BFLOAT16) */
+void tvmrt_convert_from_f32(const float* src, void* dst, tvmrt_dtype_t dtype, int32_t n);
+
+/**
+ * @brief 按张量映射表填充算子属性块的存储类型字段
+ *
+ * 属性块位于 const_workspace + op_descs[op_idx].const_offset。输入输出按
+ * 张量映射表的 dtype 填写，模型外部输入输出视为 fp32。
+ * @return 成功返回 0，参数无效返回 -1
+ */
+int tvmrt_storage_prepare_op(
+    const tvmrt_model_desc_t* model,
+    int32_t op_idx,
+    uint8_t* const_workspace
+);
+
+// ============================================================
+// 广播二元运算 (Broadcast Binary)
+// ============================================================
+//
+// fp32 逐元素二元运算按 NumPy 规则广播 (形状右对齐，长度为 1 的维扩展)，
+// 输入输出均可为带步长的视图。tvmrt_broadcast_prepare() 在准备阶段推导
+// 各张量的元素步长 (广播维为 0)，去掉长度为 1 的维并合并在三个张量中都
+// 连续的相邻维，结果写入算子常量区的属性块。内核逐行执行最内维，按其
+// 步长选择特化循环: 连续、标量广播 (一侧步长为 0)，其余为通用步长循环。
+// 行广播 ([N,C] + [C]) 合并后为外层步长 0、最内维连续，列广播
+// ([N,C] + [N,1]) 为最内维标量广播。
+
+/** 广播运算支持的最大维数 */
+#define TVMRT_BCAST_MAX_DIMS 6
+
+typedef enum {
+    TVMRT_BINARY_ADD = 0,
+    TVMRT_BINARY_SUB = 1,
+    TVMRT_BINARY_MUL = 2,
+    TVMRT_BINARY_DIV = 3,
+    TVMRT_BINARY_MAX = 4,
+    TVMRT_BINARY_MIN = 5
+} tvmrt_binary_kind_t;
+
+/** 张量视图: 形状与元素步长 */
+typedef struct {
+    int32_t rank;
+    int32_t shape[TVMRT_BCAST_MAX_DIMS];
+    const int32_t* strides;     // NULL = 按形状行主序连续
+} tvmrt_view_t;
+
+/** 广播二元算子的属性块 (算子常量区起始处，以 TVMRT_SID_CONST 引用) */
+typedef struct {
+    int32_t kind;               // tvmrt_binary_kind_t
+    int32_t rank;               // 合并后的维数 (>= 1)
+    int32_t shape[TVMRT_BCAST_MAX_DIMS];        // 合并后的输出形状
+    int32_t a_strides[TVMRT_BCAST_MAX_DIMS];    // 元素步长, 广播维为 0
+    int32_t b_strides[TVMRT_BCAST_MAX_DIMS];
+    int32_t out_strides[TVMRT_BCAST_MAX_DIMS];
+} tvmrt_bcast_attrs_t;
+
+/**
+ * @brief 推导广播步长并合并维度，填写属性块
+ *
+ * @param out 输出视图；NULL 时为广播形状的连续张量
+ * @return 成功返回 0，形状不可广播、输出形状不符或维数超过
+ *         TVMRT_BCAST_MAX_DIMS 返回 -1
+ */
+int tvmrt_broadcast_prepare(
+    tvmrt_bcast_attrs_t* attrs,
+    tvmrt_binary_kind_t kind,
+    const tvmrt_view_t* a,
+    const tvmrt_view_t* b,
+    const tvmrt_view_t* out
+);
+
+// ============================================================
+// 归约 (Reduction)
+// ============================================================
+//
+// fp32 Sum / Max / Min / ArgMax，可对任意若干维归约，输入可为带步长视图，
+// 输出为保留维按原顺序排列的连续张量。tvmrt_reduce_prepare() 去掉长度为
+// 1 的维、分别合并可连续寻址的保留维与归约维。最内维连续的一侧决定内层
+// 循环: 归约维连续时按 16 路分道累加，保留维连续时一次处理一段输出。
+//
+// 结果与线程数无关: 被归约的元素按行主序展平后切成 TVMRT_REDUCE_BLOCK
+// 个一块，块内次序固定，块间按固定的二叉树合并 (在不超过块数的最大 2 的
+// 幂处二分)。大规模归约拆成多个部分算子 (part = 0..parts-1，各自计算一段
+// 按 2 的幂对齐的块组，可在一层中并行执行) 与一个合并算子 (部分值按同一棵
+// 树合并)，结果与单算子执行逐位一致，与部分数、执行次序和 Worker 数无关。
+// ArgMax 返回最大值首次出现的位置 (被归约各维的行主序展平下标，int32)。
+
+/** 归约块长 (元素数): 决定求和次序，模型生成后不可改变 */
+#define TVMRT_REDUCE_BLOCK 256
+
+typedef enum {
+    TVMRT_REDUCE_SUM = 0,
+    TVMRT_REDUCE_MAX = 1,
+    TVMRT_REDUCE_MIN = 2,
+    TVMRT_REDUCE_ARGMAX = 3
+} tvmrt_reduce_kind_t;
+
+/** ArgMax 部分值 (其余归约的部分值为 float) */
+typedef struct {
+    float value;
+    int32_t index;
+} tvmrt_argmax_t;
+
+/** 归约算子的属性块 (算子常量区起始处，以 TVMRT_SID_CONST 引用) */
+typedef struct {
+    int32_t kind;                                   // tvmrt_reduce_kind_t
+    int32_t keep_rank;                              // 合并后的保留维 (0 = 全部归约)
+    int32_t keep_shape[TVMRT_BCAST_MAX_DIMS];
+    int32_t keep_strides[TVMRT_BCAST_MAX_DIMS];     // 输入中的元素步长
+    int32_t red_rank;                               // 合并后的归约维 (>= 1)
+    int32_t red_shape[TVMRT_BCAST_MAX_DIMS];
+    int32_t red_strides[TVMRT_BCAST_MAX_DIMS];
+    int32_t outputs;                                // 输出元素数
+    int32_t reduce_count;                           // 每个输出归约的元素数
+    int32_t blocks;                                 // 块数
+    int32_t group_blocks;                           // 每个部分的块数 (2 的幂)
+    int32_t parts;                                  // 部分数
+    int32_t part;                                   // -1 = 单算子直接写出结果，否则为本部分下标
+} tvmrt_reduce_attrs_t;
+
+/**
+ * @brief 合并维度并按最多 max_parts 个部分切分归约，填写属性块
+ *
+ * 返回后 attrs->part 为 -1 (单算子)。拆分执行时部分算子的属性块为其副本、
+ * part 依次为 0..parts-1，输出为部分值张量 (tvmrt_reduce_partial_bytes 字节，
+ * 各部分写入自己的一段); 合并算子使用 part = -1 的属性块，输入为部分值张量。
+ * @param axes 被归约的维 (可为负数，-1 为最后一维)，不得重复
+ * @param max_parts 部分数上限 (<= 1 不拆分)
+ * @return 成功返回 0，维度越界/重复、没有归约维或元素数为 0 返回 -1
+ */
+int tvmrt_reduce_prepare(
+    tvmrt_reduce_attrs_t* attrs,
+    tvmrt_reduce_kind_t kind,
+    const tvmrt_view_t* in,
+    const int32_t* axes,
+    int32_t axis_count,
+    int32_t max_parts
+);
+
+/** @brief 部分值张量的字节数 (parts × outputs 个部分值) */
+int64_t tvmrt_reduce_partial_bytes(const tvmrt_reduce_attrs_t* attrs);
+
+// ============================================================
+// 卷积与池化 (Conv2D / Pooling, NHWC)
+// ============================================================
+//
+// 输入输出为 NHWC 连续 fp32 张量，卷积权重为 [kh, kw, c, k] (HWIO)，即
+// [kh*kw*c, k] 的行主序矩阵。卷积有两条路径，由 tvmrt_conv2d_prepare()
+// 选定:
+// - im2col + GEMM: 每次把 TVMRT_CONV_PANEL 个输出像素的感受野 (填充处为 0)
+//   展开为连续行，再与权重做分块矩阵乘。展开行所需的临时区是算子的第 2 个
+//   输出张量 (scratch_bytes 字节)，由内存规划在 workspace 中分配并与其他
+//   张量复用，运行期不分配。
+// - 直接卷积: 逐个卷积核位置直接读取输入像素的通道向量，无临时区; 每个
+//   卷积核位置只做长 c 的一段规约，且各输出像素分属不相邻的输入行。
+// AUTO 按输出通道数选择: 展开每个像素的 kh*kw*c 个元素要分摊到 k 个输出
+// 通道上，k >= TVMRT_CONV_IM2COL_MIN_K 时展开开销可忽略，连续的交错面板
+// 使 im2col 在 bench_runtime conv 的各层形状 (含 3 通道首层、1x1 与步长 2)
+// 上约快 1.2-1.5 倍; 输出通道更少时两者相当，选不需要临时区的直接卷积。
+// 两条路径都按若干输出像素 × 一段输出通道分块累加，按输出通道矢量化。
+// 池化在通道维上矢量化; 窗口越出输入的位置不参与 Max，AvgPool 默认不计入
+// 除数 (count_include_pad = 1 时除数固定为 kh*kw)。
+
+/** im2col 每次展开的输出像素数 (决定临时区大小) */
+#define TVMRT_CONV_PANEL 64
+
+/** AUTO: 输出通道数不少于该值时走 im2col，否则走直接卷积 */
+#define TVMRT_CONV_IM2COL_MIN_K 32
+
+typedef enum {
+    TVMRT_CONV_AUTO = 0,        // 由 tvmrt_conv2d_prepare 按形状选择
+    TVMRT_CONV_IM2COL = 1,
+    TVMRT_CONV_DIRECT = 2
+} tvmrt_conv_algo_t;
+
+typedef enum {
+    TVMRT_POOL_MAX = 0,
+    TVMRT_POOL_AVG = 1
+} tvmrt_pool_kind_t;
+
+/** 滑动窗口几何 (卷积与池化共用) */
+typedef struct {
+    int32_t n, h, w, c;         // 输入 NHWC
+    int32_t kh, kw;             // 窗口
+    int32_t stride_h, stride_w;
+    int32_t pad_top, pad_bottom, pad_left, pad_right;
+} tvmrt_window2d_t;
+
+/** 卷积属性块 (算子常量区起始处，其后依次为权重与偏置，各 64 字节对齐) */
+typedef struct {
+    tvmrt_window2d_t win;
+    int32_t out_h, out_w;
+    int32_t k;                  // 输出通道数
+    int32_t algo;               // tvmrt_conv_algo_t (已选定，不为 AUTO)
+    int32_t weight_offset;      // 权重相对属性块起点的字节偏移
+    int32_t bias_offset;        // 偏置 [k] 的字节偏移 (0 = 无偏置)
+    int32_t const_bytes;        // 属性块 + 权重 + 偏置的总字节数 (算子 const_size)
+    int32_t scratch_bytes;      // im2col 临时区字节数 (0 = 不需要第 2 个输出)
+    float act_min;              // 输出钳位 (融合 ReLU / ReLU6; 默认不钳位)
+    float act_max;
+} tvmrt_conv2d_attrs_t;
+
+/** 池化属性块 */
+typedef struct {
+    tvmrt_window2d_t win;
+    int32_t out_h, out_w;
+    int32_t kind;               // tvmrt_pool_kind_t
+    int32_t count_include_pad;  // AvgPool: 1 = 除数计入填充位置
+} tvmrt_pool2d_attrs_t;
+
+/**
+ * @brief 推导输出尺寸、选择卷积路径并填写属性块
+ *
+ * 权重紧随属性块 (weight_offset)，有偏置时偏置在权重之后 (bias_offset)，
+ * 调用方按这两个偏移写入常量区。act_min/act_max 初始化为 ∓INFINITY。
+ * @param algo TVMRT_CONV_AUTO 时按输出通道数选择 (见 TVMRT_CONV_IM2COL_MIN_K)
+ * @return 成功返回 0，尺寸非法 (输出为空、填充不小于窗口) 返回 -1
+ */
+int tvmrt_conv2d_prepare(
+    tvmrt_conv2d_attrs_t* attrs,
+    const tvmrt_window2d_t* win,
+    int32_t out_channels,
+    bool bias,
+    tvmrt_conv_algo_t algo
+);
+
+/** @brief 推导池化输出尺寸并填写属性块 (返回值同 tvmrt_conv2d_prepare) */
+int tvmrt_pool2d_prepare(
+    tvmrt_pool2d_attrs_t* attrs,
+    tvmrt_pool_kind_t kind,
+    const tvmrt_window2d_t* win
+);
+
+// ============================================================
+// 稀疏权重 MatMul (CSR / 块稀疏)
+// ============================================================
+//
+// 剪枝模型的 MatMul 权重大部分为 0，却仍按稠密 [K,N] 存放在常量区。
+// tvmrt_sparse_init() 在准备阶段检查每个 fp32 MatMul 算子的权重密度，低于
+// 阈值的转换为稀疏格式 (另行分配，原常量区不变)，并把该算子参数中的属性块
+// 指针与执行函数换成稀疏内核。两种格式:
+// - 块稀疏 (BSR): 以同一规约行上相邻 TVMRT_SPARSE_BLOCK_COLS 个输出列为
+//   一块，只存非零块; 内核对每块做与稠密 MatMul 相同的定长矢量累加，零块
+//   整体跳过。适合按输出通道/列组的结构化剪枝。
+// - CSR: 逐个非零元素记录列号; 内核一次处理 8 个输入行，按行矢量化。适合
+//   非结构化剪枝。
+// 两者都按 TVMRT_SPARSE_PANEL 个输出列分面板、面板内按规约行 t 排列，内核
+// 按面板 × 8 行分块累加，只是省去零项; 每个输出元素与稠密 MatMul 一样从
+// 偏置起按 t 递增累加，有限值输入下结果与稠密内核相同。
+//
+// 自动选择: 元素密度不超过 csr_max_density 且不超过块密度的
+// TVMRT_SPARSE_CSR_RATIO 倍 (零元素散布在块内) 时用 CSR; 否则块密度不超过
+// bsr_max_density 用 BSR; 否则元素密度不超过 csr_max_density 用 CSR，
+// 否则保持稠密。默认阈值按 bench_runtime sparse 的测量取 ([32,1024] x
+// [1024,1024]): 稠密内核 (fp32 寄存器分块) 约在元素密度 0.5 处被 CSR 追上，
+// 块剪枝时 BSR 约在块密度 0.4 处追上; 再往上转换既不更快，又要多占一份
+// 常量区 (CSR 每个非零元素 8 字节，BSR 每块 68 字节，原稠密权重仍保留)。
+// 阈值设为 TVMRT_SPARSE_NEVER 时该格式永不自动选用。
+
+/** 面板宽度 (输出列数，与稠密 MatMul 的列分块相同) */
+#define TVMRT_SPARSE_PANEL 64
+
+/** 块稀疏格式的块宽 (输出列数) */
+#define TVMRT_SPARSE_BLOCK_COLS 16
+
+/** 默认阈值: 块密度 / 元素密度不超过该值时转换 */
+#define TVMRT_SPARSE_BSR_DENSITY 0.4f
+#define TVMRT_SPARSE_CSR_DENSITY 0.5f
+
+/** 阈值取该值 (任何负数) 时永不自动选用对应格式; 0 表示用默认阈值 */
+#define TVMRT_SPARSE_NEVER (-1.0f)
+
+/** 元素密度不超过块密度的该倍数时 CSR 优先于 BSR */
+#define TVMRT_SPARSE_CSR_RATIO 0.75f
+
+typedef enum {
+    TVMRT_SPARSE_AUTO = 0,      // 按密度阈值选择
+    TVMRT_SPARSE_CSR = 1,
+    TVMRT_SPARSE_BSR = 2,
+    TVMRT_SPARSE_DENSE = 3      // 不转换
+} tvmrt_sparse_format_t;
+
+/**
+ * 稀疏权重块 (替代 tvmrt_qattrs_t 作为稀疏 MatMul 的属性块)
+ *
+ * 其后依次为 (各 64 字节对齐): ptr[panels * k + 1] (面板 p、规约行 t 的
+ * 项为 [ptr[p*k+t], ptr[p*k+t+1])), idx[nnz] (面板内列号 / 块号),
+ * values (CSR 每项 1 个、BSR 每项 TVMRT_SPARSE_BLOCK_COLS 个 float),
+ * 以及可选的偏置 [n]。
+ */
+typedef struct {
+    int32_t format;             // TVMRT_SPARSE_CSR / TVMRT_SPARSE_BSR
+    int32_t m, n, k;            // [M,K] x [K,N]
+    int32_t panels;
+    int32_t nnz;                // 非零元素数 (CSR) / 非零块数 (BSR)
+    int32_t ptr_offset;         // 相对本结构起点的字节偏移
+    int32_t idx_offset;
+    int32_t val_offset;
+    int32_t bias_offset;        // 0 = 无偏置
+    int32_t bytes;              // 整块字节数
+} tvmrt_sparse_attrs_t;
+
+typedef struct {
+    tvmrt_sparse_format_t format;   // AUTO 按阈值; CSR/BSR 强制转换所有可转换算子
+    float csr_max_density;          // 0 = TVMRT_SPARSE_CSR_DENSITY，TVMRT_SPARSE_NEVER = 不用 CSR
+    float bsr_max_density;          // 0 = TVMRT_SPARSE_BSR_DENSITY，TVMRT_SPARSE_NEVER = 不用 BSR
+    tvmrt_op_func_t dense;          // 参与转换的稠密 MatMul 执行函数
+    tvmrt_op_func_t csr;            // 稀疏内核 (参数同稠密 MatMul，属性块为稀疏权重块)
+    tvmrt_op_func_t bsr;
+    const tvmrt_tune_kernel_t* tune_kernel; // 可选: 稠密 MatMul 的调优候选组 (用于检查调用次序)
+} tvmrt_sparse_config_t;
+
+typedef struct {
+    int32_t csr;                // 转为 CSR 的算子数
+    int32_t bsr;                // 转为 BSR 的算子数
+    int32_t dense;              // 密度过高保持稠密的算子数
+    int64_t dense_bytes;        // 被转换算子原稠密权重的字节数
+    int64_t sparse_bytes;       // 转换后稀疏权重块的字节数
+    void* storage;              // 单块分配 (所有稀疏权重块)
+} tvmrt_sparse_t;
+
+/**
+ * @brief 权重密度
+ *
+ * @param dense fp32 MatMul 属性块 (常量区中，权重与偏置为 fp32)
+ * @param format CSR 返回元素密度，BSR 返回块密度
+ * @return [0, 1]，参数无效返回 -1
+ */
+float tvmrt_sparse_density(const tvmrt_qattrs_t* dense, tvmrt_sparse_format_t format);
+
+/** @brief 按阈值选择格式 (返回 CSR / BSR / DENSE; config 为 NULL 时用默认阈值) */
+tvmrt_sparse_format_t tvmrt_sparse_choose(
+    const tvmrt_qattrs_t* dense,
+    const tvmrt_sparse_config_t* config
+);
+
+/**
+ * @brief 把稠密权重转换为稀疏权重块
+ *
+ * @param out 目标 (64 字节对齐)；为 NULL 或 capacity 不足时只计算大小
+ * @return 所需字节数，参数无效或权重不是 fp32 返回 -1
+ */
+int64_t tvmrt_sparse_pack(
+    const tvmrt_qattrs_t* dense,
+    tvmrt_sparse_format_t format,
+    tvmrt_sparse_attrs_t* out,
+    int64_t capacity
+);
+
+/**
+ * @brief 为已绑定参数的上下文转换稀疏权重
+ *
+ * 执行函数为 config->dense、输入输出与权重均为 fp32 存储的算子参与转换:
+ * 该算子参数的属性块指针 (inputs[1]) 改指稀疏权重块，执行函数改为
+ * config->csr / config->bsr。须在 tvmrt_tune 与编译执行计划之前调用:
+ * 给出 config->tune_kernel 时，若有可转换算子的执行函数已是其中 dense
+ * 以外的候选 (说明 tvmrt_tune 已先运行)，返回 -1 而不是跳过该算子。
+ * sp 须在 ctx 不再执行后才能释放。
+ * @return 成功返回 0，参数无效、调用次序错误或内存不足返回 -1 (ctx 不变)
+ */
+int tvmrt_sparse_init(
+    tvmrt_sparse_t* sp,
+    tvmrt_context_t* ctx,
+    const tvmrt_sparse_config_t* config
+);
+
+/** @brief 释放稀疏权重块 */
+void tvmrt_sparse_destroy(tvmrt_sparse_t* sp);
+
+// ============================================================
+// Softmax 与 LayerNorm
+// ============================================================
+//
+// fp32 [rows, cols] 连续张量沿最后一维逐行归一化，每个算子一个内核，每行
+// 只读两遍 (统计一遍、写出一遍; 行通常仍在缓存中)，不产生中间张量:
+// - Softmax: 在线求最大值与指数和 (最大值增大时把已累加的和按
+//   exp(旧最大值 - 新最大值) 缩放，每个元素只算一次指数)，再写出
+//   exp(x - max) / sum。
+// - LayerNorm: 对减去行首元素后的数据 Welford 递推均值与二阶中心矩 (大均值
+//   小方差时不损失精度)，再写出 (x - mean) / sqrt(var + eps) * gamma + beta
+//   (方差为总体方差)。
+// 两者都按 16 路分道矢量化 (分道各自累计，最后按固定次序合并)，指数用
+// 可矢量化的多项式近似 (相对误差约 1e-7)。输出可与输入为同一张量。
+
+typedef enum {
+    TVMRT_NORM_SOFTMAX = 0,
+    TVMRT_NORM_LAYERNORM = 1
+} tvmrt_norm_kind_t;
+
+/** 归一化属性块 (算子常量区起始处；LayerNorm 的 gamma/beta 紧随其后) */
+typedef struct {
+    int32_t kind;               // tvmrt_norm_kind_t
+    int32_t rows;
+    int32_t cols;               // 归一化维长度
+    float eps;                  // LayerNorm 方差偏置
+    int32_t gamma_offset;       // gamma [cols] 相对属性块起点的字节偏移 (0 = 无仿射)
+    int32_t beta_offset;        // beta [cols] 的字节偏移 (0 = 无仿射)
+    int32_t const_bytes;        // 属性块 + gamma + beta 的总字节数 (算子 const_size)
+} tvmrt_norm_attrs_t;
+
+/** @brief 填写 Softmax 属性块 (rows 或 cols < 1 返回 -1) */
+int tvmrt_softmax_prepare(tvmrt_norm_attrs_t* attrs, int32_t rows, int32_t cols);
+
+/**
+ * @brief 填写 LayerNorm 属性块
+ *
+ * affine 为 true 时 gamma、beta (各 cols 个 float，64 字节对齐) 依次位于
+ * 属性块之后，调用方按 gamma_offset/beta_offset 写入常量区。
+ * @return 成功返回 0，形状非法或 eps < 0 返回 -1
+ */
+int tvmrt_layernorm_prepare(
+    tvmrt_norm_attrs_t* attrs,
+    int32_t rows,
+    int32_t cols,
+    float eps,
+    bool affine
+);
+
 // ============================================================
 // 语义转换层 API
 // ============================================================
@@ -436,10 +1925,32 @@ int tvmrt_engine_run_single(
 /**
  * @brief 根据模型描述填充匹配的运行时上下文
  * 
- * 暂未使用（已通过 model_fill_args 简化）
+ * 调用前 ctx->op_execs 与 ctx->args_storage 需指向至少 op_count 个元素
+ * 的数组。为每个算子设置名称、CPU 函数表入口及 &args_storage[i]。
+ * @return 成功返回 0，函数表索引越界返回 -1
  */
 int tvmrt_semantic_init(tvmrt_context_t* ctx, const tvmrt_model_desc_t* desc);
 
+/**
+ * @brief 按算子描述生成统一参数区
+ *
+ * 对每个算子，将 input_sids/output_sids 经张量映射表解析为 workspace
+ * 指针；TVMRT_SID_INPUT(i)/TVMRT_SID_OUTPUT(i) 解析为外部缓冲区，
+ * TVMRT_SID_CONST 解析为该算子的常量区。
+ * @param args 连续参数区, 至少 desc->op_count 个元素
+ * @return 成功返回 0，存在无法解析的 SID 返回 -1
+ */
+int tvmrt_semantic_bind_args(
+    const tvmrt_model_desc_t* desc,
+    tvmrt_op_args_t* args,
+    void* const* inputs,
+    int32_t input_count,
+    void* const* outputs,
+    int32_t output_count,
+    uint8_t* workspace,
+    const uint8_t* const_workspace
+);
+
 /**
  * @brief 根据 SID 解析为 workspace 指针
  * 
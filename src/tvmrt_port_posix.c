@@ -6,8 +6,25 @@
  * 适用于 Linux、macOS 等 POSIX 兼容系统。
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE     // sched_getaffinity / CPU_COUNT
+#endif
 #include "tvmrt.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sched.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#include <unistd.h>
 
 // 类型定义现在通过条件编译在 tvmrt_port.h 中提供
 
@@ -40,9 +57,41 @@ void tvmrt_mutex_destroy(tvmrt_mutex_t* m) {
 // 条件变量实现
 // ============================================================
 
+// 超时以单调时钟计 (与 tvmrt_time_ns 一致)
+static int port_cond_init(pthread_cond_t* c) {
+#ifdef __linux__
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    int rc = pthread_cond_init(c, &attr);
+    pthread_condattr_destroy(&attr);
+    return rc;
+#else
+    return pthread_cond_init(c, NULL);
+#endif
+}
+
+// 以 tvmrt_time_ns 计的截止时刻换算为 pthread_cond_timedwait 的绝对时间
+static struct timespec port_deadline(uint64_t deadline_ns) {
+    struct timespec ts;
+#ifdef __linux__
+    ts.tv_sec = (time_t)(deadline_ns / 1000000000ull);
+    ts.tv_nsec = (long)(deadline_ns % 1000000000ull);
+#else
+    // 条件变量使用实时时钟: 换算为相对时间
+    uint64_t now = tvmrt_time_ns();
+    uint64_t rel = (deadline_ns > now) ? deadline_ns - now : 0;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    uint64_t abs_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec + rel;
+    ts.tv_sec = (time_t)(abs_ns / 1000000000ull);
+    ts.tv_nsec = (long)(abs_ns % 1000000000ull);
+#endif
+    return ts;
+}
+
 int tvmrt_cond_init(tvmrt_cond_t* c) {
     if (!c) return TVMRT_ERR_GENERIC;
-    return (pthread_cond_init(&c->handle, NULL) == 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
+    return (port_cond_init(&c->handle) == 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
 }
 
 int tvmrt_cond_wait(tvmrt_cond_t* c, tvmrt_mutex_t* m) {
@@ -50,6 +99,14 @@ int tvmrt_cond_wait(tvmrt_cond_t* c, tvmrt_mutex_t* m) {
     return (pthread_cond_wait(&c->handle, &m->handle) == 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
 }
 
+int tvmrt_cond_timedwait(tvmrt_cond_t* c, tvmrt_mutex_t* m, uint64_t deadline_ns) {
+    if (!c || !m) return TVMRT_ERR_GENERIC;
+    struct timespec ts = port_deadline(deadline_ns);
+    int rc = pthread_cond_timedwait(&c->handle, &m->handle, &ts);
+    if (rc == ETIMEDOUT) return TVMRT_ERR_TIMEOUT;
+    return (rc == 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
+}
+
 int tvmrt_cond_signal(tvmrt_cond_t* c) {
     if (!c) return TVMRT_ERR_GENERIC;
     return (pthread_cond_signal(&c->handle) == 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
@@ -80,6 +137,10 @@ int tvmrt_thread_join(tvmrt_thread_t* t) {
     return (pthread_join(t->handle, NULL) == 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
 }
 
+void tvmrt_thread_yield(void) {
+    sched_yield();
+}
+
 // ============================================================
 // 屏障实现 (用于 BSP 同步)
 // ============================================================
@@ -90,7 +151,7 @@ int tvmrt_barrier_init(tvmrt_barrier_t* b) {
     if (pthread_mutex_init(&b->mutex, NULL) != 0) {
         return TVMRT_ERR_GENERIC;
     }
-    if (pthread_cond_init(&b->cond, NULL) != 0) {
+    if (port_cond_init(&b->cond) != 0) {
         pthread_mutex_destroy(&b->mutex);
         return TVMRT_ERR_GENERIC;
     }
@@ -126,9 +187,495 @@ void tvmrt_barrier_sync(tvmrt_barrier_t* b) {
     pthread_mutex_unlock(&b->mutex);
 }
 
+int tvmrt_barrier_timedsync(tvmrt_barrier_t* b, uint64_t deadline_ns) {
+    if (!b) return TVMRT_ERR_GENERIC;
+    struct timespec ts = port_deadline(deadline_ns);
+    int ret = TVMRT_OK;
+    pthread_mutex_lock(&b->mutex);
+    while (b->count < b->target) {
+        if (pthread_cond_timedwait(&b->cond, &b->mutex, &ts) == ETIMEDOUT) {
+            ret = (b->count < b->target) ? TVMRT_ERR_TIMEOUT : TVMRT_OK;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&b->mutex);
+    return ret;
+}
+
 void tvmrt_barrier_destroy(tvmrt_barrier_t* b) {
     if (b) {
         pthread_mutex_destroy(&b->mutex);
         pthread_cond_destroy(&b->cond);
     }
 }
+
+// ============================================================
+// 内存映射实现 (用于常量分页)
+// ============================================================
+
+uint64_t tvmrt_page_size(void) {
+    long sz = sysconf(_SC_PAGESIZE);
+    return (sz > 0) ? (uint64_t)sz : 4096u;
+}
+
+int tvmrt_file_map_readonly(const char* path, void** addr, uint64_t* size) {
+    if (!path || !addr || !size) return TVMRT_ERR_GENERIC;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return TVMRT_ERR_GENERIC;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return TVMRT_ERR_GENERIC;
+    }
+
+    // MAP_PRIVATE + PROT_READ: DONTNEED 后再次访问会从文件重新读入
+    void* p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // 映射建立后即可关闭 fd
+    if (p == MAP_FAILED) return TVMRT_ERR_GENERIC;
+
+    *addr = p;
+    *size = (uint64_t)st.st_size;
+    return TVMRT_OK;
+}
+
+void tvmrt_file_unmap(void* addr, uint64_t size) {
+    if (addr && size > 0) {
+        munmap(addr, (size_t)size);
+    }
+}
+
+int tvmrt_mem_advise(void* addr, uint64_t len, tvmrt_mem_advice_t advice) {
+    if (!addr || len == 0) return TVMRT_ERR_GENERIC;
+    int flag;
+    switch (advice) {
+        case TVMRT_ADVISE_WILLNEED: flag = MADV_WILLNEED; break;
+        case TVMRT_ADVISE_DONTNEED: flag = MADV_DONTNEED; break;
+        case TVMRT_ADVISE_HUGEPAGE:
+#ifdef MADV_HUGEPAGE
+            flag = MADV_HUGEPAGE;
+            break;
+#else
+            return TVMRT_ERR_GENERIC;
+#endif
+        default: return TVMRT_ERR_GENERIC;
+    }
+    return (madvise(addr, (size_t)len, flag) == 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
+}
+
+// ============================================================
+// 匿名页分配实现 (用于 workspace 内存池)
+// ============================================================
+
+uint64_t tvmrt_huge_page_size(void) {
+    uint64_t size = 0;
+#ifdef __linux__
+    // 透明大页的 PMD 大小 (AArch64 64K 基页时为 512MB)
+    FILE* f = fopen("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r");
+    if (f) {
+        unsigned long long v = 0;
+        if (fscanf(f, "%llu", &v) == 1 && v > 0 && (v & (v - 1)) == 0) {
+            size = (uint64_t)v;
+        }
+        fclose(f);
+    }
+#endif
+    // 读取失败时取 x86-64 / AArch64 (4K 基页) 的默认大页大小
+    return size ? size : (2u << 20);
+}
+
+int tvmrt_mem_map_anon(uint64_t size, bool explicit_huge, void** addr) {
+    if (!addr || size == 0) return TVMRT_ERR_GENERIC;
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (explicit_huge) {
+#ifdef MAP_HUGETLB
+        flags |= MAP_HUGETLB;
+#else
+        return TVMRT_ERR_GENERIC;
+#endif
+    }
+
+    void* p = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (p == MAP_FAILED) return TVMRT_ERR_GENERIC;
+
+    *addr = p;
+    return TVMRT_OK;
+}
+
+void tvmrt_mem_unmap(void* addr, uint64_t size) {
+    if (addr && size > 0) {
+        munmap(addr, (size_t)size);
+    }
+}
+
+// ============================================================
+// 堆分配实现
+// ============================================================
+
+void* tvmrt_mem_alloc(uint64_t size, uint64_t align) {
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+    void* addr = NULL;
+    if (posix_memalign(&addr, (size_t)align, (size_t)(size ? size : 1)) != 0) {
+        return NULL;
+    }
+    return addr;
+}
+
+void tvmrt_mem_free(void* addr) {
+    free(addr);
+}
+
+// ============================================================
+// 时钟实现
+// ============================================================
+
+uint64_t tvmrt_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================
+// CPU 探测实现
+// ============================================================
+
+#ifdef __linux__
+
+// 配额折算的 CPU 数 (向上取整); 无限制返回 0
+static int32_t port_quota_cpus(long long quota, long long period) {
+    if (quota <= 0 || period <= 0) {
+        return 0;
+    }
+    return (int32_t)((quota + period - 1) / period);
+}
+
+// 在 /proc/self/cgroup 中查找本进程的 cgroup 路径: controller 为 NULL 时取
+// cgroup v2 的 "0::<path>" 行，否则取控制器列表含 controller 的 v1 行
+static bool port_cgroup_self_path(const char* controller, char* path, size_t size) {
+    FILE* f = fopen("/proc/self/cgroup", "r");
+    if (!f) {
+        return false;
+    }
+    char line[512];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), f)) {
+        char* c1 = strchr(line, ':');
+        char* c2 = c1 ? strchr(c1 + 1, ':') : NULL;
+        if (!c2) continue;
+        *c2 = '\0';
+        if (controller) {
+            // "N:cpu,cpuacct:/path"
+            char* save = NULL;
+            for (char* tok = strtok_r(c1 + 1, ",", &save); tok && !found;
+                 tok = strtok_r(NULL, ",", &save)) {
+                found = strcmp(tok, controller) == 0;
+            }
+        } else {
+            found = strcmp(line, "0") == 0 && c1[1] == '\0';
+        }
+        if (found) {
+            c2[1 + strcspn(c2 + 1, "\n")] = '\0';
+            snprintf(path, size, "%s", c2 + 1);
+        }
+    }
+    fclose(f);
+    return found;
+}
+
+// cgroup v2: 从本进程所在 cgroup 逐级向上读取 cpu.max ("max 100000" 或
+// "<quota> <period>")，取各级上限中最小者; 任何一级都没有 cpu.max 时返回 -1
+static int32_t port_cgroup_v2_limit(void) {
+    char rel[256];
+    if (!port_cgroup_self_path(NULL, rel, sizeof(rel))) {
+        return -1;
+    }
+    int32_t limit = 0;
+    bool seen = false;
+    char dir[320];
+    snprintf(dir, sizeof(dir), "/sys/fs/cgroup%s", strcmp(rel, "/") == 0 ? "" : rel);
+    while (1) {
+        char file[352];
+        snprintf(file, sizeof(file), "%s/cpu.max", dir);
+        FILE* f = fopen(file, "r");
+        if (f) {
+            char buf[32];
+            long long period = 0;
+            seen = true;
+            if (fscanf(f, "%31s %lld", buf, &period) == 2 && strcmp(buf, "max") != 0) {
+                int32_t n = port_quota_cpus(atoll(buf), period);
+                if (n > 0 && (limit == 0 || n < limit)) limit = n;
+            }
+            fclose(f);
+        }
+        char* slash = strrchr(dir, '/');
+        if (!slash || slash - dir < (long)strlen("/sys/fs/cgroup")) break;
+        *slash = '\0';
+    }
+    return seen ? limit : -1;
+}
+
+// cgroup v1: cpu 控制器下本进程所在 cgroup 的 cfs_quota_us / cfs_period_us
+// (cfs_quota_us = -1 表示无限制)，该目录不可见时 (如容器内) 读挂载点根
+static int32_t port_cgroup_v1_limit(void) {
+    char rel[256] = "";
+    port_cgroup_self_path("cpu", rel, sizeof(rel));
+    const char* dirs[2] = {rel, ""};
+    for (int d = 0; d < 2; d++) {
+        char file[352];
+        long long quota = -1, period = 0;
+        snprintf(file, sizeof(file), "/sys/fs/cgroup/cpu%s/cpu.cfs_quota_us",
+                 strcmp(dirs[d], "/") == 0 ? "" : dirs[d]);
+        FILE* f = fopen(file, "r");
+        if (!f) continue;
+        if (fscanf(f, "%lld", &quota) != 1) quota = -1;
+        fclose(f);
+        strcpy(strrchr(file, '/'), "/cpu.cfs_period_us");
+        f = fopen(file, "r");
+        if (f) {
+            if (fscanf(f, "%lld", &period) != 1) period = 0;
+            fclose(f);
+        }
+        return port_quota_cpus(quota, period);
+    }
+    return 0;
+}
+
+// 读取本进程 cgroup 的 CPU 配额折算的 CPU 数; 无限制或不可读返回 0
+static int32_t port_cgroup_cpu_limit(void) {
+    int32_t limit = port_cgroup_v2_limit();
+    return limit >= 0 ? limit : port_cgroup_v1_limit();
+}
+
+#endif
+
+int32_t tvmrt_cpu_count(void) {
+    int32_t n = 0;
+#ifdef __linux__
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        n = CPU_COUNT(&set);
+    }
+#endif
+    if (n <= 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        n = online > 0 ? (int32_t)online : 1;
+    }
+#ifdef __linux__
+    int32_t limit = port_cgroup_cpu_limit();
+    if (limit > 0 && limit < n) {
+        n = limit;
+    }
+#endif
+    return n;
+}
+
+int64_t tvmrt_cache_size(int32_t level) {
+    long size = -1;
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    int names[3] = {_SC_LEVEL1_DCACHE_SIZE, _SC_LEVEL2_CACHE_SIZE, _SC_LEVEL3_CACHE_SIZE};
+    if (level >= 1 && level <= 3) {
+        size = sysconf(names[level - 1]);
+    }
+#endif
+#ifdef __linux__
+    // sysconf 不可用时读 sysfs: index0 为 L1D，之后 L1I/L2/L3 (按 level 文件匹配)
+    for (int idx = 0; size <= 0 && idx < 8; idx++) {
+        char path[96], buf[32];
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", idx);
+        FILE* f = fopen(path, "r");
+        if (!f) break;
+        int lv = fgets(buf, sizeof(buf), f) ? atoi(buf) : 0;
+        fclose(f);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", idx);
+        f = fopen(path, "r");
+        bool inst = f && fgets(buf, sizeof(buf), f) && strncmp(buf, "Instruction", 11) == 0;
+        if (f) fclose(f);
+        if (lv != level || inst) continue;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", idx);
+        f = fopen(path, "r");
+        if (f && fgets(buf, sizeof(buf), f)) {
+            char* end = NULL;
+            long v = strtol(buf, &end, 10);
+            size = (end && (*end == 'K' || *end == 'k')) ? v * 1024 :
+                   (end && (*end == 'M' || *end == 'm')) ? v * 1024 * 1024 : v;
+        }
+        if (f) fclose(f);
+    }
+#endif
+    return size > 0 ? (int64_t)size : 0;
+}
+
+void tvmrt_cpu_model(char* buf, int32_t size) {
+    if (!buf || size <= 0) return;
+    snprintf(buf, (size_t)size, "unknown");
+#ifdef __linux__
+    FILE* f = fopen("/proc/cpuinfo", "r");
+    if (!f) return;
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        char* colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) != 0 || !colon) continue;
+        colon += (colon[1] == ' ') ? 2 : 1;
+        colon[strcspn(colon, "\n|")] = '\0';
+        snprintf(buf, (size_t)size, "%s", colon);
+        break;
+    }
+    fclose(f);
+#endif
+}
+
+// ============================================================
+// 硬件性能计数器实现 (Linux perf_event_open)
+// ============================================================
+
+#ifdef __linux__
+
+static int perf_fill_attr(struct perf_event_attr* attr, tvmrt_perf_event_t event) {
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+    attr->type = PERF_TYPE_HARDWARE;
+    switch (event) {
+        case TVMRT_PERF_CYCLES:           attr->config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case TVMRT_PERF_INSTRUCTIONS:     attr->config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case TVMRT_PERF_CACHE_REFERENCES: attr->config = PERF_COUNT_HW_CACHE_REFERENCES; break;
+        case TVMRT_PERF_CACHE_MISSES:     attr->config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case TVMRT_PERF_BRANCH_MISSES:    attr->config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        case TVMRT_PERF_L1D_READ_MISSES:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_L1D |
+                           (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        default: return TVMRT_ERR_GENERIC;
+    }
+    attr->exclude_kernel = 1;
+    attr->exclude_hv = 1;
+    return TVMRT_OK;
+}
+
+int tvmrt_perf_open(tvmrt_perf_counter_t* c, tvmrt_perf_event_t event) {
+    if (!c) return TVMRT_ERR_GENERIC;
+    c->fd = -1;
+
+    struct perf_event_attr attr;
+    if (perf_fill_attr(&attr, event) != TVMRT_OK) return TVMRT_ERR_GENERIC;
+    attr.inherit = 1;   // 计入之后创建的线程 (Worker)
+
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) return TVMRT_ERR_GENERIC;  // 无 PMU (虚拟机) 或权限不足
+    c->fd = (int32_t)fd;
+    return TVMRT_OK;
+}
+
+uint64_t tvmrt_perf_read(const tvmrt_perf_counter_t* c) {
+    uint64_t value = 0;
+    if (c && c->fd >= 0 && read(c->fd, &value, sizeof(value)) != (ssize_t)sizeof(value)) {
+        value = 0;
+    }
+    return value;
+}
+
+void tvmrt_perf_close(tvmrt_perf_counter_t* c) {
+    if (c && c->fd >= 0) {
+        close(c->fd);
+        c->fd = -1;
+    }
+}
+
+int tvmrt_perf_group_open(tvmrt_perf_group_t* g) {
+    if (!g) return TVMRT_ERR_GENERIC;
+    int32_t leader = -1;
+    g->mask = 0;
+    for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) {
+        g->fds[e] = -1;
+        struct perf_event_attr attr;
+        if (perf_fill_attr(&attr, (tvmrt_perf_event_t)e) != TVMRT_OK) continue;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // pid = 0, cpu = -1: 只统计调用线程，随线程迁移
+        long fd = syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+        if (fd < 0) continue;  // 个别事件不可用时跳过
+        g->fds[e] = (int32_t)fd;
+        g->mask |= 1u << e;
+        if (leader < 0) leader = (int32_t)fd;
+    }
+    return (leader >= 0) ? TVMRT_OK : TVMRT_ERR_GENERIC;
+}
+
+int tvmrt_perf_group_read(const tvmrt_perf_group_t* g, tvmrt_perf_sample_t* sample) {
+    if (!g || !sample || g->mask == 0) return TVMRT_ERR_GENERIC;
+
+    // { nr, time_enabled, time_running, value[nr] }，值的顺序与打开顺序一致
+    uint64_t buf[3 + TVMRT_PERF_EVENT_COUNT];
+    int32_t leader = -1;
+    for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT && leader < 0; e++) {
+        leader = g->fds[e];
+    }
+    ssize_t n = read(leader, buf, sizeof(buf));
+    if (n < (ssize_t)(3 * sizeof(uint64_t))) return TVMRT_ERR_GENERIC;
+
+    uint64_t nr = buf[0];
+    if (nr > (uint64_t)(n / (ssize_t)sizeof(uint64_t)) - 3) return TVMRT_ERR_GENERIC;
+    sample->time_enabled = buf[1];
+    sample->time_running = buf[2];
+    uint64_t k = 0;
+    for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) {
+        sample->values[e] = 0;
+        if (g->fds[e] >= 0 && k < nr) {
+            sample->values[e] = buf[3 + k++];
+        }
+    }
+    return TVMRT_OK;
+}
+
+void tvmrt_perf_group_close(tvmrt_perf_group_t* g) {
+    if (!g) return;
+    for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) {
+        if (g->fds[e] >= 0) {
+            close(g->fds[e]);
+            g->fds[e] = -1;
+        }
+    }
+    g->mask = 0;
+}
+
+#else
+
+int tvmrt_perf_open(tvmrt_perf_counter_t* c, tvmrt_perf_event_t event) {
+    (void)event;
+    if (c) c->fd = -1;
+    return TVMRT_ERR_GENERIC;
+}
+
+uint64_t tvmrt_perf_read(const tvmrt_perf_counter_t* c) {
+    (void)c;
+    return 0;
+}
+
+void tvmrt_perf_close(tvmrt_perf_counter_t* c) {
+    (void)c;
+}
+
+int tvmrt_perf_group_open(tvmrt_perf_group_t* g) {
+    if (g) {
+        for (int32_t e = 0; e < TVMRT_PERF_EVENT_COUNT; e++) g->fds[e] = -1;
+        g->mask = 0;
+    }
+    return TVMRT_ERR_GENERIC;
+}
+
+int tvmrt_perf_group_read(const tvmrt_perf_group_t* g, tvmrt_perf_sample_t* sample) {
+    (void)g;
+    (void)sample;
+    return TVMRT_ERR_GENERIC;
+}
+
+void tvmrt_perf_group_close(tvmrt_perf_group_t* g) {
+    (void)g;
+}
+
+#endif